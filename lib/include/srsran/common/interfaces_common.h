@@ -62,6 +62,7 @@ struct rf_args_t {
   std::string device_args;
   std::string time_adv_nsamples;
   std::string continuous_tx;
+  uint32_t    tx_fifo_ms = 0; // Depth of the Tx FIFO between the PHY and the devices, 0 transmits from the PHY workers
 
   std::array<rf_args_band_t, SRSRAN_MAX_CARRIERS> ch_rx_bands;
   std::array<rf_args_band_t, SRSRAN_MAX_CARRIERS> ch_tx_bands;
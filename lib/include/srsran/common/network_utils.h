@@ -196,6 +196,16 @@ make_sctp_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& q
 socket_manager_itf::recv_callback_t
 make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue, recvfrom_callback_t rx_callback);
 
+/**
+ * Similar to make_sdu_handler, but for datagram sockets with high packet rates. Up to batch_size datagrams are read
+ * with a single recvmmsg call into byte buffers that are kept posted between calls, and the whole batch is dispatched
+ * into the "queue" as a single task, which calls rx_callback once per datagram
+ */
+socket_manager_itf::recv_callback_t make_batch_sdu_handler(srslog::basic_logger&      logger,
+                                                           srsran::task_queue_handle& queue,
+                                                           uint32_t                   batch_size,
+                                                           recvfrom_callback_t        rx_callback);
+
 inline socket_manager& get_rx_io_manager()
 {
   static socket_manager io;
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_UDP_PCAP_READER_H
+#define SRSRAN_UDP_PCAP_READER_H
+
+#include "srsran/common/byte_buffer.h"
+#include "srsran/srslog/srslog.h"
+#include <netinet/in.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Reads the UDP datagrams of a capture file, e.g. to replay traffic recorded on a network interface
+ *
+ * It supports the classic pcap format, with microsecond or nanosecond timestamps in either byte order, and the
+ * Ethernet (with VLAN tags), Linux cooked (SLL and SLL2) and raw IP link types. Other packets, including IPv6 and IPv4
+ * fragments, are skipped.
+ */
+class udp_pcap_reader
+{
+public:
+  struct datagram_t {
+    uint64_t    time_us = 0; ///< Capture time relative to the first packet of the file
+    sockaddr_in src     = {};
+    sockaddr_in dst     = {};
+  };
+
+  explicit udp_pcap_reader(srslog::basic_logger& logger_) : logger(logger_) {}
+  ~udp_pcap_reader() { close(); }
+  udp_pcap_reader(const udp_pcap_reader&) = delete;
+  udp_pcap_reader& operator=(const udp_pcap_reader&) = delete;
+
+  bool open(const std::string& filename);
+  void close();
+  bool is_open() const { return file != nullptr; }
+
+  /**
+   * Reads the next UDP datagram of the file
+   * @param info Capture time and addresses of the datagram
+   * @param pdu Buffer the UDP payload is written to
+   * @return false at the end of the file or if it is corrupted
+   */
+  bool read(datagram_t& info, byte_buffer_t& pdu);
+
+  uint32_t get_nof_skipped() const { return nof_skipped; }
+
+private:
+  uint32_t to_host(uint32_t value) const { return swapped ? __builtin_bswap32(value) : value; }
+  bool     parse_udp(const uint8_t* data, uint32_t len, datagram_t& info, byte_buffer_t& pdu);
+
+  srslog::basic_logger& logger;
+  FILE*                 file          = nullptr;
+  bool                  swapped       = false; ///< The file was written with the opposite byte order
+  bool                  nsec          = false; ///< Timestamps in nanoseconds instead of microseconds
+  uint32_t              linktype      = 0;
+  bool                  first_packet  = true;
+  uint64_t              first_time_us = 0;
+  uint32_t              nof_skipped   = 0;
+  std::vector<uint8_t>  packet;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_UDP_PCAP_READER_H
@@ -23,6 +23,7 @@
 #define SRSRAN_ENB_COMMAND_INTERFACE_H
 
 #include <cstdint>
+#include <string>
 
 namespace srsenb {
 class enb_command_interface
@@ -41,6 +42,27 @@ public:
   virtual void cmd_cell_gain(uint32_t cell_id, float gain) = 0;
 
   virtual void toggle_padding() = 0;
+
+  /**
+   * Starts an MBMS session. The MCCH announces it from the next MCCH modification period on
+   * @param area_idx MBSFN area index, following the SIB13 area list order
+   * @param pmch_idx PMCH index within the MBSFN area
+   * @param plmn PLMN of the TMGI, as MCC and MNC digits
+   * @param service_id service ID of the TMGI
+   * @param lcid MTCH logical channel ID
+   * @param session_id MBMS session ID, or a negative value if not present
+   */
+  virtual void cmd_mbms_session_start(uint32_t           area_idx,
+                                      uint32_t           pmch_idx,
+                                      const std::string& plmn,
+                                      uint32_t           service_id,
+                                      uint32_t           lcid,
+                                      int                session_id) = 0;
+
+  /**
+   * Stops the MBMS session of a TMGI. The MCCH stops announcing it from the next MCCH modification period on
+   */
+  virtual void cmd_mbms_session_stop(const std::string& plmn, uint32_t service_id) = 0;
 };
 } // namespace srsenb
 
@@ -32,7 +32,10 @@ struct gtpu_args_t {
   std::string mme_addr;
   std::string embms_m1u_multiaddr;
   std::string embms_m1u_if_addr;
+  std::string embms_m1u_pcap;
   bool        embms_enable                 = false;
+  uint32_t    embms_mtch_max_delay_ms      = 0;
+  uint32_t    embms_mtch_queue_bytes       = 0;
   uint32_t    indirect_tunnel_timeout_msec = 0;
 };
 
@@ -53,6 +56,10 @@ public:
     bool     flush_before_teidin_present = false;
     uint32_t forward_from_teidin         = 0;
     uint32_t flush_before_teidin         = 0;
+    uint32_t mtch_rate_bps               = 0; ///< MRB only: capacity of the PMCH, used to shape the M1-U ingress
+    uint32_t mtch_burst_bytes            = 0; ///< MRB only: burst the M1-U ingress lets through at once
+    uint32_t mtch_pmch_id                = 0; ///< MRB only: PMCH of the MRB, whose MRBs share the capacity
+    uint32_t m1u_teid                    = 0; ///< MRB only: TEID of the M1-U packets carried by the MRB, 0 for none
   };
 
   virtual srsran::expected<uint32_t> add_bearer(uint16_t            rnti,
@@ -250,11 +250,29 @@ public:
   virtual int  bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, mac_lc_ch_cfg_t* cfg) = 0;
   virtual int  bearer_ue_rem(uint16_t rnti, uint32_t lc_id)                       = 0;
   virtual void phy_config_enabled(uint16_t rnti, bool enabled)                    = 0;
-  virtual void write_mcch(const srsran::sib2_mbms_t* sib2_,
-                          const srsran::sib13_t*     sib13_,
-                          const srsran::mcch_msg_t*  mcch_,
-                          const uint8_t*             mcch_payload,
-                          const uint8_t              mcch_payload_length)                      = 0;
+
+  /**
+   * Configures the MCH scheduling of all MBSFN areas
+   * @param mcch_list MCCH of each MBSFN area, in the same order as the SIB13 area list
+   * @param mcch_payload_list packed MCCH of each MBSFN area, including the RLC header
+   */
+  virtual void write_mcch(const srsran::sib2_mbms_t*                sib2_,
+                          const srsran::sib13_t*                    sib13_,
+                          const std::vector<srsran::mcch_msg_t>&    mcch_list,
+                          const std::vector<std::vector<uint8_t> >& mcch_payload_list) = 0;
+
+  /**
+   * Replaces the MCCH of an MBSFN area at the start of its next MCCH modification period (TS 36.331 5.8.1.3).
+   * Only the MBMS session list of the PMCHs may change, the subframe allocation stays as configured by write_mcch
+   * @param area_idx index of the MBSFN area in the SIB13 area list
+   * @param mcch new MCCH of the area
+   * @param mcch_payload packed MCCH, including the RLC header
+   * @param version number of the update, reported back by rrc_interface_mac::mcch_applied once it is in use
+   */
+  virtual void update_mcch(uint32_t                    area_idx,
+                           const srsran::mcch_msg_t&   mcch,
+                           const std::vector<uint8_t>& mcch_payload,
+                           uint32_t                    version) = 0;
 
   /**
    * Allocate a C-RNTI for a new user, without adding it to the phy layer and scheduler yet
@@ -37,12 +37,6 @@ public:
    */
   virtual void rem_rnti(uint16_t rnti) = 0;
 
-  /**
-   *
-   * @param stop
-   */
-  virtual void set_mch_period_stop(uint32_t stop) = 0;
-
   /**
    * Activates and/or deactivates Secondary Cells in the PHY for a given RNTI. Requires the RNTI of the given UE and a
    * vector with the activation/deactivation values. Use true for activation and false for deactivation. The index 0 is
@@ -61,7 +55,15 @@ class phy_interface_rrc_lte
 public:
   srsran::phy_cfg_mbsfn_t mbsfn_cfg;
 
-  virtual void configure_mbsfn(srsran::sib2_mbms_t* sib2, srsran::sib13_t* sib13, const srsran::mcch_msg_t& mcch) = 0;
+  /**
+   * Configures the MBSFN subframes and areas
+   * @param sib2 MBSFN subframe configuration
+   * @param sib13 MBSFN area list
+   * @param mcch_list MCCH of each MBSFN area, in the same order as the SIB13 area list
+   */
+  virtual void configure_mbsfn(srsran::sib2_mbms_t*                   sib2,
+                               srsran::sib13_t*                       sib13,
+                               const std::vector<srsran::mcch_msg_t>& mcch_list) = 0;
 
   struct phy_rrc_cfg_t {
     bool              configured = false; ///< Indicates whether PHY shall consider configuring this cell/carrier
@@ -41,6 +41,9 @@ public:
 
   ///< Provide packed SIB to MAC (buffer is managed by RRC)
   virtual uint8_t* read_pdu_bcch_dlsch(const uint8_t enb_cc_idx, const uint32_t sib_index) = 0;
+
+  ///< MCCH update of an MBSFN area that started being scheduled, at a modification period boundary
+  virtual void mcch_applied(uint32_t area_idx, uint32_t version) = 0;
 };
 
 } // namespace srsenb
@@ -24,6 +24,7 @@
 
 #include "../radio/rf_buffer.h"
 #include "../radio/rf_timestamp.h"
+#include <chrono>
 
 namespace srsran {
 
@@ -70,16 +71,20 @@ public:
    * @brief Describes a worker context
    */
   struct worker_context_t {
-    uint32_t               sf_idx     = 0;       ///< Subframe index
-    void*                  worker_ptr = nullptr; ///< Worker pointer for wait/release semaphore
-    bool                   last       = false;   ///< Indicates this worker is the last one in the sub-frame processing
-    srsran::rf_timestamp_t tx_time    = {};      ///< Transmit time, used only by last worker
+    using time_point = std::chrono::steady_clock::time_point;
+
+    uint32_t               sf_idx      = 0;       ///< Subframe index
+    void*                  worker_ptr  = nullptr; ///< Worker pointer for wait/release semaphore
+    bool                   last        = false;   ///< Indicates this worker is the last one in the sub-frame processing
+    srsran::rf_timestamp_t tx_time     = {};      ///< Transmit time, used only by last worker
+    time_point             tx_deadline = {};      ///< Host time matching tx_time, empty if not paced in real time
 
     void copy(const worker_context_t& other)
     {
-      sf_idx     = other.sf_idx;
-      worker_ptr = other.worker_ptr;
-      last       = other.last;
+      sf_idx      = other.sf_idx;
+      worker_ptr  = other.worker_ptr;
+      last        = other.last;
+      tx_deadline = other.tx_deadline;
       tx_time.copy(other.tx_time);
     }
 
@@ -58,6 +58,7 @@ public:
   virtual uint32_t size()                                                                                         = 0;
   virtual void     set_nof_samples(uint32_t n)                                                                    = 0;
   virtual uint32_t get_nof_samples() const                                                                        = 0;
+  virtual bool     is_sc16() const                                                                                = 0;
 };
 
 /**
@@ -136,6 +137,15 @@ public:
    */
   virtual bool rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time) = 0;
 
+  /**
+   * Reads the current time of every RF device without receiving any sample. It allows timing transmissions when the
+   * receive stream is not running
+   *
+   * @param now Current time of each RF device
+   * @return it returns true if the time was read, false if the radio does not provide it
+   */
+  virtual bool get_time(rf_timestamp_interface& now) = 0;
+
   /**
    * Sets the TX frequency for all antennas in the provided carrier index
    * @param carrier_idx Index of the carrier to change the frequency
@@ -194,6 +204,13 @@ public:
    */
   virtual void set_channel_rx_offset(uint32_t ch, int32_t offset_samples) = 0;
 
+  /**
+   * Gets the scale of the Tx samples the radio takes as interleaved int16 I/Q, in buffers flagged with
+   * rf_buffer_interface::is_sc16(). It saves the float to int16 conversion of the RF devices
+   * @return Value a float amplitude of 1.0 maps to, 0 if the radio only takes cf_t samples
+   */
+  virtual float get_tx_sc16_scale() = 0;
+
   // getter
   virtual double            get_freq_offset()       = 0;
   virtual float             get_rx_gain()           = 0;
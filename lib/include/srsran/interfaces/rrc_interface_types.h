@@ -349,7 +349,7 @@ struct mbsfn_area_info_t {
   struct mcch_cfg_t {
     enum class repeat_period_t { rf32, rf64, rf128, rf256, nulltype } mcch_repeat_period;
     uint8_t mcch_offset = 0;
-    enum class mod_period_t { rf512, rf1024 } mcch_mod_period;
+    enum class mod_period_t { rf512, rf1024, nulltype } mcch_mod_period;
     uint8_t sf_alloc_info = 0;
     enum class sig_mcs_t { n2, n7, n13, n19, nulltype } sig_mcs;
   } mcch_cfg;
@@ -365,6 +365,12 @@ inline uint16_t enum_to_number(const mbsfn_area_info_t::mcch_cfg_t::repeat_perio
   return enum_to_number(
       options, (uint32_t)mbsfn_area_info_t::mcch_cfg_t::repeat_period_t::nulltype, (uint32_t)repeat_period);
 }
+inline uint16_t enum_to_number(const mbsfn_area_info_t::mcch_cfg_t::mod_period_t& mod_period)
+{
+  constexpr static uint16_t options[] = {512, 1024};
+  return enum_to_number(
+      options, (uint32_t)mbsfn_area_info_t::mcch_cfg_t::mod_period_t::nulltype, (uint32_t)mod_period);
+}
 inline uint16_t enum_to_number(const mbsfn_area_info_t::mcch_cfg_t::sig_mcs_t& sig_mcs)
 {
   constexpr static uint16_t options[] = {2, 7, 13, 19};
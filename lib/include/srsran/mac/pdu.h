@@ -402,6 +402,7 @@ public:
 
   static uint32_t size_header_sdu(uint32_t nbytes);
   bool            update_space_ce(uint32_t nbytes, bool var_len = false);
+  bool            update_space_var_ce(uint32_t old_len, uint32_t new_len);
   bool            update_space_sdu(uint32_t nbytes);
   void            to_string(fmt::memory_buffer& buffer);
 };
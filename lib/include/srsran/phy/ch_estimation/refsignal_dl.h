@@ -96,6 +96,13 @@ SRSRAN_API int srsran_refsignal_mbsfn_put_sf(srsran_cell_t cell,
                                              cf_t*         mbsfn_pilots,
                                              cf_t*         sf_symbols);
 
+/* Puts the cell-specific reference signals of the non-MBSFN region of an MBSFN subframe */
+SRSRAN_API int srsran_refsignal_mbsfn_put_cs(srsran_cell_t cell, uint32_t port_id, cf_t* cs_pilots, cf_t* sf_symbols);
+
+/* Puts the MBSFN reference signals of the MBSFN region, only transmitted along with the PMCH (TS 36.211 6.10.2) */
+SRSRAN_API int
+srsran_refsignal_mbsfn_put_mbsfn(srsran_cell_t cell, uint32_t port_id, cf_t* mbsfn_pilots, cf_t* sf_symbols);
+
 SRSRAN_API int srsran_refsignal_mbsfn_gen_seq(srsran_refsignal_t* q, srsran_cell_t cell, uint32_t N_mbsfn_id);
 
 #endif // SRSRAN_REFSIGNAL_DL_H
@@ -250,6 +250,7 @@ typedef struct SRSRAN_API {
   uint32_t            cfi;
   srsran_sf_t         sf_type;
   uint32_t            non_mbsfn_region;
+  uint16_t            mbsfn_area_id; // MBSFN area of an MBSFN subframe
 } srsran_dl_sf_cfg_t;
 
 typedef struct SRSRAN_API {
@@ -72,6 +72,7 @@ typedef struct SRSRAN_API {
   srsran_ofdm_cfg_t cfg;
   srsran_dft_plan_t fft_plan;
   srsran_dft_plan_t fft_plan_sf[2];
+  srsran_dft_plan_t fft_plan_mbsfn; ///< Tx guru plan for the first slot of MBSFN subframes
   uint32_t          max_prb;
   uint32_t          nof_symbols;
   uint32_t          nof_guards;
@@ -87,7 +88,8 @@ typedef struct SRSRAN_API {
   cf_t*             shift_buffer;
   cf_t*             window_offset_buffer;
   cf_t              phase_compensation[SRSRAN_MAX_NSYMB * SRSRAN_NOF_SLOTS_PER_SF];
-  srsran_cfr_t      tx_cfr; ///< Tx CFR object
+  cf_t              phase_compensation_mbsfn[SRSRAN_CP_EXT_NSYMB]; ///< First slot of MBSFN subframes
+  srsran_cfr_t      tx_cfr;                                        ///< Tx CFR object
 } srsran_ofdm_t;
 
 /**
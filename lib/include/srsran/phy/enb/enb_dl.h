@@ -59,6 +59,23 @@
 
 #include "srsran/config.h"
 
+/* MBSFN areas a cell can take part in (TS 36.331 maxMBSFN-Area) */
+#define SRSRAN_ENB_DL_MAX_MBSFN_AREAS 8
+
+/* Precomputed base signals: subframe type, subframe index and CFI */
+#define SRSRAN_ENB_DL_NOF_BASE_TEMPLATES (2 * SRSRAN_NOF_SF_X_FRAME * SRSRAN_NOF_CFI)
+
+/* Resource elements put by srsran_enb_dl_put_base in a subframe, except the PBCH: PSS/SSS, reference signals and
+ * PCFICH. They only depend on the cell, the subframe type, the subframe index and the CFI. The MBSFN reference
+ * signals are not part of them, they are put with the PMCH */
+typedef struct SRSRAN_API {
+  uint32_t* re_idx[SRSRAN_MAX_PORTS];  ///< Index of each RE in the subframe grid
+  cf_t*     re_symb[SRSRAN_MAX_PORTS]; ///< Value of each RE
+  uint32_t  nof_re[SRSRAN_MAX_PORTS];
+  uint32_t  max_re[SRSRAN_MAX_PORTS];
+  bool      valid;
+} srsran_enb_dl_base_template_t;
+
 typedef struct SRSRAN_API {
   srsran_cell_t cell;
 
@@ -80,7 +97,10 @@ typedef struct SRSRAN_API {
   srsran_phich_t  phich;
 
   srsran_refsignal_t csr_signal;
-  srsran_refsignal_t mbsfnr_signal;
+  srsran_refsignal_t mbsfnr_signal[SRSRAN_ENB_DL_MAX_MBSFN_AREAS]; ///< MBSFN reference signals of each area
+  uint16_t           mbsfn_area_id[SRSRAN_ENB_DL_MAX_MBSFN_AREAS];
+  uint32_t           nof_mbsfn_areas;
+  uint32_t           max_prb;
 
   cf_t  pss_signal[SRSRAN_PSS_LEN];
   float sss_signal0[SRSRAN_SSS_LEN];
@@ -89,6 +109,8 @@ typedef struct SRSRAN_API {
   uint32_t              nof_common_locations[3];
   srsran_dci_location_t common_locations[3][SRSRAN_MAX_CANDIDATES_COM];
 
+  srsran_enb_dl_base_template_t base_templates[SRSRAN_ENB_DL_NOF_BASE_TEMPLATES];
+
 } srsran_enb_dl_t;
 
 typedef struct {
@@ -106,6 +128,11 @@ SRSRAN_API int srsran_enb_dl_set_cell(srsran_enb_dl_t* q, srsran_cell_t cell);
 
 SRSRAN_API int srsran_enb_dl_set_cfr(srsran_enb_dl_t* q, const srsran_cfr_cfg_t* cfr);
 
+/* Sets the MBSFN areas of the cell, replacing the previous ones: PMCH scrambling and MBSFN reference signals are
+ * generated for each of them. Only area 0 is set after init. The area of every PMCH is selected with the area_id of
+ * its configuration */
+SRSRAN_API int srsran_enb_dl_set_mbsfn_areas(srsran_enb_dl_t* q, const uint16_t* area_ids, uint32_t nof_areas);
+
 SRSRAN_API bool srsran_enb_dl_location_is_common_ncce(srsran_enb_dl_t* q, const srsran_dci_location_t* loc);
 
 SRSRAN_API void srsran_enb_dl_put_base(srsran_enb_dl_t* q, srsran_dl_sf_cfg_t* dl_sf);
@@ -119,8 +146,15 @@ SRSRAN_API int srsran_enb_dl_put_pdcch_ul(srsran_enb_dl_t* q, srsran_dci_cfg_t*
 SRSRAN_API int
 srsran_enb_dl_put_pdsch(srsran_enb_dl_t* q, srsran_pdsch_cfg_t* pdsch, uint8_t* data[SRSRAN_MAX_CODEWORDS]);
 
+/* Puts the PMCH with the MBSFN reference signals of its area. MBSFN subframes without PMCH have an empty MBSFN region
+ * (TS 36.211 6.10.2) */
 SRSRAN_API int srsran_enb_dl_put_pmch(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmch_cfg, uint8_t* data);
 
+SRSRAN_API int
+srsran_enb_dl_encode_pmch_symbols(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmch_cfg, uint8_t* data, cf_t* symbols);
+
+SRSRAN_API int srsran_enb_dl_put_pmch_symbols(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmch_cfg, cf_t* symbols);
+
 SRSRAN_API void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q);
 
 SRSRAN_API bool srsran_enb_dl_gen_cqi_periodic(const srsran_cell_t*   cell,
@@ -64,6 +64,17 @@ SRSRAN_API int srsran_rm_turbo_tx_lut(uint8_t* w_buff,
                                       uint32_t w_offset,
                                       uint32_t rv_idx);
 
+/* Sub-block interleaving and bit collection of a code block into its circular buffer. Only needed for rv 0 */
+SRSRAN_API int srsran_rm_turbo_tx_lut_collect(uint8_t* w_buff, uint8_t* systematic, uint8_t* parity, uint32_t cb_idx);
+
+/* Bit selection from a circular buffer filled by srsran_rm_turbo_tx_lut_collect() */
+SRSRAN_API int srsran_rm_turbo_tx_lut_select(uint8_t* w_buff,
+                                             uint8_t* output,
+                                             uint32_t cb_idx,
+                                             uint32_t out_len,
+                                             uint32_t w_offset,
+                                             uint32_t rv_idx);
+
 SRSRAN_API int srsran_rm_turbo_rx(float*   w_buff,
                                   uint32_t buff_len,
                                   float*   input,
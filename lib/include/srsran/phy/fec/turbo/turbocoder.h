@@ -38,6 +38,9 @@
 #include "srsran/phy/fec/turbo/tc_interl.h"
 #define SRSRAN_TCOD_MAX_LEN_CB_BYTES (6144 / 8)
 
+/* Maximum number of code blocks srsran_tcod_encode_multi() encodes in one call */
+#define SRSRAN_TCOD_MAX_PARALLEL_CB 8
+
 #ifndef SRSRAN_TX_NULL
 #define SRSRAN_TX_NULL 100
 #endif
@@ -66,6 +69,23 @@ SRSRAN_API int srsran_tcod_encode_lut(srsran_tcod_t* h,
                                       uint32_t       cblen_idx,
                                       bool           last_cb);
 
+/* Feeds a code block to the transport block CRC and writes the CRCs at its end, exactly as srsran_tcod_encode_lut()
+ * does. Code blocks must be given in transport block order. crc_cb may be NULL for a single code block */
+SRSRAN_API int srsran_tcod_attach_crc(srsran_crc_t* crc_tb,
+                                      srsran_crc_t* crc_cb,
+                                      uint8_t*      input,
+                                      uint32_t      cblen_idx,
+                                      bool          last_cb);
+
+/* Encodes up to SRSRAN_TCOD_MAX_PARALLEL_CB code blocks of the same size which already carry their CRCs. The input
+ * tail and parity bytes are bit-exact with srsran_tcod_encode_lut(). The constituent encoders run 64 bits at a time
+ * and one code block per SIMD lane */
+SRSRAN_API int srsran_tcod_encode_multi(srsran_tcod_t* h,
+                                        uint8_t**      input,
+                                        uint8_t**      parity,
+                                        uint32_t       cblen_idx,
+                                        uint32_t       nof_cb);
+
 SRSRAN_API void srsran_tcod_gentable();
 
 #endif // SRSRAN_TURBOCODER_H
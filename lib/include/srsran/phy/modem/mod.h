@@ -41,4 +41,18 @@ SRSRAN_API int srsran_mod_modulate(const srsran_modem_table_t* table, uint8_t* b
 SRSRAN_API int
 srsran_mod_modulate_bytes(const srsran_modem_table_t* q, const uint8_t* bits, cf_t* symbols, uint32_t nbits);
 
+/**
+ * Scrambles packed bits with a packed scrambling sequence and modulates them in one pass, without intermediate
+ * buffers. Symbols are written every stride elements, so that they can be mapped straight to the resource grid.
+ * @param bit_offset Position of the first bit in both the bits and the sequence
+ * @return The number of symbols written
+ */
+SRSRAN_API int srsran_mod_modulate_scrambled_bytes(const srsran_modem_table_t* q,
+                                                   const uint8_t*              bits,
+                                                   const uint8_t*              seq,
+                                                   uint32_t                    bit_offset,
+                                                   cf_t*                       symbols,
+                                                   uint32_t                    nof_symbols,
+                                                   uint32_t                    stride);
+
 #endif // SRSRAN_MOD_H
@@ -107,6 +107,9 @@ typedef struct SRSRAN_API {
   uint32_t preamble_idx;
   uint32_t prach_mask_idx;
 
+  // MCCH change notification, format 1C with M-RNTI. Bit i flags the MBSFN area with notificationIndicator i
+  uint8_t mcch_change_notif;
+
   // Release 10
   uint32_t cif;
   bool     cif_present;
@@ -68,6 +68,8 @@ typedef struct SRSRAN_API {
   uint8_t* rm_b;
   uint8_t  data[SRSRAN_BCH_PAYLOADCRC_LEN];
   uint8_t  data_enc[SRSRAN_BCH_ENCODED_LEN];
+  uint8_t  tx_payload[SRSRAN_BCH_PAYLOAD_LEN]; ///< Payload rm_b holds the scrambled bits of, for its 4 frames
+  bool     tx_payload_valid;
 
   uint32_t frame_idx;
 
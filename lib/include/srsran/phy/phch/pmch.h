@@ -96,6 +96,27 @@ SRSRAN_API int srsran_pmch_encode(srsran_pmch_t*      q,
                                   uint8_t*            data,
                                   cf_t*               sf_symbols[SRSRAN_MAX_PORTS]);
 
+/**
+ * Encodes, scrambles and modulates a PMCH transport block into complex symbols, without mapping them to the resource
+ * grid. The symbols only depend on the TB, the grant, the MBSFN area ID and the subframe index, so they can be mapped
+ * again with srsran_pmch_put_symbols() for as long as none of them changes.
+ * @param symbols Output buffer of at least cfg->pdsch_cfg.grant.nof_re symbols
+ */
+SRSRAN_API int srsran_pmch_encode_symbols(srsran_pmch_t*      q,
+                                          srsran_dl_sf_cfg_t* sf,
+                                          srsran_pmch_cfg_t*  cfg,
+                                          uint8_t*            data,
+                                          cf_t*               symbols);
+
+/**
+ * Maps PMCH symbols, as generated by srsran_pmch_encode_symbols(), to the resource grid of every port
+ */
+SRSRAN_API int srsran_pmch_put_symbols(srsran_pmch_t*      q,
+                                       srsran_dl_sf_cfg_t* sf,
+                                       srsran_pmch_cfg_t*  cfg,
+                                       cf_t*               symbols,
+                                       cf_t*               sf_symbols[SRSRAN_MAX_PORTS]);
+
 SRSRAN_API int srsran_pmch_decode(srsran_pmch_t*         q,
                                   srsran_dl_sf_cfg_t*    sf,
                                   srsran_pmch_cfg_t*     cfg,
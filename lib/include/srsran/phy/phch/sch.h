@@ -39,6 +39,7 @@
 #include "srsran/phy/phch/pdsch_cfg.h"
 #include "srsran/phy/phch/pusch_cfg.h"
 #include "srsran/phy/phch/uci.h"
+#include <pthread.h>
 
 #ifndef SRSRAN_RX_NULL
 #define SRSRAN_RX_NULL 10000
@@ -48,6 +49,12 @@
 #define SRSRAN_TX_NULL 100
 #endif
 
+/* Threads shared by several DL-SCH encoders to turbo encode the code blocks of a transport block in parallel */
+typedef struct srsran_sch_tx_pool_s srsran_sch_tx_pool_t;
+
+/* Starts a thread of the pool running start_routine(arg), e.g. with threads_new_rt_prio(). Returns true on success */
+typedef bool (*srsran_sch_thread_create_t)(pthread_t* thread, void* (*start_routine)(void*), void* arg, void* user);
+
 /* DL-SCH AND UL-SCH common functions */
 typedef struct SRSRAN_API {
 
@@ -57,8 +64,8 @@ typedef struct SRSRAN_API {
   bool llr_is_8bit;
 
   /* buffers */
-  uint8_t*         cb_in;
-  uint8_t*         parity_bits;
+  uint8_t*         cb_in[SRSRAN_TCOD_MAX_PARALLEL_CB]; // Code blocks turbo encoded together
+  uint8_t*         parity_bits[SRSRAN_TCOD_MAX_PARALLEL_CB];
   void*            e;
   uint8_t*         temp_g_bits;
   uint32_t*        ul_interleaver;
@@ -71,6 +78,8 @@ typedef struct SRSRAN_API {
 
   srsran_uci_cqi_pusch_t uci_cqi;
 
+  srsran_sch_tx_pool_t* tx_pool;
+
 } srsran_sch_t;
 
 SRSRAN_API int srsran_sch_init(srsran_sch_t* q);
@@ -81,6 +90,19 @@ SRSRAN_API void srsran_sch_set_max_noi(srsran_sch_t* q, uint32_t max_iterations)
 
 SRSRAN_API float srsran_sch_last_noi(srsran_sch_t* q);
 
+/* Creates nof_threads threads, each with its own turbo encoder. The threads are started by create_thread(..., user),
+ * which sets their priority and affinity, or with the default attributes if it is NULL. Returns NULL on error */
+SRSRAN_API srsran_sch_tx_pool_t* srsran_sch_tx_pool_create(uint32_t                   nof_threads,
+                                                           srsran_sch_thread_create_t create_thread,
+                                                           void*                      user);
+
+/* Stops the threads of the pool. No encoder may be using it */
+SRSRAN_API void srsran_sch_tx_pool_free(srsran_sch_tx_pool_t* pool);
+
+/* Makes the encoder spread the code blocks of each transport block between the calling thread and the pool, which
+ * may be shared with other encoders. NULL encodes all code blocks in the calling thread */
+SRSRAN_API void srsran_sch_set_tx_pool(srsran_sch_t* q, srsran_sch_tx_pool_t* pool);
+
 SRSRAN_API int srsran_dlsch_encode(srsran_sch_t* q, srsran_pdsch_cfg_t* cfg, uint8_t* data, uint8_t* e_bits);
 
 SRSRAN_API int srsran_dlsch_encode2(srsran_sch_t*       q,
@@ -51,8 +51,69 @@ typedef struct SRSRAN_API {
 
 } srsran_resample_arb_t;
 
+/**
+ * Delay, in input samples, between the input and the output of the streaming resampler
+ */
+#define SRSRAN_RESAMPLE_ARB_DELAY (SRSRAN_RESAMPLE_ARB_M / 2)
+
+/**
+ * Streaming arbitrary rate resampler. The rate is the exact fraction up/down, so the output does not drift from the
+ * input however long it runs, and the filter window is carried from one block to the next.
+ */
+typedef struct SRSRAN_API {
+  uint32_t up;     // Output rate factor
+  uint32_t down;   // Input rate factor
+  uint32_t phase;  // Position of the next output after its window newest input, in 1/up input samples
+  uint32_t offset; // Index of the newest input sample of the next output window, relative to the next block
+  float    phase_scale;                  // Polyphase filter rows per phase unit
+  float*   coeff;                        // Polyphase filter with every tap repeated for real and imaginary parts
+  cf_t     hist[SRSRAN_RESAMPLE_ARB_M]; // Last input samples of the previous block
+} srsran_resample_arb_stream_t;
+
 SRSRAN_API void srsran_resample_arb_init(srsran_resample_arb_t* q, float rate, bool interpolate);
 
 SRSRAN_API int srsran_resample_arb_compute(srsran_resample_arb_t* q, cf_t* input, cf_t* output, int n_in);
 
+/**
+ * Initialises a streaming resampler with an output rate of up/down times the input rate
+ * @param q Resampler object
+ * @param up Output rate factor
+ * @param down Input rate factor
+ * @return SRSRAN_SUCCESS if the initialization is successful, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_resample_arb_stream_init(srsran_resample_arb_stream_t* q, uint32_t up, uint32_t down);
+
+/**
+ * Resets the filter window and phase of a streaming resampler, keeping its rate
+ * @param q Resampler object
+ */
+SRSRAN_API void srsran_resample_arb_stream_reset(srsran_resample_arb_stream_t* q);
+
+/**
+ * Resamples a block of samples, continuing the stream of the previous block
+ * @param q Resampler object
+ * @param input Input block
+ * @param output Output block, it must fit at least ceil(n_in * up / down) samples
+ * @param n_in Number of input samples
+ * @return The number of output samples
+ */
+SRSRAN_API uint32_t srsran_resample_arb_stream_run(srsran_resample_arb_stream_t* q,
+                                                   const cf_t*                   input,
+                                                   cf_t*                         output,
+                                                   uint32_t                      n_in);
+
+/**
+ * Gets the time of the next output sample relative to the first sample of the next input block, so the output can be
+ * timestamped from the input timestamps
+ * @param q Resampler object
+ * @return The time in input samples, negative if it precedes the block
+ */
+SRSRAN_API double srsran_resample_arb_stream_next_time(const srsran_resample_arb_stream_t* q);
+
+/**
+ * Frees the memory allocated by a streaming resampler
+ * @param q Resampler object
+ */
+SRSRAN_API void srsran_resample_arb_stream_free(srsran_resample_arb_stream_t* q);
+
 #endif // SRSRAN_RESAMPLE_ARB_
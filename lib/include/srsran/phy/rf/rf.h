@@ -129,6 +129,16 @@ typedef struct {
                                     bool   blocking,
                                     bool   is_start_of_burst,
                                     bool   is_end_of_burst);
+  float (*srsran_rf_get_tx_sc16_scale)(void* h);
+  int (*srsran_rf_send_timed_multi_sc16)(void*  h,
+                                         void** data,
+                                         int    nsamples,
+                                         time_t secs,
+                                         double frac_secs,
+                                         bool   has_time_spec,
+                                         bool   blocking,
+                                         bool   is_start_of_burst,
+                                         bool   is_end_of_burst);
 } rf_dev_t;
 
 typedef struct {
@@ -252,6 +262,26 @@ SRSRAN_API int srsran_rf_send_multi(srsran_rf_t* rf,
                                     bool         is_start_of_burst,
                                     bool         is_end_of_burst);
 
+/**
+ * @brief Gets the scale of the Tx samples the device takes as interleaved int16 I/Q
+ * @param[in] rf Device handle
+ * @return Value a float amplitude of 1.0 maps to, 0 if the device only takes floating point samples at its current rate
+ */
+SRSRAN_API float srsran_rf_get_tx_sc16_scale(srsran_rf_t* rf);
+
+/**
+ * @brief Same as srsran_rf_send_timed_multi with interleaved int16 I/Q samples, already scaled as reported by
+ * srsran_rf_get_tx_sc16_scale
+ */
+SRSRAN_API int srsran_rf_send_timed_multi_sc16(srsran_rf_t* rf,
+                                               void**       data,
+                                               int          nsamples,
+                                               time_t       secs,
+                                               double       frac_secs,
+                                               bool         blocking,
+                                               bool         is_start_of_burst,
+                                               bool         is_end_of_burst);
+
 #ifdef __cplusplus
 }
 #endif
@@ -189,6 +189,7 @@ SRSRAN_API void srsran_vec_sc_prod_fcc(const float* x, const cf_t h, cf_t* z, co
 SRSRAN_API void srsran_vec_sc_prod_ccc(const cf_t* x, const cf_t h, cf_t* z, const uint32_t len);
 SRSRAN_API void srsran_vec_sc_prod_fff(const float* x, const float h, float* z, const uint32_t len);
 
+/* converts with saturation, z may point to x for an in-place conversion to the first half of its memory */
 SRSRAN_API void srsran_vec_convert_fi(const float* x, const float scale, int16_t* z, const uint32_t len);
 SRSRAN_API void srsran_vec_convert_conj_cs(const cf_t* x, const float scale, int16_t* z, const uint32_t len);
 SRSRAN_API void srsran_vec_convert_if(const int16_t* x, const float scale, float* z, const uint32_t len);
@@ -145,6 +145,9 @@ SRSRAN_API uint32_t srsran_vec_max_abs_fi_simd(const float* x, const int len);
 
 SRSRAN_API uint32_t srsran_vec_max_ci_simd(const cf_t* x, const int len);
 
+/* Instruction set the SIMD functions above run with, either selected at runtime or fixed at build time */
+SRSRAN_API const char* srsran_vec_simd_isa_name(void);
+
 #ifdef __cplusplus
 }
 #endif
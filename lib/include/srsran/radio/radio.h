@@ -23,8 +23,11 @@
 #include "radio_metrics.h"
 #include "rf_buffer.h"
 #include "rf_timestamp.h"
+#include "rf_tx_fifo.h"
 #include "srsran/common/interfaces_common.h"
+#include "srsran/common/threads.h"
 #include "srsran/interfaces/radio_interfaces.h"
+#include "srsran/phy/resampling/resample_arb.h"
 #include "srsran/phy/resampling/resampler.h"
 #include "srsran/phy/rf/rf.h"
 #include "srsran/radio/radio_base.h"
@@ -66,6 +69,7 @@ public:
   void tx_end() override;
   bool tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_time) override;
   bool rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time) override;
+  bool get_time(rf_timestamp_interface& now) override;
 
   // setter
   void set_tx_freq(const uint32_t& carrier_idx, const double& freq) override;
@@ -80,6 +84,7 @@ public:
   void set_channel_rx_offset(uint32_t ch, int32_t offset_samples) override;
 
   // getter
+  float             get_tx_sc16_scale() override;
   double            get_freq_offset() override;
   float             get_rx_gain() override;
   bool              is_continuous_tx() override;
@@ -111,6 +116,22 @@ private:
   std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> interpolators = {};
   std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> decimators    = {};
   std::atomic<bool> decimator_busy = {false}; ///< Indicates the decimator is changing the rate
+  std::array<srsran_resample_arb_stream_t, SRSRAN_MAX_CHANNELS> tx_resamplers = {}; ///< Non-integer ratio Tx resampling
+  srsran_timestamp_t tx_resample_end = {}; ///< Time of the Tx sample following the last one resampled
+
+  /// Streams the subframes queued by tx() to the devices when the Tx FIFO is enabled
+  class tx_fifo_thread : public thread
+  {
+  public:
+    explicit tx_fifo_thread(radio* parent_) : thread("RF_TX"), parent(parent_) {}
+
+  private:
+    void   run_thread() override { parent->run_tx_fifo(); }
+    radio* parent;
+  };
+  rf_tx_fifo        tx_fifo;
+  tx_fifo_thread    tx_thread{this};
+  std::atomic<bool> tx_fifo_running{false};
 
   rf_timestamp_t    end_of_burst_time = {};
   std::atomic<bool> is_start_of_burst{false};
@@ -125,6 +146,9 @@ private:
   double            cur_tx_srate       = 0.0;
   double            cur_rx_srate       = 0.0;
   double            fix_srate_hz       = 0.0;
+  bool              tx_resample_arb    = false; ///< Indicates Tx uses tx_resamplers instead of interpolators
+  double            tx_resample_srate  = 0.0;   ///< Sampling rate of the Tx samples before resampling
+  float             tx_sc16_scale      = 0.0f;  ///< Scale of the int16 Tx samples all devices take, 0 if not
   uint32_t          nof_antennas       = 0;
   uint32_t          nof_channels       = 0;
   uint32_t          nof_channels_x_dev = 0;
@@ -198,6 +222,25 @@ private:
   // private unprotected tx_end implementation
   void tx_end_nolock();
 
+  /**
+   * Transmits the buffer from the calling thread, it is the implementation of tx() when the Tx FIFO is disabled
+   *
+   * @param buffer Common transmit buffer
+   * @param tx_time Timestamp to transmit
+   * @return it returns true if the transmission was successful, otherwise it returns false
+   */
+  bool tx_now(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_time);
+
+  /**
+   * Body of the Tx FIFO thread, it pops the queued subframes and transmits them until the radio is stopped
+   */
+  void run_tx_fifo();
+
+  /**
+   * Stops the Tx FIFO thread and waits for it to finish, the subframes still queued are discarded
+   */
+  void stop_tx_fifo();
+
   /**
    * Helper method for receiving over a single RF device. This function maps automatically the logical receive buffers
    * to the physical RF buffers for the given device.
@@ -266,6 +266,11 @@ public:
 
     return true;
   }
+  bool get_time(srsran::rf_timestamp_interface& now) override
+  {
+    srsran_timestamp_init_uint64(now.get_ptr(0), rx_timestamp, (double)srate_hz);
+    return true;
+  }
   void set_tx_freq(const uint32_t& channel_idx, const double& freq) override
   {
     logger.info("Set Tx freq to %+.0f MHz.", freq * 1.0e-6);
@@ -296,6 +301,7 @@ public:
   double            get_freq_offset() override { return 0; }
   bool              is_continuous_tx() override { return false; }
   bool              get_is_start_of_burst() override { return false; }
+  float             get_tx_sc16_scale() override { return 0.0f; }
   bool              is_init() override { return is_initialised; }
   void              reset() override {}
   srsran_rf_info_t* get_info() override { return &rf_info; }
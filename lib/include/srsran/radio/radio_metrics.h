@@ -29,6 +29,16 @@ typedef struct {
   uint32_t rf_u;
   uint32_t rf_l;
   bool     rf_error;
+  uint32_t tx_fifo_size;      ///< Capacity of the Tx FIFO in subframes, 0 if it is disabled
+  uint32_t tx_fifo_min_depth; ///< Fewest subframes queued ahead of the device, 0 if none was transmitted
+  uint32_t tx_fifo_max_depth; ///< Most subframes queued ahead of the device
+  uint32_t tx_fifo_drop;      ///< Subframes dropped because the Tx FIFO was full
+  uint32_t tx_late;           ///< Transmissions dropped because they started and ended before the previous one ended
+  uint32_t tx_trim;           ///< Transmissions whose start overlapped the previous one and was trimmed
+  uint32_t tx_trim_max_us;    ///< Longest trimmed overlap
+  uint32_t tx_gap;            ///< Gaps after the previous transmission filled with zeros
+  uint32_t tx_gap_max_us;     ///< Longest gap filled with zeros
+  uint32_t tx_gap_eob;        ///< Gaps too long to fill, which ended the burst
 } rf_metrics_t;
 
 } // namespace srsran
@@ -76,6 +76,12 @@ public:
     return true;
   }
 
+  bool get_time(rf_timestamp_interface& now) override
+  {
+    logger.info("%s", __PRETTY_FUNCTION__);
+    return false;
+  }
+
   void set_rx_gain(const float& gain) override { logger.info("%s", __PRETTY_FUNCTION__); }
 
   void set_rx_gain_th(const float& gain) override { logger.info("%s", __PRETTY_FUNCTION__); }
@@ -112,6 +118,8 @@ public:
 
   bool get_is_start_of_burst() override { return true; }
 
+  float get_tx_sc16_scale() override { return 0.0f; }
+
   void release_freq(const uint32_t& carrier_idx) override { logger.info("%s", __PRETTY_FUNCTION__); }
 
 protected:
@@ -107,6 +107,7 @@ public:
     for (int i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
       this->sample_buffer[i] = other.sample_buffer[i];
     }
+    this->sc16 = other.sc16;
     return *this;
   }
 
@@ -135,8 +136,9 @@ public:
   }
   void set_combine(const rf_buffer_interface& other)
   {
-    // Take the other number of samples always
+    // Take the other number of samples and format always, int16 samples are only passed through
     set_nof_samples(other.get_nof_samples());
+    set_sc16(other.is_sc16());
     for (uint32_t ch = 0; ch < SRSRAN_MAX_CHANNELS; ch++) {
       set_combine(ch, other.get(ch));
     }
@@ -146,12 +148,19 @@ public:
   uint32_t size() override { return nof_subframes * SRSRAN_SF_LEN_MAX; }
   void     set_nof_samples(uint32_t n) override { nof_samples = n; }
   uint32_t get_nof_samples() const override { return nof_samples; }
+  /**
+   * Flags the buffers as holding interleaved int16 I/Q samples instead of cf_t, in the same memory
+   * @see radio_interface_phy::get_tx_sc16_scale
+   */
+  void set_sc16(bool sc16_) { sc16 = sc16_; }
+  bool is_sc16() const override { return sc16; }
 
 private:
   std::array<cf_t*, SRSRAN_MAX_CHANNELS> sample_buffer = {};
   bool                                   allocated     = false;
   uint32_t                               nof_subframes = 0;
   uint32_t                               nof_samples   = 0;
+  bool                                   sc16          = false;
   void                                   free_all()
   {
     for (uint32_t i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
@@ -0,0 +1,192 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_RF_TX_FIFO_H
+#define SRSRAN_RF_TX_FIFO_H
+
+#include "rf_timestamp.h"
+#include "srsran/interfaces/radio_interfaces.h"
+#include "srsran/phy/utils/vector.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <semaphore.h>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Ring of timestamped Tx subframes between the PHY workers and the thread streaming them to the RF devices
+ *
+ * The ring keeps a copy of the samples, so the workers can reuse their buffers as soon as push() returns. It supports
+ * one producer at a time, the PHY workers take turns in TTI order, and a single consumer. Neither side takes a lock:
+ * the head index is published by the producer and the tail index by the consumer, each with release/acquire ordering.
+ * A semaphore counting the queued slots lets the consumer sleep while the ring is empty.
+ */
+class rf_tx_fifo
+{
+public:
+  struct slot_t {
+    std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS> samples      = {};
+    std::array<bool, SRSRAN_MAX_CHANNELS>              present      = {}; ///< The channel buffer was not NULL
+    rf_timestamp_t                                     tx_time      = {};
+    uint32_t                                           nof_samples  = 0;
+    bool                                               sc16         = false; ///< Samples are interleaved int16 I/Q
+    bool                                               end_of_burst = false; ///< No samples, ends the current burst
+  };
+
+  rf_tx_fifo() { sem_init(&nof_queued, 0, 0); }
+  ~rf_tx_fifo() { sem_destroy(&nof_queued); }
+  rf_tx_fifo(const rf_tx_fifo&) = delete;
+  rf_tx_fifo& operator=(const rf_tx_fifo&) = delete;
+
+  /**
+   * Allocates the slots, it must be called before any push or pop
+   * @param nof_slots_ Number of subframes the ring can hold
+   * @param nof_channels_ Number of channels copied from each buffer
+   * @param max_samples_ Maximum number of samples per channel and slot, longer buffers are truncated
+   */
+  void init(uint32_t nof_slots_, uint32_t nof_channels_, uint32_t max_samples_)
+  {
+    slots.clear();
+    slots.resize(nof_slots_);
+    for (slot_t& slot : slots) {
+      for (uint32_t ch = 0; ch < nof_channels_; ch++) {
+        slot.samples[ch].resize(max_samples_);
+      }
+    }
+    nof_channels = nof_channels_;
+    max_samples  = max_samples_;
+    head         = 0;
+    tail         = 0;
+  }
+
+  uint32_t capacity() const { return slots.size(); }
+  uint32_t get_max_samples() const { return max_samples; }
+  uint32_t size() const
+  {
+    return (uint32_t)(head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire));
+  }
+
+  /**
+   * Producer side, copies a subframe into the ring
+   * @return false if the ring is full, the subframe is not queued
+   */
+  bool push(const rf_buffer_interface& buffer, const rf_timestamp_interface& tx_time)
+  {
+    slot_t* slot = write_slot();
+    if (slot == nullptr) {
+      return false;
+    }
+
+    slot->nof_samples  = std::min(buffer.get_nof_samples(), max_samples);
+    slot->sc16         = buffer.is_sc16();
+    slot->end_of_burst = false;
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      cf_t* ptr         = buffer.get(ch);
+      slot->present[ch] = (ptr != nullptr);
+      if (ptr == nullptr) {
+        continue;
+      }
+      // int16 samples take half the bytes
+      if (slot->sc16) {
+        srsran_vec_i16_copy((int16_t*)slot->samples[ch].data(), (const int16_t*)ptr, 2 * slot->nof_samples);
+      } else {
+        srsran_vec_cf_copy(slot->samples[ch].data(), ptr, slot->nof_samples);
+      }
+    }
+    slot->tx_time.copy(tx_time);
+
+    publish();
+    return true;
+  }
+
+  /**
+   * Producer side, queues the end of the current burst after the subframes already in the ring
+   * @return false if the ring is full
+   */
+  bool push_end_of_burst()
+  {
+    slot_t* slot = write_slot();
+    if (slot == nullptr) {
+      return false;
+    }
+    slot->nof_samples  = 0;
+    slot->end_of_burst = true;
+
+    publish();
+    return true;
+  }
+
+  /**
+   * Consumer side, waits for the oldest slot, which stays valid until pop()
+   * @return the oldest slot, or nullptr if the wait was interrupted by wake_up()
+   */
+  slot_t* front()
+  {
+    while (sem_wait(&nof_queued) != 0) {
+      if (errno != EINTR) {
+        return nullptr;
+      }
+    }
+
+    uint64_t idx = tail.load(std::memory_order_relaxed);
+    if (head.load(std::memory_order_acquire) == idx) {
+      return nullptr;
+    }
+    return &slots[idx % slots.size()];
+  }
+
+  /// Consumer side, releases the slot returned by front()
+  void pop() { tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+  /// Unblocks a consumer waiting in front(), e.g. to stop it
+  void wake_up() { sem_post(&nof_queued); }
+
+private:
+  slot_t* write_slot()
+  {
+    uint64_t idx = head.load(std::memory_order_relaxed);
+    if (slots.empty() or idx - tail.load(std::memory_order_acquire) >= slots.size()) {
+      return nullptr;
+    }
+    return &slots[idx % slots.size()];
+  }
+
+  void publish()
+  {
+    head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    sem_post(&nof_queued);
+  }
+
+  std::vector<slot_t>   slots;
+  uint32_t              nof_channels = 0;
+  uint32_t              max_samples  = 0;
+  std::atomic<uint64_t> head{0}; ///< Total number of slots pushed, only written by the producer
+  std::atomic<uint64_t> tail{0}; ///< Total number of slots popped, only written by the consumer
+  sem_t                 nof_queued = {};
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_RF_TX_FIFO_H
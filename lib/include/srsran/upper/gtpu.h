@@ -72,6 +72,10 @@ namespace srsran {
 #define GTPU_EXT_HEADER_PDU_SESSION_CONTAINER 0x85
 
 #define GTPU_EXT_HEADER_PDU_SESSION_CONTAINER_LEN 4
+
+// M1-U TEID of the MBMS traffic, unless each MBMS service is tagged with its own TEID
+#define GTPU_M1U_DEFAULT_TEID 0xAAAA
+
 struct gtpu_header_t {
   uint8_t              flags             = 0;
   uint8_t              message_type      = 0;
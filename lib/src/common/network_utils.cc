@@ -21,6 +21,7 @@
 
 #include "srsran/common/network_utils.h"
 
+#include <algorithm>
 #include <netinet/sctp.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -657,4 +658,105 @@ make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue,
   return socket_manager_itf::recv_callback_t(recvfrom_pdu_task(logger, queue, std::move(rx_callback)));
 }
 
+/**
+ * Description: Functor for datagram sockets with high packet rates. Datagrams are received in batches with recvmmsg
+ * straight into pooled byte buffers, which stay posted until a datagram is received into them
+ */
+class recvmmsg_pdu_task
+{
+public:
+  using callback_t = recvfrom_callback_t;
+  explicit recvmmsg_pdu_task(srslog::basic_logger&      logger,
+                             srsran::task_queue_handle& queue_,
+                             uint32_t                   batch_size,
+                             callback_t                 func_) :
+    logger(logger),
+    queue(queue_),
+    func(std::make_shared<callback_t>(std::move(func_))),
+    pdus(std::max(batch_size, 1u)),
+    froms(pdus.size()),
+    iovs(pdus.size()),
+    msgs(pdus.size())
+  {}
+
+  bool operator()(int fd)
+  {
+    uint32_t nof_posted = 0;
+    for (; nof_posted < pdus.size(); ++nof_posted) {
+      srsran::unique_byte_buffer_t& pdu = pdus[nof_posted];
+      if (pdu == nullptr) {
+        pdu = srsran::make_byte_buffer();
+        if (pdu == nullptr) {
+          break;
+        }
+      }
+      iovs[nof_posted].iov_base            = pdu->msg;
+      iovs[nof_posted].iov_len             = pdu->get_tailroom();
+      msgs[nof_posted]                     = {};
+      msgs[nof_posted].msg_hdr.msg_name    = &froms[nof_posted];
+      msgs[nof_posted].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+      msgs[nof_posted].msg_hdr.msg_iov     = &iovs[nof_posted];
+      msgs[nof_posted].msg_hdr.msg_iovlen  = 1;
+    }
+    if (nof_posted == 0) {
+      logger.error("Unable to allocate byte buffer");
+      return true;
+    }
+
+    int n_recv = recvmmsg(fd, msgs.data(), nof_posted, MSG_DONTWAIT, nullptr);
+    if (n_recv == -1 and errno != EAGAIN) {
+      logger.error("Error reading from socket: %s", strerror(errno));
+      return true;
+    }
+    if (n_recv == -1 and errno == EAGAIN) {
+      logger.debug("Socket timeout reached");
+      return true;
+    }
+
+    std::vector<std::pair<srsran::unique_byte_buffer_t, sockaddr_in> > batch;
+    batch.reserve(n_recv);
+    for (int i = 0; i < n_recv; ++i) {
+      if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+        // The buffer stays posted for the next datagram
+        logger.warning("Discarding datagram larger than %zd bytes", iovs[i].iov_len);
+        continue;
+      }
+      pdus[i]->N_bytes = msgs[i].msg_len;
+      batch.emplace_back(std::move(pdus[i]), froms[i]);
+    }
+    if (batch.empty()) {
+      return true;
+    }
+
+    // Defer handling of the whole batch to provided queue
+    std::shared_ptr<callback_t> func_ptr = func;
+    queue.push(std::bind(
+        [func_ptr](std::vector<std::pair<srsran::unique_byte_buffer_t, sockaddr_in> >& sdus) {
+          for (auto& sdu : sdus) {
+            (*func_ptr)(std::move(sdu.first), sdu.second);
+          }
+        },
+        std::move(batch)));
+
+    return true;
+  }
+
+private:
+  srslog::basic_logger&                     logger;
+  srsran::task_queue_handle&                queue;
+  std::shared_ptr<callback_t>               func;
+  std::vector<srsran::unique_byte_buffer_t> pdus;
+  std::vector<sockaddr_in>                  froms;
+  std::vector<struct iovec>                 iovs;
+  std::vector<struct mmsghdr>               msgs;
+};
+
+socket_manager_itf::recv_callback_t make_batch_sdu_handler(srslog::basic_logger&      logger,
+                                                           srsran::task_queue_handle& queue,
+                                                           uint32_t                   batch_size,
+                                                           recvfrom_callback_t        rx_callback)
+{
+  return socket_manager_itf::recv_callback_t(recvmmsg_pdu_task(logger, queue, batch_size, std::move(rx_callback)));
+}
+
 } // namespace srsran
@@ -0,0 +1,203 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/udp_pcap_reader.h"
+#include "srsran/common/pcap.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <string.h>
+
+#define PCAP_MAGIC_USEC 0xa1b2c3d4
+#define PCAP_MAGIC_NSEC 0xa1b23c4d
+
+#define LINKTYPE_ETHERNET 1
+#define LINKTYPE_RAW 101
+#define LINKTYPE_LINUX_SLL 113
+#define LINKTYPE_IPV4 228
+#define LINKTYPE_LINUX_SLL2 276
+
+#define ETHERTYPE_IPV4 0x0800
+#define ETHERTYPE_VLAN 0x8100
+#define ETHERTYPE_QINQ 0x88a8
+
+namespace srsran {
+
+static uint16_t read_be16(const uint8_t* ptr)
+{
+  return (uint16_t)((ptr[0] << 8) | ptr[1]);
+}
+
+bool udp_pcap_reader::open(const std::string& filename)
+{
+  close();
+
+  file = fopen(filename.c_str(), "rb");
+  if (file == nullptr) {
+    logger.error("Failed to open pcap file %s: %s", filename.c_str(), strerror(errno));
+    return false;
+  }
+
+  pcap_hdr_t header = {};
+  if (fread(&header, sizeof(header), 1, file) != 1) {
+    logger.error("Failed to read the header of pcap file %s", filename.c_str());
+    close();
+    return false;
+  }
+
+  swapped = (header.magic_number == __builtin_bswap32(PCAP_MAGIC_USEC) or
+             header.magic_number == __builtin_bswap32(PCAP_MAGIC_NSEC));
+  uint32_t magic = to_host(header.magic_number);
+  if (magic != PCAP_MAGIC_USEC and magic != PCAP_MAGIC_NSEC) {
+    logger.error("%s is not a pcap file (magic number 0x%08x), pcapng is not supported", filename.c_str(), magic);
+    close();
+    return false;
+  }
+  nsec     = (magic == PCAP_MAGIC_NSEC);
+  linktype = to_host(header.network);
+  if (linktype != LINKTYPE_ETHERNET and linktype != LINKTYPE_RAW and linktype != LINKTYPE_LINUX_SLL and
+      linktype != LINKTYPE_IPV4 and linktype != LINKTYPE_LINUX_SLL2) {
+    logger.error("Unsupported link type %d in pcap file %s", linktype, filename.c_str());
+    close();
+    return false;
+  }
+
+  first_packet = true;
+  nof_skipped  = 0;
+  logger.info("Reading UDP datagrams from pcap file %s, link type %d", filename.c_str(), linktype);
+  return true;
+}
+
+void udp_pcap_reader::close()
+{
+  if (file != nullptr) {
+    fclose(file);
+    file = nullptr;
+  }
+}
+
+bool udp_pcap_reader::read(datagram_t& info, byte_buffer_t& pdu)
+{
+  while (file != nullptr) {
+    pcaprec_hdr_t record = {};
+    if (fread(&record, sizeof(record), 1, file) != 1) {
+      return false;
+    }
+
+    uint32_t incl_len = to_host(record.incl_len);
+    packet.resize(incl_len);
+    if (incl_len > 0 and fread(packet.data(), incl_len, 1, file) != 1) {
+      logger.warning("Truncated packet at the end of the pcap file");
+      return false;
+    }
+
+    uint64_t time_us = (uint64_t)to_host(record.ts_sec) * 1000000 + to_host(record.ts_usec) / (nsec ? 1000 : 1);
+    if (first_packet) {
+      first_time_us = time_us;
+      first_packet  = false;
+    }
+    info.time_us = (time_us > first_time_us) ? time_us - first_time_us : 0;
+
+    if (parse_udp(packet.data(), incl_len, info, pdu)) {
+      return true;
+    }
+    nof_skipped++;
+  }
+  return false;
+}
+
+bool udp_pcap_reader::parse_udp(const uint8_t* data, uint32_t len, datagram_t& info, byte_buffer_t& pdu)
+{
+  // Link layer
+  uint32_t offset    = 0;
+  uint16_t ethertype = ETHERTYPE_IPV4;
+  switch (linktype) {
+    case LINKTYPE_ETHERNET:
+      offset = 14;
+      if (len < offset) {
+        return false;
+      }
+      ethertype = read_be16(&data[12]);
+      while ((ethertype == ETHERTYPE_VLAN or ethertype == ETHERTYPE_QINQ) and len >= offset + 4) {
+        ethertype = read_be16(&data[offset + 2]);
+        offset += 4;
+      }
+      break;
+    case LINKTYPE_LINUX_SLL:
+      offset = 16;
+      if (len < offset) {
+        return false;
+      }
+      ethertype = read_be16(&data[14]);
+      break;
+    case LINKTYPE_LINUX_SLL2:
+      offset = 20;
+      if (len < offset) {
+        return false;
+      }
+      ethertype = read_be16(&data[0]);
+      break;
+    default:
+      break;
+  }
+  if (ethertype != ETHERTYPE_IPV4) {
+    return false;
+  }
+
+  // IPv4, fragments are not reassembled
+  const uint8_t* ip = &data[offset];
+  if (len < offset + 20 or (ip[0] >> 4) != 4) {
+    return false;
+  }
+  uint32_t ihl       = (ip[0] & 0x0f) * 4;
+  uint32_t total_len = read_be16(&ip[2]);
+  if (ihl < 20 or total_len < ihl + 8 or len < offset + total_len or ip[9] != IPPROTO_UDP or
+      (read_be16(&ip[6]) & 0x3fff) != 0) {
+    return false;
+  }
+
+  // UDP
+  const uint8_t* udp     = &ip[ihl];
+  uint32_t       udp_len = read_be16(&udp[4]);
+  if (udp_len < 8 or udp_len > total_len - ihl) {
+    return false;
+  }
+  uint32_t payload_len = udp_len - 8;
+  pdu.clear();
+  if (payload_len > pdu.get_tailroom()) {
+    logger.warning("Skipping UDP datagram of %d bytes, larger than the buffer", payload_len);
+    return false;
+  }
+
+  info.src                 = {};
+  info.src.sin_family      = AF_INET;
+  info.src.sin_addr.s_addr = *(const uint32_t*)&ip[12];
+  info.src.sin_port        = htons(read_be16(&udp[0]));
+  info.dst                 = {};
+  info.dst.sin_family      = AF_INET;
+  info.dst.sin_addr.s_addr = *(const uint32_t*)&ip[16];
+  info.dst.sin_port        = htons(read_be16(&udp[2]));
+
+  memcpy(pdu.msg, &udp[8], payload_len);
+  pdu.N_bytes = payload_len;
+  return true;
+}
+
+} // namespace srsran
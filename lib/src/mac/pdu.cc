@@ -445,6 +445,18 @@ bool sch_pdu::update_space_ce(uint32_t nbytes, bool var_len)
   }
 }
 
+// Updates the remaining length when a variable size MAC CE grows from old_len to new_len bytes
+// @return false if the PDU has no space for it
+bool sch_pdu::update_space_var_ce(uint32_t old_len, uint32_t new_len)
+{
+  uint32_t delta = new_len + size_header_sdu(new_len) - old_len - size_header_sdu(old_len);
+  if (rem_len >= delta) {
+    rem_len -= delta;
+    return true;
+  }
+  return false;
+}
+
 bool sch_pdu::has_space_sdu(uint32_t nbytes)
 {
   int s = get_sdu_space();
@@ -606,7 +618,7 @@ bool sch_subh::get_next_mch_sched_info(uint8_t* lcid_, uint16_t* mtch_stop)
     mtch_stop_ce = ((uint16_t)(payload[cur_mch_sched_ce * 2] & 0x07)) << 8;
     mtch_stop_ce += payload[cur_mch_sched_ce * 2 + 1];
     cur_mch_sched_ce++;
-    *mtch_stop = (mtch_stop_ce == sch_subh::MTCH_STOP_EMPTY) ? (0) : (mtch_stop_ce);
+    *mtch_stop = mtch_stop_ce;
     return true;
   }
   return false;
@@ -780,13 +792,13 @@ bool sch_subh::set_scell_activation_cmd(const std::array<bool, SRSRAN_MAX_CARRIE
 
 bool sch_subh::set_next_mch_sched_info(uint8_t lcid_, uint16_t mtch_stop)
 {
-  if (((sch_pdu*)parent)->has_space_ce(2, true)) {
-    uint16_t mtch_stop_ce                  = (mtch_stop) ? (mtch_stop) : (sch_subh::MTCH_STOP_EMPTY);
-    w_payload_ce[nof_mch_sched_ce * 2]     = (lcid_ & 0x1F) << 3 | (uint8_t)((mtch_stop_ce & 0x0700) >> 8);
-    w_payload_ce[nof_mch_sched_ce * 2 + 1] = (uint8_t)(mtch_stop_ce & 0xff);
+  // All the entries share the same subheader, which is accounted for with the first one
+  if (((sch_pdu*)parent)->update_space_var_ce(nof_bytes, nof_bytes + 2)) {
+    // A stop of 0 is the first subframe of the MSP, only MTCH_STOP_EMPTY stands for an MTCH that is not scheduled
+    w_payload_ce[nof_mch_sched_ce * 2]     = (lcid_ & 0x1F) << 3 | (uint8_t)((mtch_stop & 0x0700) >> 8);
+    w_payload_ce[nof_mch_sched_ce * 2 + 1] = (uint8_t)(mtch_stop & 0xff);
     nof_mch_sched_ce++;
     lcid = (uint32_t)mch_lcid::MCH_SCHED_INFO;
-    ((sch_pdu*)parent)->update_space_ce(2, true);
     nof_bytes += 2;
     return true;
   }
@@ -915,7 +915,7 @@ int mac_sch_pdu_pack_error_test()
 
 int mac_mch_pdu_pack_test1()
 {
-  static uint8_t tv[] = {0x3e, 0x02, 0x20, 0x05, 0x21, 0x0a, 0x1f, 0x0f, 0xff, 0x01, 0x02, 0x03, 0x04, 0x05, 0x02,
+  static uint8_t tv[] = {0x3e, 0x02, 0x20, 0x05, 0x21, 0x0a, 0x1f, 0x08, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x02,
                          0x04, 0x06, 0x08, 0x0a, 0x0c, 0x0e, 0x10, 0x12, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
 
   auto& mac_logger = srslog::fetch_basic_logger("MAC");
@@ -962,6 +962,66 @@ int mac_mch_pdu_pack_test1()
   return SRSRAN_SUCCESS;
 }
 
+// MCH PDU with a single MSI carrying the stop of two MTCHs, followed by one SDU of each MTCH
+int mac_mch_pdu_pack_test2()
+{
+  static uint8_t tv[] = {0x3e, 0x04, 0x21, 0x0a, 0x22, 0x05, 0x1f, 0x08, 0x03, 0x17, 0xff, 0x01, 0x02, 0x03, 0x04,
+                         0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00};
+
+  auto& mac_logger = srslog::fetch_basic_logger("MAC");
+
+  const uint32_t  pdu_size = 30;
+  srsran::mch_pdu mch_pdu(10, mac_logger);
+  byte_buffer_t   buffer;
+  mch_pdu.init_tx(&buffer, pdu_size, true);
+
+  // The subheader is only accounted for once
+  TESTASSERT(mch_pdu.new_subh());
+  TESTASSERT(mch_pdu.get()->set_next_mch_sched_info(1, 3));
+  TESTASSERT(mch_pdu.rem_size() == pdu_size - 4);
+  TESTASSERT(mch_pdu.get()->set_next_mch_sched_info(2, sch_subh::MTCH_STOP_EMPTY));
+  TESTASSERT(mch_pdu.rem_size() == pdu_size - 6);
+
+  TESTASSERT(mch_pdu.new_subh());
+  uint8_t sdu1[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  TESTASSERT(mch_pdu.get()->set_sdu(1, 10, sdu1) == 10);
+
+  TESTASSERT(mch_pdu.new_subh());
+  uint8_t sdu2[5] = {5, 4, 3, 2, 1};
+  TESTASSERT(mch_pdu.get()->set_sdu(2, 5, sdu2) == 5);
+
+  // write PDU
+  TESTASSERT(mch_pdu.write_packet(mac_logger) == buffer.msg);
+  TESTASSERT(buffer.N_bytes == pdu_size);
+
+  // log
+  mac_logger.info(buffer.msg, buffer.N_bytes, "MAC PDU (%d B):", buffer.N_bytes);
+
+  // compare with TV
+  TESTASSERT(memcmp(buffer.msg, tv, buffer.N_bytes) == 0);
+
+  // parse it back
+  srsran::mch_pdu mch_pdu_rx(10, mac_logger);
+  mch_pdu_rx.init_rx(sizeof(tv));
+  mch_pdu_rx.parse_packet(tv);
+
+  uint8_t  lcid = 0;
+  uint16_t stop = 0;
+  TESTASSERT(mch_pdu_rx.next());
+  TESTASSERT(mch_pdu_rx.get()->mch_ce_type() == mch_lcid::MCH_SCHED_INFO);
+  TESTASSERT(mch_pdu_rx.get()->get_next_mch_sched_info(&lcid, &stop));
+  TESTASSERT(lcid == 1 and stop == 3);
+  TESTASSERT(mch_pdu_rx.get()->get_next_mch_sched_info(&lcid, &stop));
+  TESTASSERT(lcid == 2 and stop == sch_subh::MTCH_STOP_EMPTY);
+  TESTASSERT(not mch_pdu_rx.get()->get_next_mch_sched_info(&lcid, &stop));
+  TESTASSERT(mch_pdu_rx.next());
+  TESTASSERT(mch_pdu_rx.get()->get_sdu_lcid() == 1 and mch_pdu_rx.get()->get_payload_size() == 10);
+  TESTASSERT(mch_pdu_rx.next());
+  TESTASSERT(mch_pdu_rx.get()->get_sdu_lcid() == 2 and mch_pdu_rx.get()->get_payload_size() == 5);
+
+  return SRSRAN_SUCCESS;
+}
+
 // Parsing a corrupted MAC PDU and making sure the PDU is reset and not further processed
 int mac_sch_pdu_unpack_test1()
 {
@@ -1193,6 +1253,7 @@ int main(int argc, char** argv)
   TESTASSERT(mac_sch_pdu_pack_error_test() == SRSRAN_SUCCESS);
 
   TESTASSERT(mac_mch_pdu_pack_test1() == SRSRAN_SUCCESS);
+  TESTASSERT(mac_mch_pdu_pack_test2() == SRSRAN_SUCCESS);
 
   TESTASSERT(mac_sch_pdu_unpack_test1() == SRSRAN_SUCCESS);
   TESTASSERT(mac_sch_pdu_unpack_test2() == SRSRAN_SUCCESS);
@@ -319,18 +319,38 @@ SRSRAN_API int srsran_refsignal_mbsfn_put_sf(srsran_cell_t cell,
                                              cf_t*         mbsfn_pilots,
                                              cf_t*         sf_symbols)
 {
-  uint32_t i, l;
+  if (srsran_refsignal_mbsfn_put_cs(cell, port_id, cs_pilots, sf_symbols) ||
+      srsran_refsignal_mbsfn_put_mbsfn(cell, port_id, mbsfn_pilots, sf_symbols)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+SRSRAN_API int srsran_refsignal_mbsfn_put_cs(srsran_cell_t cell, uint32_t port_id, cf_t* cs_pilots, cf_t* sf_symbols)
+{
+  uint32_t i;
   uint32_t fidx;
 
-  if (srsran_cell_isvalid(&cell) && srsran_portid_isvalid(port_id) && cs_pilots != NULL && mbsfn_pilots != NULL &&
-      sf_symbols != NULL) {
+  if (srsran_cell_isvalid(&cell) && srsran_portid_isvalid(port_id) && cs_pilots != NULL && sf_symbols != NULL) {
     // adding CS refs for the non-mbsfn section of the sub-frame
     fidx = ((srsran_refsignal_cs_v(port_id, 0) + (cell.id % 6)) % 6);
     for (i = 0; i < 2 * cell.nof_prb; i++) {
       sf_symbols[SRSRAN_RE_IDX(cell.nof_prb, 0, fidx)] = cs_pilots[SRSRAN_REFSIGNAL_PILOT_IDX(i, 0, cell)];
       fidx += SRSRAN_NRE / 2; // 1 reference every 6 RE
     }
+    return SRSRAN_SUCCESS;
+  } else {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+}
+
+SRSRAN_API int
+srsran_refsignal_mbsfn_put_mbsfn(srsran_cell_t cell, uint32_t port_id, cf_t* mbsfn_pilots, cf_t* sf_symbols)
+{
+  uint32_t i, l;
+  uint32_t fidx;
 
+  if (srsran_cell_isvalid(&cell) && srsran_portid_isvalid(port_id) && mbsfn_pilots != NULL && sf_symbols != NULL) {
     for (l = 0; l < srsran_refsignal_mbsfn_nof_symbols(); l++) {
       uint32_t nsymbol = srsran_refsignal_mbsfn_nsymbol(l);
       fidx             = srsran_refsignal_mbsfn_fidx(l);
@@ -340,7 +360,6 @@ SRSRAN_API int srsran_refsignal_mbsfn_put_sf(srsran_cell_t cell,
         fidx += SRSRAN_NRE / 6;
       }
     }
-
     return SRSRAN_SUCCESS;
   } else {
     return SRSRAN_ERROR_INVALID_INPUTS;
@@ -35,6 +35,21 @@
 /* Uncomment next line for avoiding Guru DFT call */
 //#define AVOID_GURU
 
+/* CP length of a symbol in the first slot of an MBSFN subframe, the non-MBSFN region uses normal CP */
+static inline uint32_t ofdm_mbsfn_cp_len(const srsran_ofdm_t* q, uint32_t i)
+{
+  return (i < q->non_mbsfn_region) ? SRSRAN_CP_LEN_NORM(i, q->cfg.symbol_sz) : SRSRAN_CP_LEN_EXT(q->cfg.symbol_sz);
+}
+
+/* Tx scratch area for the first slot of MBSFN subframes, placed at the end of the temporal buffer so it does not
+ * overlap the frequency-domain symbols of any slot */
+static inline cf_t* ofdm_mbsfn_scratch(const srsran_ofdm_t* q)
+{
+  return q->tmp + q->sf_sz - q->nof_symbols_mbsfn * q->cfg.symbol_sz;
+}
+
+static void ofdm_set_phase_compensation_mbsfn(srsran_ofdm_t* q);
+
 static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft_dir_t dir)
 {
   // If the symbol size is not given, calculate in function of the number of resource blocks
@@ -204,6 +219,27 @@ static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft
       }
     }
   }
+
+  // The first slot of MBSFN subframes mixes normal and extended CP, so all its symbols are transformed at once into a
+  // scratch area and then copied into place with their own CP length
+  if (q->fft_plan_mbsfn.size) {
+    srsran_dft_plan_free(&q->fft_plan_mbsfn);
+  }
+  if (dir == SRSRAN_DFT_BACKWARD && sf_type == SRSRAN_SF_MBSFN) {
+    if (srsran_dft_plan_guru_c(&q->fft_plan_mbsfn,
+                               symbol_sz,
+                               dir,
+                               q->tmp,
+                               ofdm_mbsfn_scratch(q),
+                               1,
+                               1,
+                               q->nof_symbols_mbsfn,
+                               symbol_sz,
+                               symbol_sz)) {
+      ERROR("Creating MBSFN Guru inverse-DFT plan");
+      return SRSRAN_ERROR;
+    }
+  }
 #endif
 
   srsran_dft_plan_set_mirror(&q->fft_plan, true);
@@ -240,7 +276,10 @@ static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft
 
 void srsran_ofdm_set_non_mbsfn_region(srsran_ofdm_t* q, uint8_t non_mbsfn_region)
 {
-  q->non_mbsfn_region = non_mbsfn_region;
+  if (q->non_mbsfn_region != non_mbsfn_region) {
+    q->non_mbsfn_region = non_mbsfn_region;
+    ofdm_set_phase_compensation_mbsfn(q);
+  }
 }
 
 void srsran_ofdm_free_(srsran_ofdm_t* q)
@@ -253,6 +292,9 @@ void srsran_ofdm_free_(srsran_ofdm_t* q)
       srsran_dft_plan_free(&q->fft_plan_sf[slot]);
     }
   }
+  if (q->fft_plan_mbsfn.init_size) {
+    srsran_dft_plan_free(&q->fft_plan_mbsfn);
+  }
 #endif
 
   if (q->tmp) {
@@ -406,9 +448,38 @@ int srsran_ofdm_set_phase_compensation(srsran_ofdm_t* q, double center_freq_hz)
     count += symbol_sz;
   }
 
+  ofdm_set_phase_compensation_mbsfn(q);
+
   return SRSRAN_SUCCESS;
 }
 
+/* The symbols of the non-MBSFN region and the guard after it start at different times than in the extended CP slot, so
+ * the first slot of MBSFN subframes has its own phase compensation. The second slot uses the extended CP one.
+ */
+static void ofdm_set_phase_compensation_mbsfn(srsran_ofdm_t* q)
+{
+  double   center_freq_hz = q->cfg.phase_compensation_hz;
+  uint32_t symbol_sz      = q->cfg.symbol_sz;
+  double   srate_hz       = symbol_sz * 15e3; //< Assume 15kHz subcarrier spacing
+
+  if (!isnormal(center_freq_hz) || !isnormal(srate_hz)) {
+    return;
+  }
+
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < SRSRAN_CP_EXT_NSYMB; i++) {
+    count += ofdm_mbsfn_cp_len(q, i);
+
+    double phase_rad               = -2.0 * M_PI * center_freq_hz * (double)count / srate_hz;
+    q->phase_compensation_mbsfn[i] = (cf_t)cexp(I * phase_rad);
+
+    count += symbol_sz;
+    if (i + 1 == q->non_mbsfn_region) {
+      count += SRSRAN_NON_MBSFN_REGION_GUARD_LENGTH(q->non_mbsfn_region, symbol_sz);
+    }
+  }
+}
+
 void srsran_ofdm_rx_free(srsran_ofdm_t* q)
 {
   srsran_ofdm_free_(q);
@@ -526,9 +597,12 @@ static void ofdm_rx_slot_mbsfn(srsran_ofdm_t* q, cf_t* input, cf_t* output)
     if (i == q->non_mbsfn_region) {
       input += SRSRAN_NON_MBSFN_REGION_GUARD_LENGTH(q->non_mbsfn_region, q->cfg.symbol_sz);
     }
-    input += (i >= q->non_mbsfn_region) ? SRSRAN_CP_LEN_EXT(q->cfg.symbol_sz) : SRSRAN_CP_LEN_NORM(i, q->cfg.symbol_sz);
+    input += ofdm_mbsfn_cp_len(q, i);
     srsran_dft_run_c(&q->fft_plan, input, q->tmp);
     memcpy(output, &q->tmp[q->nof_guards], q->nof_re * sizeof(cf_t));
+    if (isnormal(q->cfg.phase_compensation_hz)) {
+      srsran_vec_sc_prod_ccc(output, conjf(q->phase_compensation_mbsfn[i]), output, q->nof_re);
+    }
     input += q->cfg.symbol_sz;
     output += q->nof_re;
   }
@@ -579,10 +653,21 @@ void srsran_ofdm_rx_sf_ng(srsran_ofdm_t* q, cf_t* input, cf_t* output)
   }
 }
 
+// Checks whether a symbol has no resource element to transmit, so its IFFT can be skipped
+static bool ofdm_tx_symbol_is_zero(const cf_t* symbol, uint32_t nof_re)
+{
+  for (uint32_t i = 0; i < nof_re; i++) {
+    if (crealf(symbol[i]) != 0.0f || cimagf(symbol[i]) != 0.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
 /* Transforms input OFDM symbols into output samples.
- * Performs the FFT on each symbol and adds CP.
+ * Performs the FFT on each symbol and adds CP. Returns false if the whole slot is zero.
  */
-static void ofdm_tx_slot(srsran_ofdm_t* q, int slot_in_sf)
+static bool ofdm_tx_slot(srsran_ofdm_t* q, int slot_in_sf)
 {
   uint32_t    symbol_sz = q->cfg.symbol_sz;
   srsran_cp_t cp        = q->cfg.cp;
@@ -609,19 +694,49 @@ static void ofdm_tx_slot(srsran_ofdm_t* q, int slot_in_sf)
   bzero(tmp, q->slot_sz);
   uint32_t dc = (q->fft_plan.dc) ? 1 : 0;
 
+  // All-zero symbols, e.g. the data symbols of idle subframes, transform into zeros
+  bool     tx_symbol[SRSRAN_MAX_NSYMB];
+  uint32_t nof_tx_symbols = 0;
   for (int i = 0; i < nof_symbols; i++) {
-    srsran_vec_cf_copy(&tmp[dc], &input[nof_re / 2], nof_re / 2);
-    srsran_vec_cf_copy(&tmp[symbol_sz - nof_re / 2], &input[0], nof_re / 2);
+    tx_symbol[i] = !ofdm_tx_symbol_is_zero(input, nof_re);
+    if (tx_symbol[i]) {
+      srsran_vec_cf_copy(&tmp[dc], &input[nof_re / 2], nof_re / 2);
+      srsran_vec_cf_copy(&tmp[symbol_sz - nof_re / 2], &input[0], nof_re / 2);
+      nof_tx_symbols++;
+    }
 
     input += nof_re;
     tmp += symbol_sz;
   }
 
-  srsran_dft_run_guru_c(&q->fft_plan_sf[slot_in_sf]);
+  if (nof_tx_symbols == 0) {
+    srsran_vec_cf_zero(output, q->slot_sz);
+    return false;
+  }
+
+  // Transform all symbols at once, unless some can be skipped. Those left are transformed one by one into the last
+  // symbol of the scratch area, which does not overlap the input symbols
+  bool  pruned  = nof_tx_symbols < nof_symbols;
+  cf_t* scratch = q->tmp + q->sf_sz - symbol_sz;
+  if (!pruned) {
+    srsran_dft_run_guru_c(&q->fft_plan_sf[slot_in_sf]);
+  }
 
   for (int i = 0; i < nof_symbols; i++) {
     int cp_len = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
 
+    if (!tx_symbol[i]) {
+      srsran_vec_cf_zero(output, cp_len + symbol_sz);
+      output += symbol_sz + cp_len;
+      continue;
+    }
+
+    cf_t* symbol = &output[cp_len];
+    if (pruned) {
+      symbol = scratch;
+      srsran_dft_run_c_zerocopy(&q->fft_plan, &q->tmp[i * symbol_sz], symbol);
+    }
+
     if (isnormal(q->cfg.phase_compensation_hz)) {
       // Get phase compensation
       cf_t phase_compensation = q->phase_compensation[slot_in_sf * q->nof_symbols + i];
@@ -632,9 +747,11 @@ static void ofdm_tx_slot(srsran_ofdm_t* q, int slot_in_sf)
       }
 
       // Apply correction
-      srsran_vec_sc_prod_ccc(&output[cp_len], phase_compensation, &output[cp_len], symbol_sz);
+      srsran_vec_sc_prod_ccc(symbol, phase_compensation, &output[cp_len], symbol_sz);
     } else if (q->fft_plan.norm) {
-      srsran_vec_sc_prod_cfc(&output[cp_len], norm, &output[cp_len], symbol_sz);
+      srsran_vec_sc_prod_cfc(symbol, norm, &output[cp_len], symbol_sz);
+    } else if (pruned) {
+      srsran_vec_cf_copy(&output[cp_len], symbol, symbol_sz);
     }
 
     // CFR: Process the time-domain signal without the CP
@@ -647,14 +764,19 @@ static void ofdm_tx_slot(srsran_ofdm_t* q, int slot_in_sf)
     output += symbol_sz + cp_len;
   }
 #endif
+  return true;
 }
 
-void ofdm_tx_slot_mbsfn(srsran_ofdm_t* q, cf_t* input, cf_t* output)
+/* Transforms the first slot of an MBSFN subframe. The non-MBSFN region uses normal CP and is followed by a guard up to
+ * the start of the extended CP MBSFN region, which is transmitted as zeros. Returns false if the whole slot is zero.
+ */
+bool ofdm_tx_slot_mbsfn(srsran_ofdm_t* q, cf_t* input, cf_t* output)
 {
   uint32_t symbol_sz = q->cfg.symbol_sz;
 
+#ifdef AVOID_GURU
   for (uint32_t i = 0; i < q->nof_symbols_mbsfn; i++) {
-    int cp_len = (i > (q->non_mbsfn_region - 1)) ? SRSRAN_CP_LEN_EXT(symbol_sz) : SRSRAN_CP_LEN_NORM(i, symbol_sz);
+    int cp_len = ofdm_mbsfn_cp_len(q, i);
     memcpy(&q->tmp[q->nof_guards], input, q->nof_re * sizeof(cf_t));
     srsran_dft_run_c(&q->fft_plan, q->tmp, &output[cp_len]);
     input += q->nof_re;
@@ -666,6 +788,81 @@ void ofdm_tx_slot_mbsfn(srsran_ofdm_t* q, cf_t* input, cf_t* output)
     if (i == (q->non_mbsfn_region - 1))
       output += SRSRAN_NON_MBSFN_REGION_GUARD_LENGTH(q->non_mbsfn_region, symbol_sz);
   }
+#else
+  uint32_t nof_re = q->nof_re;
+  float    norm   = 1.0f / sqrtf(symbol_sz);
+  cf_t*    tmp    = q->tmp;
+  cf_t*    symbol = ofdm_mbsfn_scratch(q);
+  uint32_t dc     = (q->fft_plan.dc) ? 1 : 0;
+
+  // The MBSFN region of subframes without PMCH is empty
+  bool     tx_symbol[SRSRAN_MAX_NSYMB];
+  uint32_t nof_tx_symbols = 0;
+  for (uint32_t i = 0; i < q->nof_symbols_mbsfn; i++) {
+    tx_symbol[i] = !ofdm_tx_symbol_is_zero(input, nof_re);
+    if (tx_symbol[i]) {
+      srsran_vec_cf_copy(&tmp[dc], &input[nof_re / 2], nof_re / 2);
+      srsran_vec_cf_copy(&tmp[symbol_sz - nof_re / 2], &input[0], nof_re / 2);
+      nof_tx_symbols++;
+    }
+
+    input += nof_re;
+    tmp += symbol_sz;
+  }
+
+  if (nof_tx_symbols == 0) {
+    srsran_vec_cf_zero(output, q->slot_sz);
+    return false;
+  }
+
+  bool pruned = nof_tx_symbols < q->nof_symbols_mbsfn;
+  if (!pruned) {
+    srsran_dft_run_guru_c(&q->fft_plan_mbsfn);
+  }
+
+  for (uint32_t i = 0; i < q->nof_symbols_mbsfn; i++) {
+    uint32_t cp_len = ofdm_mbsfn_cp_len(q, i);
+
+    if (!tx_symbol[i]) {
+      srsran_vec_cf_zero(output, cp_len + symbol_sz);
+    } else {
+      if (pruned) {
+        srsran_dft_run_c_zerocopy(&q->fft_plan, &q->tmp[i * symbol_sz], symbol);
+      }
+
+      // Scale from the scratch area into place, normalization and phase compensation come for free in the copy
+      if (isnormal(q->cfg.phase_compensation_hz)) {
+        cf_t phase_compensation = q->phase_compensation_mbsfn[i];
+        if (q->fft_plan.norm) {
+          phase_compensation *= norm;
+        }
+        srsran_vec_sc_prod_ccc(symbol, phase_compensation, &output[cp_len], symbol_sz);
+      } else if (q->fft_plan.norm) {
+        srsran_vec_sc_prod_cfc(symbol, norm, &output[cp_len], symbol_sz);
+      } else {
+        srsran_vec_cf_copy(&output[cp_len], symbol, symbol_sz);
+      }
+
+      // CFR: Process the time-domain signal without the CP
+      if (q->cfg.cfr_tx_cfg.cfr_enable) {
+        srsran_cfr_process(&q->tx_cfr, output + cp_len, output + cp_len);
+      }
+
+      /* add CP */
+      srsran_vec_cf_copy(output, &output[symbol_sz], cp_len);
+    }
+    output += symbol_sz + cp_len;
+    symbol += symbol_sz;
+
+    // Nothing is transmitted between the non-MBSFN region and the MBSFN region
+    if (i + 1 == q->non_mbsfn_region) {
+      uint32_t guard_len = SRSRAN_NON_MBSFN_REGION_GUARD_LENGTH(q->non_mbsfn_region, symbol_sz);
+      srsran_vec_cf_zero(output, guard_len);
+      output += guard_len;
+    }
+  }
+#endif
+  return true;
 }
 
 void srsran_ofdm_set_normalize(srsran_ofdm_t* q, bool normalize_enable)
@@ -676,15 +873,18 @@ void srsran_ofdm_set_normalize(srsran_ofdm_t* q, bool normalize_enable)
 void srsran_ofdm_tx_sf(srsran_ofdm_t* q)
 {
   uint32_t n;
+  bool     tx = false;
   if (!q->mbsfn_subframe) {
     for (n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
-      ofdm_tx_slot(q, n);
+      tx |= ofdm_tx_slot(q, n);
     }
   } else {
-    ofdm_tx_slot_mbsfn(q, q->cfg.in_buffer, q->cfg.out_buffer);
-    ofdm_tx_slot(q, 1);
+    tx |= ofdm_tx_slot_mbsfn(q, q->cfg.in_buffer, q->cfg.out_buffer);
+    tx |= ofdm_tx_slot(q, 1);
   }
-  if (isnormal(q->cfg.freq_shift_f)) {
+
+  // A silent subframe stays silent after the frequency shift
+  if (tx && isnormal(q->cfg.freq_shift_f)) {
     srsran_vec_prod_ccc(q->cfg.out_buffer, q->shift_buffer, q->cfg.out_buffer, q->sf_sz);
   }
 }
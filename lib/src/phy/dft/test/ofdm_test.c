@@ -36,6 +36,9 @@ static float       rx_window_offset      = 0.5f;
 static float       freq_shift_f          = 0.0f;
 static double      phase_compensation_hz = 0.0;
 static uint32_t    force_symbol_sz       = 0;
+static srsran_sf_t sf_type               = SRSRAN_SF_NORM;
+static uint32_t    non_mbsfn_region      = 2;
+static uint32_t    sparse_period         = 1;
 static double      elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
 {
   if (ts_end->tv_usec > ts_start->tv_usec) {
@@ -57,12 +60,14 @@ static void usage(char* prog)
   printf("\t-o rx window offset (portion of CP length) [Default %.1f]\n", rx_window_offset);
   printf("\t-s frequency shift (normalised with sampling rate) [Default %.1f]\n", freq_shift_f);
   printf("\t-p Phase compensation carrier frequency in Hz [Default %.1f]\n", phase_compensation_hz);
+  printf("\t-m MBSFN subframe with the given non-MBSFN region length, implies extended CP [Default Normal]\n");
+  printf("\t-z Only fill one symbol every given number of them, the rest are zero [Default %d]\n", sparse_period);
 }
 
 static void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "Nnerosp")) != -1) {
+  while ((opt = getopt(argc, argv, "Nnerospmz")) != -1) {
     switch (opt) {
       case 'n':
         nof_prb = (int)strtol(argv[optind], NULL, 10);
@@ -85,6 +90,14 @@ static void parse_args(int argc, char** argv)
       case 'p':
         phase_compensation_hz = strtod(argv[optind], NULL);
         break;
+      case 'm':
+        sf_type          = SRSRAN_SF_MBSFN;
+        cp               = SRSRAN_CP_EXT;
+        non_mbsfn_region = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'z':
+        sparse_period = SRSRAN_MAX(1, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -136,10 +149,12 @@ int main(int argc, char** argv)
     ofdm_cfg.freq_shift_f          = freq_shift_f;
     ofdm_cfg.normalize             = true;
     ofdm_cfg.phase_compensation_hz = phase_compensation_hz;
+    ofdm_cfg.sf_type               = sf_type;
     if (srsran_ofdm_tx_init_cfg(&ifft, &ofdm_cfg)) {
       ERROR("Error initializing iFFT");
       exit(-1);
     }
+    srsran_ofdm_set_non_mbsfn_region(&ifft, non_mbsfn_region);
 
     ofdm_cfg.in_buffer        = outifft;
     ofdm_cfg.out_buffer       = outfft;
@@ -149,6 +164,7 @@ int main(int argc, char** argv)
       ERROR("Error initializing FFT");
       exit(-1);
     }
+    srsran_ofdm_set_non_mbsfn_region(&fft, non_mbsfn_region);
 
     if (isnormal(freq_shift_f)) {
       nof_repetitions = 1;
@@ -156,6 +172,11 @@ int main(int argc, char** argv)
 
     // Generate Random data
     srsran_random_uniform_complex_dist_vector(random_gen, input, n_re, -1.0f, +1.0f);
+    for (uint32_t i = 0; i < n_re / (n_prb * SRSRAN_NRE); i++) {
+      if (i % sparse_period != 0) {
+        srsran_vec_cf_zero(&input[i * n_prb * SRSRAN_NRE], n_prb * SRSRAN_NRE);
+      }
+    }
 
     // Execute Tx
     gettimeofday(&start, NULL);
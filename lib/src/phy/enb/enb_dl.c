@@ -78,12 +78,10 @@ int srsran_enb_dl_init(srsran_enb_dl_t* q, cf_t* out_buffer[SRSRAN_MAX_PORTS], u
       ERROR("Error creating PHICH object");
       goto clean_exit;
     }
-    int mbsfn_area_id = 0;
-
     if (srsran_pmch_init(&q->pmch, max_prb, 1)) {
       ERROR("Error creating PMCH object");
+      goto clean_exit;
     }
-    srsran_pmch_set_area_id(&q->pmch, mbsfn_area_id);
 
     if (srsran_pdcch_init_enb(&q->pdcch, max_prb)) {
       ERROR("Error creating PDCCH object");
@@ -100,8 +98,12 @@ int srsran_enb_dl_init(srsran_enb_dl_t* q, cf_t* out_buffer[SRSRAN_MAX_PORTS], u
       goto clean_exit;
     }
 
-    if (srsran_refsignal_mbsfn_init(&q->mbsfnr_signal, max_prb)) {
-      ERROR("Error initializing CSR signal (%d)", ret);
+    q->max_prb = max_prb;
+
+    // Area 0 until the cell is configured with its own areas
+    uint16_t mbsfn_area_id = 0;
+    if (srsran_enb_dl_set_mbsfn_areas(q, &mbsfn_area_id, 1)) {
+      ERROR("Error initializing MBSFN area");
       goto clean_exit;
     }
     ret = SRSRAN_SUCCESS;
@@ -117,9 +119,26 @@ clean_exit:
   return ret;
 }
 
+static void enb_dl_free_base_templates(srsran_enb_dl_t* q)
+{
+  for (uint32_t i = 0; i < SRSRAN_ENB_DL_NOF_BASE_TEMPLATES; i++) {
+    srsran_enb_dl_base_template_t* t = &q->base_templates[i];
+    for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+      if (t->re_idx[p]) {
+        free(t->re_idx[p]);
+      }
+      if (t->re_symb[p]) {
+        free(t->re_symb[p]);
+      }
+    }
+    bzero(t, sizeof(srsran_enb_dl_base_template_t));
+  }
+}
+
 void srsran_enb_dl_free(srsran_enb_dl_t* q)
 {
   if (q) {
+    enb_dl_free_base_templates(q);
     for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
       srsran_ofdm_tx_free(&q->ifft[i]);
     }
@@ -132,7 +151,9 @@ void srsran_enb_dl_free(srsran_enb_dl_t* q)
     srsran_pdsch_free(&q->pdsch);
     srsran_pmch_free(&q->pmch);
     srsran_refsignal_free(&q->csr_signal);
-    srsran_refsignal_free(&q->mbsfnr_signal);
+    for (int i = 0; i < SRSRAN_ENB_DL_MAX_MBSFN_AREAS; i++) {
+      srsran_refsignal_free(&q->mbsfnr_signal[i]);
+    }
     for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
       if (q->sf_symbols[i]) {
         free(q->sf_symbols[i]);
@@ -151,6 +172,7 @@ int srsran_enb_dl_set_cell(srsran_enb_dl_t* q, srsran_cell_t cell)
       if (q->cell.nof_prb != 0) {
         srsran_regs_free(&q->regs);
       }
+      enb_dl_free_base_templates(q);
       q->cell                    = cell;
       srsran_ofdm_cfg_t ofdm_cfg = {};
       ofdm_cfg.nof_prb           = q->cell.nof_prb;
@@ -216,10 +238,11 @@ int srsran_enb_dl_set_cell(srsran_enb_dl_t* q, srsran_cell_t cell)
         ERROR("Error initializing CSR signal (%d)", ret);
         return SRSRAN_ERROR;
       }
-      int mbsfn_area_id = 0;
-      if (srsran_refsignal_mbsfn_set_cell(&q->mbsfnr_signal, q->cell, mbsfn_area_id)) {
-        ERROR("Error initializing MBSFNR signal (%d)", ret);
-        return SRSRAN_ERROR;
+      for (uint32_t i = 0; i < q->nof_mbsfn_areas; i++) {
+        if (srsran_refsignal_mbsfn_set_cell(&q->mbsfnr_signal[i], q->cell, q->mbsfn_area_id[i])) {
+          ERROR("Error initializing MBSFNR signal (%d)", ret);
+          return SRSRAN_ERROR;
+        }
       }
       /* Generate PSS/SSS signals */
       srsran_pss_generate(q->pss_signal, cell.id % 3);
@@ -264,6 +287,52 @@ int srsran_enb_dl_set_cfr(srsran_enb_dl_t* q, const srsran_cfr_cfg_t* cfr)
   return SRSRAN_SUCCESS;
 }
 
+int srsran_enb_dl_set_mbsfn_areas(srsran_enb_dl_t* q, const uint16_t* area_ids, uint32_t nof_areas)
+{
+  if (q == NULL || (area_ids == NULL && nof_areas > 0) || nof_areas > SRSRAN_ENB_DL_MAX_MBSFN_AREAS) {
+    ERROR("Error, invalid inputs");
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  for (uint32_t i = 0; i < nof_areas; i++) {
+    if (area_ids[i] >= SRSRAN_MAX_MBSFN_AREA_IDS) {
+      ERROR("Invalid MBSFN area ID %d", area_ids[i]);
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+  }
+
+  // Release the PMCH scrambling sequences of the areas left
+  for (uint32_t i = 0; i < q->nof_mbsfn_areas; i++) {
+    bool kept = false;
+    for (uint32_t j = 0; j < nof_areas; j++) {
+      kept |= (area_ids[j] == q->mbsfn_area_id[i]);
+    }
+    if (!kept) {
+      srsran_pmch_free_area_id(&q->pmch, q->mbsfn_area_id[i]);
+    }
+  }
+
+  q->nof_mbsfn_areas = 0;
+  for (uint32_t i = 0; i < nof_areas; i++) {
+    if (q->mbsfnr_signal[i].pilots[0][0] == NULL && srsran_refsignal_mbsfn_init(&q->mbsfnr_signal[i], q->max_prb)) {
+      ERROR("Error initializing MBSFNR signal");
+      return SRSRAN_ERROR;
+    }
+    if (srsran_pmch_set_area_id(&q->pmch, area_ids[i])) {
+      ERROR("Error setting PMCH MBSFN area ID %d", area_ids[i]);
+      return SRSRAN_ERROR;
+    }
+    // The reference signals also depend on the cell, they are generated once it is set
+    if (q->cell.nof_prb != 0 && srsran_refsignal_mbsfn_set_cell(&q->mbsfnr_signal[i], q->cell, area_ids[i])) {
+      ERROR("Error initializing MBSFNR signal");
+      return SRSRAN_ERROR;
+    }
+    q->mbsfn_area_id[i] = area_ids[i];
+    q->nof_mbsfn_areas++;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 #ifdef resolve
 void srsran_enb_dl_apply_power_allocation(srsran_enb_dl_t* q)
 {
@@ -342,12 +411,23 @@ static void put_sync(srsran_enb_dl_t* q)
   }
 }
 
+/* Returns the index of an MBSFN area in the cell configuration, -1 if the cell does not take part in it */
+static int enb_dl_mbsfn_area_idx(srsran_enb_dl_t* q, uint16_t mbsfn_area_id)
+{
+  for (uint32_t i = 0; i < q->nof_mbsfn_areas; i++) {
+    if (q->mbsfn_area_id[i] == mbsfn_area_id) {
+      return (int)i;
+    }
+  }
+  return -1;
+}
+
 static void put_refs(srsran_enb_dl_t* q)
 {
   uint32_t sf_idx = q->dl_sf.tti % 10;
   if (q->dl_sf.sf_type == SRSRAN_SF_MBSFN) {
-    srsran_refsignal_mbsfn_put_sf(
-        q->cell, 0, q->csr_signal.pilots[0][sf_idx], q->mbsfnr_signal.pilots[0][sf_idx], q->sf_symbols[0]);
+    // The MBSFN reference signals are put along with the PMCH, idle MBSFN subframes leave the MBSFN region empty
+    srsran_refsignal_mbsfn_put_cs(q->cell, 0, q->csr_signal.pilots[0][sf_idx], q->sf_symbols[0]);
   } else {
     for (int p = 0; p < q->cell.nof_ports; p++) {
       srsran_refsignal_cs_put_sf(&q->csr_signal, &q->dl_sf, (uint32_t)p, q->sf_symbols[p]);
@@ -373,15 +453,91 @@ static void put_pcfich(srsran_enb_dl_t* q)
   srsran_pcfich_encode(&q->pcfich, &q->dl_sf, q->sf_symbols);
 }
 
+/* Collects the non-zero RE of the subframe grid, holding the base signals of the current subframe, into a template */
+static int enb_dl_gen_base_template(srsran_enb_dl_t* q, srsran_enb_dl_base_template_t* t)
+{
+  for (uint32_t p = 0; p < q->cell.nof_ports; p++) {
+    const cf_t* sf_symbols = q->sf_symbols[p];
+
+    uint32_t nof_re = 0;
+    for (uint32_t i = 0; i < CURRENT_SFLEN_RE; i++) {
+      if (crealf(sf_symbols[i]) != 0.0f || cimagf(sf_symbols[i]) != 0.0f) {
+        nof_re++;
+      }
+    }
+
+    if (nof_re > t->max_re[p]) {
+      if (t->re_idx[p]) {
+        free(t->re_idx[p]);
+      }
+      if (t->re_symb[p]) {
+        free(t->re_symb[p]);
+      }
+      t->max_re[p]  = 0;
+      t->re_idx[p]  = srsran_vec_u32_malloc(nof_re);
+      t->re_symb[p] = srsran_vec_cf_malloc(nof_re);
+      if (!t->re_idx[p] || !t->re_symb[p]) {
+        return SRSRAN_ERROR;
+      }
+      t->max_re[p] = nof_re;
+    }
+
+    t->nof_re[p] = 0;
+    for (uint32_t i = 0; i < CURRENT_SFLEN_RE; i++) {
+      if (crealf(sf_symbols[i]) != 0.0f || cimagf(sf_symbols[i]) != 0.0f) {
+        t->re_idx[p][t->nof_re[p]]  = i;
+        t->re_symb[p][t->nof_re[p]] = sf_symbols[i];
+        t->nof_re[p]++;
+      }
+    }
+  }
+  t->valid = true;
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Returns the base signal template of the current subframe, NULL if the subframe cannot use one */
+static srsran_enb_dl_base_template_t* enb_dl_get_base_template(srsran_enb_dl_t* q)
+{
+  // The number of reference signal symbols of TDD special subframes depends on the subframe configuration. Invalid
+  // CFI values are left to the PCFICH encoder as they are
+  if (q->cell.frame_type != SRSRAN_FDD || !SRSRAN_CFI_ISVALID(q->dl_sf.cfi)) {
+    return NULL;
+  }
+
+  uint32_t idx = (q->dl_sf.sf_type == SRSRAN_SF_MBSFN) ? 1 : 0;
+  idx          = idx * SRSRAN_NOF_SF_X_FRAME + q->dl_sf.tti % SRSRAN_NOF_SF_X_FRAME;
+  idx = idx * SRSRAN_NOF_CFI + SRSRAN_CFI_IDX(q->dl_sf.cfi);
+  return &q->base_templates[idx];
+}
+
 void srsran_enb_dl_put_base(srsran_enb_dl_t* q, srsran_dl_sf_cfg_t* dl_sf)
 {
   srsran_ofdm_set_non_mbsfn_region(&q->ifft_mbsfn, dl_sf->non_mbsfn_region);
   q->dl_sf = *dl_sf;
   clear_sf(q);
-  put_sync(q);
-  put_refs(q);
+
+  // Synchronization signals, reference signals and PCFICH are put from a template, generated the first time the
+  // subframe is seen. The PBCH changes every frame and is encoded once per MIB period by the PBCH object
+  srsran_enb_dl_base_template_t* t = enb_dl_get_base_template(q);
+  if (t != NULL && t->valid) {
+    for (uint32_t p = 0; p < q->cell.nof_ports; p++) {
+      cf_t*           sf_symbols = q->sf_symbols[p];
+      const uint32_t* re_idx     = t->re_idx[p];
+      const cf_t*     re_symb    = t->re_symb[p];
+      for (uint32_t i = 0; i < t->nof_re[p]; i++) {
+        sf_symbols[re_idx[i]] = re_symb[i];
+      }
+    }
+  } else {
+    put_sync(q);
+    put_refs(q);
+    put_pcfich(q);
+    if (t != NULL && enb_dl_gen_base_template(q, t)) {
+      ERROR("Error generating base signal template");
+    }
+  }
   put_mib(q);
-  put_pcfich(q);
 }
 
 void srsran_enb_dl_put_phich(srsran_enb_dl_t* q, srsran_phich_grant_t* grant, bool ack)
@@ -438,11 +594,39 @@ int srsran_enb_dl_put_pdsch(srsran_enb_dl_t* q, srsran_pdsch_cfg_t* pdsch, uint8
   return srsran_pdsch_encode(&q->pdsch, &q->dl_sf, pdsch, data, q->sf_symbols);
 }
 
+/* Puts the MBSFN reference signals of the area of a PMCH, TS 36.211 6.10.2 only transmits them along with the PMCH */
+static int put_mbsfn_refs(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmch_cfg)
+{
+  int area_idx = enb_dl_mbsfn_area_idx(q, pmch_cfg->area_id);
+  if (area_idx < 0) {
+    ERROR("MBSFN area ID %d is not configured", pmch_cfg->area_id);
+    return SRSRAN_ERROR;
+  }
+  return srsran_refsignal_mbsfn_put_mbsfn(
+      q->cell, 0, q->mbsfnr_signal[area_idx].pilots[0][q->dl_sf.tti % 10], q->sf_symbols[0]);
+}
+
 int srsran_enb_dl_put_pmch(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmch_cfg, uint8_t* data)
 {
+  if (put_mbsfn_refs(q, pmch_cfg)) {
+    return SRSRAN_ERROR;
+  }
   return srsran_pmch_encode(&q->pmch, &q->dl_sf, pmch_cfg, data, q->sf_symbols);
 }
 
+int srsran_enb_dl_encode_pmch_symbols(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmch_cfg, uint8_t* data, cf_t* symbols)
+{
+  return srsran_pmch_encode_symbols(&q->pmch, &q->dl_sf, pmch_cfg, data, symbols);
+}
+
+int srsran_enb_dl_put_pmch_symbols(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmch_cfg, cf_t* symbols)
+{
+  if (put_mbsfn_refs(q, pmch_cfg)) {
+    return SRSRAN_ERROR;
+  }
+  return srsran_pmch_put_symbols(&q->pmch, &q->dl_sf, pmch_cfg, symbols, q->sf_symbols);
+}
+
 void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q)
 {
   float norm_factor = enb_dl_get_norm_factor(q->cell.nof_prb);
@@ -342,28 +342,35 @@ void srsran_rm_turbo_free_tables()
  *
  * @return Error code
  */
-int srsran_rm_turbo_tx_lut(uint8_t* w_buff,
-                           uint8_t* systematic,
-                           uint8_t* parity,
-                           uint8_t* output,
-                           uint32_t cb_idx,
-                           uint32_t out_len,
-                           uint32_t w_offset,
-                           uint32_t rv_idx)
+int srsran_rm_turbo_tx_lut_collect(uint8_t* w_buff, uint8_t* systematic, uint8_t* parity, uint32_t cb_idx)
 {
-  if (rv_idx < 4 && cb_idx < SRSRAN_NOF_TC_CB_SIZES) {
+  if (cb_idx < SRSRAN_NOF_TC_CB_SIZES) {
     int in_len = 3 * srsran_cbsegm_cbsize(cb_idx) + 12;
 
     /* Sub-block interleaver (5.1.4.1.1) and bit collection */
-    if (rv_idx == 0) {
-      // Systematic bits
-      // srsran_bit_interleave(systematic, w_buff, interleaver_systematic_bits[cb_idx], in_len/3);
-      srsran_bit_interleaver_run(&bit_interleavers_systematic_bits[cb_idx], systematic, w_buff, 0);
+    // Systematic bits
+    // srsran_bit_interleave(systematic, w_buff, interleaver_systematic_bits[cb_idx], in_len/3);
+    srsran_bit_interleaver_run(&bit_interleavers_systematic_bits[cb_idx], systematic, w_buff, 0);
 
-      // Parity bits
-      // srsran_bit_interleave_w_offset(parity, &w_buff[in_len/24], interleaver_parity_bits[cb_idx], 2*in_len/3, 4);
-      srsran_bit_interleaver_run(&bit_interleavers_parity_bits[cb_idx], parity, &w_buff[in_len / 24], 4);
-    }
+    // Parity bits
+    // srsran_bit_interleave_w_offset(parity, &w_buff[in_len/24], interleaver_parity_bits[cb_idx], 2*in_len/3, 4);
+    srsran_bit_interleaver_run(&bit_interleavers_parity_bits[cb_idx], parity, &w_buff[in_len / 24], 4);
+
+    return 0;
+  } else {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+}
+
+int srsran_rm_turbo_tx_lut_select(uint8_t* w_buff,
+                                  uint8_t* output,
+                                  uint32_t cb_idx,
+                                  uint32_t out_len,
+                                  uint32_t w_offset,
+                                  uint32_t rv_idx)
+{
+  if (rv_idx < 4 && cb_idx < SRSRAN_NOF_TC_CB_SIZES) {
+    int in_len = 3 * srsran_cbsegm_cbsize(cb_idx) + 12;
 
     /* Bit selection and transmission 5.1.4.1.2 */
     int w_len = 0;
@@ -387,6 +394,25 @@ int srsran_rm_turbo_tx_lut(uint8_t* w_buff,
   }
 }
 
+int srsran_rm_turbo_tx_lut(uint8_t* w_buff,
+                           uint8_t* systematic,
+                           uint8_t* parity,
+                           uint8_t* output,
+                           uint32_t cb_idx,
+                           uint32_t out_len,
+                           uint32_t w_offset,
+                           uint32_t rv_idx)
+{
+  if (rv_idx < 4 && cb_idx < SRSRAN_NOF_TC_CB_SIZES) {
+    if (rv_idx == 0) {
+      srsran_rm_turbo_tx_lut_collect(w_buff, systematic, parity, cb_idx);
+    }
+    return srsran_rm_turbo_tx_lut_select(w_buff, output, cb_idx, out_len, w_offset, rv_idx);
+  } else {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+}
+
 int srsran_rm_turbo_rx_lut(int16_t* input, int16_t* output, uint32_t in_len, uint32_t cb_idx, uint32_t rv_idx)
 {
   return srsran_rm_turbo_rx_lut_(input, output, in_len, cb_idx, rv_idx, true);
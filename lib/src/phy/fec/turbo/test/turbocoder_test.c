@@ -21,6 +21,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <strings.h>
 #include <unistd.h>
 
@@ -60,6 +61,59 @@ uint8_t parity_bits[3 * 6144 + 12];
 uint8_t output_bits[3 * 6144 + 12];
 uint8_t output_bits2[3 * 6144 + 12];
 
+uint8_t multi_input[2][SRSRAN_TCOD_MAX_PARALLEL_CB][6144 / 8 + 3];
+uint8_t multi_parity[2][SRSRAN_TCOD_MAX_PARALLEL_CB][3 * 6144 / 8 + 3];
+
+/* Encodes a few code blocks of the same size with srsran_tcod_encode_lut() and srsran_tcod_encode_multi(), which
+ * must produce the same bytes */
+int test_encode_multi(srsran_tcod_t* tcod, srsran_random_t random_gen, uint32_t cblen_idx, uint32_t nof_cb)
+{
+  uint32_t     cb_len = srsran_cbsegm_cbsize(cblen_idx);
+  srsran_crc_t crc_tb[2], crc_cb[2];
+  for (int i = 0; i < 2; i++) {
+    bzero(&crc_tb[i], sizeof(srsran_crc_t));
+    bzero(&crc_cb[i], sizeof(srsran_crc_t));
+    if (srsran_crc_init(&crc_tb[i], SRSRAN_LTE_CRC24A, 24) || srsran_crc_init(&crc_cb[i], SRSRAN_LTE_CRC24B, 24)) {
+      printf("error initialising CRC\n");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // The smallest code blocks cannot carry both CRCs
+  bool with_crc = cb_len > 48;
+
+  uint8_t* input[SRSRAN_TCOD_MAX_PARALLEL_CB];
+  uint8_t* parity_ptr[SRSRAN_TCOD_MAX_PARALLEL_CB];
+  for (uint32_t cb = 0; cb < nof_cb; cb++) {
+    for (uint32_t i = 0; i < cb_len / 8; i++) {
+      multi_input[0][cb][i] = srsran_random_uniform_int_dist(random_gen, 0, 256);
+    }
+    memcpy(multi_input[1][cb], multi_input[0][cb], cb_len / 8);
+
+    bool last_cb = with_crc && cb == nof_cb - 1;
+    srsran_tcod_encode_lut(
+        tcod, &crc_tb[0], with_crc ? &crc_cb[0] : NULL, multi_input[0][cb], multi_parity[0][cb], cblen_idx, last_cb);
+    srsran_tcod_attach_crc(&crc_tb[1], with_crc ? &crc_cb[1] : NULL, multi_input[1][cb], cblen_idx, last_cb);
+    input[cb]      = multi_input[1][cb];
+    parity_ptr[cb] = multi_parity[1][cb];
+  }
+
+  if (srsran_tcod_encode_multi(tcod, input, parity_ptr, cblen_idx, nof_cb) != 3 * cb_len + 12) {
+    printf("error encoding %d code blocks, long_cb=%d\n", nof_cb, cb_len);
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t cb = 0; cb < nof_cb; cb++) {
+    if (memcmp(multi_input[0][cb], multi_input[1][cb], cb_len / 8 + 1) != 0 ||
+        memcmp(multi_parity[0][cb], multi_parity[1][cb], 2 * cb_len / 8 + 1) != 0) {
+      printf("error in code block %d of %d, long_cb=%d\n", cb, nof_cb, cb_len);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   srsran_random_t random_gen = srsran_random_init(0);
@@ -124,6 +178,12 @@ int main(int argc, char** argv)
         exit(-1);
       }
     }
+
+    for (uint32_t nof_cb = 1; nof_cb <= SRSRAN_TCOD_MAX_PARALLEL_CB; nof_cb++) {
+      if (test_encode_multi(&tcod, random_gen, len, nof_cb) != SRSRAN_SUCCESS) {
+        exit(-1);
+      }
+    }
   }
 
   srsran_tcod_free(&tcod);
@@ -30,6 +30,14 @@
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
 
+#if defined(LV_HAVE_AVX2) || defined(LV_HAVE_AVX512)
+#include <immintrin.h>
+#endif /* LV_HAVE_AVX2 || LV_HAVE_AVX512 */
+
+#ifdef HAVE_NEON
+#include <arm_neon.h>
+#endif /* HAVE_NEON */
+
 #define NOF_REGS 3
 
 #define RATE 3
@@ -46,10 +54,13 @@ static srsran_bit_interleaver_t tcod_interleavers[188];
 
 static bool table_initiated = false;
 
+// Bytes of interleaved input reserved for each code block encoded in parallel
+#define TCOD_TEMP_STRIDE(max_long_cb) ((max_long_cb) / 8 + 8)
+
 int srsran_tcod_init(srsran_tcod_t* h, uint32_t max_long_cb)
 {
   h->max_long_cb = max_long_cb;
-  h->temp        = srsran_vec_malloc(max_long_cb / 8);
+  h->temp        = srsran_vec_malloc(SRSRAN_TCOD_MAX_PARALLEL_CB * TCOD_TEMP_STRIDE(max_long_cb));
 
   if (!table_initiated) {
     table_initiated = true;
@@ -184,6 +195,73 @@ int srsran_tcod_encode(srsran_tcod_t* h, uint8_t* input, uint8_t* output, uint32
   return 0;
 }
 
+/* Terminates both constituent encoders from their final states. The systematic tail bits of the 1st encoder go after
+ * the input, and the rest after each of the parity streams */
+static void tcod_put_tail(uint8_t state0, uint8_t state1, uint8_t* input, uint8_t* parity, uint32_t long_cb)
+{
+  uint8_t reg1_0, reg1_1, reg1_2, reg2_0, reg2_1, reg2_2;
+  uint8_t bit, in, out;
+  uint8_t k = 0;
+  uint8_t tail[12];
+
+  reg2_0 = (state1 & 4) >> 2;
+  reg2_1 = (state1 & 2) >> 1;
+  reg2_2 = state1 & 1;
+
+  reg1_0 = (state0 & 4) >> 2;
+  reg1_1 = (state0 & 2) >> 1;
+  reg1_2 = state0 & 1;
+
+  /* TAILING CODER #1 */
+  for (uint32_t j = 0; j < NOF_REGS; j++) {
+    bit = reg1_2 ^ reg1_1;
+
+    tail[k] = bit;
+    k++;
+
+    in  = bit ^ (reg1_2 ^ reg1_1);
+    out = reg1_2 ^ (reg1_0 ^ in);
+
+    reg1_2 = reg1_1;
+    reg1_1 = reg1_0;
+    reg1_0 = in;
+
+    tail[k] = out;
+    k++;
+  }
+
+  /* TAILING CODER #2 */
+  for (uint32_t j = 0; j < NOF_REGS; j++) {
+    bit = reg2_2 ^ reg2_1;
+
+    tail[k] = bit;
+    k++;
+
+    in  = bit ^ (reg2_2 ^ reg2_1);
+    out = reg2_2 ^ (reg2_0 ^ in);
+
+    reg2_2 = reg2_1;
+    reg2_1 = reg2_0;
+    reg2_0 = in;
+
+    tail[k] = out;
+    k++;
+  }
+
+  uint8_t tailv[3][4];
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 3; j++) {
+      tailv[j][i] = tail[3 * i + j];
+    }
+  }
+  uint8_t* x         = tailv[0];
+  input[long_cb / 8] = (srsran_bit_pack(&x, 4) << 4);
+  x                  = tailv[1];
+  parity[long_cb / 8] |= (srsran_bit_pack(&x, 4) << 4);
+  x = tailv[2];
+  parity[2 * long_cb / 8] |= (srsran_bit_pack(&x, 4) & 0xf);
+}
+
 /* Expects bytes and produces bytes. The systematic and parity bits are interlaced in the output */
 int srsran_tcod_encode_lut(srsran_tcod_t* h,
                            srsran_crc_t*  crc_tb,
@@ -300,73 +378,235 @@ int srsran_tcod_encode_lut(srsran_tcod_t* h,
       state1                      = l.next_state;
     }
 
-    /* Tail bits */
-    uint8_t reg1_0, reg1_1, reg1_2, reg2_0, reg2_1, reg2_2;
-    uint8_t bit, in, out;
-    uint8_t k = 0;
-    uint8_t tail[12];
+    tcod_put_tail(state0, state1, input, parity, long_cb);
 
-    reg2_0 = (state1 & 4) >> 2;
-    reg2_1 = (state1 & 2) >> 1;
-    reg2_2 = state1 & 1;
+    return 3 * long_cb + TOTALTAIL;
+  } else {
+    return -1;
+  }
+}
 
-    reg1_0 = (state0 & 4) >> 2;
-    reg1_1 = (state0 & 2) >> 1;
-    reg1_2 = state0 & 1;
+int srsran_tcod_attach_crc(srsran_crc_t* crc_tb,
+                           srsran_crc_t* crc_cb,
+                           uint8_t*      input,
+                           uint32_t      cblen_idx,
+                           bool          last_cb)
+{
+  if (crc_tb == NULL || input == NULL || cblen_idx >= 188) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-    /* TAILING CODER #1 */
-    for (uint32_t j = 0; j < NOF_REGS; j++) {
-      bit = reg1_2 ^ reg1_1;
+  uint32_t long_cb = (uint32_t)srsran_cbsegm_cbsize(cblen_idx);
+  if (long_cb % 8) {
+    ERROR("Turbo coder LUT implementation long_cb must be multiple of 8");
+    return SRSRAN_ERROR;
+  }
 
-      tail[k] = bit;
-      k++;
+  uint32_t crc_cb_order     = crc_cb ? crc_cb->order : 0;
+  uint32_t block_size_nocrc = (long_cb - crc_cb_order - ((last_cb) ? crc_tb->order : 0)) / 8;
 
-      in  = bit ^ (reg1_2 ^ reg1_1);
-      out = reg1_2 ^ (reg1_0 ^ in);
+  if (crc_cb) {
+    srsran_crc_set_init(crc_cb, 0);
+  }
 
-      reg1_2 = reg1_1;
-      reg1_1 = reg1_0;
-      reg1_0 = in;
+  for (uint32_t i = 0; i < block_size_nocrc; i++) {
+    srsran_crc_checksum_put_byte(crc_tb, input[i]);
+    if (crc_cb) {
+      srsran_crc_checksum_put_byte(crc_cb, input[i]);
+    }
+  }
 
-      tail[k] = out;
-      k++;
+  if (last_cb) {
+    uint32_t checksum = (uint32_t)srsran_crc_checksum_get(crc_tb);
+    for (uint32_t i = 0; i < crc_tb->order / 8; i++) {
+      uint8_t in = (uint8_t)((checksum >> (8 * (crc_tb->order / 8 - i - 1))) & 0xff);
+      if (crc_cb) {
+        srsran_crc_checksum_put_byte(crc_cb, in);
+      }
+      input[block_size_nocrc + i] = in;
     }
+  }
 
-    /* TAILING CODER #2 */
-    for (uint32_t j = 0; j < NOF_REGS; j++) {
-      bit = reg2_2 ^ reg2_1;
+  if (crc_cb) {
+    uint32_t checksum = (uint32_t)srsran_crc_checksum_get(crc_cb);
+    for (uint32_t i = 0; i < crc_cb->order / 8; i++) {
+      input[(long_cb - crc_cb->order) / 8 + i] = (uint8_t)((checksum >> (8 * (crc_cb->order / 8 - i - 1))) & 0xff);
+    }
+  }
 
-      tail[k] = bit;
-      k++;
+  return SRSRAN_SUCCESS;
+}
 
-      in  = bit ^ (reg2_2 ^ reg2_1);
-      out = reg2_2 ^ (reg2_0 ^ in);
+/* Word-parallel constituent encoder. Both constituent encoders are y_t = x_t + y_{t-2} + y_{t-3} with parity
+ * z_t = y_t + y_{t-1} + y_{t-3}. Since 1 + D^2 + D^3 divides 1 + D^7, the recursive part is rewritten as
+ * u_t = x_t + u_{t-7}, which a 64-bit word resolves with a shift-xor prefix, and the register sequence and parity
+ * follow from u with feed-forward taps: y = (1 + D^2 + D^3 + D^4) u and z = (1 + D + D^2 + D^3 + D^6 + D^7) u.
+ * Bit 63 of a word is the earliest bit, so delaying is a right shift. Each SIMD lane carries a different code block */
+#if defined(LV_HAVE_AVX512)
+#define TCOD_LANES 8
+typedef __m512i tcod_word_t;
+#define tcod_word_load(P) _mm512_load_si512((const void*)(P))
+#define tcod_word_store(P, V) _mm512_store_si512((void*)(P), V)
+#define tcod_word_xor(A, B) _mm512_xor_si512(A, B)
+#define tcod_word_or(A, B) _mm512_or_si512(A, B)
+#define tcod_word_shl(A, N) _mm512_slli_epi64(A, N)
+#define tcod_word_shr(A, N) _mm512_srli_epi64(A, N)
+#define tcod_word_zero() _mm512_setzero_si512()
+#elif defined(LV_HAVE_AVX2)
+#define TCOD_LANES 4
+typedef __m256i tcod_word_t;
+#define tcod_word_load(P) _mm256_load_si256((const __m256i*)(P))
+#define tcod_word_store(P, V) _mm256_store_si256((__m256i*)(P), V)
+#define tcod_word_xor(A, B) _mm256_xor_si256(A, B)
+#define tcod_word_or(A, B) _mm256_or_si256(A, B)
+#define tcod_word_shl(A, N) _mm256_slli_epi64(A, N)
+#define tcod_word_shr(A, N) _mm256_srli_epi64(A, N)
+#define tcod_word_zero() _mm256_setzero_si256()
+#elif defined(HAVE_NEON)
+#define TCOD_LANES 2
+typedef uint64x2_t tcod_word_t;
+#define tcod_word_load(P) vld1q_u64(P)
+#define tcod_word_store(P, V) vst1q_u64(P, V)
+#define tcod_word_xor(A, B) veorq_u64(A, B)
+#define tcod_word_or(A, B) vorrq_u64(A, B)
+#define tcod_word_shl(A, N) vshlq_n_u64(A, N)
+#define tcod_word_shr(A, N) vshrq_n_u64(A, N)
+#define tcod_word_zero() vdupq_n_u64(0)
+#else
+#define TCOD_LANES 1
+typedef uint64_t tcod_word_t;
+#define tcod_word_load(P) (*(P))
+#define tcod_word_store(P, V) (*(P) = (V))
+#define tcod_word_xor(A, B) ((A) ^ (B))
+#define tcod_word_or(A, B) ((A) | (B))
+#define tcod_word_shl(A, N) ((A) << (N))
+#define tcod_word_shr(A, N) ((A) >> (N))
+#define tcod_word_zero() ((uint64_t)0)
+#endif
+
+/* u delayed by K bits, taking the earlier bits from the previous word */
+#define TCOD_DELAY(U, PREV, K) tcod_word_or(tcod_word_shr(U, K), tcod_word_shl(PREV, 64 - (K)))
+
+/* Loads up to 8 bytes MSB first, zero padding the rest */
+static inline uint64_t tcod_load_be(const uint8_t* p, uint32_t nof_bytes)
+{
+  uint64_t w = 0;
+  if (nof_bytes == 8) {
+    memcpy(&w, p, 8);
+    return __builtin_bswap64(w);
+  }
+  for (uint32_t i = 0; i < nof_bytes; i++) {
+    w |= (uint64_t)p[i] << (56 - 8 * i);
+  }
+  return w;
+}
 
-      reg2_2 = reg2_1;
-      reg2_1 = reg2_0;
-      reg2_0 = in;
+/* Stores the first bytes of a word MSB first */
+static inline void tcod_store_be(uint8_t* p, uint64_t w, uint32_t nof_bytes)
+{
+  if (nof_bytes == 8) {
+    w = __builtin_bswap64(w);
+    memcpy(p, &w, 8);
+    return;
+  }
+  for (uint32_t i = 0; i < nof_bytes; i++) {
+    p[i] = (uint8_t)(w >> (56 - 8 * i));
+  }
+}
 
-      tail[k] = out;
-      k++;
+/* Runs one constituent encoder over up to TCOD_LANES code blocks. The parity of the 2nd encoder is stored half a byte
+ * later than the 1st one, as srsran_tcod_encode_lut() does, in which case the first byte is OR-ed */
+static void tcod_encode_conv_multi(uint8_t* const* input,
+                                   uint8_t* const* parity,
+                                   uint32_t        nof_cb,
+                                   uint32_t        long_cb,
+                                   bool            nibble_shift,
+                                   uint8_t*        state)
+{
+  uint64_t    x[TCOD_LANES] __attribute__((aligned(64))) = {};
+  uint64_t    z[TCOD_LANES] __attribute__((aligned(64))) = {};
+  tcod_word_t u_prev                                     = tcod_word_zero();
+  tcod_word_t y                                          = tcod_word_zero();
+  uint32_t    nof_bytes                                  = 8;
+
+  for (uint32_t offset = 0; offset < long_cb / 8; offset += 8) {
+    nof_bytes = SRSRAN_MIN(8, long_cb / 8 - offset);
+    for (uint32_t i = 0; i < nof_cb; i++) {
+      x[i] = tcod_load_be(&input[i][offset], nof_bytes);
     }
 
-    uint8_t tailv[3][4];
-    for (int i = 0; i < 4; i++) {
-      for (int j = 0; j < 3; j++) {
-        tailv[j][i] = tail[3 * i + j];
+    /* Recursive part, u_t = x_t + u_{t-7} */
+    tcod_word_t u = tcod_word_xor(tcod_word_load(x), tcod_word_shl(u_prev, 57));
+    u             = tcod_word_xor(u, tcod_word_shr(u, 7));
+    u             = tcod_word_xor(u, tcod_word_shr(u, 14));
+    u             = tcod_word_xor(u, tcod_word_shr(u, 28));
+    u             = tcod_word_xor(u, tcod_word_shr(u, 56));
+
+    tcod_word_t d2 = TCOD_DELAY(u, u_prev, 2);
+    tcod_word_t d3 = TCOD_DELAY(u, u_prev, 3);
+    tcod_word_t p  = tcod_word_xor(tcod_word_xor(u, TCOD_DELAY(u, u_prev, 1)), tcod_word_xor(d2, d3));
+    p = tcod_word_xor(p, tcod_word_xor(TCOD_DELAY(u, u_prev, 6), TCOD_DELAY(u, u_prev, 7)));
+    y = tcod_word_xor(tcod_word_xor(u, d2), tcod_word_xor(d3, TCOD_DELAY(u, u_prev, 4)));
+    tcod_word_store(z, p);
+
+    for (uint32_t i = 0; i < nof_cb; i++) {
+      if (nibble_shift) {
+        uint64_t w = z[i] & (~0ULL << (64 - 8 * nof_bytes));
+        parity[i][offset] |= (uint8_t)(w >> 60);
+        tcod_store_be(&parity[i][offset + 1], w << 4, nof_bytes);
+      } else {
+        tcod_store_be(&parity[i][offset], z[i], nof_bytes);
       }
     }
-    uint8_t* x         = tailv[0];
-    input[long_cb / 8] = (srsran_bit_pack(&x, 4) << 4);
-    x                  = tailv[1];
-    parity[long_cb / 8] |= (srsran_bit_pack(&x, 4) << 4);
-    x = tailv[2];
-    parity[2 * long_cb / 8] |= (srsran_bit_pack(&x, 4) & 0xf);
+    u_prev = u;
+  }
 
-    return 3 * long_cb + TOTALTAIL;
-  } else {
-    return -1;
+  /* The last three register values give the final state, most recent in the MSB */
+  uint64_t last[TCOD_LANES] __attribute__((aligned(64)));
+  tcod_word_store(last, y);
+  for (uint32_t i = 0; i < nof_cb; i++) {
+    uint8_t b = (uint8_t)((last[i] >> (64 - 8 * nof_bytes)) & 7);
+    state[i]  = (uint8_t)(((b & 1) << 2) | (b & 2) | ((b >> 2) & 1));
+  }
+}
+
+int srsran_tcod_encode_multi(srsran_tcod_t* h, uint8_t** input, uint8_t** parity, uint32_t cblen_idx, uint32_t nof_cb)
+{
+  if (h == NULL || input == NULL || parity == NULL || cblen_idx >= 188 || nof_cb > SRSRAN_TCOD_MAX_PARALLEL_CB) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
   }
+
+  uint32_t long_cb = (uint32_t)srsran_cbsegm_cbsize(cblen_idx);
+  if (long_cb % 8 || long_cb > h->max_long_cb) {
+    ERROR("Turbo coder LUT implementation long_cb must be multiple of 8 and up to %d", h->max_long_cb);
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t cb = 0; cb < nof_cb; cb += TCOD_LANES) {
+    uint32_t nof_lanes = SRSRAN_MIN(TCOD_LANES, nof_cb - cb);
+    uint8_t  state0[TCOD_LANES];
+    uint8_t  state1[TCOD_LANES];
+    uint8_t* temp[TCOD_LANES];
+    uint8_t* parity2[TCOD_LANES];
+
+    /* Parity bits for the 1st constituent encoders */
+    tcod_encode_conv_multi(&input[cb], &parity[cb], nof_lanes, long_cb, false, state0);
+
+    /* Interleave input and run the 2nd constituent encoders */
+    for (uint32_t i = 0; i < nof_lanes; i++) {
+      temp[i]    = &h->temp[i * TCOD_TEMP_STRIDE(h->max_long_cb)];
+      parity2[i] = &parity[cb + i][long_cb / 8];
+      srsran_bit_interleaver_run(&tcod_interleavers[cblen_idx], input[cb + i], temp[i], 0);
+      parity2[i][0] = 0; // will put tail here later
+    }
+    tcod_encode_conv_multi(temp, parity2, nof_lanes, long_cb, true, state1);
+
+    for (uint32_t i = 0; i < nof_lanes; i++) {
+      tcod_put_tail(state0[i], state1[i], input[cb + i], parity[cb + i], long_cb);
+    }
+  }
+
+  return 3 * long_cb + TOTALTAIL;
 }
 
 void srsran_tcod_gentable()
@@ -164,3 +164,49 @@ int srsran_mod_modulate_bytes(const srsran_modem_table_t* q, const uint8_t* bits
   }
   return nbits / q->nbits_x_symbol;
 }
+
+int srsran_mod_modulate_scrambled_bytes(const srsran_modem_table_t* q,
+                                        const uint8_t*              bits,
+                                        const uint8_t*              seq,
+                                        uint32_t                    bit_offset,
+                                        cf_t*                       symbols,
+                                        uint32_t                    nof_symbols,
+                                        uint32_t                    stride)
+{
+  uint32_t qm = q->nbits_x_symbol;
+  if (qm == 0 || qm > 8 || stride == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  if (nof_symbols == 0) {
+    return 0;
+  }
+
+  // Scrambled bits are read into an accumulator, 32 at a time while that does not read past the last byte
+  uint32_t byte_idx = bit_offset / 8;
+  uint32_t byte_end = (bit_offset + nof_symbols * qm + 7) / 8;
+  uint64_t acc      = (uint8_t)(bits[byte_idx] ^ seq[byte_idx]);
+  uint32_t nof_acc  = 8 - bit_offset % 8;
+  uint32_t mask     = (1U << qm) - 1;
+  byte_idx++;
+
+  for (uint32_t i = 0; i < nof_symbols; i++) {
+    if (nof_acc < qm) {
+      if (byte_idx + 4 <= byte_end) {
+        uint32_t b, c;
+        memcpy(&b, &bits[byte_idx], sizeof(uint32_t));
+        memcpy(&c, &seq[byte_idx], sizeof(uint32_t));
+        acc = (acc << 32) | __builtin_bswap32(b ^ c);
+        byte_idx += 4;
+        nof_acc += 32;
+      } else {
+        acc = (acc << 8) | (uint8_t)(bits[byte_idx] ^ seq[byte_idx]);
+        byte_idx++;
+        nof_acc += 8;
+      }
+    }
+    nof_acc -= qm;
+    symbols[i * stride] = q->symbol_table[(acc >> nof_acc) & mask];
+  }
+
+  return (int)nof_symbols;
+}
@@ -175,6 +175,38 @@ int main(int argc, char** argv)
     }
   }
 
+  /* Test fused scrambling and modulation, written every other symbol and split at a symbol that is not byte aligned */
+  uint32_t nof_symbols   = num_bits / mod.nbits_x_symbol;
+  uint32_t split         = nof_symbols / 2 + 1;
+  uint8_t* seq_bytes     = srsran_vec_u8_malloc(num_bits / 8 + 1);
+  uint8_t* scrambled     = srsran_vec_u8_malloc(num_bits);
+  cf_t*    symbols_fused = srsran_vec_cf_malloc(2 * nof_symbols);
+  if (!seq_bytes || !scrambled || !symbols_fused) {
+    perror("malloc");
+    exit(-1);
+  }
+  for (i = 0; i < num_bits; i++) {
+    scrambled[i] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 1);
+  }
+  srsran_bit_pack_vector(scrambled, seq_bytes, num_bits);
+  for (i = 0; i < num_bits; i++) {
+    scrambled[i] ^= input[i];
+  }
+  srsran_mod_modulate(&mod, scrambled, symbols, num_bits);
+  srsran_mod_modulate_scrambled_bytes(&mod, input_bytes, seq_bytes, 0, symbols_fused, split, 2);
+  srsran_mod_modulate_scrambled_bytes(
+      &mod, input_bytes, seq_bytes, split * mod.nbits_x_symbol, &symbols_fused[2 * split], nof_symbols - split, 2);
+  for (int j = 0; j < nof_symbols; j++) {
+    if (symbols[j] != symbols_fused[2 * j]) {
+      printf("error in scrambled symbol %d\n", j);
+      exit(-1);
+    }
+  }
+  srsran_mod_modulate(&mod, input, symbols, num_bits);
+  free(seq_bytes);
+  free(scrambled);
+  free(symbols_fused);
+
   srsran_vec_f_zero(llr, num_bits / mod.nbits_x_symbol);
 
   printf("Symbols OK\n");
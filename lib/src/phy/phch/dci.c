@@ -960,6 +960,15 @@ static int dci_format1Cs_pack(srsran_cell_t*      cell,
   /* pack bits */
   uint8_t* y = msg->payload;
 
+  // MCCH change notification: 8 bits followed by reserved bits up to the size of format 1C, as in 36.212 5.3.3.1.4
+  if (SRSRAN_RNTI_ISMBSFN(dci->rnti)) {
+    uint32_t nof_bits = srsran_dci_format_sizeof(cell, sf, cfg, SRSRAN_DCI_FORMAT1C);
+    srsran_bit_unpack(dci->mcch_change_notif, &y, 8);
+    bzero(y, nof_bits - 8);
+    msg->nof_bits = nof_bits;
+    return SRSRAN_SUCCESS;
+  }
+
   if (dci->cif_present) {
     srsran_bit_unpack(dci->cif, &y, 3);
   }
@@ -1001,6 +1010,11 @@ static int dci_format1Cs_unpack(srsran_cell_t*      cell,
     return SRSRAN_ERROR;
   }
 
+  if (SRSRAN_RNTI_ISMBSFN(msg->rnti)) {
+    dci->mcch_change_notif = (uint8_t)srsran_bit_pack(&y, 8);
+    return SRSRAN_SUCCESS;
+  }
+
   dci->alloc_type       = SRSRAN_RA_ALLOC_TYPE2;
   dci->type2_alloc.mode = SRSRAN_RA_TYPE2_DIST;
   if (cell->nof_prb >= 50) {
@@ -1655,6 +1669,8 @@ uint32_t srsran_dci_dl_info(const srsran_dci_dl_t* dci_dl, char* info_str, uint3
   if (dci_dl->is_pdcch_order) {
     n = srsran_print_check(info_str, len, n, ", preamb_idx=%d", dci_dl->preamble_idx);
     n = srsran_print_check(info_str, len, n, ", prach_mask_idx=%d", dci_dl->prach_mask_idx);
+  } else if (dci_dl->format == SRSRAN_DCI_FORMAT1C && SRSRAN_RNTI_ISMBSFN(dci_dl->rnti)) {
+    n = srsran_print_check(info_str, len, n, ", mcch_change_notif=0x%02x", dci_dl->mcch_change_notif);
   } else {
     switch (dci_dl->alloc_type) {
       case SRSRAN_RA_ALLOC_TYPE0:
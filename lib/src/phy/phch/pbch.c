@@ -250,7 +250,8 @@ int srsran_pbch_set_cell(srsran_pbch_t* q, srsran_cell_t cell)
         return SRSRAN_ERROR;
       }
     }
-    q->nof_symbols = (SRSRAN_CP_ISNORM(q->cell.cp)) ? PBCH_RE_CP_NORM : PBCH_RE_CP_EXT;
+    q->nof_symbols      = (SRSRAN_CP_ISNORM(q->cell.cp)) ? PBCH_RE_CP_NORM : PBCH_RE_CP_EXT;
+    q->tx_payload_valid = false;
 
     ret = SRSRAN_SUCCESS;
   }
@@ -575,17 +576,25 @@ int srsran_pbch_encode(srsran_pbch_t* q,
 
     frame_idx = frame_idx % 4;
 
-    memcpy(q->data, bch_payload, sizeof(uint8_t) * SRSRAN_BCH_PAYLOAD_LEN);
+    /* encode and scramble the 4 frames at once. The payload only changes every 4 frames, so the result is kept
+     * until a different payload is given */
+    if (!q->tx_payload_valid || memcmp(q->tx_payload, bch_payload, sizeof(uint8_t) * SRSRAN_BCH_PAYLOAD_LEN) != 0) {
+      memcpy(q->data, bch_payload, sizeof(uint8_t) * SRSRAN_BCH_PAYLOAD_LEN);
 
-    /* encode & modulate */
-    srsran_crc_attach(&q->crc, q->data, SRSRAN_BCH_PAYLOAD_LEN);
-    srsran_crc_set_mask(q->data, q->cell.nof_ports);
+      srsran_crc_attach(&q->crc, q->data, SRSRAN_BCH_PAYLOAD_LEN);
+      srsran_crc_set_mask(q->data, q->cell.nof_ports);
 
-    srsran_convcoder_encode(&q->encoder, q->data, q->data_enc, SRSRAN_BCH_PAYLOADCRC_LEN);
+      srsran_convcoder_encode(&q->encoder, q->data, q->data_enc, SRSRAN_BCH_PAYLOADCRC_LEN);
 
-    srsran_rm_conv_tx(q->data_enc, SRSRAN_BCH_ENCODED_LEN, q->rm_b, 4 * nof_bits);
+      srsran_rm_conv_tx(q->data_enc, SRSRAN_BCH_ENCODED_LEN, q->rm_b, 4 * nof_bits);
 
-    srsran_scrambling_b_offset(&q->seq, &q->rm_b[frame_idx * nof_bits], frame_idx * nof_bits, nof_bits);
+      srsran_scrambling_b_offset(&q->seq, q->rm_b, 0, 4 * nof_bits);
+
+      memcpy(q->tx_payload, bch_payload, sizeof(uint8_t) * SRSRAN_BCH_PAYLOAD_LEN);
+      q->tx_payload_valid = true;
+    }
+
+    /* modulate */
     srsran_mod_modulate(&q->mod, &q->rm_b[frame_idx * nof_bits], q->d, nof_bits);
 
     /* layer mapping & precoding */
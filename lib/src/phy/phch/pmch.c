@@ -294,6 +294,11 @@ int srsran_pmch_decode(srsran_pmch_t*         q,
   uint32_t i, n;
 
   if (q != NULL && sf_symbols != NULL && out != NULL && cfg != NULL) {
+    if (cfg->area_id >= SRSRAN_MAX_MBSFN_AREA_IDS || !q->seqs[cfg->area_id]) {
+      ERROR("Error MBSFN area ID %d is not configured", cfg->area_id);
+      return SRSRAN_ERROR;
+    }
+
     INFO("Decoding PMCH SF: %d, MBSFN area ID: 0x%x, Mod %s, TBS: %d, NofSymbols: %d, NofBitsE: %d, rv_idx: %d, "
          "C_prb=%d, cfi=%d",
          sf->tti % 10,
@@ -396,64 +401,168 @@ void srsran_configure_pmch(srsran_pmch_cfg_t* pmch_cfg, srsran_cell_t* cell, srs
   }
 }
 
-int srsran_pmch_encode(srsran_pmch_t*      q,
-                       srsran_dl_sf_cfg_t* sf,
-                       srsran_pmch_cfg_t*  cfg,
-                       uint8_t*            data,
-                       cf_t*               sf_symbols[SRSRAN_MAX_PORTS])
+/**
+ * Scrambles, modulates and maps the PMCH codeword in q->e straight to the MBSFN region of the grid of every port,
+ * skipping the MBSFN reference signal REs. Follows the same RE order as pmch_put()
+ *
+ * Returns the number of symbols written to sf_symbols
+ */
+static int pmch_mod_put(srsran_pmch_t*      q,
+                        srsran_dl_sf_cfg_t* sf,
+                        srsran_pmch_cfg_t*  cfg,
+                        cf_t*               sf_symbols[SRSRAN_MAX_PORTS],
+                        uint32_t            lstart)
 {
-  int i;
-  int ret = SRSRAN_ERROR_INVALID_INPUTS;
-  if (q != NULL && cfg != NULL) {
-    for (i = 0; i < q->cell.nof_ports; i++) {
-      if (sf_symbols[i] == NULL) {
-        return SRSRAN_ERROR_INVALID_INPUTS;
+  const srsran_modem_table_t* table       = &q->mod[cfg->pdsch_cfg.grant.tb[0].mod];
+  const uint8_t*              seq         = q->seqs[cfg->area_id]->seq[sf->tti % 10].c_bytes;
+  uint32_t                    nof_symbols = cfg->pdsch_cfg.grant.tb[0].nof_bits / table->nbits_x_symbol;
+  uint32_t                    count       = 0;
+
+  for (uint32_t s = 0; s < 2; s++) {
+    for (uint32_t l = (s == 0) ? lstart : 0; l < SRSRAN_CP_EXT_NSYMB && count < nof_symbols; l++) {
+      uint32_t lp     = l + s * SRSRAN_CP_EXT_NSYMB;
+      uint32_t offset = lp * q->cell.nof_prb * SRSRAN_NRE;
+      uint32_t stride = 1;
+      uint32_t len    = q->cell.nof_prb * SRSRAN_NRE;
+
+      // Symbols with MBSFN reference signals carry data in every other RE
+      if (SRSRAN_SYMBOL_HAS_REF_MBSFN(l, s)) {
+        offset += (l == 0 && s == 1) ? 0 : 1;
+        stride = 2;
+        len /= 2;
       }
+      len = SRSRAN_MIN(len, nof_symbols - count);
+
+      srsran_mod_modulate_scrambled_bytes(
+          table, q->e, seq, count * table->nbits_x_symbol, &sf_symbols[0][offset], len, stride);
+      for (uint32_t i = 1; i < q->cell.nof_ports; i++) {
+        if (stride == 1) {
+          srsran_vec_cf_copy(&sf_symbols[i][offset], &sf_symbols[0][offset], len);
+        } else {
+          for (uint32_t k = 0; k < len; k++) {
+            sf_symbols[i][offset + k * stride] = sf_symbols[0][offset + k * stride];
+          }
+        }
+      }
+      count += len;
     }
+  }
 
-    if (cfg->pdsch_cfg.grant.tb[0].tbs == 0) {
-      return SRSRAN_ERROR_INVALID_INPUTS;
-    }
+  return count;
+}
 
-    if (cfg->pdsch_cfg.grant.nof_re > q->max_re) {
-      ERROR("Error too many RE per subframe (%d). PMCH configured for %d RE (%d PRB)",
-            cfg->pdsch_cfg.grant.nof_re,
-            q->max_re,
-            q->cell.nof_prb);
-      return SRSRAN_ERROR_INVALID_INPUTS;
-    }
+static int pmch_encode_tb(srsran_pmch_t* q, srsran_dl_sf_cfg_t* sf, srsran_pmch_cfg_t* cfg, uint8_t* data)
+{
+  if (cfg->pdsch_cfg.grant.tb[0].tbs == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-    INFO("Encoding PMCH SF: %d, Mod %s, NofBits: %d, NofSymbols: %d, NofBitsE: %d, rv_idx: %d",
-         sf->tti % 10,
-         srsran_mod_string(cfg->pdsch_cfg.grant.tb[0].mod),
-         cfg->pdsch_cfg.grant.tb[0].tbs,
-         cfg->pdsch_cfg.grant.nof_re,
-         cfg->pdsch_cfg.grant.tb[0].nof_bits,
-         0);
+  if (cfg->area_id >= SRSRAN_MAX_MBSFN_AREA_IDS || !q->seqs[cfg->area_id]) {
+    ERROR("Error MBSFN area ID %d is not configured", cfg->area_id);
+    return SRSRAN_ERROR;
+  }
 
-    // TODO: use tb_encode directly
-    if (srsran_dlsch_encode(&q->dl_sch, &cfg->pdsch_cfg, data, q->e)) {
-      ERROR("Error encoding TB");
-      return SRSRAN_ERROR;
+  if (cfg->pdsch_cfg.grant.nof_re > q->max_re) {
+    ERROR("Error too many RE per subframe (%d). PMCH configured for %d RE (%d PRB)",
+          cfg->pdsch_cfg.grant.nof_re,
+          q->max_re,
+          q->cell.nof_prb);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  INFO("Encoding PMCH SF: %d, Mod %s, NofBits: %d, NofSymbols: %d, NofBitsE: %d, rv_idx: %d",
+       sf->tti % 10,
+       srsran_mod_string(cfg->pdsch_cfg.grant.tb[0].mod),
+       cfg->pdsch_cfg.grant.tb[0].tbs,
+       cfg->pdsch_cfg.grant.nof_re,
+       cfg->pdsch_cfg.grant.tb[0].nof_bits,
+       0);
+
+  // TODO: use tb_encode directly
+  if (srsran_dlsch_encode(&q->dl_sch, &cfg->pdsch_cfg, data, q->e)) {
+    ERROR("Error encoding TB");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_pmch_encode_symbols(srsran_pmch_t*      q,
+                               srsran_dl_sf_cfg_t* sf,
+                               srsran_pmch_cfg_t*  cfg,
+                               uint8_t*            data,
+                               cf_t*               symbols)
+{
+  if (q == NULL || sf == NULL || cfg == NULL || symbols == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  int ret = pmch_encode_tb(q, sf, cfg, data);
+  if (ret != SRSRAN_SUCCESS) {
+    return ret;
+  }
+
+  /* scramble and modulate */
+  const srsran_modem_table_t* table = &q->mod[cfg->pdsch_cfg.grant.tb[0].mod];
+  srsran_mod_modulate_scrambled_bytes(table,
+                                      q->e,
+                                      q->seqs[cfg->area_id]->seq[sf->tti % 10].c_bytes,
+                                      0,
+                                      symbols,
+                                      cfg->pdsch_cfg.grant.tb[0].nof_bits / table->nbits_x_symbol,
+                                      1);
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_pmch_put_symbols(srsran_pmch_t*      q,
+                            srsran_dl_sf_cfg_t* sf,
+                            srsran_pmch_cfg_t*  cfg,
+                            cf_t*               symbols,
+                            cf_t*               sf_symbols[SRSRAN_MAX_PORTS])
+{
+  if (q == NULL || sf == NULL || cfg == NULL || symbols == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  for (uint32_t i = 0; i < q->cell.nof_ports; i++) {
+    if (sf_symbols[i] == NULL) {
+      return SRSRAN_ERROR_INVALID_INPUTS;
     }
+  }
 
-    /* scramble */
-    srsran_scrambling_bytes(
-        &q->seqs[cfg->area_id]->seq[sf->tti % 10], (uint8_t*)q->e, cfg->pdsch_cfg.grant.tb[0].nof_bits);
+  /* No tx diversity in MBSFN, mapping to resource elements */
+  uint32_t lstart = SRSRAN_NOF_CTRL_SYMBOLS(q->cell, sf->cfi);
+  for (uint32_t i = 0; i < q->cell.nof_ports; i++) {
+    pmch_put(q, symbols, sf_symbols[i], lstart);
+  }
 
-    srsran_mod_modulate_bytes(
-        &q->mod[cfg->pdsch_cfg.grant.tb[0].mod], (uint8_t*)q->e, q->d, cfg->pdsch_cfg.grant.tb[0].nof_bits);
+  return SRSRAN_SUCCESS;
+}
 
-    /* No tx diversity in MBSFN */
-    memcpy(q->symbols[0], q->d, cfg->pdsch_cfg.grant.nof_re * sizeof(cf_t));
+int srsran_pmch_encode(srsran_pmch_t*      q,
+                       srsran_dl_sf_cfg_t* sf,
+                       srsran_pmch_cfg_t*  cfg,
+                       uint8_t*            data,
+                       cf_t*               sf_symbols[SRSRAN_MAX_PORTS])
+{
+  if (q == NULL || sf == NULL || cfg == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-    /* mapping to resource elements */
-    uint32_t lstart = SRSRAN_NOF_CTRL_SYMBOLS(q->cell, sf->cfi);
-    for (i = 0; i < q->cell.nof_ports; i++) {
-      pmch_put(q, q->symbols[i], sf_symbols[i], lstart);
+  for (uint32_t i = 0; i < q->cell.nof_ports; i++) {
+    if (sf_symbols[i] == NULL) {
+      return SRSRAN_ERROR_INVALID_INPUTS;
     }
+  }
 
-    ret = SRSRAN_SUCCESS;
+  int ret = pmch_encode_tb(q, sf, cfg, data);
+  if (ret != SRSRAN_SUCCESS) {
+    return ret;
   }
-  return ret;
+
+  /* Scramble, modulate and map to resource elements in one pass. No tx diversity in MBSFN */
+  pmch_mod_put(q, sf, cfg, sf_symbols, SRSRAN_NOF_CTRL_SYMBOLS(q->cell, sf->cfi));
+
+  return SRSRAN_SUCCESS;
 }
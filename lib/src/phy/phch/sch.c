@@ -25,6 +25,7 @@
 #include "srsran/srsran.h"
 #include <assert.h>
 #include <math.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -167,14 +168,16 @@ int srsran_sch_init(srsran_sch_t* q)
     srsran_rm_turbo_gentables();
 
     // Allocate int16 for reception (LLRs)
-    q->cb_in = srsran_vec_u8_malloc((SRSRAN_TCOD_MAX_LEN_CB + 8) / 8);
-    if (!q->cb_in) {
-      goto clean;
-    }
+    for (uint32_t i = 0; i < SRSRAN_TCOD_MAX_PARALLEL_CB; i++) {
+      q->cb_in[i] = srsran_vec_u8_malloc((SRSRAN_TCOD_MAX_LEN_CB + 8) / 8);
+      if (!q->cb_in[i]) {
+        goto clean;
+      }
 
-    q->parity_bits = srsran_vec_u8_malloc((3 * SRSRAN_TCOD_MAX_LEN_CB + 16) / 8);
-    if (!q->parity_bits) {
-      goto clean;
+      q->parity_bits[i] = srsran_vec_u8_malloc((3 * SRSRAN_TCOD_MAX_LEN_CB + 16) / 8);
+      if (!q->parity_bits[i]) {
+        goto clean;
+      }
     }
     q->temp_g_bits = srsran_vec_u8_malloc(SCH_MAX_G_BITS);
     if (!q->temp_g_bits) {
@@ -202,11 +205,13 @@ void srsran_sch_free(srsran_sch_t* q)
 {
   srsran_rm_turbo_free_tables();
 
-  if (q->cb_in) {
-    free(q->cb_in);
-  }
-  if (q->parity_bits) {
-    free(q->parity_bits);
+  for (uint32_t i = 0; i < SRSRAN_TCOD_MAX_PARALLEL_CB; i++) {
+    if (q->cb_in[i]) {
+      free(q->cb_in[i]);
+    }
+    if (q->parity_bits[i]) {
+      free(q->parity_bits[i]);
+    }
   }
   if (q->temp_g_bits) {
     free(q->temp_g_bits);
@@ -234,6 +239,295 @@ float srsran_sch_last_noi(srsran_sch_t* q)
   return q->avg_iterations;
 }
 
+/* Code blocks of the same size, turbo encoded together by one thread */
+typedef struct {
+  uint32_t first_cb;
+  uint32_t nof_cb;
+  uint32_t cblen_idx;
+  uint32_t rlen;
+  uint32_t rp; // Position of the first code block in the transport block, in bits
+} sch_tx_group_t;
+
+/* Turbo encoding of a transport block, shared by the calling thread and the pool threads */
+typedef struct sch_tx_job_s {
+  const uint8_t*          data;
+  srsran_softbuffer_tx_t* softbuffer;
+  uint32_t                nof_cb;
+  uint32_t                tb_crc;
+  sch_tx_group_t          groups[SRSRAN_MAX_CODEBLOCKS];
+  uint32_t                nof_groups;
+  uint32_t                next_group;  // First group not taken by any thread yet, protected by the pool mutex
+  uint32_t                nof_pending; // Groups not finished yet, protected by the pool mutex
+  int                     ret;
+  struct sch_tx_job_s*    next;
+} sch_tx_job_t;
+
+/* Turbo encoder and buffers of a pool thread */
+typedef struct {
+  srsran_sch_tx_pool_t* pool;
+  srsran_tcod_t         encoder;
+  srsran_crc_t          crc_cb;
+  uint8_t*              cb_in[SRSRAN_TCOD_MAX_PARALLEL_CB];
+  uint8_t*              parity_bits[SRSRAN_TCOD_MAX_PARALLEL_CB];
+} sch_tx_ctx_t;
+
+struct srsran_sch_tx_pool_s {
+  pthread_t*      threads;
+  sch_tx_ctx_t*   ctx;
+  uint32_t        nof_ctx;
+  uint32_t        nof_threads; // Threads running
+  pthread_mutex_t mutex;
+  pthread_cond_t  cvar_job;
+  pthread_cond_t  cvar_done;
+  sch_tx_job_t*   jobs; // Jobs with groups not taken yet, oldest first
+  bool            quit;
+};
+
+/* Attaches the CRCs of a group of code blocks, turbo encodes them and collects the result in their circular buffers.
+ * Bit selection is left to the calling thread, since adjacent code blocks may share bytes of the output */
+static int sch_encode_group(srsran_tcod_t*        encoder,
+                            srsran_crc_t*         crc_cb,
+                            uint8_t**             cb_in,
+                            uint8_t**             parity_bits,
+                            const sch_tx_job_t*   job,
+                            const sch_tx_group_t* group)
+{
+  for (uint32_t j = 0; j < group->nof_cb; j++) {
+    const uint8_t* data = &job->data[(group->rp + j * group->rlen) / 8];
+
+    /* Copy data to another buffer, making space for the Codeblock CRC */
+    if (group->first_cb + j < job->nof_cb - 1) {
+      memcpy(cb_in[j], data, group->rlen / 8);
+    } else {
+      /* Append Transport Block parity bits to the last CB */
+      uint32_t len = (group->rlen - 24) / 8;
+      memcpy(cb_in[j], data, len);
+      cb_in[j][len]     = (uint8_t)(job->tb_crc >> 16);
+      cb_in[j][len + 1] = (uint8_t)(job->tb_crc >> 8);
+      cb_in[j][len + 2] = (uint8_t)job->tb_crc;
+    }
+
+    if (job->nof_cb > 1) {
+      srsran_crc_attach_byte(crc_cb, cb_in[j], group->rlen);
+    }
+  }
+
+  /* Turbo Encoding */
+  if (srsran_tcod_encode_multi(encoder, cb_in, parity_bits, group->cblen_idx, group->nof_cb) < SRSRAN_SUCCESS) {
+    ERROR("Error in turbo encoding");
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t j = 0; j < group->nof_cb; j++) {
+    srsran_rm_turbo_tx_lut_collect(
+        job->softbuffer->buffer_b[group->first_cb + j], cb_in[j], parity_bits[j], group->cblen_idx);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Takes the next group of a job. Must be called with the pool mutex locked */
+static sch_tx_job_t* sch_tx_pool_take(srsran_sch_tx_pool_t* pool, sch_tx_job_t* job, uint32_t* group_idx)
+{
+  if (job == NULL || job->next_group >= job->nof_groups) {
+    return NULL;
+  }
+
+  *group_idx = job->next_group++;
+  if (job->next_group == job->nof_groups) {
+    sch_tx_job_t** it = &pool->jobs;
+    while (*it != NULL && *it != job) {
+      it = &(*it)->next;
+    }
+    if (*it != NULL) {
+      *it = job->next;
+    }
+  }
+  return job;
+}
+
+/* Must be called with the pool mutex locked */
+static void sch_tx_pool_finish(srsran_sch_tx_pool_t* pool, sch_tx_job_t* job, int ret)
+{
+  if (ret < SRSRAN_SUCCESS) {
+    job->ret = ret;
+  }
+  if (--job->nof_pending == 0) {
+    pthread_cond_broadcast(&pool->cvar_done);
+  }
+}
+
+static void* sch_tx_pool_thread(void* arg)
+{
+  sch_tx_ctx_t*         ctx  = (sch_tx_ctx_t*)arg;
+  srsran_sch_tx_pool_t* pool = ctx->pool;
+
+  pthread_mutex_lock(&pool->mutex);
+  while (!pool->quit) {
+    uint32_t      group_idx = 0;
+    sch_tx_job_t* job       = sch_tx_pool_take(pool, pool->jobs, &group_idx);
+    if (job == NULL) {
+      pthread_cond_wait(&pool->cvar_job, &pool->mutex);
+      continue;
+    }
+    pthread_mutex_unlock(&pool->mutex);
+
+    int ret = sch_encode_group(&ctx->encoder, &ctx->crc_cb, ctx->cb_in, ctx->parity_bits, job, &job->groups[group_idx]);
+
+    pthread_mutex_lock(&pool->mutex);
+    sch_tx_pool_finish(pool, job, ret);
+  }
+  pthread_mutex_unlock(&pool->mutex);
+
+  return NULL;
+}
+
+/* Encodes all the groups of a job. With a pool, the calling thread works on its own job until no groups are left to
+ * take and then waits for the pool threads to finish theirs */
+static int sch_tx_run(srsran_sch_t* q, sch_tx_job_t* job)
+{
+  srsran_sch_tx_pool_t* pool = q->tx_pool;
+
+  if (pool == NULL || job->nof_groups < 2) {
+    for (uint32_t i = 0; i < job->nof_groups; i++) {
+      if (sch_encode_group(&q->encoder, &q->crc_cb, q->cb_in, q->parity_bits, job, &job->groups[i])) {
+        return SRSRAN_ERROR;
+      }
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  job->next_group  = 0;
+  job->nof_pending = job->nof_groups;
+  job->ret         = SRSRAN_SUCCESS;
+  job->next        = NULL;
+
+  pthread_mutex_lock(&pool->mutex);
+  sch_tx_job_t** it = &pool->jobs;
+  while (*it != NULL) {
+    it = &(*it)->next;
+  }
+  *it = job;
+  pthread_cond_broadcast(&pool->cvar_job);
+
+  uint32_t group_idx = 0;
+  while (sch_tx_pool_take(pool, job, &group_idx) != NULL) {
+    pthread_mutex_unlock(&pool->mutex);
+    int ret = sch_encode_group(&q->encoder, &q->crc_cb, q->cb_in, q->parity_bits, job, &job->groups[group_idx]);
+    pthread_mutex_lock(&pool->mutex);
+    sch_tx_pool_finish(pool, job, ret);
+  }
+  while (job->nof_pending > 0) {
+    pthread_cond_wait(&pool->cvar_done, &pool->mutex);
+  }
+  pthread_mutex_unlock(&pool->mutex);
+
+  return job->ret;
+}
+
+srsran_sch_tx_pool_t* srsran_sch_tx_pool_create(uint32_t                   nof_threads,
+                                                srsran_sch_thread_create_t create_thread,
+                                                void*                      user)
+{
+  srsran_sch_tx_pool_t* pool = calloc(1, sizeof(srsran_sch_tx_pool_t));
+  if (pool == NULL) {
+    return NULL;
+  }
+
+  pool->threads = calloc(nof_threads, sizeof(pthread_t));
+  pool->ctx     = calloc(nof_threads, sizeof(sch_tx_ctx_t));
+  if (pool->threads == NULL || pool->ctx == NULL) {
+    ERROR("Allocating FEC pool");
+    goto clean;
+  }
+  pool->nof_ctx = nof_threads;
+  pthread_mutex_init(&pool->mutex, NULL);
+  pthread_cond_init(&pool->cvar_job, NULL);
+  pthread_cond_init(&pool->cvar_done, NULL);
+
+  for (uint32_t i = 0; i < nof_threads; i++) {
+    sch_tx_ctx_t* ctx = &pool->ctx[i];
+    ctx->pool         = pool;
+    if (srsran_tcod_init(&ctx->encoder, SRSRAN_TCOD_MAX_LEN_CB) || !ctx->encoder.temp) {
+      ERROR("Error initiating Turbo Coder");
+      goto clean;
+    }
+    if (srsran_crc_init(&ctx->crc_cb, SRSRAN_LTE_CRC24B, 24)) {
+      ERROR("Error initiating CRC");
+      goto clean;
+    }
+    for (uint32_t j = 0; j < SRSRAN_TCOD_MAX_PARALLEL_CB; j++) {
+      ctx->cb_in[j]       = srsran_vec_u8_malloc((SRSRAN_TCOD_MAX_LEN_CB + 8) / 8);
+      ctx->parity_bits[j] = srsran_vec_u8_malloc((3 * SRSRAN_TCOD_MAX_LEN_CB + 16) / 8);
+      if (!ctx->cb_in[j] || !ctx->parity_bits[j]) {
+        goto clean;
+      }
+    }
+    bool created = create_thread ? create_thread(&pool->threads[i], sch_tx_pool_thread, ctx, user)
+                                 : pthread_create(&pool->threads[i], NULL, sch_tx_pool_thread, ctx) == 0;
+    if (!created) {
+      ERROR("Creating FEC pool thread");
+      goto clean;
+    }
+    pool->nof_threads++;
+  }
+
+  return pool;
+
+clean:
+  srsran_sch_tx_pool_free(pool);
+  return NULL;
+}
+
+void srsran_sch_tx_pool_free(srsran_sch_tx_pool_t* pool)
+{
+  if (pool == NULL) {
+    return;
+  }
+
+  if (pool->threads && pool->ctx) {
+    pthread_mutex_lock(&pool->mutex);
+    pool->quit = true;
+    pthread_cond_broadcast(&pool->cvar_job);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (uint32_t i = 0; i < pool->nof_threads; i++) {
+      pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&pool->cvar_done);
+    pthread_cond_destroy(&pool->cvar_job);
+    pthread_mutex_destroy(&pool->mutex);
+  }
+
+  if (pool->ctx) {
+    for (uint32_t i = 0; i < pool->nof_ctx; i++) {
+      sch_tx_ctx_t* ctx = &pool->ctx[i];
+      for (uint32_t j = 0; j < SRSRAN_TCOD_MAX_PARALLEL_CB; j++) {
+        if (ctx->cb_in[j]) {
+          free(ctx->cb_in[j]);
+        }
+        if (ctx->parity_bits[j]) {
+          free(ctx->parity_bits[j]);
+        }
+      }
+      if (ctx->encoder.temp) {
+        srsran_tcod_free(&ctx->encoder);
+      }
+    }
+    free(pool->ctx);
+  }
+  if (pool->threads) {
+    free(pool->threads);
+  }
+  free(pool);
+}
+
+void srsran_sch_set_tx_pool(srsran_sch_t* q, srsran_sch_tx_pool_t* pool)
+{
+  q->tx_pool = pool;
+}
+
 /* Encode a transport block according to 36.212 5.3.2
  *
  */
@@ -262,6 +556,11 @@ static int encode_tb_off(srsran_sch_t*           q,
       return SRSRAN_ERROR;
     }
 
+    if (cb_segm->C > SRSRAN_MAX_CODEBLOCKS) {
+      ERROR("Error number of CB to encode (%d) exceeds maximum (%d CBs)", cb_segm->C, SRSRAN_MAX_CODEBLOCKS);
+      return SRSRAN_ERROR;
+    }
+
     if (Qm == 0) {
       ERROR("Invalid Qm");
       return SRSRAN_ERROR;
@@ -274,8 +573,39 @@ static int encode_tb_off(srsran_sch_t*           q,
       gamma = Gp % cb_segm->C;
     }
 
-    /* Reset TB CRC */
-    srsran_crc_set_init(&q->crc_tb, 0);
+    /* Turbo encode and collect into the circular buffers, in groups of code blocks of the same size. Without a pool
+     * the groups fill the encoder lanes, otherwise they are spread across the threads */
+    if (data && cb_segm->C > 0) {
+      sch_tx_job_t job = {};
+      job.data         = data;
+      job.softbuffer   = softbuffer;
+      job.nof_cb       = cb_segm->C;
+
+      uint32_t nof_threads = 1 + (q->tx_pool ? q->tx_pool->nof_threads : 0);
+      uint32_t group_size  = SRSRAN_MIN(SRSRAN_TCOD_MAX_PARALLEL_CB, (cb_segm->C + nof_threads - 1) / nof_threads);
+      group_size           = SRSRAN_MAX(group_size, 1);
+
+      rp = 0;
+      i  = 0;
+      while (i < cb_segm->C) {
+        sch_tx_group_t* group = &job.groups[job.nof_groups++];
+        uint32_t        end   = (i < cb_segm->C2) ? cb_segm->C2 : cb_segm->C;
+        group->first_cb       = i;
+        group->nof_cb         = SRSRAN_MIN(group_size, end - i);
+        group->cblen_idx      = (i < cb_segm->C2) ? cb_segm->K2_idx : cb_segm->K1_idx;
+        group->rlen           = ((i < cb_segm->C2) ? cb_segm->K2 : cb_segm->K1) - ((cb_segm->C > 1) ? 24 : 0);
+        group->rp             = rp;
+        rp += group->nof_cb * group->rlen;
+        i += group->nof_cb;
+      }
+
+      /* Transport Block CRC, appended to the last CB */
+      job.tb_crc = srsran_crc_checksum_byte(&q->crc_tb, data, rp - 24);
+
+      if (sch_tx_run(q, &job)) {
+        return SRSRAN_ERROR;
+      }
+    }
 
     wp = 0;
     rp = 0;
@@ -301,44 +631,15 @@ static int encode_tb_off(srsran_sch_t*           q,
       }
 
       INFO("CB#%d: cb_len: %d, rlen: %d, wp: %d, rp: %d, E: %d", i, cb_len, rlen, wp, rp, n_e);
-
-      if (data) {
-        bool last_cb = false;
-
-        /* Copy data to another buffer, making space for the Codeblock CRC */
-        if (i < cb_segm->C - 1) {
-          // Copy data
-          memcpy(q->cb_in, &data[rp / 8], rlen * sizeof(uint8_t) / 8);
-        } else {
-          INFO("Last CB, appending parity: %d from %d and 24 to %d", rlen - 24, rp, rlen - 24);
-
-          /* Append Transport Block parity bits to the last CB */
-          memcpy(q->cb_in, &data[rp / 8], (rlen - 24) * sizeof(uint8_t) / 8);
-          last_cb = true;
-        }
-
-        /* Turbo Encoding
-         * If Codeblock CRC is required it is given the CRC instance pointer, otherwise CRC pointer shall be NULL
-         */
-        srsran_tcod_encode_lut(&q->encoder,
-                               &q->crc_tb,
-                               (cb_segm->C > 1) ? &q->crc_cb : NULL,
-                               q->cb_in,
-                               q->parity_bits,
-                               cblen_idx,
-                               last_cb);
-      }
       DEBUG("RM cblen_idx=%d, n_e=%d, wp=%d, nof_e_bits=%d", cblen_idx, n_e, wp, nof_e_bits);
 
       /* Rate matching */
-      if (srsran_rm_turbo_tx_lut(softbuffer->buffer_b[i],
-                                 q->cb_in,
-                                 q->parity_bits,
-                                 &e_bits[(wp + w_offset) / 8],
-                                 cblen_idx,
-                                 n_e,
-                                 (wp + w_offset) % 8,
-                                 rv)) {
+      if (srsran_rm_turbo_tx_lut_select(softbuffer->buffer_b[i],
+                                        &e_bits[(wp + w_offset) / 8],
+                                        cblen_idx,
+                                        n_e,
+                                        (wp + w_offset) % 8,
+                                        rv)) {
         ERROR("Error in rate matching");
         return SRSRAN_ERROR;
       }
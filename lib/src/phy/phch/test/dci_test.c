@@ -105,12 +105,62 @@ static int test_pdcch_orders()
   return SRSRAN_SUCCESS;
 }
 
+static int test_mcch_change_notif()
+{
+  srsran_cell_t cell = {
+      6,                 // nof_prb
+      1,                 // nof_ports
+      0,                 // cell_id
+      SRSRAN_CP_NORM,    // cyclic prefix
+      SRSRAN_PHICH_NORM, // PHICH length
+      SRSRAN_PHICH_R_1,  // PHICH resources
+      SRSRAN_FDD,
+  };
+  uint32_t prb_list[] = {6, 25, 50, 100};
+
+  srsran_dl_sf_cfg_t dl_sf;
+  ZERO_OBJECT(dl_sf);
+  dl_sf.cfi = 1;
+
+  for (uint32_t i = 0; i < sizeof(prb_list) / sizeof(prb_list[0]); i++) {
+    cell.nof_prb = prb_list[i];
+
+    srsran_dci_dl_t dci_tx   = {};
+    dci_tx.rnti              = SRSRAN_MRNTI;
+    dci_tx.format            = SRSRAN_DCI_FORMAT1C;
+    dci_tx.mcch_change_notif = 0x81;
+
+    // The notification has the size of format 1C, with the reserved bits set to zero
+    srsran_dci_msg_t dci_msg = {};
+    TESTASSERT(srsran_dci_msg_pack_pdsch(&cell, &dl_sf, NULL, &dci_tx, &dci_msg) == SRSRAN_SUCCESS);
+    TESTASSERT(dci_msg.nof_bits == srsran_dci_format_sizeof(&cell, &dl_sf, NULL, SRSRAN_DCI_FORMAT1C));
+    TESTASSERT(dci_msg.payload[0] == 1 && dci_msg.payload[7] == 1);
+    for (uint32_t j = 8; j < dci_msg.nof_bits; j++) {
+      TESTASSERT(dci_msg.payload[j] == 0);
+    }
+
+    srsran_dci_dl_t dci_rx = {};
+    TESTASSERT(srsran_dci_msg_unpack_pdsch(&cell, &dl_sf, NULL, &dci_msg, &dci_rx) == SRSRAN_SUCCESS);
+    TESTASSERT(dci_rx.mcch_change_notif == dci_tx.mcch_change_notif);
+
+    char str[128];
+    srsran_dci_dl_info(&dci_rx, str, sizeof(str));
+    printf("Rx %d PRB: %s\n", cell.nof_prb, str);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   if (test_pdcch_orders() != SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
+  if (test_mcch_change_notif() != SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   printf("Success!\n");
 
   return SRSRAN_SUCCESS;
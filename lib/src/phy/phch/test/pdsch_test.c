@@ -50,6 +50,7 @@ static uint16_t    rnti                         = 1234;
 static uint32_t    nof_rx_antennas              = 1;
 static bool        tb_cw_swap                   = false;
 static bool        enable_coworker              = false;
+static uint32_t    nof_fec_threads              = 0;
 static uint32_t    pmi                          = 0;
 static char*       input_file                   = NULL;
 static int         M                            = 1;
@@ -76,6 +77,7 @@ void usage(char* prog)
   printf("\t-p pmi (multiplex only)  [Default %d]\n", pmi);
   printf("\t-w Swap Transport Blocks\n");
   printf("\t-j Enable PDSCH decoder coworker\n");
+  printf("\t-e Number of threads turbo encoding in parallel with the encoder [Default %d]\n", nof_fec_threads);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
   printf("\t-q Enable/Disable 256QAM modulation (default %s)\n", enable_256qam ? "enabled" : "disabled");
 }
@@ -83,7 +85,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "fmMcsbrtRFpnqawvXxj")) != -1) {
+  while ((opt = getopt(argc, argv, "fmMcsbrtRFpnqawvXxje")) != -1) {
     switch (opt) {
       case 'f':
         input_file = argv[optind];
@@ -136,6 +138,9 @@ void parse_args(int argc, char** argv)
       case 'j':
         enable_coworker = true;
         break;
+      case 'e':
+        nof_fec_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -209,6 +214,7 @@ int main(int argc, char** argv)
   srsran_pdsch_res_t      pdsch_res[SRSRAN_MAX_CODEWORDS];
   srsran_random_t         random_gen = srsran_random_init(0x1234);
   srsran_crc_t            crc_tb;
+  srsran_sch_tx_pool_t*   fec_pool   = NULL;
 
   /* Initialise to zeros */
   ZERO_OBJECT(softbuffers_tx);
@@ -387,6 +393,15 @@ int main(int argc, char** argv)
       goto quit;
     }
 
+    if (nof_fec_threads > 0) {
+      fec_pool = srsran_sch_tx_pool_create(nof_fec_threads, NULL, NULL);
+      if (fec_pool == NULL) {
+        ERROR("Error creating FEC pool");
+        goto quit;
+      }
+      srsran_sch_set_tx_pool(&pdsch_tx.dl_sch, fec_pool);
+    }
+
     for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
       softbuffers_tx[i] = calloc(sizeof(srsran_softbuffer_tx_t), 1);
       if (!softbuffers_tx[i]) {
@@ -564,6 +579,7 @@ quit:
   srsran_chest_dl_free(&chest);
   srsran_pdsch_free(&pdsch_tx);
   srsran_pdsch_free(&pdsch_rx);
+  srsran_sch_tx_pool_free(fec_pool);
   for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
     srsran_softbuffer_tx_free(softbuffers_tx[i]);
     if (softbuffers_tx[i]) {
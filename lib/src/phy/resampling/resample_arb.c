@@ -21,8 +21,10 @@
 
 #include "srsran/phy/resampling/resample_arb.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 #include <math.h>
+#include <stdlib.h>
 #include <string.h>
 
 // clang-format off
@@ -175,3 +177,142 @@ int srsran_resample_arb_compute(srsran_resample_arb_t* q, cf_t* input, cf_t* out
   }
   return n_out;
 }
+
+// Filter taps per row of the streaming resampler coefficients, every tap is repeated for real and imaginary parts
+#define RESAMPLE_ARB_STREAM_ROW (2 * SRSRAN_RESAMPLE_ARB_M)
+
+int srsran_resample_arb_stream_init(srsran_resample_arb_stream_t* q, uint32_t up, uint32_t down)
+{
+  if (q == NULL || up == 0 || down == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Reduce the fraction, the phase spans up units
+  uint32_t a = up;
+  uint32_t b = down;
+  while (b != 0) {
+    uint32_t t = a % b;
+    a          = b;
+    b          = t;
+  }
+  q->up          = up / a;
+  q->down        = down / a;
+  q->phase_scale = (float)SRSRAN_RESAMPLE_ARB_N / (float)q->up;
+
+  // The extra last row is the first one delayed a sample, so the interpolation between the last row and the next one
+  // does not need to move the window
+  q->coeff = srsran_vec_f_malloc((SRSRAN_RESAMPLE_ARB_N + 1) * RESAMPLE_ARB_STREAM_ROW);
+  if (q->coeff == NULL) {
+    return SRSRAN_ERROR;
+  }
+  for (uint32_t i = 0; i < SRSRAN_RESAMPLE_ARB_N + 1; i++) {
+    for (uint32_t j = 0; j < SRSRAN_RESAMPLE_ARB_M; j++) {
+      float c = 0.0f;
+      if (i < SRSRAN_RESAMPLE_ARB_N) {
+        c = srsran_resample_arb_polyfilt[i][j];
+      } else if (j > 0) {
+        c = srsran_resample_arb_polyfilt[0][j - 1];
+      }
+      q->coeff[i * RESAMPLE_ARB_STREAM_ROW + 2 * j]     = c;
+      q->coeff[i * RESAMPLE_ARB_STREAM_ROW + 2 * j + 1] = c;
+    }
+  }
+
+  srsran_resample_arb_stream_reset(q);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_resample_arb_stream_reset(srsran_resample_arb_stream_t* q)
+{
+  q->phase  = 0;
+  q->offset = 0;
+  srsran_vec_cf_zero(q->hist, SRSRAN_RESAMPLE_ARB_M);
+}
+
+// Applies the filter row interpolated between the rows c0 and c1 to a window of input samples
+static inline cf_t resample_arb_stream_filter(const float* c0, const float* c1, float frac, const cf_t* x)
+{
+  const float* xf = (const float*)x;
+  float        re = 0.0f;
+  float        im = 0.0f;
+  uint32_t     i  = 0;
+
+#if SRSRAN_SIMD_F_SIZE
+  simd_f_t f   = srsran_simd_f_set1(frac);
+  simd_f_t acc = srsran_simd_f_zero();
+  for (; i < RESAMPLE_ARB_STREAM_ROW + 1 - SRSRAN_SIMD_F_SIZE; i += SRSRAN_SIMD_F_SIZE) {
+    simd_f_t a = srsran_simd_f_load(&c0[i]);
+    simd_f_t b = srsran_simd_f_load(&c1[i]);
+    simd_f_t c = srsran_simd_f_add(a, srsran_simd_f_mul(f, srsran_simd_f_sub(b, a)));
+    acc        = srsran_simd_f_add(acc, srsran_simd_f_mul(c, srsran_simd_f_loadu(&xf[i])));
+  }
+
+  float sum[SRSRAN_SIMD_F_SIZE] srsran_simd_aligned;
+  srsran_simd_f_store(sum, acc);
+  for (uint32_t j = 0; j < SRSRAN_SIMD_F_SIZE; j += 2) {
+    re += sum[j];
+    im += sum[j + 1];
+  }
+#endif /* SRSRAN_SIMD_F_SIZE */
+
+  for (; i < RESAMPLE_ARB_STREAM_ROW; i += 2) {
+    float c = c0[i] + frac * (c1[i] - c0[i]);
+    re += c * xf[i];
+    im += c * xf[i + 1];
+  }
+
+  return re + im * _Complex_I;
+}
+
+uint32_t
+srsran_resample_arb_stream_run(srsran_resample_arb_stream_t* q, const cf_t* input, cf_t* output, uint32_t n_in)
+{
+  // The windows of the first outputs start in the previous block
+  cf_t win[2 * SRSRAN_RESAMPLE_ARB_M];
+  memcpy(win, q->hist, sizeof(cf_t) * SRSRAN_RESAMPLE_ARB_M);
+  memcpy(&win[SRSRAN_RESAMPLE_ARB_M], input, sizeof(cf_t) * SRSRAN_MIN(n_in, SRSRAN_RESAMPLE_ARB_M));
+
+  uint32_t n_out = 0;
+  while (q->offset < n_in) {
+    const cf_t* x = (q->offset + 1 < SRSRAN_RESAMPLE_ARB_M) ? &win[q->offset + 1]
+                                                             : &input[q->offset + 1 - SRSRAN_RESAMPLE_ARB_M];
+
+    float    pos  = (float)q->phase * q->phase_scale;
+    uint32_t row  = SRSRAN_MIN((uint32_t)pos, SRSRAN_RESAMPLE_ARB_N - 1);
+    float    frac = pos - (float)row;
+    output[n_out++] = resample_arb_stream_filter(
+        &q->coeff[row * RESAMPLE_ARB_STREAM_ROW], &q->coeff[(row + 1) * RESAMPLE_ARB_STREAM_ROW], frac, x);
+
+    q->phase += q->down;
+    while (q->phase >= q->up) {
+      q->phase -= q->up;
+      q->offset++;
+    }
+  }
+  q->offset -= n_in;
+
+  // Keep the end of the block for the next one
+  if (n_in >= SRSRAN_RESAMPLE_ARB_M) {
+    memcpy(q->hist, &input[n_in - SRSRAN_RESAMPLE_ARB_M], sizeof(cf_t) * SRSRAN_RESAMPLE_ARB_M);
+  } else {
+    memmove(q->hist, &q->hist[n_in], sizeof(cf_t) * (SRSRAN_RESAMPLE_ARB_M - n_in));
+    memcpy(&q->hist[SRSRAN_RESAMPLE_ARB_M - n_in], input, sizeof(cf_t) * n_in);
+  }
+
+  return n_out;
+}
+
+double srsran_resample_arb_stream_next_time(const srsran_resample_arb_stream_t* q)
+{
+  // The filter rows peak SRSRAN_RESAMPLE_ARB_DELAY samples before the newest one of the window
+  return (double)q->offset + (double)q->phase / (double)q->up - SRSRAN_RESAMPLE_ARB_DELAY;
+}
+
+void srsran_resample_arb_stream_free(srsran_resample_arb_stream_t* q)
+{
+  if (q != NULL && q->coeff != NULL) {
+    free(q->coeff);
+    q->coeff = NULL;
+  }
+}
@@ -29,6 +29,83 @@
 #include "srsran/phy/resampling/resample_arb.h"
 #include "srsran/srsran.h"
 
+// Resamples a complex tone in blocks of varying size and compares it against the ideal tone at the output rate
+static int test_stream(uint32_t up, uint32_t down)
+{
+  uint32_t N      = 20000;
+  uint32_t N_out  = N * up / down + 1;
+  float    freq   = 0.2f; // Tone frequency, normalised to the input rate
+  int      ret    = 0;
+  cf_t*    in     = srsran_vec_cf_malloc(N);
+  cf_t*    out    = srsran_vec_cf_malloc(N_out);
+  cf_t*    out_1b = srsran_vec_cf_malloc(N_out);
+  if (!in || !out || !out_1b) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  for (uint32_t i = 0; i < N; i++) {
+    in[i] = cexpf(_Complex_I * 2 * M_PI * freq * i);
+  }
+
+  srsran_resample_arb_stream_t r;
+  if (srsran_resample_arb_stream_init(&r, up, down) < SRSRAN_SUCCESS) {
+    printf("Error initialising resampler\n");
+    exit(-1);
+  }
+
+  // Whole signal at once
+  uint32_t n_out_1b = srsran_resample_arb_stream_run(&r, in, out_1b, N);
+
+  // Same signal in blocks, including blocks shorter than the filter
+  srsran_resample_arb_stream_reset(&r);
+  uint32_t n_in  = 0;
+  uint32_t n_out = 0;
+  for (uint32_t len = 1; n_in < N; len = (len * 7 + 3) % 1000) {
+    len = SRSRAN_MIN(len, N - n_in);
+
+    // The next output continues the output of the previous blocks
+    double t_next = n_in + srsran_resample_arb_stream_next_time(&r);
+    if (fabs(t_next - ((double)n_out * down / up - SRSRAN_RESAMPLE_ARB_DELAY)) > 1e-6) {
+      printf("Rate %d/%d: wrong next output time %f at output %d\n", up, down, t_next, n_out);
+      ret = -1;
+    }
+    n_out += srsran_resample_arb_stream_run(&r, &in[n_in], &out[n_out], len);
+    n_in += len;
+  }
+  srsran_resample_arb_stream_free(&r);
+
+  if (n_out != n_out_1b || (uint64_t)n_out != ((uint64_t)N * up + down - 1) / down) {
+    printf("Rate %d/%d: wrong number of output samples %d/%d\n", up, down, n_out, n_out_1b);
+    ret = -1;
+  }
+
+  float max_err = 0.0f;
+  for (uint32_t i = 0; i < n_out && ret == 0; i++) {
+    if (out[i] != out_1b[i]) {
+      printf("Rate %d/%d: block output differs at sample %d\n", up, down, i);
+      ret = -1;
+    }
+
+    // Skip the filter transient
+    double t = (double)i * down / up - SRSRAN_RESAMPLE_ARB_DELAY;
+    if (t > SRSRAN_RESAMPLE_ARB_M) {
+      cf_t expected = cexpf(_Complex_I * 2 * M_PI * freq * t);
+      max_err       = SRSRAN_MAX(max_err, cabsf(out[i] - expected));
+    }
+  }
+
+  printf("Rate %d/%d: max error %.4f\n", up, down, max_err);
+  if (max_err > 0.05f) {
+    ret = -1;
+  }
+
+  free(in);
+  free(out);
+  free(out_1b);
+  return ret;
+}
+
 int main(int argc, char** argv)
 {
   int   N     = 100;  // Number of sinwave samples
@@ -76,6 +153,12 @@ int main(int argc, char** argv)
     free(out);
   }
 
+  // Fixed clocks for the LTE sampling rates, up and down
+  if (test_stream(25, 24) || test_stream(2000, 1920) || test_stream(16384, 15360) || test_stream(24, 25) ||
+      test_stream(3, 1)) {
+    exit(-1);
+  }
+
   printf("Ok\n");
   exit(0);
 }
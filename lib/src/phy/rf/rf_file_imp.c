@@ -23,6 +23,7 @@
 #include "rf_file_imp_trx.h"
 #include "rf_helper.h"
 #include <errno.h>
+#include <inttypes.h>
 #include <math.h>
 #include <srsran/phy/common/phy_common.h>
 #include <srsran/phy/common/timestamp.h>
@@ -43,6 +44,7 @@ typedef struct {
   uint32_t decim_factor; // decimation factor between base_srate used on transport on radio's rate
   double   rx_gain;
   uint32_t tx_freq_mhz[SRSRAN_MAX_CHANNELS];
+  double   tx_freq_hz[SRSRAN_MAX_CHANNELS];
   uint32_t rx_freq_mhz[SRSRAN_MAX_CHANNELS];
   bool     tx_off;
   char     id[RF_PARAM_LEN];
@@ -51,6 +53,8 @@ typedef struct {
   rf_file_tx_t transmitter[SRSRAN_MAX_CHANNELS];
   rf_file_rx_t receiver[SRSRAN_MAX_CHANNELS];
   bool         close_files;
+  char*        tx_stdio_buffer[SRSRAN_MAX_CHANNELS];
+  char         tx_sigmf_meta[SRSRAN_MAX_CHANNELS][RF_PARAM_LEN]; // SigMF metadata written on close, if not empty
 
   // Various sample buffers
   cf_t* buffer_decimation[SRSRAN_MAX_CHANNELS];
@@ -70,6 +74,7 @@ typedef struct {
  */
 
 static void update_rates(rf_file_handler_t* handler, double srate);
+static void write_sigmf_meta(rf_file_handler_t* handler, uint32_t ch);
 
 void rf_file_info(char* id, const char* format, ...)
 {
@@ -175,16 +180,29 @@ int rf_file_open_multi(char* args, void** h, uint32_t nof_channels)
 {
   int ret = SRSRAN_ERROR;
 
-  FILE* rx_files[SRSRAN_MAX_CHANNELS] = {NULL};
-  FILE* tx_files[SRSRAN_MAX_CHANNELS] = {NULL};
+  FILE* rx_files[SRSRAN_MAX_CHANNELS]                    = {NULL};
+  FILE* tx_files[SRSRAN_MAX_CHANNELS]                    = {NULL};
+  char* tx_stdio_buffer[SRSRAN_MAX_CHANNELS]             = {NULL};
+  char  tx_sigmf_meta[SRSRAN_MAX_CHANNELS][RF_PARAM_LEN] = {};
 
   if (h && nof_channels <= SRSRAN_MAX_CHANNELS) {
-    uint32_t base_srate = FILE_BASERATE_DEFAULT_HZ;
+    uint32_t         base_srate = FILE_BASERATE_DEFAULT_HZ;
+    rf_file_format_t tx_format  = FILERF_TYPE_FC32;
 
     // parse args
     if (args && strlen(args)) {
       // base_srate
       parse_uint32(args, "base_srate", -1, &base_srate);
+
+      // tx_format
+      char tx_format_str[RF_PARAM_LEN] = {};
+      parse_string(args, "tx_format", -1, tx_format_str);
+      if (strcmp(tx_format_str, "sc16") == 0) {
+        tx_format = FILERF_TYPE_SC16;
+      } else if (strlen(tx_format_str) != 0 && strcmp(tx_format_str, "fc32") != 0) {
+        fprintf(stderr, "[file] Error: unsupported tx_format %s, must be fc32 or sc16\n", tx_format_str);
+        goto clean_exit;
+      }
     } else {
       fprintf(stderr, "[file] Error: RF device args are required for file-based no-RF module\n");
       goto clean_exit;
@@ -206,6 +224,19 @@ int rf_file_open_multi(char* args, void** h, uint32_t nof_channels)
           fprintf(stderr, "[file] Error: opening tx_file%d: %s; %s\n", i, tx_file, strerror(errno));
           goto clean_exit;
         }
+
+        // Large writes keep up with faster than real time rendering
+        tx_stdio_buffer[i] = malloc(FILE_TX_STDIO_BUFFER_SIZE);
+        if (tx_stdio_buffer[i] != NULL) {
+          setvbuf(tx_files[i], tx_stdio_buffer[i], _IOFBF, FILE_TX_STDIO_BUFFER_SIZE);
+        }
+
+        // SigMF recording, the metadata file is written next to the samples on close
+        size_t len = strlen(tx_file);
+        size_t ext = strlen(FILE_SIGMF_DATA_EXT);
+        if (len > ext && strcmp(tx_file + len - ext, FILE_SIGMF_DATA_EXT) == 0) {
+          snprintf(tx_sigmf_meta[i], RF_PARAM_LEN, "%.*s%s", (int)(len - ext), tx_file, FILE_SIGMF_META_EXT);
+        }
       }
 
       // initialize receiver
@@ -227,6 +258,11 @@ int rf_file_open_multi(char* args, void** h, uint32_t nof_channels)
     // add flag to close all files when closing device
     rf_file_handler_t* handler = (rf_file_handler_t*)(*h);
     handler->close_files       = true;
+    for (int i = 0; i < nof_channels; i++) {
+      handler->transmitter[i].sample_format = tx_format;
+      handler->tx_stdio_buffer[i]           = tx_stdio_buffer[i];
+      memcpy(handler->tx_sigmf_meta[i], tx_sigmf_meta[i], RF_PARAM_LEN);
+    }
     return ret;
   }
 
@@ -238,6 +274,9 @@ clean_exit:
     if (tx_files[i] != NULL) {
       fclose(tx_files[i]);
     }
+    if (tx_stdio_buffer[i] != NULL) {
+      free(tx_stdio_buffer[i]);
+    }
   }
   return ret;
 }
@@ -387,6 +426,10 @@ int rf_file_close(void* h)
       }
       if (handler->transmitter[i].file != NULL) {
         fclose(handler->transmitter[i].file);
+        write_sigmf_meta(handler, i);
+      }
+      if (handler->tx_stdio_buffer[i] != NULL) {
+        free(handler->tx_stdio_buffer[i]);
       }
     }
   }
@@ -397,6 +440,44 @@ int rf_file_close(void* h)
   return SRSRAN_SUCCESS;
 }
 
+static void write_sigmf_meta(rf_file_handler_t* handler, uint32_t ch)
+{
+  if (strlen(handler->tx_sigmf_meta[ch]) == 0) {
+    return;
+  }
+
+  FILE* f = fopen(handler->tx_sigmf_meta[ch], "w");
+  if (f == NULL) {
+    fprintf(stderr, "[file] Error: opening %s; %s\n", handler->tx_sigmf_meta[ch], strerror(errno));
+    return;
+  }
+
+  const char* datatype = (handler->transmitter[ch].sample_format == FILERF_TYPE_SC16) ? "ci16_le" : "cf32_le";
+  fprintf(f, "{\n");
+  fprintf(f, "  \"global\": {\n");
+  fprintf(f, "    \"core:datatype\": \"%s\",\n", datatype);
+  fprintf(f, "    \"core:sample_rate\": %" PRIu32 ",\n", handler->base_srate);
+  fprintf(f, "    \"core:version\": \"1.0.0\",\n");
+  fprintf(f, "    \"core:description\": \"eNB downlink, channel %" PRIu32 "\",\n", ch);
+  fprintf(f, "    \"core:recorder\": \"srsRAN file RF\"\n");
+  fprintf(f, "  },\n");
+  fprintf(f, "  \"captures\": [\n");
+  fprintf(f, "    {\n");
+  fprintf(f, "      \"core:sample_start\": 0,\n");
+  fprintf(f, "      \"core:frequency\": %.0f\n", handler->tx_freq_hz[ch]);
+  fprintf(f, "    }\n");
+  fprintf(f, "  ],\n");
+  fprintf(f, "  \"annotations\": [\n");
+  fprintf(f, "    {\n");
+  fprintf(f, "      \"core:sample_start\": 0,\n");
+  fprintf(f, "      \"core:sample_count\": %" PRIu64 ",\n", handler->transmitter[ch].nsamples);
+  fprintf(f, "      \"core:label\": \"LTE downlink\"\n");
+  fprintf(f, "    }\n");
+  fprintf(f, "  ]\n");
+  fprintf(f, "}\n");
+  fclose(f);
+}
+
 void update_rates(rf_file_handler_t* handler, double srate)
 {
   pthread_mutex_lock(&handler->decim_mutex);
@@ -515,6 +596,7 @@ double rf_file_set_tx_freq(void* h, uint32_t ch, double freq)
     pthread_mutex_lock(&handler->tx_config_mutex);
     if (ch < handler->nof_channels && isnormal(freq) && freq > 0.0) {
       handler->tx_freq_mhz[ch] = (uint32_t)(freq / 1e6);
+      handler->tx_freq_hz[ch]  = freq;
       ret                      = freq;
     }
     pthread_mutex_unlock(&handler->tx_config_mutex);
@@ -566,7 +648,7 @@ int rf_file_recv_with_time_multi(void*    h,
         // Consider a match if the physical channel is NOT mapped and the frequency match
         if (!mapped[physical] && rf_file_rx_match_freq(&handler->receiver[physical], handler->rx_freq_mhz[logical])) {
           // Not mapped and matched frequency with receiver
-          buffers[physical] = (cf_t*)data[logical];
+          buffers[physical] = data[logical];
           mapped[physical]  = true;
           unmatched         = false;
           break;
@@ -729,15 +811,13 @@ int rf_file_send_timed(void*  h,
       h, _data, nsamples, secs, frac_secs, has_time_spec, blocking, is_start_of_burst, is_end_of_burst);
 }
 
-int rf_file_send_timed_multi(void*  h,
-                             void*  data[4],
-                             int    nsamples,
-                             time_t secs,
-                             double frac_secs,
-                             bool   has_time_spec,
-                             bool   blocking,
-                             bool   is_start_of_burst,
-                             bool   is_end_of_burst)
+static int file_send_timed_multi(void*  h,
+                                 void*  data[4],
+                                 int    nsamples,
+                                 time_t secs,
+                                 double frac_secs,
+                                 bool   has_time_spec,
+                                 bool   is_sc16)
 {
   int ret = SRSRAN_ERROR;
 
@@ -747,7 +827,7 @@ int rf_file_send_timed_multi(void*  h,
     // Map ports to data buffers according to the selected frequencies
     pthread_mutex_lock(&handler->tx_config_mutex);
     bool  mapped[SRSRAN_MAX_CHANNELS]  = {}; // Mapped mask, set to true when the physical channel is used
-    cf_t* buffers[SRSRAN_MAX_CHANNELS] = {}; // Buffer pointers, NULL if unmatched or zero transmission
+    void* buffers[SRSRAN_MAX_CHANNELS] = {}; // Buffer pointers, NULL if unmatched or zero transmission
 
     // For each logical channel...
     for (uint32_t logical = 0; logical < handler->nof_channels; logical++) {
@@ -778,6 +858,12 @@ int rf_file_send_timed_multi(void*  h,
       goto clean_exit;
     }
 
+    // The zero order hold below only takes floating point samples
+    if (is_sc16 && decim_factor != 1) {
+      fprintf(stderr, "Error: int16 samples can not be interpolated %dx\n", decim_factor);
+      goto clean_exit;
+    }
+
     rf_file_info(handler->id, "Tx %d samples (%d B)\n", nsamples, nbytes);
 
     // return if transmitter is switched off
@@ -813,8 +899,17 @@ int rf_file_send_timed_multi(void*  h,
     // Send base-band samples
     for (int i = 0; i < handler->nof_channels; i++) {
       if (buffers[i] != NULL) {
+        // int16 samples are written as they are
+        if (is_sc16) {
+          int n = rf_file_tx_baseband_sc16(&handler->transmitter[i], (int16_t*)buffers[i], nsamples_baseband);
+          if (n == SRSRAN_ERROR) {
+            goto clean_exit;
+          }
+          continue;
+        }
+
         // Select buffer pointer depending on interpolation
-        cf_t* buf = (decim_factor != 1) ? handler->buffer_tx : buffers[i];
+        cf_t* buf = (decim_factor != 1) ? handler->buffer_tx : (cf_t*)buffers[i];
 
         // Interpolate if required
         if (decim_factor != 1) {
@@ -825,7 +920,7 @@ int rf_file_send_timed_multi(void*  h,
                        nsamples_baseband);
 
           int   n   = 0;
-          cf_t* src = buffers[i];
+          cf_t* src = (cf_t*)buffers[i];
           for (int k = 0; k < nsamples; k++) {
             // perform zero order hold
             for (int j = 0; j < decim_factor; j++, n++) {
@@ -862,6 +957,52 @@ clean_exit:
   return ret;
 }
 
+int rf_file_send_timed_multi(void*  h,
+                             void*  data[4],
+                             int    nsamples,
+                             time_t secs,
+                             double frac_secs,
+                             bool   has_time_spec,
+                             bool   blocking,
+                             bool   is_start_of_burst,
+                             bool   is_end_of_burst)
+{
+  return file_send_timed_multi(h, data, nsamples, secs, frac_secs, has_time_spec, false);
+}
+
+float rf_file_get_tx_sc16_scale(void* h)
+{
+  rf_file_handler_t* handler = (rf_file_handler_t*)h;
+
+  // Samples interpolated to the file rate are held in floating point
+  pthread_mutex_lock(&handler->decim_mutex);
+  uint32_t decim_factor = handler->decim_factor;
+  pthread_mutex_unlock(&handler->decim_mutex);
+  if (decim_factor != 1) {
+    return 0.0f;
+  }
+
+  for (uint32_t i = 0; i < handler->nof_channels; i++) {
+    if (handler->transmitter[i].running && handler->transmitter[i].sample_format != FILERF_TYPE_SC16) {
+      return 0.0f;
+    }
+  }
+  return INT16_MAX;
+}
+
+int rf_file_send_timed_multi_sc16(void*  h,
+                                  void*  data[4],
+                                  int    nsamples,
+                                  time_t secs,
+                                  double frac_secs,
+                                  bool   has_time_spec,
+                                  bool   blocking,
+                                  bool   is_start_of_burst,
+                                  bool   is_end_of_burst)
+{
+  return file_send_timed_multi(h, data, nsamples, secs, frac_secs, has_time_spec, true);
+}
+
 rf_dev_t srsran_rf_dev_file = {"file",
                                rf_file_devname,
                                rf_file_start_rx_stream,
@@ -890,4 +1031,6 @@ rf_dev_t srsran_rf_dev_file = {"file",
                                rf_file_recv_with_time,
                                rf_file_recv_with_time_multi,
                                rf_file_send_timed,
-                               .srsran_rf_send_timed_multi = rf_file_send_timed_multi};
+                               .srsran_rf_send_timed_multi      = rf_file_send_timed_multi,
+                               .srsran_rf_get_tx_sc16_scale     = rf_file_get_tx_sc16_scale,
+                               .srsran_rf_send_timed_multi_sc16 = rf_file_send_timed_multi_sc16};
@@ -129,6 +129,18 @@ SRSRAN_API int rf_file_send_timed_multi(void*  h,
                                         bool   is_start_of_burst,
                                         bool   is_end_of_burst);
 
+SRSRAN_API float rf_file_get_tx_sc16_scale(void* h);
+
+SRSRAN_API int rf_file_send_timed_multi_sc16(void*  h,
+                                             void*  data[4],
+                                             int    nsamples,
+                                             time_t secs,
+                                             double frac_secs,
+                                             bool   has_time_spec,
+                                             bool   blocking,
+                                             bool   is_start_of_burst,
+                                             bool   is_end_of_burst);
+
 /**
  * @brief Dedicated function to open a file-based RF abstraction
  * @param[out] h Resulting object handle
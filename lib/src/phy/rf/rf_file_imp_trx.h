@@ -36,6 +36,9 @@
 #define FILE_MAX_BUFFER_SIZE (NSAMPLES2NBYTES(3072000)) // 10 subframes at 20 MHz
 #define FILE_TIMEOUT_MS (1000)
 #define FILE_BASERATE_DEFAULT_HZ (23040000)
+#define FILE_TX_STDIO_BUFFER_SIZE (16 * 1024 * 1024) // fewer and larger writes when rendering faster than real time
+#define FILE_SIGMF_DATA_EXT ".sigmf-data"
+#define FILE_SIGMF_META_EXT ".sigmf-meta"
 #define FILE_ID_STRLEN 16
 #define FILE_MAX_GAIN_DB (30.0f)
 #define FILE_MIN_GAIN_DB (0.0f)
@@ -93,6 +96,9 @@ SRSRAN_API int rf_file_tx_align(rf_file_tx_t* q, uint64_t ts);
 
 SRSRAN_API int rf_file_tx_baseband(rf_file_tx_t* q, cf_t* buffer, uint32_t nsamples);
 
+/* Writes interleaved int16 I/Q samples, only to files with the sc16 format */
+SRSRAN_API int rf_file_tx_baseband_sc16(rf_file_tx_t* q, int16_t* buffer, uint32_t nsamples);
+
 SRSRAN_API int rf_file_tx_get_nsamples(rf_file_tx_t* q);
 
 SRSRAN_API int rf_file_tx_zeros(rf_file_tx_t* q, uint32_t nsamples);
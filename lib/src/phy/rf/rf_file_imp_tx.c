@@ -73,18 +73,23 @@ clean_exit:
   return ret;
 }
 
-static int _rf_file_tx_baseband(rf_file_tx_t* q, cf_t* buffer, uint32_t nsamples)
+static int _rf_file_tx_baseband(rf_file_tx_t* q, void* buffer, bool is_sc16, uint32_t nsamples)
 {
   int n = SRSRAN_ERROR;
 
-  // convert samples if necessary
+  // convert floating point samples if the file takes int16 ones
   void*    buf       = (buffer) ? buffer : q->zeros;
   uint32_t sample_sz = sizeof(cf_t);
 
   if (q->sample_format == FILERF_TYPE_SC16) {
-    buf       = q->temp_buffer_convert;
+    if (buffer && !is_sc16) {
+      srsran_vec_convert_fi((float*)buf, INT16_MAX, (short*)q->temp_buffer_convert, 2 * nsamples);
+      buf = q->temp_buffer_convert;
+    }
     sample_sz = 2 * sizeof(short);
-    srsran_vec_convert_fi((float*)buffer, INT16_MAX, (short*)q->temp_buffer_convert, 2 * nsamples);
+  } else if (is_sc16) {
+    rf_file_error(q->id, "[file] Error: int16 samples can only be written with tx_format=sc16\n");
+    goto clean_exit;
   }
 
   size_t ret = fwrite(buf, (size_t)sample_sz, (size_t)nsamples, q->file);
@@ -114,7 +119,7 @@ int rf_file_tx_align(rf_file_tx_t* q, uint64_t ts)
 
   if (nsamples > 0) {
     rf_file_info(q->id, " - Detected Tx gap of %d samples.\n", nsamples);
-    _rf_file_tx_baseband(q, q->zeros, (uint32_t)nsamples);
+    _rf_file_tx_baseband(q, q->zeros, false, (uint32_t)nsamples);
   }
 
   pthread_mutex_unlock(&q->mutex);
@@ -122,32 +127,43 @@ int rf_file_tx_align(rf_file_tx_t* q, uint64_t ts)
   return (int)nsamples;
 }
 
-int rf_file_tx_baseband(rf_file_tx_t* q, cf_t* buffer, uint32_t nsamples)
+static int rf_file_tx_samples(rf_file_tx_t* q, void* buffer, bool is_sc16, uint32_t nsamples)
 {
   int n;
 
   pthread_mutex_lock(&q->mutex);
 
   if (q->sample_offset > 0) {
-    _rf_file_tx_baseband(q, q->zeros, (uint32_t)q->sample_offset);
+    _rf_file_tx_baseband(q, q->zeros, false, (uint32_t)q->sample_offset);
     q->sample_offset = 0;
   } else if (q->sample_offset < 0) {
     n = SRSRAN_MIN(-q->sample_offset, nsamples);
-    buffer += n;
+    buffer = (uint8_t*)buffer + (size_t)n * (is_sc16 ? 2 * sizeof(int16_t) : sizeof(cf_t));
     nsamples -= n;
     q->sample_offset += n;
     if (nsamples == 0) {
+      pthread_mutex_unlock(&q->mutex);
       return n;
     }
   }
 
-  n = _rf_file_tx_baseband(q, buffer, nsamples);
+  n = _rf_file_tx_baseband(q, buffer, is_sc16, nsamples);
 
   pthread_mutex_unlock(&q->mutex);
 
   return n;
 }
 
+int rf_file_tx_baseband(rf_file_tx_t* q, cf_t* buffer, uint32_t nsamples)
+{
+  return rf_file_tx_samples(q, buffer, false, nsamples);
+}
+
+int rf_file_tx_baseband_sc16(rf_file_tx_t* q, int16_t* buffer, uint32_t nsamples)
+{
+  return rf_file_tx_samples(q, buffer, true, nsamples);
+}
+
 int rf_file_tx_get_nsamples(rf_file_tx_t* q)
 {
   pthread_mutex_lock(&q->mutex);
@@ -161,7 +177,7 @@ int rf_file_tx_zeros(rf_file_tx_t* q, uint32_t nsamples)
   pthread_mutex_lock(&q->mutex);
 
   rf_file_info(q->id, " - Tx %d Zeros.\n", nsamples);
-  _rf_file_tx_baseband(q, q->zeros, (uint32_t)nsamples);
+  _rf_file_tx_baseband(q, q->zeros, false, (uint32_t)nsamples);
 
   pthread_mutex_unlock(&q->mutex);
 
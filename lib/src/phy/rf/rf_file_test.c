@@ -24,6 +24,7 @@
 #include "srsran/phy/common/timestamp.h"
 #include "srsran/phy/utils/debug.h"
 #include <complex.h>
+#include <math.h>
 #include <pthread.h>
 #include <srsran/phy/common/phy_common.h>
 #include <srsran/phy/utils/vector.h>
@@ -231,6 +232,101 @@ int param_test(const char* args_param, const int num_channels)
   return SRSRAN_SUCCESS;
 }
 
+int sigmf_test()
+{
+  char rf_args[RF_PARAM_LEN] = "tx_file=tx_file0.sigmf-data,tx_format=sc16,base_srate=1.92e6";
+
+  printf("opening tx device with args=%s\n", rf_args);
+  if (srsran_rf_open_devname(&enb_radio, "file", rf_args, 1)) {
+    fprintf(stderr, "Error opening rf\n");
+    return SRSRAN_ERROR;
+  }
+  srsran_rf_set_tx_freq(&enb_radio, 0, 2.6e9);
+
+  for (uint32_t i = 0; i < SF_LEN; i++) {
+    enb_tx_buffer[0][i] = (2.0f * rand() / RAND_MAX - 1.0f) + _Complex_I * (2.0f * rand() / RAND_MAX - 1.0f);
+  }
+
+  // The device takes int16 samples at full scale as well, every other subframe is sent already converted
+  if (srsran_rf_get_tx_sc16_scale(&enb_radio) != INT16_MAX) {
+    fprintf(stderr, "Unexpected int16 scale %.1f\n", srsran_rf_get_tx_sc16_scale(&enb_radio));
+    return SRSRAN_ERROR;
+  }
+  static int16_t tx_sc16[2 * SF_LEN];
+  srsran_vec_convert_fi((float*)enb_tx_buffer[0], INT16_MAX, tx_sc16, 2 * SF_LEN);
+
+  void* data_ptr[SRSRAN_MAX_PORTS]      = {enb_tx_buffer[0]};
+  void* data_sc16_ptr[SRSRAN_MAX_PORTS] = {tx_sc16};
+  for (uint32_t i = 0; i < 10; ++i) {
+    int ret = SRSRAN_ERROR;
+    if (i % 2) {
+      ret = srsran_rf_send_timed_multi_sc16(&enb_radio, data_sc16_ptr, SF_LEN, 0, i * 1e-3, true, false, false);
+    } else {
+      ret = srsran_rf_send_multi(&enb_radio, data_ptr, SF_LEN, true, true, false);
+    }
+    if (ret != SRSRAN_SUCCESS) {
+      fprintf(stderr, "Error sending data\n");
+      return SRSRAN_ERROR;
+    }
+  }
+  srsran_rf_close(&enb_radio);
+
+  // 16-bit I/Q samples, the transmitted ones scaled to full scale
+  FILE* f = fopen("tx_file0.sigmf-data", "rb");
+  if (f == NULL) {
+    return SRSRAN_ERROR;
+  }
+  fseek(f, 0, SEEK_END);
+  long data_size = ftell(f);
+  if (data_size != 10 * SF_LEN * 2 * sizeof(int16_t)) {
+    fprintf(stderr, "Unexpected SigMF data size %ld\n", data_size);
+    fclose(f);
+    return SRSRAN_ERROR;
+  }
+  fseek(f, 0, SEEK_SET);
+  for (uint32_t sf = 0; sf < 10; sf++) {
+    int16_t samples[2 * SF_LEN];
+    if (fread(samples, 2 * sizeof(int16_t), SF_LEN, f) != SF_LEN) {
+      fprintf(stderr, "Error reading SigMF data\n");
+      fclose(f);
+      return SRSRAN_ERROR;
+    }
+    const float* expected = (const float*)enb_tx_buffer[0];
+    for (uint32_t i = 0; i < 2 * SF_LEN; i++) {
+      if (fabsf(expected[i] * INT16_MAX - samples[i]) > 1.0f) {
+        fprintf(
+            stderr, "Unexpected SigMF sample %d of sf %d: %d != %.1f\n", i, sf, samples[i], expected[i] * INT16_MAX);
+        fclose(f);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+  fclose(f);
+
+  // Metadata describing them
+  char meta[2048] = {};
+  f               = fopen("tx_file0.sigmf-meta", "r");
+  if (f == NULL) {
+    fprintf(stderr, "SigMF metadata not written\n");
+    return SRSRAN_ERROR;
+  }
+  size_t meta_size = fread(meta, 1, sizeof(meta) - 1, f);
+  fclose(f);
+  meta[meta_size] = '\0';
+  if (strstr(meta, "\"core:datatype\": \"ci16_le\"") == NULL ||
+      strstr(meta, "\"core:sample_rate\": 1920000,") == NULL ||
+      strstr(meta, "\"core:frequency\": 2600000000") == NULL ||
+      strstr(meta, "\"core:sample_count\": 19200,") == NULL) {
+    fprintf(stderr, "Unexpected SigMF metadata:\n%s\n", meta);
+    return SRSRAN_ERROR;
+  }
+
+  remove("tx_file0.sigmf-data");
+  remove("tx_file0.sigmf-meta");
+
+  return SRSRAN_SUCCESS;
+}
+
 void create_file(const char* filename)
 {
   FILE* f = fopen(filename, "w");
@@ -320,6 +416,12 @@ int main()
     return -1;
   }
 
+  // single tx in 16-bit samples with SigMF metadata
+  if (sigmf_test() != SRSRAN_SUCCESS) {
+    fprintf(stderr, "SigMF test failed!\n");
+    return -1;
+  }
+
   // clean workspace
   remove_file("rx_file0");
   remove_file("rx_file1");
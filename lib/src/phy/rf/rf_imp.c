@@ -374,6 +374,33 @@ int srsran_rf_send_multi(srsran_rf_t* rf,
           rf->handler, data, nsamples, 0, 0, false, blocking, is_start_of_burst, is_end_of_burst);
 }
 
+float srsran_rf_get_tx_sc16_scale(srsran_rf_t* rf)
+{
+  if (((rf_dev_t*)rf->dev)->srsran_rf_get_tx_sc16_scale == NULL ||
+      ((rf_dev_t*)rf->dev)->srsran_rf_send_timed_multi_sc16 == NULL) {
+    return 0.0f;
+  }
+  return ((rf_dev_t*)rf->dev)->srsran_rf_get_tx_sc16_scale(rf->handler);
+}
+
+int srsran_rf_send_timed_multi_sc16(srsran_rf_t* rf,
+                                    void**       data,
+                                    int          nsamples,
+                                    time_t       secs,
+                                    double       frac_secs,
+                                    bool         blocking,
+                                    bool         is_start_of_burst,
+                                    bool         is_end_of_burst)
+{
+  if (((rf_dev_t*)rf->dev)->srsran_rf_send_timed_multi_sc16 == NULL) {
+    ERROR("RF device %s does not take int16 samples", srsran_rf_name(rf));
+    return SRSRAN_ERROR;
+  }
+  return ((rf_dev_t*)rf->dev)
+      ->srsran_rf_send_timed_multi_sc16(
+          rf->handler, data, nsamples, secs, frac_secs, true, blocking, is_start_of_burst, is_end_of_burst);
+}
+
 int srsran_rf_send(srsran_rf_t* rf, void* data, uint32_t nsamples, bool blocking)
 {
   return srsran_rf_send2(rf, data, nsamples, blocking, true, true);
@@ -47,6 +47,8 @@
 #define PRINT_RX_STATS 0
 #define PRINT_TX_STATS 0
 
+#define SOAPY_TX_CS16_BUFFER_LEN (64 * 1024)
+
 typedef struct {
   char*            devname;
   SoapySDRKwargs   args;
@@ -62,6 +64,10 @@ typedef struct {
   size_t           num_rx_channels;
   size_t           num_tx_channels;
 
+  bool     tx_cs16;                          ///< Tx stream uses the CS16 format, converted by srsran_vec_convert_fi
+  float    tx_cs16_scale;                    ///< Device full scale, maps a float amplitude of 1.0 to int16
+  int16_t* tx_buffer_cs16[SRSRAN_MAX_PORTS]; ///< Interleaved I/Q of up to SOAPY_TX_CS16_BUFFER_LEN samples
+
   srsran_rf_error_handler_t soapy_error_handler;
   void*                     soapy_error_handler_arg;
 
@@ -359,6 +365,23 @@ int rf_soapy_open_multi(char* args, void** h, uint32_t num_requested_channels)
   handler->rx_stream_active = false;
   handler->devname          = DEVNAME_SOAPY;
 
+  // Tx stream format, CS16 converts the samples here instead of in the Soapy module
+  if (args) {
+    const char tx_format_arg[]   = "txformat=";
+    char       tx_format_str[64] = {0};
+    char*      tx_format_ptr     = strstr(args, tx_format_arg);
+    if (tx_format_ptr) {
+      copy_subdev_string(tx_format_str, tx_format_ptr + strlen(tx_format_arg));
+      if (strcasecmp(tx_format_str, SOAPY_SDR_CS16) == 0) {
+        handler->tx_cs16 = true;
+      } else if (strcasecmp(tx_format_str, SOAPY_SDR_CF32) != 0) {
+        ERROR("Unsupported Tx format %s. Using %s.", tx_format_str, SOAPY_SDR_CF32);
+      }
+      remove_substring(args, tx_format_arg);
+      remove_substring(args, tx_format_str);
+    }
+  }
+
   // create stream args from device args
   SoapySDRKwargs stream_args = {};
 #if SOAPY_SDR_API_VERSION >= 0x00060000
@@ -401,18 +424,38 @@ int rf_soapy_open_multi(char* args, void** h, uint32_t num_requested_channels)
     for (int i = 0; i < handler->num_tx_channels; i++) {
       tx_channels[i] = i;
     }
+    const char* tx_format = SOAPY_SDR_CF32;
+    if (handler->tx_cs16) {
+      // The full scale of the native format is the largest int16 value the device takes
+      double      full_scale    = 0.0;
+      char*       native_format = SoapySDRDevice_getNativeStreamFormat(handler->device, SOAPY_SDR_TX, 0, &full_scale);
+      tx_format                 = SOAPY_SDR_CS16;
+      handler->tx_cs16_scale    = (full_scale > 0.0 && full_scale <= INT16_MAX) ? (float)full_scale : INT16_MAX;
+      printf("Tx native format %s, converting to %s with full scale %.0f\n",
+             native_format,
+             tx_format,
+             handler->tx_cs16_scale);
+      free(native_format);
+      for (int i = 0; i < handler->num_tx_channels; i++) {
+        handler->tx_buffer_cs16[i] = srsran_vec_i16_malloc(2 * SOAPY_TX_CS16_BUFFER_LEN);
+        if (handler->tx_buffer_cs16[i] == NULL) {
+          ERROR("Error allocating Tx CS16 buffer");
+          return SRSRAN_ERROR;
+        }
+      }
+    }
     printf("Setting up Tx stream with %zd channel(s)\n", handler->num_tx_channels);
 #if SOAPY_SDR_API_VERSION < 0x00080000
     if (SoapySDRDevice_setupStream(handler->device,
                                    &handler->txStream,
                                    SOAPY_SDR_TX,
-                                   SOAPY_SDR_CF32,
+                                   tx_format,
                                    tx_channels,
                                    handler->num_tx_channels,
                                    &stream_args) != 0) {
 #else
     handler->txStream = SoapySDRDevice_setupStream(
-        handler->device, SOAPY_SDR_TX, SOAPY_SDR_CF32, tx_channels, handler->num_tx_channels, &stream_args);
+        handler->device, SOAPY_SDR_TX, tx_format, tx_channels, handler->num_tx_channels, &stream_args);
     if (handler->txStream == NULL) {
 #endif
       printf("Tx setupStream fail: %s\n", SoapySDRDevice_lastError());
@@ -585,6 +628,12 @@ int rf_soapy_close(void* h)
 
   SoapySDRDevice_unmake(handler->device);
 
+  for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    if (handler->tx_buffer_cs16[i]) {
+      free(handler->tx_buffer_cs16[i]);
+    }
+  }
+
   // print statistics
   if (handler->num_lates)
     printf("#lates=%d\n", handler->num_lates);
@@ -883,15 +932,16 @@ int rf_soapy_send_timed(void*  h,
 }
 
 // Todo: Check correct handling of flags, use RF metrics API, fix timed transmissions
-int rf_soapy_send_timed_multi(void*  h,
-                              void*  data[SRSRAN_MAX_PORTS],
-                              int    nsamples,
-                              time_t secs,
-                              double frac_secs,
-                              bool   has_time_spec,
-                              bool   blocking,
-                              bool   is_start_of_burst,
-                              bool   is_end_of_burst)
+static int soapy_send_timed_multi(void*  h,
+                                  void*  data[SRSRAN_MAX_PORTS],
+                                  int    nsamples,
+                                  time_t secs,
+                                  double frac_secs,
+                                  bool   has_time_spec,
+                                  bool   blocking,
+                                  bool   is_start_of_burst,
+                                  bool   is_end_of_burst,
+                                  bool   is_sc16)
 {
   rf_soapy_handler_t* handler   = (rf_soapy_handler_t*)h;
   int                 flags     = 0;
@@ -924,6 +974,9 @@ int rf_soapy_send_timed_multi(void*  h,
       tx_samples = nsamples - n;
     }
 #endif
+    if (handler->tx_cs16 && !is_sc16) {
+      tx_samples = SRSRAN_MIN(tx_samples, SOAPY_TX_CS16_BUFFER_LEN);
+    }
 
     // (re-)set stream flags
     flags = 0;
@@ -948,6 +1001,15 @@ int rf_soapy_send_timed_multi(void*  h,
     for (int i = 0; i < handler->num_tx_channels; i++) {
       cf_t* data_c = data[i] ? data[i] : zero_mem;
       buffs_ptr[i] = &data_c[n];
+
+      // The caller already scaled and converted int16 samples, floating point ones are scaled to the device full scale
+      // and saturated in a single vectorized pass
+      if (is_sc16) {
+        buffs_ptr[i] = &((int16_t*)data_c)[2 * n];
+      } else if (handler->tx_cs16) {
+        srsran_vec_convert_fi((float*)&data_c[n], handler->tx_cs16_scale, handler->tx_buffer_cs16[i], 2 * tx_samples);
+        buffs_ptr[i] = handler->tx_buffer_cs16[i];
+      }
     }
 
     ret = SoapySDRDevice_writeStream(
@@ -1005,6 +1067,45 @@ int rf_soapy_send_timed_multi(void*  h,
   return n;
 }
 
+int rf_soapy_send_timed_multi(void*  h,
+                              void*  data[SRSRAN_MAX_PORTS],
+                              int    nsamples,
+                              time_t secs,
+                              double frac_secs,
+                              bool   has_time_spec,
+                              bool   blocking,
+                              bool   is_start_of_burst,
+                              bool   is_end_of_burst)
+{
+  return soapy_send_timed_multi(
+      h, data, nsamples, secs, frac_secs, has_time_spec, blocking, is_start_of_burst, is_end_of_burst, false);
+}
+
+float rf_soapy_get_tx_sc16_scale(void* h)
+{
+  rf_soapy_handler_t* handler = (rf_soapy_handler_t*)h;
+  return handler->tx_cs16 ? handler->tx_cs16_scale : 0.0f;
+}
+
+int rf_soapy_send_timed_multi_sc16(void*  h,
+                                   void*  data[SRSRAN_MAX_PORTS],
+                                   int    nsamples,
+                                   time_t secs,
+                                   double frac_secs,
+                                   bool   has_time_spec,
+                                   bool   blocking,
+                                   bool   is_start_of_burst,
+                                   bool   is_end_of_burst)
+{
+  rf_soapy_handler_t* handler = (rf_soapy_handler_t*)h;
+  if (!handler->tx_cs16) {
+    ERROR("The Tx stream takes int16 samples only with txformat=CS16");
+    return SRSRAN_ERROR;
+  }
+  return soapy_send_timed_multi(
+      h, data, nsamples, secs, frac_secs, has_time_spec, blocking, is_start_of_burst, is_end_of_burst, true);
+}
+
 rf_dev_t srsran_rf_dev_soapy = {"soapy",
                                 rf_soapy_devname,
                                 rf_soapy_start_rx_stream,
@@ -1033,7 +1134,9 @@ rf_dev_t srsran_rf_dev_soapy = {"soapy",
                                 rf_soapy_recv_with_time,
                                 rf_soapy_recv_with_time_multi,
                                 rf_soapy_send_timed,
-                                .srsran_rf_send_timed_multi = rf_soapy_send_timed_multi};
+                                .srsran_rf_send_timed_multi      = rf_soapy_send_timed_multi,
+                                .srsran_rf_get_tx_sc16_scale     = rf_soapy_get_tx_sc16_scale,
+                                .srsran_rf_send_timed_multi_sc16 = rf_soapy_send_timed_multi_sc16};
 
 #ifdef ENABLE_RF_PLUGINS
 int register_plugin(rf_dev_t** rf_api)
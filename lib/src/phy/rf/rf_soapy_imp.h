@@ -111,4 +111,16 @@ int rf_soapy_send_timed_multi(void*  h,
                               bool   is_start_of_burst,
                               bool   is_end_of_burst);
 
+float rf_soapy_get_tx_sc16_scale(void* h);
+
+int rf_soapy_send_timed_multi_sc16(void*  h,
+                                   void*  data[4],
+                                   int    nsamples,
+                                   time_t secs,
+                                   double frac_secs,
+                                   bool   has_time_spec,
+                                   bool   blocking,
+                                   bool   is_start_of_burst,
+                                   bool   is_end_of_burst);
+
 #endif /* SRSRAN_RF_SOAPY_IMP_H_ */
@@ -442,19 +442,29 @@ TEST(
 TEST(
     srsran_vec_convert_fi, MALLOC(float, x); MALLOC(short, z); float scale = 1000.0f;
 
+    // Some of the inputs exceed the int16 range once scaled and must saturate
     short gold;
-    for (int i = 0; i < block_size; i++) { x[i] = (float)RANDOM_F(); }
+    for (int i = 0; i < block_size; i++) { x[i] = (float)RANDOM_F() * 40.0f; }
 
     TEST_CALL(srsran_vec_convert_fi(x, scale, z, block_size))
 
         for (int i = 0; i < block_size; i++) {
-          gold       = (short)((x[i] * scale));
+          gold       = (short)SRSRAN_MAX(SRSRAN_MIN(x[i] * scale, INT16_MAX), INT16_MIN);
           double err = fabsf((float)gold - (float)z[i]);
           if (err > mse) {
             mse = err;
           }
         }
 
+    // In place, the result must not differ from the one above
+    srsran_vec_convert_fi(x, scale, (int16_t*)x, block_size);
+    for (int i = 0; i < block_size; i++) {
+      double err = fabsf((float)((int16_t*)x)[i] - (float)z[i]);
+      if (err > mse) {
+        mse = err;
+      }
+    }
+
     free(x);
     free(z);)
 
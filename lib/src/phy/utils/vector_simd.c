@@ -27,6 +27,14 @@
 #include <stdlib.h>
 #include <string.h>
 
+// Name the kernels after the instruction set of this build when they are dispatched at runtime
+#ifdef SRSRAN_SIMD_DISPATCH
+#ifndef SRSRAN_VEC_SIMD_ISA
+#define SRSRAN_VEC_SIMD_ISA generic
+#endif /* SRSRAN_VEC_SIMD_ISA */
+#include "vector_simd_isa.h"
+#endif /* SRSRAN_SIMD_DISPATCH */
+
 #include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector_simd.h"
 
@@ -466,8 +474,9 @@ void srsran_vec_convert_fi_simd(const float* x, int16_t* z, const float scale, c
   }
 #endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE */
 
+  // Saturate like the packing above
   for (; i < len; i++) {
-    z[i] = (int16_t)(x[i] * scale);
+    z[i] = (int16_t)fmaxf(fminf(x[i] * scale, INT16_MAX), INT16_MIN);
   }
 }
 
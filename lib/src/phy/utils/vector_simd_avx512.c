@@ -0,0 +1,29 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * AVX512 build of the vector kernels, selected at runtime on CPUs that support it. It is empty unless the kernels are
+ * dispatched at runtime (ENABLE_SIMD_DISPATCH).
+ */
+#ifdef SRSRAN_SIMD_DISPATCH
+#define SRSRAN_VEC_SIMD_ISA avx512
+#include "vector_simd.c"
+#endif /* SRSRAN_SIMD_DISPATCH */
@@ -0,0 +1,89 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/vector_simd.h"
+#include "srsran/phy/utils/simd.h"
+
+#ifdef SRSRAN_SIMD_DISPATCH
+#include "vector_simd_isa.h"
+
+typedef enum { VEC_SIMD_ISA_GENERIC = 0, VEC_SIMD_ISA_AVX2, VEC_SIMD_ISA_AVX512 } vec_simd_isa_t;
+
+// Picks the widest build of the kernels the CPU can run. It is called by the ifunc resolvers, before any constructor,
+// so it initialises the CPU feature detection itself
+static vec_simd_isa_t vec_simd_isa(void)
+{
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512cd") && __builtin_cpu_supports("avx512bw") &&
+      __builtin_cpu_supports("avx512dq")) {
+    return VEC_SIMD_ISA_AVX512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return VEC_SIMD_ISA_AVX2;
+  }
+  return VEC_SIMD_ISA_GENERIC;
+}
+
+// Every kernel resolves to one of its builds when the library is loaded, so calls are as cheap as to any other function
+#define VEC_SIMD_DISPATCH(NAME)                                                                                        \
+  extern __typeof__(NAME) NAME##_generic, NAME##_avx2, NAME##_avx512;                                                  \
+  static __typeof__(NAME)* NAME##_resolve(void)                                                                        \
+  {                                                                                                                    \
+    switch (vec_simd_isa()) {                                                                                          \
+      case VEC_SIMD_ISA_AVX512:                                                                                        \
+        return NAME##_avx512;                                                                                          \
+      case VEC_SIMD_ISA_AVX2:                                                                                          \
+        return NAME##_avx2;                                                                                            \
+      default:                                                                                                         \
+        return NAME##_generic;                                                                                         \
+    }                                                                                                                  \
+  }                                                                                                                    \
+  __typeof__(NAME) NAME __attribute__((ifunc(#NAME "_resolve")));
+
+SRSRAN_VEC_SIMD_FUNCTIONS(VEC_SIMD_DISPATCH)
+SRSRAN_VEC_SIMD_FUNCTIONS_C16(VEC_SIMD_DISPATCH)
+
+const char* srsran_vec_simd_isa_name(void)
+{
+  static const char* names[] = {"sse4.1", "avx2", "avx512"};
+  return names[vec_simd_isa()];
+}
+
+#else /* SRSRAN_SIMD_DISPATCH */
+
+const char* srsran_vec_simd_isa_name(void)
+{
+#if defined(LV_HAVE_AVX512)
+  return "avx512";
+#elif defined(LV_HAVE_AVX2)
+  return "avx2";
+#elif defined(LV_HAVE_AVX)
+  return "avx";
+#elif defined(LV_HAVE_SSE)
+  return "sse4.1";
+#elif defined(HAVE_NEON)
+  return "neon";
+#else
+  return "none";
+#endif
+}
+
+#endif /* SRSRAN_SIMD_DISPATCH */
@@ -40,6 +40,8 @@ radio::radio()
 
 radio::~radio()
 {
+  stop_tx_fifo();
+
   for (srsran_resampler_fft_t& q : interpolators) {
     srsran_resampler_fft_free(&q);
   }
@@ -47,6 +49,10 @@ radio::~radio()
   for (srsran_resampler_fft_t& q : decimators) {
     srsran_resampler_fft_free(&q);
   }
+
+  for (srsran_resample_arb_stream_t& q : tx_resamplers) {
+    srsran_resample_arb_stream_free(&q);
+  }
 }
 
 int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
@@ -222,6 +228,15 @@ int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
   // Frequency offset
   freq_offset = args.freq_offset;
 
+  // Decouple the PHY workers from the devices, a dedicated thread streams the queued subframes
+  if (args.tx_fifo_ms > 0) {
+    tx_fifo.init(args.tx_fifo_ms, nof_channels, SRSRAN_SF_LEN_MAX);
+    tx_fifo_running = true;
+    if (not tx_thread.start(0)) {
+      logger.warning("Tx FIFO thread could not get real-time priority");
+    }
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -232,6 +247,9 @@ bool radio::is_init()
 
 void radio::stop()
 {
+  // No more transmissions once the devices are closed
+  stop_tx_fifo();
+
   // Stop Rx streams as soon as possible to avoid Overflows
   if (radio_is_streaming) {
     for (srsran_rf_t& rf_device : rf_devices) {
@@ -360,6 +378,19 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
   return ret;
 }
 
+bool radio::get_time(rf_timestamp_interface& now)
+{
+  if (!is_initialized) {
+    return false;
+  }
+
+  for (uint32_t device_idx = 0; device_idx < (uint32_t)rf_devices.size(); device_idx++) {
+    srsran_timestamp_t* t = now.get_ptr(device_idx);
+    srsran_rf_get_time(&rf_devices[device_idx], &t->full_secs, &t->frac_secs);
+  }
+  return true;
+}
+
 bool radio::rx_dev(const uint32_t& device_idx, const rf_buffer_interface& buffer, srsran_timestamp_t* rxd_time)
 {
   if (!is_initialized) {
@@ -418,11 +449,87 @@ bool radio::rx_dev(const uint32_t& device_idx, const rf_buffer_interface& buffer
 }
 
 bool radio::tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_time)
+{
+  if (tx_fifo.capacity() == 0) {
+    return tx_now(buffer, tx_time);
+  }
+
+  // Stopped radio
+  if (not tx_fifo_running) {
+    return false;
+  }
+
+  if (buffer.get_nof_samples() > tx_fifo.get_max_samples()) {
+    logger.error("Tx FIFO truncates %d samples to %d", buffer.get_nof_samples(), tx_fifo.get_max_samples());
+  }
+
+  // The workers never wait for the devices, a full FIFO means the devices are not keeping up
+  if (not tx_fifo.push(buffer, tx_time)) {
+    logger.warning("Tx FIFO full, dropping %d samples", buffer.get_nof_samples());
+    std::lock_guard<std::mutex> lock(metrics_mutex);
+    rf_metrics.tx_fifo_drop++;
+    return false;
+  }
+
+  return true;
+}
+
+void radio::run_tx_fifo()
+{
+  while (tx_fifo_running) {
+    rf_tx_fifo::slot_t* slot = tx_fifo.front();
+    if (slot == nullptr) {
+      continue;
+    }
+
+    // The subframes queued, including this one, are the margin left to the workers before the device underruns
+    uint32_t depth = tx_fifo.size();
+    {
+      std::lock_guard<std::mutex> lock(metrics_mutex);
+      if (rf_metrics.tx_fifo_max_depth == 0 or depth < rf_metrics.tx_fifo_min_depth) {
+        rf_metrics.tx_fifo_min_depth = depth;
+      }
+      rf_metrics.tx_fifo_max_depth = std::max(rf_metrics.tx_fifo_max_depth, depth);
+    }
+
+    if (slot->end_of_burst) {
+      std::unique_lock<std::mutex> lock(tx_mutex);
+      tx_end_nolock();
+    } else {
+      cf_t* ptr[SRSRAN_MAX_CHANNELS] = {};
+      for (uint32_t ch = 0; ch < SRSRAN_MAX_CHANNELS; ch++) {
+        ptr[ch] = slot->present[ch] ? slot->samples[ch].data() : nullptr;
+      }
+      rf_buffer_t buffer(ptr, slot->nof_samples);
+      buffer.set_sc16(slot->sc16);
+      tx_now(buffer, slot->tx_time);
+    }
+
+    tx_fifo.pop();
+  }
+}
+
+void radio::stop_tx_fifo()
+{
+  if (tx_fifo_running) {
+    tx_fifo_running = false;
+    tx_fifo.wake_up();
+    tx_thread.wait_thread_finish();
+  }
+}
+
+bool radio::tx_now(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_time)
 {
   bool                         ret = true;
   std::unique_lock<std::mutex> lock(tx_mutex);
   uint32_t                     ratio = interpolators[0].ratio;
 
+  // int16 samples are only passed through to the devices
+  if (buffer.is_sc16() and (ratio > 1 or tx_resample_arb)) {
+    logger.error("Tx int16 samples can not be resampled, dropping %d samples", buffer.get_nof_samples());
+    return false;
+  }
+
   // Get number of samples at the low rate
   uint32_t nof_samples = buffer.get_nof_samples();
 
@@ -456,8 +563,49 @@ bool radio::tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_tim
     buffer.set_nof_samples(nof_samples * ratio);
   }
 
+  // The first resampled sample is not aligned with the first one of the buffer, shift the timestamp accordingly
+  double tx_time_offset = 0.0;
+  if (tx_resample_arb) {
+    // The resampler continues the stream of the previous buffer, unless this one does not follow it within half an input
+    // sample
+    srsran_timestamp_t tx_jump = tx_time.get(0);
+    srsran_timestamp_sub(&tx_jump, tx_resample_end.full_secs, tx_resample_end.frac_secs);
+    if (is_start_of_burst or std::abs(srsran_timestamp_real(&tx_jump)) * tx_resample_srate > 0.5) {
+      if (not is_start_of_burst) {
+        logger.info("Tx time jumped by %.1f us, restarting the Tx resampler", srsran_timestamp_real(&tx_jump) * 1.0e6);
+      }
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resample_arb_stream_reset(&tx_resamplers[ch]);
+      }
+    }
+    tx_time_offset = srsran_resample_arb_stream_next_time(&tx_resamplers[0]) / tx_resample_srate;
+
+    // Limit number of samples to the buffer size, resampling adds one sample at most
+    uint32_t max_samples = (uint32_t)((tx_buffer[0].size() - 1) * tx_resample_srate / cur_tx_srate);
+    if (nof_samples > max_samples) {
+      logger.info("Tx number of samples (%d) exceeds resampler buffer size, limited to %d", nof_samples, max_samples);
+      nof_samples = max_samples;
+    }
+    tx_resample_end = tx_time.get(0);
+    srsran_timestamp_add(&tx_resample_end, 0, nof_samples / tx_resample_srate);
+
+    uint32_t nof_resampled = 0;
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      nof_resampled =
+          srsran_resample_arb_stream_run(&tx_resamplers[ch], buffer.get(ch), tx_buffer[ch].data(), nof_samples);
+      buffer.set(ch, tx_buffer[ch].data());
+    }
+    buffer.set_nof_samples(nof_resampled);
+  }
+
   for (uint32_t device_idx = 0; device_idx < (uint32_t)rf_devices.size(); device_idx++) {
-    ret &= tx_dev(device_idx, buffer, tx_time.get(device_idx));
+    srsran_timestamp_t device_tx_time = tx_time.get(device_idx);
+    if (tx_time_offset < 0) {
+      srsran_timestamp_sub(&device_tx_time, 0, -tx_time_offset);
+    } else {
+      srsran_timestamp_add(&device_tx_time, 0, tx_time_offset);
+    }
+    ret &= tx_dev(device_idx, buffer, device_tx_time);
   }
 
   is_start_of_burst = false;
@@ -556,6 +704,8 @@ bool radio::tx_dev(const uint32_t& device_idx, rf_buffer_interface& buffer, cons
     // If the overlap length is greater than the current transmission length, it means the whole transmission is in
     // the past and it shall be ignored
     if ((int32_t)nof_samples < past_nsamples) {
+      std::lock_guard<std::mutex> lock(metrics_mutex);
+      rf_metrics.tx_late++;
       return true;
     }
 
@@ -568,14 +718,28 @@ bool radio::tx_dev(const uint32_t& device_idx, rf_buffer_interface& buffer, cons
     logger.debug("Detected RF overlap of %.1f us. Discarding %d samples.",
                  srsran_timestamp_real(&ts_overlap) * 1.0e6,
                  past_nsamples);
+    {
+      std::lock_guard<std::mutex> lock(metrics_mutex);
+      rf_metrics.tx_trim++;
+      rf_metrics.tx_trim_max_us =
+          std::max(rf_metrics.tx_trim_max_us, (uint32_t)(srsran_timestamp_real(&ts_overlap) * 1.0e6));
+    }
 
   } else if (past_nsamples < 0 and not is_start_of_burst) {
     // if the gap is bigger than TX_MAX_GAP_ZEROS, stop burst
     if (fabs(srsran_timestamp_real(&ts_overlap)) > tx_max_gap_zeros) {
       logger.info("Detected RF gap of %.1f us. Sending end-of-burst.", srsran_timestamp_real(&ts_overlap) * 1.0e6);
       tx_end_nolock();
+      std::lock_guard<std::mutex> lock(metrics_mutex);
+      rf_metrics.tx_gap_eob++;
     } else {
       logger.debug("Detected RF gap of %.1f us. Tx'ing zeroes.", srsran_timestamp_real(&ts_overlap) * 1.0e6);
+      {
+        std::lock_guard<std::mutex> lock(metrics_mutex);
+        rf_metrics.tx_gap++;
+        rf_metrics.tx_gap_max_us =
+            std::max(rf_metrics.tx_gap_max_us, (uint32_t)(-srsran_timestamp_real(&ts_overlap) * 1.0e6));
+      }
       // Otherwise, transmit zeros
       uint32_t gap_nsamples = abs(past_nsamples);
       while (gap_nsamples > 0) {
@@ -619,14 +783,28 @@ bool radio::tx_dev(const uint32_t& device_idx, rf_buffer_interface& buffer, cons
     return false;
   }
 
-  int ret = srsran_rf_send_timed_multi(
-      rf_device, radio_buffers, nof_samples, tx_time.full_secs, tx_time.frac_secs, true, is_start_of_burst, false);
+  int ret = SRSRAN_ERROR;
+  if (buffer.is_sc16()) {
+    ret = srsran_rf_send_timed_multi_sc16(
+        rf_device, radio_buffers, nof_samples, tx_time.full_secs, tx_time.frac_secs, true, is_start_of_burst, false);
+  } else {
+    ret = srsran_rf_send_timed_multi(
+        rf_device, radio_buffers, nof_samples, tx_time.full_secs, tx_time.frac_secs, true, is_start_of_burst, false);
+  }
 
   return ret > SRSRAN_SUCCESS;
 }
 
 void radio::tx_end()
 {
+  // The end of burst must follow the subframes already queued
+  if (tx_fifo.capacity() > 0) {
+    while (tx_fifo_running and not tx_fifo.push_end_of_burst()) {
+      usleep(100);
+    }
+    return;
+  }
+
   std::unique_lock<std::mutex> lock(tx_mutex);
   tx_end_nolock();
 }
@@ -643,6 +821,19 @@ void radio::tx_end_nolock()
     }
     is_start_of_burst = true;
   }
+
+  // The next burst starts a new resampling stream
+  if (tx_resample_arb) {
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      srsran_resample_arb_stream_reset(&tx_resamplers[ch]);
+    }
+  }
+}
+
+float radio::get_tx_sc16_scale()
+{
+  std::unique_lock<std::mutex> lock(tx_mutex);
+  return tx_sc16_scale;
 }
 
 bool radio::get_is_start_of_burst()
@@ -1002,17 +1193,31 @@ void radio::set_tx_srate(const double& srate)
       }
     }
 
-    // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_tx_srate % (uint32_t)srate) == 0,
-                  "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
-                  cur_rx_srate / 1e6,
-                  srate / 1e6,
-                  cur_rx_srate / srate);
+    // Neither the interpolators nor the resampler decimate, a lower device rate would alias
+    if (cur_tx_srate < srate) {
+      srsran_terminate("Tx sampling rate %.3f MHz is below the %.3f MHz LTE rate", cur_tx_srate / 1e6, srate / 1e6);
+    }
 
-    // Update interpolators
-    uint32_t ratio = (uint32_t)ceil(cur_tx_srate / srate);
-    for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+    // Integer ratios are interpolated in the frequency domain, any other ratio is resampled by the exact fraction of
+    // both rates, so the device clock does not need to be a multiple of the LTE rate
+    tx_resample_arb = ((uint32_t)cur_tx_srate % (uint32_t)srate) != 0;
+    if (tx_resample_arb) {
+      logger.info("Resampling Tx from %.3f MHz to %.3f MHz", srate / 1e6, cur_tx_srate / 1e6);
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resample_arb_stream_free(&tx_resamplers[ch]);
+        if (srsran_resample_arb_stream_init(
+                &tx_resamplers[ch], (uint32_t)round(cur_tx_srate), (uint32_t)round(srate)) < SRSRAN_SUCCESS) {
+          srsran_terminate("Error initialising Tx resampler");
+        }
+        srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, 1);
+      }
+      tx_resample_srate = srate;
+    } else {
+      // Update interpolators
+      uint32_t ratio = (uint32_t)ceil(cur_tx_srate / srate);
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+      }
     }
   } else {
     for (srsran_rf_t& rf_device : rf_devices) {
@@ -1020,6 +1225,21 @@ void radio::set_tx_srate(const double& srate)
     }
   }
 
+  // The workers can hand int16 samples straight to the devices only if all of them take the same scale and nothing is
+  // resampled in between
+  tx_sc16_scale = 0.0f;
+  if (not tx_resample_arb and interpolators[0].ratio <= 1) {
+    tx_sc16_scale = srsran_rf_get_tx_sc16_scale(&rf_devices[0]);
+    for (srsran_rf_t& rf_device : rf_devices) {
+      if (srsran_rf_get_tx_sc16_scale(&rf_device) != tx_sc16_scale) {
+        tx_sc16_scale = 0.0f;
+      }
+    }
+  }
+  if (tx_sc16_scale > 0.0f) {
+    logger.info("Tx takes int16 samples with a full scale of %.0f", tx_sc16_scale);
+  }
+
   // Get calibrated advanced
   tx_adv_sec = get_dev_cal_tx_adv_sec(std::string(srsran_rf_name(&rf_devices[0])));
 
@@ -1040,8 +1260,9 @@ srsran_rf_info_t* radio::get_info()
 bool radio::get_metrics(rf_metrics_t* metrics)
 {
   std::lock_guard<std::mutex> lock(metrics_mutex);
-  *metrics   = rf_metrics;
-  rf_metrics = {};
+  *metrics              = rf_metrics;
+  metrics->tx_fifo_size = tx_fifo.capacity();
+  rf_metrics            = {};
   return true;
 }
 
@@ -1118,9 +1339,9 @@ bool radio::map_channels(const channel_mapping&     map,
       if (physical_idx.device_idx == device_idx) {
         cf_t* ptr = buffer.get(i, j, nof_antennas);
 
-        // Add sample offset only if it is a valid pointer
+        // Add sample offset only if it is a valid pointer, int16 samples take half the bytes
         if (ptr != nullptr) {
-          ptr += sample_offset;
+          ptr = buffer.is_sc16() ? (cf_t*)((int16_t*)ptr + 2 * sample_offset) : ptr + sample_offset;
         }
 
         radio_buffers[physical_idx.channel_idx] = ptr;
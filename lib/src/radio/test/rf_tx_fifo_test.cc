@@ -0,0 +1,155 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/radio/rf_buffer.h"
+#include "srsran/radio/rf_tx_fifo.h"
+#include <thread>
+
+using namespace srsran;
+
+static const uint32_t nof_channels = 2;
+static const uint32_t max_samples  = 64;
+
+static cf_t sample_value(uint32_t seq, uint32_t i)
+{
+  return (float)(seq * max_samples + i);
+}
+
+static void fill_buffer(std::vector<cf_t>& samples, uint32_t seq)
+{
+  for (uint32_t i = 0; i < samples.size(); i++) {
+    samples[i] = sample_value(seq, i);
+  }
+}
+
+/// Subframes come out in order with their samples and timestamp, the ring refuses them once full
+int test_push_pop()
+{
+  rf_tx_fifo fifo;
+  fifo.init(4, nof_channels, max_samples);
+  TESTASSERT(fifo.capacity() == 4);
+  TESTASSERT(fifo.size() == 0);
+
+  std::vector<cf_t> samples(max_samples);
+  cf_t*             ptr[SRSRAN_MAX_CHANNELS] = {samples.data()}; // Second channel not transmitted
+  rf_buffer_t       buffer(ptr, max_samples);
+  rf_timestamp_t    tx_time = {};
+  for (uint32_t seq = 0; seq < 4; seq++) {
+    fill_buffer(samples, seq);
+    tx_time.get_ptr(0)->full_secs = seq;
+    TESTASSERT(fifo.push(buffer, tx_time));
+  }
+  TESTASSERT(not fifo.push(buffer, tx_time));
+  TESTASSERT(not fifo.push_end_of_burst());
+  TESTASSERT(fifo.size() == 4);
+
+  // The ring keeps its own copy
+  fill_buffer(samples, 100);
+
+  for (uint32_t seq = 0; seq < 4; seq++) {
+    rf_tx_fifo::slot_t* slot = fifo.front();
+    TESTASSERT(slot != nullptr);
+    TESTASSERT(not slot->end_of_burst);
+    TESTASSERT(slot->nof_samples == max_samples);
+    TESTASSERT(slot->present[0] and not slot->present[1]);
+    TESTASSERT(slot->tx_time.get(0).full_secs == seq);
+    TESTASSERT(slot->samples[0][max_samples - 1] == sample_value(seq, max_samples - 1));
+    fifo.pop();
+  }
+  TESTASSERT(fifo.size() == 0);
+
+  // Oversized buffers are truncated, the end of burst is queued behind them
+  rf_buffer_t long_buffer(ptr, max_samples);
+  long_buffer.set_nof_samples(2 * max_samples);
+  TESTASSERT(fifo.push(long_buffer, tx_time));
+  TESTASSERT(fifo.push_end_of_burst());
+  TESTASSERT(fifo.front()->nof_samples == max_samples);
+  fifo.pop();
+  TESTASSERT(fifo.front()->end_of_burst);
+  fifo.pop();
+
+  // int16 samples are copied in their own format, in the memory of the cf_t buffers
+  int16_t* sc16 = (int16_t*)samples.data();
+  for (uint32_t i = 0; i < 2 * max_samples; i++) {
+    sc16[i] = (int16_t)i;
+  }
+  rf_buffer_t sc16_buffer(ptr, max_samples);
+  sc16_buffer.set_sc16(true);
+  TESTASSERT(fifo.push(sc16_buffer, tx_time));
+  rf_tx_fifo::slot_t* slot = fifo.front();
+  TESTASSERT(slot != nullptr and slot->sc16);
+  TESTASSERT(((int16_t*)slot->samples[0].data())[2 * max_samples - 1] == (int16_t)(2 * max_samples - 1));
+  fifo.pop();
+
+  // Waking up an empty ring returns no slot
+  fifo.wake_up();
+  TESTASSERT(fifo.front() == nullptr);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// A producer and a consumer thread exchange many more subframes than the ring holds
+int test_threads()
+{
+  const uint32_t nof_sf = 100000;
+  rf_tx_fifo     fifo;
+  fifo.init(8, nof_channels, max_samples);
+
+  std::thread producer([&fifo]() {
+    std::vector<cf_t> samples(max_samples);
+    cf_t*             ptr[SRSRAN_MAX_CHANNELS] = {samples.data(), samples.data()};
+    rf_buffer_t       buffer(ptr, max_samples);
+    rf_timestamp_t    tx_time = {};
+    for (uint32_t seq = 0; seq < nof_sf; seq++) {
+      fill_buffer(samples, seq);
+      tx_time.get_ptr(0)->full_secs = seq;
+      while (not fifo.push(buffer, tx_time)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint32_t nof_errors = 0;
+  for (uint32_t seq = 0; seq < nof_sf; seq++) {
+    rf_tx_fifo::slot_t* slot = fifo.front();
+    if (slot == nullptr or slot->tx_time.get(0).full_secs != seq or
+        slot->samples[1][max_samples - 1] != sample_value(seq, max_samples - 1)) {
+      nof_errors++;
+    }
+    fifo.pop();
+  }
+  producer.join();
+
+  TESTASSERT(nof_errors == 0);
+  TESTASSERT(fifo.size() == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_push_pop() == SRSRAN_SUCCESS);
+  TESTASSERT(test_threads() == SRSRAN_SUCCESS);
+
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
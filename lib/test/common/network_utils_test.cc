@@ -124,6 +124,58 @@ int test_socket_handler()
   return 0;
 }
 
+int test_batch_sdu_handler()
+{
+  auto& logger = srslog::fetch_basic_logger("S1AP", false);
+
+  std::atomic<int>      counter      = {0};
+  std::atomic<uint32_t> nof_rx_bytes = {0};
+
+  srsran::unique_socket  server_socket, client_socket;
+  srsran::socket_manager sockhandler;
+  int                    server_port = 2152;
+  const char*            server_addr = "127.0.100.1";
+  using namespace srsran::net_utils;
+
+  TESTASSERT(server_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(server_socket.bind_addr(server_addr, server_port));
+  TESTASSERT(client_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(client_socket.connect_to(server_addr, server_port));
+
+  // register server Rx handler
+  auto pdu_handler = [&logger, &counter, &nof_rx_bytes](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
+    logger.info(pdu->msg, pdu->N_bytes, "Received msg from %s:", get_ip(from).c_str());
+    nof_rx_bytes += pdu->N_bytes;
+    counter++;
+  };
+  rx_thread_tester rx_tester;
+  sockhandler.add_socket_handler(server_socket.fd(),
+                                 srsran::make_batch_sdu_handler(logger, rx_tester.task_queue, 4, pdu_handler));
+
+  // Send more datagrams than fit in a batch, without waiting for them to be read
+  uint8_t  buf[128]   = {};
+  int32_t  nof_counts = 10;
+  uint32_t nof_bytes  = 0;
+  for (int32_t i = 0; i < nof_counts; ++i) {
+    buf[i] = i;
+    TESTASSERT(send(client_socket.fd(), buf, i + 1, 0) == i + 1);
+    nof_bytes += i + 1;
+  }
+
+  uint32_t time_elapsed = 0;
+  while (counter != nof_counts) {
+    usleep(100);
+    time_elapsed += 100;
+    if (time_elapsed > 3000000) {
+      // too much time has passed
+      return -1;
+    }
+  }
+  TESTASSERT(nof_rx_bytes == nof_bytes);
+
+  return 0;
+}
+
 int test_sctp_bind_error()
 {
   srsran::unique_socket sock;
@@ -145,6 +197,7 @@ int main()
   srslog::init();
 
   TESTASSERT(test_socket_handler() == 0);
+  TESTASSERT(test_batch_sdu_handler() == 0);
   TESTASSERT(test_sctp_bind_error() == 0);
 
   return 0;
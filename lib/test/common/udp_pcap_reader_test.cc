@@ -0,0 +1,124 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/udp_pcap_reader.h"
+#include "srsran/common/pcap.h"
+#include "srsran/common/test_common.h"
+#include <arpa/inet.h>
+
+using namespace srsran;
+
+static const char* filename = "/tmp/udp_pcap_reader_test.pcap";
+
+static void write_packet(FILE* f, uint32_t time_us, uint8_t ip_proto, uint16_t frag, uint16_t dst_port, uint8_t len)
+{
+  uint8_t packet[128] = {};
+  // Ethernet
+  packet[12] = 0x08;
+  packet[13] = 0x00;
+  // IPv4
+  uint8_t* ip     = &packet[14];
+  uint16_t ip_len = 20 + 8 + len;
+  ip[0]           = 0x45;
+  ip[2]           = ip_len >> 8;
+  ip[3]           = ip_len & 0xff;
+  ip[6]           = frag >> 8;
+  ip[7]           = frag & 0xff;
+  ip[9]           = ip_proto;
+  ip[12]          = 10;
+  ip[15]          = 1;
+  ip[16]          = 239;
+  ip[19]          = 1;
+  // UDP
+  uint8_t* udp = &ip[20];
+  udp[0]       = 0x12;
+  udp[1]       = 0x34;
+  udp[2]       = dst_port >> 8;
+  udp[3]       = dst_port & 0xff;
+  udp[5]       = 8 + len;
+  for (uint8_t i = 0; i < len; i++) {
+    udp[8 + i] = i;
+  }
+
+  pcaprec_hdr_t record = {};
+  record.ts_sec        = 1000 + time_us / 1000000;
+  record.ts_usec       = time_us % 1000000;
+  record.incl_len      = 14 + ip_len;
+  record.orig_len      = record.incl_len;
+  fwrite(&record, sizeof(record), 1, f);
+  fwrite(packet, record.incl_len, 1, f);
+}
+
+int test_read_udp()
+{
+  FILE* f = fopen(filename, "wb");
+  TESTASSERT(f != nullptr);
+  pcap_hdr_t header    = {};
+  header.magic_number  = 0xa1b2c3d4;
+  header.version_major = 2;
+  header.version_minor = 4;
+  header.snaplen       = 65535;
+  header.network       = 1;
+  fwrite(&header, sizeof(header), 1, f);
+  write_packet(f, 500, IPPROTO_UDP, 0, 2153, 10);
+  write_packet(f, 1500, IPPROTO_TCP, 0, 2153, 10);    // Not UDP
+  write_packet(f, 2500, IPPROTO_UDP, 0x2000, 2153, 10); // First fragment
+  write_packet(f, 1000500, IPPROTO_UDP, 0, 2154, 20);
+  fclose(f);
+
+  udp_pcap_reader reader(srslog::fetch_basic_logger("PCAP", false));
+  TESTASSERT(not reader.open("/tmp/udp_pcap_reader_test_missing.pcap"));
+  TESTASSERT(reader.open(filename));
+
+  udp_pcap_reader::datagram_t info;
+  byte_buffer_t               pdu;
+  TESTASSERT(reader.read(info, pdu));
+  TESTASSERT(info.time_us == 0);
+  TESTASSERT(ntohs(info.src.sin_port) == 0x1234);
+  TESTASSERT(ntohs(info.dst.sin_port) == 2153);
+  TESTASSERT(ntohl(info.dst.sin_addr.s_addr) == 0xef000001);
+  TESTASSERT(pdu.N_bytes == 10);
+  TESTASSERT(pdu.msg[9] == 9);
+
+  TESTASSERT(reader.read(info, pdu));
+  TESTASSERT(info.time_us == 1000000);
+  TESTASSERT(ntohs(info.dst.sin_port) == 2154);
+  TESTASSERT(pdu.N_bytes == 20);
+  TESTASSERT(pdu.msg[19] == 19);
+  TESTASSERT(reader.get_nof_skipped() == 2);
+
+  TESTASSERT(not reader.read(info, pdu));
+  reader.close();
+  TESTASSERT(not reader.is_open());
+
+  remove(filename);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(test_read_udp() == SRSRAN_SUCCESS);
+
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
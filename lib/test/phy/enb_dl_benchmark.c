@@ -0,0 +1,449 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * Benchmark of the eNodeB downlink generation chain. For every combination of number of PRB, MCS, subframe type
+ * (unicast or MBSFN) and CFR enabled or disabled, it generates subframes with a single full bandwidth PDSCH or PMCH
+ * transport block and measures the average time spent in each of the stages:
+ *  - base:       srsran_enb_dl_put_base (grid reset, PSS/SSS, reference signals, PBCH and PCFICH)
+ *  - pdcch:      srsran_enb_dl_put_pdcch_dl, unicast subframes only
+ *  - data:       srsran_enb_dl_put_pdsch or srsran_enb_dl_put_pmch (CRC, turbo encoding, rate matching, scrambling,
+ *                modulation and mapping)
+ *  - gen_signal: srsran_enb_dl_gen_signal (normalization, IFFT and CFR when enabled). The cost of the CFR is the
+ *                difference between the CFR enabled and disabled entries of the same point
+ *
+ * The real time headroom is the fraction of the 1 ms subframe period left after generating one subframe of one cell.
+ */
+
+#include <srsran/phy/utils/random.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector_simd.h"
+#include "srsran/srsran.h"
+
+#define MAX_DATABUFFER_SIZE (6144 * 16 * 3 / 8)
+#define BENCHMARK_WARMUP_SF 10
+#define BENCHMARK_SF_NS 1000000.0
+
+static const uint32_t sweep_prb[] = {6, 15, 25, 50, 75, 100};
+static const uint32_t sweep_mcs[] = {0, 9, 18, 27};
+
+static uint32_t nof_prb          = 0;  // 0 sweeps all the bandwidths
+static int      mcs              = -1; // Negative sweeps several MCS
+static uint32_t sf_type_mask     = 3;  // Bit 0 unicast, bit 1 MBSFN
+static uint32_t cfr_mask         = 3;  // Bit 0 CFR disabled, bit 1 CFR enabled
+static uint32_t nof_subframes    = 200;
+static uint32_t non_mbsfn_region = 2;
+static uint32_t cfi              = 2;
+static uint16_t rnti             = 0x1234;
+static char*    json_filename    = NULL;
+
+typedef struct {
+  uint32_t nof_prb;
+  uint32_t mcs;
+  bool     mbsfn;
+  bool     cfr;
+  uint32_t tbs;
+  double   base_ns;
+  double   pdcch_ns;
+  double   data_ns;
+  double   gen_signal_ns;
+  double   total_ns;
+  double   max_total_ns;
+} benchmark_result_t;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [pmtcsfo]\n", prog);
+  printf("\t-p number of PRB, 0 sweeps 6, 15, 25, 50, 75 and 100 [Default %d]\n", nof_prb);
+  printf("\t-m MCS, negative sweeps 0, 9, 18 and 27 [Default %d]\n", mcs);
+  printf("\t-t subframe types: 1 unicast, 2 MBSFN, 3 both [Default %d]\n", sf_type_mask);
+  printf("\t-c CFR: 1 disabled, 2 enabled, 3 both [Default %d]\n", cfr_mask);
+  printf("\t-s number of measured subframes per point [Default %d]\n", nof_subframes);
+  printf("\t-f cfi of unicast subframes [Default %d]\n", cfi);
+  printf("\t-o JSON output file [Default none]\n");
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "pmtcsfov")) != -1) {
+    switch (opt) {
+      case 'p':
+        nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'm':
+        mcs = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        sf_type_mask = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'c':
+        cfr_mask = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        nof_subframes = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'f':
+        cfi = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'o':
+        json_filename = argv[optind];
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static inline uint64_t time_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000UL + (uint64_t)ts.tv_nsec;
+}
+
+/* Generates the subframes of a point and accumulates the time spent in each stage */
+static int run_point(srsran_enb_dl_t*        enb_dl,
+                     srsran_cell_t*          cell,
+                     srsran_softbuffer_tx_t* softbuffer,
+                     uint8_t*                data,
+                     srsran_random_t         random,
+                     benchmark_result_t*     result)
+{
+  // PDCCH candidates of the RNTI for every subframe of the frame
+  uint32_t              nof_locations[SRSRAN_NOF_SF_X_FRAME];
+  srsran_dci_location_t dci_locations[SRSRAN_NOF_SF_X_FRAME][SRSRAN_MAX_CANDIDATES_UE];
+  for (uint32_t i = 0; i < SRSRAN_NOF_SF_X_FRAME; i++) {
+    srsran_dl_sf_cfg_t sf_cfg_dl = {};
+    sf_cfg_dl.tti                = i;
+    sf_cfg_dl.cfi                = cfi;
+    sf_cfg_dl.sf_type            = SRSRAN_SF_NORM;
+    nof_locations[i] =
+        srsran_pdcch_ue_locations(&enb_dl->pdcch, &sf_cfg_dl, dci_locations[i], SRSRAN_MAX_CANDIDATES_UE, rnti);
+  }
+
+  srsran_dci_cfg_t dci_cfg    = {};
+  srsran_dci_dl_t  dci        = {};
+  dci.rnti                    = rnti;
+  dci.format                  = SRSRAN_DCI_FORMAT1;
+  dci.alloc_type              = SRSRAN_RA_ALLOC_TYPE0;
+  dci.type0_alloc.rbg_bitmask = 0xffffffff;
+  dci.tb[0].mcs_idx           = result->mcs;
+  dci.tb[0].rv                = 0;
+  dci.tb[0].cw_idx            = 0;
+  SRSRAN_DCI_TB_DISABLE(dci.tb[1]);
+
+  srsran_mbsfn_cfg_t mbsfn_cfg      = {};
+  mbsfn_cfg.mbsfn_area_id           = 0; // The only area srsran_enb_dl_init prepares the PMCH for
+  mbsfn_cfg.non_mbsfn_region_length = non_mbsfn_region;
+  mbsfn_cfg.mbsfn_mcs               = result->mcs;
+  mbsfn_cfg.enable                  = true;
+
+  uint64_t base_ns = 0, pdcch_ns = 0, data_ns = 0, gen_signal_ns = 0, max_total_ns = 0;
+
+  for (uint32_t i = 0; i < BENCHMARK_WARMUP_SF + nof_subframes; i++) {
+    srsran_dl_sf_cfg_t dl_sf = {};
+    srsran_pdsch_cfg_t pdsch_cfg;
+    srsran_pmch_cfg_t  pmch_cfg;
+    uint8_t*           data_tx[SRSRAN_MAX_CODEWORDS] = {data, NULL};
+
+    if (result->mbsfn) {
+      // Subframes 0, 4, 5 and 9 cannot be MBSFN
+      const uint32_t mbsfn_sf[] = {1, 2, 3, 6, 7, 8};
+      dl_sf.tti                 = mbsfn_sf[i % 6];
+      dl_sf.sf_type             = SRSRAN_SF_MBSFN;
+      dl_sf.non_mbsfn_region    = non_mbsfn_region;
+      dl_sf.cfi                 = non_mbsfn_region;
+
+      ZERO_OBJECT(pmch_cfg);
+      srsran_configure_pmch(&pmch_cfg, cell, &mbsfn_cfg);
+      srsran_ra_dl_compute_nof_re(cell, &dl_sf, &pmch_cfg.pdsch_cfg.grant);
+      pmch_cfg.pdsch_cfg.softbuffers.tx[0] = softbuffer;
+      result->tbs                          = pmch_cfg.pdsch_cfg.grant.tb[0].tbs;
+    } else {
+      dl_sf.tti     = i % SRSRAN_NOF_SF_X_FRAME;
+      dl_sf.sf_type = SRSRAN_SF_NORM;
+      dl_sf.cfi     = cfi;
+
+      // Small bandwidths leave no room for high MCS in the subframes carrying PSS/SSS and PBCH
+      dci.tb[0].mcs_idx = result->mcs;
+      if (cell->nof_prb == 6 && dl_sf.tti % 5 == 0) {
+        dci.tb[0].mcs_idx = 0;
+      } else if (cell->nof_prb == 15 && dl_sf.tti % 5 == 0) {
+        dci.tb[0].mcs_idx = SRSRAN_MIN(result->mcs, 27);
+      }
+      dci.location = dci_locations[dl_sf.tti][(i / SRSRAN_NOF_SF_X_FRAME) % nof_locations[dl_sf.tti]];
+
+      ZERO_OBJECT(pdsch_cfg);
+      if (srsran_ra_dl_dci_to_grant(cell, &dl_sf, SRSRAN_TM1, false, &dci, &pdsch_cfg.grant)) {
+        ERROR("Computing DL grant sf_idx=%d", dl_sf.tti);
+        return SRSRAN_ERROR;
+      }
+      pdsch_cfg.softbuffers.tx[0] = softbuffer;
+      pdsch_cfg.rnti              = rnti;
+      pdsch_cfg.power_scale       = true;
+      pdsch_cfg.p_a               = 0.0f;
+      pdsch_cfg.p_b               = 0;
+      if (dl_sf.tti == 1) {
+        result->tbs = pdsch_cfg.grant.tb[0].tbs;
+      }
+    }
+
+    srsran_random_byte_vector(random, data, MAX_DATABUFFER_SIZE);
+    srsran_softbuffer_tx_reset(softbuffer);
+
+    uint64_t t0 = time_ns();
+    srsran_enb_dl_put_base(enb_dl, &dl_sf);
+    uint64_t t1 = time_ns();
+    if (!result->mbsfn && srsran_enb_dl_put_pdcch_dl(enb_dl, &dci_cfg, &dci)) {
+      ERROR("Error putting PDCCH sf_idx=%d", dl_sf.tti);
+      return SRSRAN_ERROR;
+    }
+    uint64_t t2 = time_ns();
+    if (result->mbsfn) {
+      if (srsran_enb_dl_put_pmch(enb_dl, &pmch_cfg, data)) {
+        ERROR("Error putting PMCH sf_idx=%d", dl_sf.tti);
+        return SRSRAN_ERROR;
+      }
+    } else if (srsran_enb_dl_put_pdsch(enb_dl, &pdsch_cfg, data_tx)) {
+      ERROR("Error putting PDSCH sf_idx=%d", dl_sf.tti);
+      return SRSRAN_ERROR;
+    }
+    uint64_t t3 = time_ns();
+    srsran_enb_dl_gen_signal(enb_dl);
+    uint64_t t4 = time_ns();
+
+    if (i < BENCHMARK_WARMUP_SF) {
+      continue;
+    }
+    base_ns += t1 - t0;
+    pdcch_ns += t2 - t1;
+    data_ns += t3 - t2;
+    gen_signal_ns += t4 - t3;
+    max_total_ns = SRSRAN_MAX(max_total_ns, t4 - t0);
+  }
+
+  result->base_ns       = (double)base_ns / nof_subframes;
+  result->pdcch_ns      = (double)pdcch_ns / nof_subframes;
+  result->data_ns       = (double)data_ns / nof_subframes;
+  result->gen_signal_ns = (double)gen_signal_ns / nof_subframes;
+  result->total_ns      = result->base_ns + result->pdcch_ns + result->data_ns + result->gen_signal_ns;
+  result->max_total_ns  = (double)max_total_ns;
+
+  return SRSRAN_SUCCESS;
+}
+
+static int benchmark_cell(uint32_t            prb,
+                          srsran_random_t     random,
+                          uint8_t*            data,
+                          benchmark_result_t* results,
+                          uint32_t*           nof_results)
+{
+  int                    ret                             = SRSRAN_ERROR;
+  cf_t*                  signal_buffer[SRSRAN_MAX_PORTS] = {};
+  srsran_enb_dl_t        enb_dl                          = {};
+  srsran_softbuffer_tx_t softbuffer                      = {};
+  srsran_cell_t          cell                            = {.nof_prb         = prb,
+                                                            .nof_ports       = 1,
+                                                            .id              = 1,
+                                                            .cp              = SRSRAN_CP_NORM,
+                                                            .phich_resources = SRSRAN_PHICH_R_1,
+                                                            .phich_length    = SRSRAN_PHICH_NORM};
+
+  signal_buffer[0] = srsran_vec_cf_malloc(SRSRAN_SF_LEN_PRB(prb));
+  if (!signal_buffer[0]) {
+    perror("srsran_vec_cf_malloc");
+    goto quit;
+  }
+
+  if (srsran_softbuffer_tx_init(&softbuffer, prb)) {
+    ERROR("Error initiating TX soft buffer");
+    goto quit;
+  }
+
+  if (srsran_enb_dl_init(&enb_dl, signal_buffer, prb)) {
+    ERROR("Error initiating eNb downlink");
+    goto quit;
+  }
+
+  if (srsran_enb_dl_set_cell(&enb_dl, cell)) {
+    ERROR("Error setting eNb DL cell");
+    goto quit;
+  }
+
+  for (uint32_t c = 0; c < 2; c++) {
+    if ((cfr_mask & (1U << c)) == 0) {
+      continue;
+    }
+
+    srsran_cfr_cfg_t cfr_cfg = {};
+    cfr_cfg.cfr_enable       = (c == 1);
+    cfr_cfg.cfr_mode         = SRSRAN_CFR_THR_AUTO_EMA;
+    cfr_cfg.alpha            = 1.0f;
+    cfr_cfg.max_papr_db      = 8.0f;
+    cfr_cfg.ema_alpha        = 1.0f / (float)SRSRAN_CP_NORM_NSYMB;
+    if (srsran_enb_dl_set_cfr(&enb_dl, &cfr_cfg)) {
+      ERROR("Error setting CFR");
+      goto quit;
+    }
+
+    for (uint32_t t = 0; t < 2; t++) {
+      if ((sf_type_mask & (1U << t)) == 0) {
+        continue;
+      }
+
+      uint32_t nof_mcs = (mcs < 0) ? sizeof(sweep_mcs) / sizeof(sweep_mcs[0]) : 1;
+      for (uint32_t m = 0; m < nof_mcs; m++) {
+        benchmark_result_t* result = &results[(*nof_results)++];
+        result->nof_prb            = prb;
+        result->mcs                = (mcs < 0) ? sweep_mcs[m] : (uint32_t)mcs;
+        result->mbsfn              = (t == 1);
+        result->cfr                = (c == 1);
+
+        if (run_point(&enb_dl, &cell, &softbuffer, data, random, result)) {
+          goto quit;
+        }
+
+        printf("%3d  %-7s %2d  %-3s %6d  %8.0f %8.0f %8.0f %8.0f  %8.0f %8.0f  %6.1f%%\n",
+               result->nof_prb,
+               result->mbsfn ? "mbsfn" : "unicast",
+               result->mcs,
+               result->cfr ? "on" : "off",
+               result->tbs,
+               result->base_ns,
+               result->pdcch_ns,
+               result->data_ns,
+               result->gen_signal_ns,
+               result->total_ns,
+               result->max_total_ns,
+               100.0 * (1.0 - result->total_ns / BENCHMARK_SF_NS));
+      }
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+quit:
+  srsran_enb_dl_free(&enb_dl);
+  srsran_softbuffer_tx_free(&softbuffer);
+  if (signal_buffer[0]) {
+    free(signal_buffer[0]);
+  }
+  return ret;
+}
+
+static int write_json(const char* filename, const benchmark_result_t* results, uint32_t nof_results)
+{
+  FILE* f = fopen(filename, "w");
+  if (f == NULL) {
+    perror("fopen");
+    return SRSRAN_ERROR;
+  }
+
+  fprintf(f, "{\n");
+  fprintf(f, "  \"benchmark\": \"enb_dl\",\n");
+  fprintf(f, "  \"simd_cf_size\": %d,\n", SRSRAN_SIMD_CF_SIZE);
+  fprintf(f, "  \"simd_isa\": \"%s\",\n", srsran_vec_simd_isa_name());
+  fprintf(f, "  \"nof_subframes\": %d,\n", nof_subframes);
+  fprintf(f, "  \"results\": [\n");
+  for (uint32_t i = 0; i < nof_results; i++) {
+    const benchmark_result_t* r = &results[i];
+    fprintf(f,
+            "    {\"nof_prb\": %d, \"sf_type\": \"%s\", \"mcs\": %d, \"cfr\": %s, \"tbs\": %d, "
+            "\"base_ns\": %.0f, \"pdcch_ns\": %.0f, \"data_ns\": %.0f, \"gen_signal_ns\": %.0f, "
+            "\"total_ns\": %.0f, \"max_total_ns\": %.0f, \"headroom\": %.4f}%s\n",
+            r->nof_prb,
+            r->mbsfn ? "mbsfn" : "unicast",
+            r->mcs,
+            r->cfr ? "true" : "false",
+            r->tbs,
+            r->base_ns,
+            r->pdcch_ns,
+            r->data_ns,
+            r->gen_signal_ns,
+            r->total_ns,
+            r->max_total_ns,
+            1.0 - r->total_ns / BENCHMARK_SF_NS,
+            (i + 1 < nof_results) ? "," : "");
+  }
+  fprintf(f, "  ]\n");
+  fprintf(f, "}\n");
+  fclose(f);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int                 ret         = SRSRAN_ERROR;
+  srsran_random_t     random      = srsran_random_init(0x1234);
+  uint8_t*            data        = srsran_vec_u8_malloc(MAX_DATABUFFER_SIZE);
+  benchmark_result_t* results     = NULL;
+  uint32_t            nof_results = 0;
+
+  parse_args(argc, argv);
+
+  uint32_t nof_cells = (nof_prb == 0) ? sizeof(sweep_prb) / sizeof(sweep_prb[0]) : 1;
+  results            = calloc(nof_cells * 2 * 2 * sizeof(sweep_mcs) / sizeof(sweep_mcs[0]), sizeof(benchmark_result_t));
+  if (!data || !results) {
+    perror("malloc");
+    goto quit;
+  }
+
+  printf("PRB  type    MCS CFR    TBS   base_ns pdcch_ns  data_ns  gen_ns  total_ns   max_ns  headroom\n");
+  for (uint32_t i = 0; i < nof_cells; i++) {
+    if (benchmark_cell((nof_prb == 0) ? sweep_prb[i] : nof_prb, random, data, results, &nof_results)) {
+      goto quit;
+    }
+  }
+
+  if (json_filename && write_json(json_filename, results, nof_results)) {
+    goto quit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+quit:
+  srsran_random_free(random);
+  if (data) {
+    free(data);
+  }
+  if (results) {
+    free(results);
+  }
+
+  if (ret) {
+    printf("Error\n");
+  } else {
+    printf("Ok\n");
+  }
+  exit(ret);
+}
@@ -0,0 +1,273 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <srsran/common/test_common.h>
+#include <srsran/phy/utils/random.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srsran/srsran.h"
+
+#define NON_MBSFN_REGION 2
+#define MBSFN_MCS 9
+#define MAX_DATABUFFER_SIZE (6144 * 16 * 3 / 8)
+
+static srsran_cell_t cell = {
+    25,                 // nof_prb
+    1,                  // nof_ports
+    1,                  // cell_id
+    SRSRAN_CP_NORM,     // cyclic prefix
+    SRSRAN_PHICH_NORM,  // PHICH length
+    SRSRAN_PHICH_R_1_6, // PHICH resources
+    SRSRAN_FDD,
+};
+
+static srsran_random_t random_gen = NULL;
+
+/* Generates the MBSFN subframe sf_idx of area tx_area_id and decodes its PMCH as area rx_area_id. Returns true if the
+ * transport block is received */
+static bool loopback_pmch(srsran_enb_dl_t* enb_dl,
+                          srsran_ue_dl_t*  ue_dl,
+                          uint32_t         sf_idx,
+                          uint16_t         tx_area_id,
+                          uint16_t         rx_area_id)
+{
+  srsran_dl_sf_cfg_t dl_sf = {};
+  dl_sf.tti                = sf_idx;
+  dl_sf.cfi                = NON_MBSFN_REGION;
+  dl_sf.sf_type            = SRSRAN_SF_MBSFN;
+  dl_sf.non_mbsfn_region   = NON_MBSFN_REGION;
+  dl_sf.mbsfn_area_id      = tx_area_id;
+
+  srsran_mbsfn_cfg_t mbsfn_cfg      = {};
+  mbsfn_cfg.enable                  = true;
+  mbsfn_cfg.mbsfn_area_id           = tx_area_id;
+  mbsfn_cfg.mbsfn_mcs               = MBSFN_MCS;
+  mbsfn_cfg.non_mbsfn_region_length = NON_MBSFN_REGION;
+
+  srsran_softbuffer_tx_t softbuffer_tx = {};
+  srsran_softbuffer_rx_t softbuffer_rx = {};
+  uint8_t*               data_tx       = srsran_vec_u8_malloc(MAX_DATABUFFER_SIZE);
+  uint8_t*               data_rx       = srsran_vec_u8_malloc(MAX_DATABUFFER_SIZE);
+  bool                   received      = false;
+  if (!data_tx || !data_rx || srsran_softbuffer_tx_init(&softbuffer_tx, cell.nof_prb) ||
+      srsran_softbuffer_rx_init(&softbuffer_rx, cell.nof_prb)) {
+    ERROR("Error allocating buffers");
+    goto clean_exit;
+  }
+
+  // eNodeB
+  srsran_pmch_cfg_t pmch_cfg = {};
+  srsran_configure_pmch(&pmch_cfg, &cell, &mbsfn_cfg);
+  srsran_ra_dl_compute_nof_re(&cell, &dl_sf, &pmch_cfg.pdsch_cfg.grant);
+  pmch_cfg.pdsch_cfg.softbuffers.tx[0] = &softbuffer_tx;
+
+  uint32_t tbs_bytes = (uint32_t)pmch_cfg.pdsch_cfg.grant.tb[0].tbs / 8;
+  for (uint32_t i = 0; i < tbs_bytes; i++) {
+    data_tx[i] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 255);
+  }
+
+  srsran_enb_dl_put_base(enb_dl, &dl_sf);
+  if (srsran_enb_dl_put_pmch(enb_dl, &pmch_cfg, data_tx)) {
+    ERROR("Error putting PMCH");
+    goto clean_exit;
+  }
+  srsran_enb_dl_gen_signal(enb_dl);
+
+  // UE
+  if (srsran_ue_dl_set_mbsfn_area_id(ue_dl, rx_area_id)) {
+    ERROR("Error setting UE MBSFN area ID");
+    goto clean_exit;
+  }
+  srsran_ue_dl_set_non_mbsfn_region(ue_dl, NON_MBSFN_REGION);
+
+  srsran_ue_dl_cfg_t ue_dl_cfg           = {};
+  ue_dl_cfg.chest_cfg.filter_type        = SRSRAN_CHEST_FILTER_TRIANGLE;
+  ue_dl_cfg.chest_cfg.filter_coef[0]     = 0.1;
+  ue_dl_cfg.chest_cfg.estimator_alg      = SRSRAN_ESTIMATOR_ALG_INTERPOLATE;
+  ue_dl_cfg.chest_cfg.noise_alg          = SRSRAN_NOISE_ALG_PSS;
+  ue_dl_cfg.chest_cfg.mbsfn_area_id      = rx_area_id;
+  ue_dl_cfg.cfg.pdsch.max_nof_iterations = 10;
+  ue_dl_cfg.cfg.pdsch.decoder_type       = SRSRAN_MIMO_DECODER_MMSE;
+  ue_dl_cfg.cfg.pdsch.csi_enable         = false;
+  ue_dl_cfg.cfg.pdsch.meas_evm_en        = false;
+  ue_dl_cfg.cfg.pdsch.meas_time_en       = false;
+  ue_dl_cfg.cfg.pdsch.use_tbs_index_alt  = false;
+  ue_dl_cfg.cfg.pdsch.power_scale        = false;
+  if (srsran_ue_dl_decode_fft_estimate(ue_dl, &dl_sf, &ue_dl_cfg) < 0) {
+    ERROR("Error estimating channel");
+    goto clean_exit;
+  }
+
+  srsran_pmch_cfg_t rx_pmch_cfg = {};
+  rx_pmch_cfg.pdsch_cfg         = ue_dl_cfg.cfg.pdsch;
+  srsran_configure_pmch(&rx_pmch_cfg, &cell, &mbsfn_cfg);
+  srsran_ra_dl_compute_nof_re(&cell, &dl_sf, &rx_pmch_cfg.pdsch_cfg.grant);
+  rx_pmch_cfg.area_id                     = rx_area_id;
+  rx_pmch_cfg.pdsch_cfg.softbuffers.rx[0] = &softbuffer_rx;
+  srsran_softbuffer_rx_reset_tbs(&softbuffer_rx, rx_pmch_cfg.pdsch_cfg.grant.tb[0].tbs);
+
+  srsran_pdsch_res_t pmch_res[SRSRAN_MAX_CODEWORDS] = {};
+  pmch_res[0].payload                               = data_rx;
+  if (srsran_ue_dl_decode_pmch(ue_dl, &dl_sf, &rx_pmch_cfg, pmch_res)) {
+    ERROR("Error decoding PMCH");
+    goto clean_exit;
+  }
+
+  received = pmch_res[0].crc && memcmp(data_tx, data_rx, tbs_bytes) == 0;
+  printf("sf_idx=%d; tx_area=%d; rx_area=%d; tbs=%d; crc=%s;\n",
+         sf_idx,
+         tx_area_id,
+         rx_area_id,
+         pmch_cfg.pdsch_cfg.grant.tb[0].tbs,
+         pmch_res[0].crc ? "OK" : "KO");
+
+clean_exit:
+  srsran_softbuffer_tx_free(&softbuffer_tx);
+  srsran_softbuffer_rx_free(&softbuffer_rx);
+  if (data_tx) {
+    free(data_tx);
+  }
+  if (data_rx) {
+    free(data_rx);
+  }
+  return received;
+}
+
+/* Generates an MBSFN subframe without PMCH, its MBSFN region must be empty: the MBSFN reference signals are only
+ * transmitted along with the PMCH (TS 36.211 6.10.2) */
+static int test_idle_mbsfn_sf(srsran_enb_dl_t* enb_dl, cf_t* signal, uint32_t sf_idx, uint16_t area_id)
+{
+  srsran_dl_sf_cfg_t dl_sf = {};
+  dl_sf.tti                = sf_idx;
+  dl_sf.cfi                = NON_MBSFN_REGION;
+  dl_sf.sf_type            = SRSRAN_SF_MBSFN;
+  dl_sf.non_mbsfn_region   = NON_MBSFN_REGION;
+  dl_sf.mbsfn_area_id      = area_id;
+
+  srsran_enb_dl_put_base(enb_dl, &dl_sf);
+
+  // The non-MBSFN region keeps its reference signals and PCFICH
+  uint32_t nof_re_symbol = cell.nof_prb * SRSRAN_NRE;
+  TESTASSERT(srsran_vec_avg_power_cf(enb_dl->sf_symbols[0], NON_MBSFN_REGION * nof_re_symbol) > 0.0f);
+  for (uint32_t i = NON_MBSFN_REGION * nof_re_symbol; i < SRSRAN_CP_EXT_SF_NSYMB * nof_re_symbol; i++) {
+    TESTASSERT(crealf(enb_dl->sf_symbols[0][i]) == 0.0f && cimagf(enb_dl->sf_symbols[0][i]) == 0.0f);
+  }
+
+  // The second slot is entirely in the MBSFN region
+  srsran_enb_dl_gen_signal(enb_dl);
+  uint32_t sf_len = SRSRAN_SF_LEN_PRB(cell.nof_prb);
+  for (uint32_t i = sf_len / 2; i < sf_len; i++) {
+    TESTASSERT(crealf(signal[i]) == 0.0f && cimagf(signal[i]) == 0.0f);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Configures the cell with the given MBSFN areas and checks every area is received with its own area ID only */
+static int test_mbsfn_areas(const uint16_t* area_ids, uint32_t nof_areas)
+{
+  int              ret                             = SRSRAN_ERROR;
+  cf_t*            signal_buffer[SRSRAN_MAX_PORTS] = {};
+  srsran_enb_dl_t* enb_dl                          = srsran_vec_malloc(sizeof(srsran_enb_dl_t));
+  srsran_ue_dl_t*  ue_dl                           = srsran_vec_malloc(sizeof(srsran_ue_dl_t));
+  if (!enb_dl || !ue_dl) {
+    ERROR("Error allocating eNodeB and UE");
+    goto clean_exit;
+  }
+  for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    signal_buffer[i] = srsran_vec_cf_malloc(SRSRAN_SF_LEN_PRB(cell.nof_prb));
+    if (!signal_buffer[i]) {
+      ERROR("Error allocating signal buffer");
+      goto clean_exit;
+    }
+    srsran_vec_cf_zero(signal_buffer[i], SRSRAN_SF_LEN_PRB(cell.nof_prb));
+  }
+
+  if (srsran_enb_dl_init(enb_dl, signal_buffer, cell.nof_prb) || srsran_enb_dl_set_cell(enb_dl, cell) ||
+      srsran_enb_dl_set_mbsfn_areas(enb_dl, area_ids, nof_areas)) {
+    ERROR("Error initiating eNodeB DL");
+    goto clean_exit;
+  }
+  if (srsran_ue_dl_init(ue_dl, signal_buffer, cell.nof_prb, 1) || srsran_ue_dl_set_cell(ue_dl, cell)) {
+    ERROR("Error initiating UE DL");
+    goto clean_exit;
+  }
+
+  // Every area in the same MBSFN subframes, twice to go through the base signal templates
+  for (uint32_t n = 0; n < 2; n++) {
+    for (uint32_t sf_idx = 1; sf_idx <= 2; sf_idx++) {
+      for (uint32_t i = 0; i < nof_areas; i++) {
+        uint16_t wrong_area_id = area_ids[i] + 1;
+        TESTASSERT(loopback_pmch(enb_dl, ue_dl, sf_idx, area_ids[i], area_ids[i]));
+        TESTASSERT(!loopback_pmch(enb_dl, ue_dl, sf_idx, area_ids[i], wrong_area_id));
+      }
+    }
+  }
+
+  // Areas the cell does not take part in are not transmitted
+  TESTASSERT(!loopback_pmch(enb_dl, ue_dl, 6, 7, 7));
+
+  // Idle MBSFN subframes, also after the same subframes carried the PMCH
+  for (uint32_t sf_idx = 1; sf_idx <= 2; sf_idx++) {
+    for (uint32_t i = 0; i < nof_areas; i++) {
+      TESTASSERT(test_idle_mbsfn_sf(enb_dl, signal_buffer[0], sf_idx, area_ids[i]) == SRSRAN_SUCCESS);
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  if (enb_dl) {
+    srsran_enb_dl_free(enb_dl);
+    free(enb_dl);
+  }
+  if (ue_dl) {
+    srsran_ue_dl_free(ue_dl);
+    free(ue_dl);
+  }
+  for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    if (signal_buffer[i]) {
+      free(signal_buffer[i]);
+    }
+  }
+  return ret;
+}
+
+int main(int argc, char** argv)
+{
+  random_gen = srsran_random_init(0x1234);
+
+  // Non-zero area, as configured by sib.conf.mbsfn.example
+  uint16_t one_area[] = {1};
+  TESTASSERT(test_mbsfn_areas(one_area, 1) == SRSRAN_SUCCESS);
+
+  // Two areas sharing the cell
+  uint16_t two_areas[] = {1, 2};
+  TESTASSERT(test_mbsfn_areas(two_areas, 2) == SRSRAN_SUCCESS);
+
+  srsran_random_free(random_gen);
+
+  printf("Ok\n");
+
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,102 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_MBSFN_AREA_MAP_H
+#define SRSENB_MBSFN_AREA_MAP_H
+
+#include "srsran/interfaces/rrc_interface_types.h"
+#include <vector>
+
+namespace srsenb {
+
+/// Allocation of an MBSFN subframe to an MBSFN area and PMCH
+struct mbsfn_sf_alloc_t {
+  uint32_t area_idx      = 0;     ///< Index of the MBSFN area in the SIB13 area list
+  uint32_t pmch_idx      = 0;     ///< Index of the PMCH in the MCCH of the area
+  uint32_t sf_idx_in_msp = 0;     ///< Subframe ordinal within the PMCH MCH scheduling period (TS 36.321 6.1.3.7)
+  bool     has_pmch      = false; ///< Subframe is allocated to one of the PMCHs of the area
+  bool     is_mcch       = false; ///< Subframe carries the MCCH of the area
+};
+
+/**
+ * Maps MBSFN subframes to MBSFN areas and PMCHs, based on SIB2, SIB13 and the MCCH of each area.
+ * The common subframe allocation (CSA) of every area is expanded into a table at configuration time, so that lookups
+ * from the PHY workers and MAC are constant time and do not depend on the order in which TTIs are processed.
+ */
+class mbsfn_area_map
+{
+public:
+  /**
+   * Builds the subframe tables
+   * @param sib2 MBSFN subframe configuration of the cell
+   * @param sib13 MBSFN area list of the cell
+   * @param mcch_list MCCH of each area, in the same order as the SIB13 area list
+   */
+  void configure(const srsran::sib2_mbms_t&             sib2,
+                 const srsran::sib13_t&                 sib13,
+                 const std::vector<srsran::mcch_msg_t>& mcch_list);
+
+  bool     is_configured() const { return configured; }
+  uint32_t nof_areas() const { return areas.size(); }
+
+  /// Checks whether the subframe is reserved for MBSFN by SIB2
+  bool is_mbsfn_sf(uint32_t tti) const;
+
+  /// Looks up the MBSFN area and PMCH the subframe is allocated to. Returns false if not allocated to any area
+  bool get_sf_alloc(uint32_t tti, mbsfn_sf_alloc_t& sf_alloc) const;
+
+  /// Number of subframes of a PMCH within one of its MCH scheduling periods
+  uint32_t get_nof_sf_per_msp(uint32_t area_idx, uint32_t pmch_idx) const;
+
+  /// Checks whether the subframe is an MCCH change notification occasion of SIB13 (TS 36.331 5.8.1.3)
+  bool is_mcch_notif_sf(uint32_t tti) const;
+
+  /// Bit of the MCCH change notification that flags the area
+  uint32_t get_notif_ind(uint32_t area_idx) const;
+
+private:
+  struct sf_entry_t {
+    int16_t  pmch_idx      = -1; ///< PMCH the subframe is allocated to, -1 if not allocated to the area
+    uint16_t sf_idx_in_msp = 0;
+  };
+  struct area_t {
+    uint32_t                mcch_period      = 0;
+    uint32_t                mcch_offset      = 0;
+    uint32_t                notif_ind        = 0;
+    uint8_t                 mcch_table[10]   = {};
+    uint32_t                nof_frames       = 0; ///< Number of frames after which the area allocation repeats
+    std::vector<sf_entry_t> sf_table;             ///< Indexed by (SFN % nof_frames) * 10 + subframe
+    std::vector<uint32_t>   nof_sf_per_msp;       ///< Indexed by PMCH
+  };
+
+  static bool is_alloc_sf(const srsran::mbsfn_sf_cfg_t& cfg, uint32_t sfn, uint32_t sf);
+
+  bool                                configured   = false;
+  uint32_t                            notif_period = 0; ///< Notification repetition period in frames, 0 if none
+  uint32_t                            notif_offset = 0;
+  uint32_t                            notif_sf     = 0;
+  std::vector<srsran::mbsfn_sf_cfg_t> sib2_sf_cfg_list;
+  std::vector<area_t>                 areas;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_MBSFN_AREA_MAP_H
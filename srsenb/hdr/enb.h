@@ -155,6 +155,14 @@ public:
 
   void toggle_padding() override;
 
+  void cmd_mbms_session_start(uint32_t           area_idx,
+                              uint32_t           pmch_idx,
+                              const std::string& plmn,
+                              uint32_t           service_id,
+                              uint32_t           lcid,
+                              int                session_id) override;
+  void cmd_mbms_session_stop(const std::string& plmn, uint32_t service_id) override;
+
   void tti_clock() override;
 
 private:
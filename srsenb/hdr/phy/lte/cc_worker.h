@@ -25,6 +25,7 @@
 #include <string.h>
 
 #include "../phy_common.h"
+#include "pmch_cache.h"
 #include "srsran/srslog/srslog.h"
 
 #define LOG_EXECTIME
@@ -43,6 +44,7 @@ public:
   cf_t* get_buffer_rx(uint32_t antenna_idx);
   cf_t* get_buffer_tx(uint32_t antenna_idx);
   void  set_tti(uint32_t tti);
+  void  set_mbsfn_areas(const std::vector<uint16_t>& area_ids);
 
   int      add_rnti(uint16_t rnti);
   void     rem_rnti(uint16_t rnti);
@@ -59,7 +61,8 @@ public:
   void work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                stack_interface_phy_lte::dl_sched_t& dl_grants,
                stack_interface_phy_lte::ul_sched_t& ul_grants,
-               srsran_mbsfn_cfg_t*                  mbsfn_cfg);
+               srsran_mbsfn_cfg_t*                  mbsfn_cfg,
+               float                                tx_sc16_scale);
 
   uint32_t get_metrics(std::vector<phy_metrics_t>& metrics);
 
@@ -94,6 +97,7 @@ private:
   srsran_ul_sf_cfg_t ul_sf = {};
 
   srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
+  pmch_cache             pmch_symbols_cache;
 
   // Class to store user information
   class ue
@@ -0,0 +1,125 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSENB_PMCH_CACHE_H
+#define SRSENB_PMCH_CACHE_H
+
+#include "srsran/config.h"
+#include <stdint.h>
+#include <vector>
+
+namespace srsenb {
+namespace lte {
+
+/**
+ * Cache of encoded and modulated PMCH transport blocks.
+ *
+ * The MCCH is repeated unchanged within a modification period and file carousels replay identical TBs, so their PMCH
+ * symbols are the same every time they are transmitted. Entries are looked up by the payload hash together with every
+ * parameter the symbols depend on, and the payload is compared byte by byte on a hash match. A hit saves the turbo
+ * encoding, rate matching, scrambling and modulation of the TB; only the mapping to the resource grid is left.
+ *
+ * A TB only gets an entry the second time it is seen. The first time, only its hash and parameters are remembered, so
+ * that TBs sent once, such as most MTCH data, neither copy their payload nor evict the entries of repeated TBs.
+ *
+ * Each PHY worker owns its cache, so it is not thread-safe.
+ */
+class pmch_cache
+{
+public:
+  /// Parameters the PMCH symbols of a TB depend on, besides its payload
+  struct key_t {
+    uint32_t area_id = 0; ///< MBSFN area ID, selects the scrambling sequence
+    uint32_t sf_idx  = 0; ///< Subframe index within the radio frame, selects the scrambling sequence
+    uint32_t tbs     = 0; ///< Transport block size in bits
+    uint32_t mcs     = 0;
+    uint32_t nof_re  = 0; ///< Number of PMCH resource elements, depends on the non-MBSFN region length
+  };
+
+  pmch_cache() = default;
+  ~pmch_cache();
+  pmch_cache(const pmch_cache&) = delete;
+  pmch_cache& operator=(const pmch_cache&) = delete;
+
+  /**
+   * Allocates the cache entries
+   * @param nof_entries Number of TBs kept in the cache, 0 disables it
+   * @param max_re Maximum number of PMCH resource elements per subframe
+   * @return SRSRAN_SUCCESS or SRSRAN_ERROR if the memory could not be allocated
+   */
+  int  init(uint32_t nof_entries, uint32_t max_re);
+  bool is_enabled() const { return not entries.empty(); }
+
+  /**
+   * Looks up the symbols of a TB. On a miss of a TB seen before, the least recently used entry is reassigned to the TB
+   * and its buffer is returned to be filled by the caller
+   * @param key Parameters of the TB
+   * @param data Payload of the TB, tbs / 8 bytes
+   * @param hit Set to true if the returned buffer already holds the symbols of the TB
+   * @return Buffer of max_re symbols, nullptr if the cache is disabled, the TB does not fit in it or is seen for the
+   * first time
+   */
+  cf_t* get(const key_t& key, const uint8_t* data, bool& hit);
+
+  /// Invalidates all the entries, e.g. after an entry returned on a miss could not be filled
+  void clear();
+
+  uint64_t get_nof_hits() const { return nof_hits; }
+  uint64_t get_nof_misses() const { return nof_misses; }
+
+private:
+  struct entry_t {
+    bool                 valid    = false;
+    key_t                key      = {};
+    uint64_t             hash     = 0;
+    uint64_t             last_use = 0;
+    std::vector<uint8_t> payload;
+    cf_t*                symbols = nullptr;
+  };
+
+  /// TB seen once, without an entry
+  struct seen_t {
+    bool     valid = false;
+    key_t    key   = {};
+    uint64_t hash  = 0;
+  };
+
+  /// Number of TBs remembered as seen once per entry, enough to span an MCCH repetition period of MTCH data
+  static const uint32_t nof_seen_per_entry = 32;
+
+  static uint64_t hash_payload(const uint8_t* data, uint32_t nof_bytes);
+  static bool     key_equal(const key_t& a, const key_t& b);
+  bool            check_seen(const key_t& key, uint64_t hash);
+
+  std::vector<entry_t> entries;
+  std::vector<seen_t>  seen;
+  uint32_t             seen_next  = 0;
+  uint32_t             max_re     = 0;
+  uint64_t             use_count  = 0;
+  uint64_t             nof_hits   = 0;
+  uint64_t             nof_misses = 0;
+};
+
+} // namespace lte
+} // namespace srsenb
+
+#endif // SRSENB_PMCH_CACHE_H
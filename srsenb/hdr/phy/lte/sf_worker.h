@@ -42,6 +42,7 @@ public:
 
   cf_t* get_buffer_rx(uint32_t cc_idx, uint32_t antenna_idx);
   void  set_context(const srsran::phy_common_interface::worker_context_t& w_ctx);
+  void  set_mbsfn_areas(const std::vector<uint16_t>& area_ids);
 
   int      add_rnti(uint16_t rnti, uint32_t cc_idx);
   void     rem_rnti(uint16_t rnti);
@@ -61,18 +61,20 @@ public:
 
   /* MAC->PHY interface */
   void rem_rnti(uint16_t rnti) final;
-  void set_mch_period_stop(uint32_t stop) final;
   void set_activation_deactivation_scell(uint16_t                                     rnti,
                                          const std::array<bool, SRSRAN_MAX_CARRIERS>& activation) override;
 
   /*RRC-PHY interface*/
-  void configure_mbsfn(srsran::sib2_mbms_t* sib2, srsran::sib13_t* sib13, const srsran::mcch_msg_t& mcch) override;
+  void configure_mbsfn(srsran::sib2_mbms_t*                   sib2,
+                       srsran::sib13_t*                       sib13,
+                       const std::vector<srsran::mcch_msg_t>& mcch_list) override;
 
   void start_plot() override;
   void set_config(uint16_t rnti, const phy_rrc_cfg_list_t& phy_cfg_list) override;
   void complete_config(uint16_t rnti) override;
 
   void get_metrics(std::vector<phy_metrics_t>& metrics) override;
+  void get_tx_metrics(phy_tx_metrics_t& metrics) override;
 
   void cmd_cell_gain(uint32_t cell_id, float gain_db) override;
   void cmd_cell_measure() override;
@@ -85,8 +87,7 @@ public:
   int set_common_cfg(const common_cfg_t& common_cfg) override;
 
 private:
-  srsran::phy_cfg_mbsfn_t mbsfn_config = {};
-  uint32_t                nof_workers  = 0;
+  uint32_t nof_workers = 0;
 
   const static int MAX_WORKERS = 4;
 
@@ -23,6 +23,7 @@
 #define SRSENB_PHCH_COMMON_H
 
 #include "phy_interfaces.h"
+#include "srsenb/hdr/common/mbsfn_area_map.h"
 #include "srsenb/hdr/phy/phy_ue_db.h"
 #include "srsran/common/gen_mch_tables.h"
 #include "srsran/common/interfaces_common.h"
@@ -35,6 +36,7 @@
 #include "srsran/phy/channel/channel.h"
 #include "srsran/radio/radio.h"
 
+#include <atomic>
 #include <map>
 #include <srsran/common/tti_sempahore.h>
 #include <string.h>
@@ -45,6 +47,7 @@ class phy_common : public srsran::phy_common_interface
 {
 public:
   phy_common() = default;
+  ~phy_common();
 
   bool init(const phy_cell_cfg_list_t&    cell_list_,
             const phy_cell_cfg_list_nr_t& cell_list_nr_,
@@ -68,9 +71,30 @@ public:
    */
   void worker_end(const worker_context_t& w_ctx, const bool& tx_enable, srsran::rf_buffer_t& buffer) override;
 
+  /**
+   * TX deadline accounting. The slack of the subframes handed to the radio since the last call, which resets it
+   */
+  void get_tx_metrics(phy_tx_metrics_t& m);
+  /// Smallest slack since the last call, which resets it. Infinite if no subframe had a deadline
+  float get_tx_min_slack_ms();
+  /// Time subframes are currently generated ahead of their air time, reported with the metrics
+  void set_tx_lookahead_ms(uint32_t lookahead_ms) { tx_lookahead_ms = lookahead_ms; }
+
+  /**
+   * Sets the int16 scale the radio takes Tx samples with. The workers only use it when the subframe goes to the radio
+   * untouched, the carrier combining and the DL channel emulator need cf_t samples
+   */
+  void set_tx_sc16_scale(float scale);
+  /// Scale the workers convert the Tx samples to int16 with, 0 if they hand cf_t samples to the radio
+  float get_tx_sc16_scale() { return tx_sc16_scale; }
+
   // Common objects
   phy_args_t params = {};
 
+  /// Threads shared by all the workers for turbo encoding the code blocks of a transport block in parallel. NULL if
+  /// every worker encodes its transport blocks alone
+  srsran_sch_tx_pool_t* get_fec_pool() { return fec_pool; }
+
   uint32_t get_nof_carriers_lte() { return static_cast<uint32_t>(cell_list_lte.size()); }
   uint32_t get_nof_carriers_nr() { return static_cast<uint32_t>(cell_list_nr.size()); }
   uint32_t get_nof_carriers() { return static_cast<uint32_t>(cell_list_lte.size() + cell_list_nr.size()); }
@@ -273,11 +297,19 @@ public:
    */
   phy_ue_db ue_db;
 
-  void configure_mbsfn(srsran::phy_cfg_mbsfn_t* cfg);
+  void configure_mbsfn(const srsran::sib2_mbms_t&             sib2,
+                       const srsran::sib13_t&                 sib13,
+                       const std::vector<srsran::mcch_msg_t>& mcch_list);
   void build_mch_table();
-  void build_mcch_table();
+
+  /**
+   * Checks whether the TTI is an MBSFN subframe and fills the area dependent parameters. Whether the PMCH is actually
+   * transmitted, and with which MCS, is decided by the MAC MCH scheduler
+   */
   bool is_mbsfn_sf(srsran_mbsfn_cfg_t* cfg, uint32_t phy_tti);
-  void set_mch_period_stop(uint32_t stop);
+
+  /// MBSFN area IDs of SIB13, the workers generate the PMCH scrambling and MBSFN reference signals of each of them
+  std::vector<uint16_t> get_mbsfn_area_ids();
 
   // Getters and setters for ul grants which need to be shared between workers
   const stack_interface_phy_lte::ul_sched_list_t get_ul_grants(uint32_t tti);
@@ -292,19 +324,27 @@ private:
   phy_cell_cfg_list_t    cell_list_lte;
   phy_cell_cfg_list_nr_t cell_list_nr;
   std::mutex             cell_gain_mutex;
-
-  bool                    have_mtch_stop   = false;
-  pthread_mutex_t         mtch_mutex       = {};
-  pthread_cond_t          mtch_cvar        = {};
-  srsran::phy_cfg_mbsfn_t mbsfn            = {};
-  bool                    sib13_configured = false;
-  bool                    mcch_configured  = false;
-  uint8_t                 mch_table[40]    = {};
-  uint8_t                 mcch_table[10]   = {};
-  uint32_t                mch_period_stop  = 0;
-  srsran::rf_buffer_t     tx_buffer        = {};
-  bool                    is_mch_subframe(srsran_mbsfn_cfg_t* cfg, uint32_t phy_tti);
-  bool                    is_mcch_subframe(srsran_mbsfn_cfg_t* cfg, uint32_t phy_tti);
+  std::atomic<float>     tx_sc16_scale = {0.0f};
+
+  std::mutex             mbsfn_mutex;
+  srsran::mbsfn_sf_cfg_t mbsfn_subfr_cnfg = {};
+  srsran::sib13_t        mbsfn_sib13      = {};
+  mbsfn_area_map         mbsfn_map;
+  uint8_t                mch_table[40] = {};
+  srsran::rf_buffer_t    tx_buffer     = {};
+
+  /// FEC threads encode on behalf of the PHY workers, with the same real-time priority
+  const static int      FEC_THREAD_PRIO = 2;
+  srsran_sch_tx_pool_t* fec_pool        = nullptr;
+
+  static bool create_fec_thread(pthread_t* thread, void* (*start_routine)(void*), void* arg, void* user);
+
+  void                  count_tx_slack(float slack_ms);
+  std::mutex            tx_metrics_mutex;
+  phy_tx_metrics_t      tx_metrics      = {};
+  double                tx_slack_sum_ms = 0;
+  float                 tx_min_slack_ms = std::numeric_limits<float>::infinity(); ///< Adaptive lookahead window
+  std::atomic<uint32_t> tx_lookahead_ms = {FDD_HARQ_DELAY_UL_MS};
 };
 
 } // namespace srsenb
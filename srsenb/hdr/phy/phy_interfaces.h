@@ -73,6 +73,18 @@ struct phy_args_t {
   bool                    pusch_meas_ta       = true;
   bool                    pucch_meas_ta       = true;
   uint32_t                nof_prach_threads   = 1;
+  uint32_t                pmch_cache_size     = 8;
+  uint32_t                nof_fec_threads     = 0;
+  uint32_t                fec_cpu_mask        = 0; ///< CPUs the FEC threads may run on, 0 for any
+  bool                    tx_only             = false;
+  uint32_t                tx_lookahead_ms     = FDD_HARQ_DELAY_UL_MS; ///< TX only: generation advance over air time
+  uint32_t                tx_burst_sf         = 1;                    ///< TX only: subframes dispatched ahead per wakeup
+  uint32_t                tx_lookahead_max_ms = 0;                    ///< TX only: adaptive lookahead limit, 0 fixed
+  uint32_t                tx_slack_min_us     = 500;                  ///< TX only: slack below which it widens
+  bool                    tx_offline          = false;                ///< TX only: no pacing, synthetic clock
+  uint32_t                tx_offline_sf       = 0;                    ///< TX offline: subframes to render, 0 no limit
+  std::string             tx_time_ref         = "none";               ///< TX only: SFN time base: none, radio, system
+  int32_t                 tx_site_delay_ns    = 0;                    ///< TX only: static delay of this transmitter
   bool                    extended_cp         = false;
   srsran::channel::args_t dl_channel_args;
   srsran::channel::args_t ul_channel_args;
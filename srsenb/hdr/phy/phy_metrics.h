@@ -53,6 +53,22 @@ struct phy_metrics_t {
   ul_metrics_t ul;
 };
 
+// PHY transmission timing. The slack of a subframe is the time left before its transmission when the last PHY worker
+// hands it to the radio, negative when the worker was late
+
+/// Upper edges in ms of the slack histogram bins, the last bin counts the larger slacks
+static const float    phy_tx_slack_edges_ms[] = {0.0f, 0.25f, 0.5f, 1.0f, 2.0f, 4.0f, 8.0f};
+static const uint32_t phy_tx_slack_nof_bins   = sizeof(phy_tx_slack_edges_ms) / sizeof(float) + 1;
+
+struct phy_tx_metrics_t {
+  uint32_t nof_sf;                            ///< Subframes handed to the radio with a deadline
+  uint32_t nof_late;                          ///< Subframes handed to the radio after their deadline
+  float    min_slack_ms;                      ///< Smallest slack, valid if nof_sf > 0
+  float    avg_slack_ms;                      ///< Average slack, valid if nof_sf > 0
+  uint32_t slack_hist[phy_tx_slack_nof_bins]; ///< Subframes per slack bin, see phy_tx_slack_edges_ms
+  uint32_t lookahead_ms;                      ///< Time subframes are generated ahead of their air time
+};
+
 } // namespace srsenb
 
 #endif // SRSENB_PHY_METRICS_H
@@ -0,0 +1,52 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSENB_TX_ONLY_TIMING_H
+#define SRSENB_TX_ONLY_TIMING_H
+
+#include "srsran/phy/common/timestamp.h"
+#include <stdint.h>
+
+namespace srsenb {
+
+/// TTI boundary TX only transmitters start from. TTI n is transmitted n ms after the epoch of the absolute time
+/// reference, plus the static delay of the site, so that every transmitter of an SFN numbers its subframes the same
+struct tx_only_boundary_t {
+  uint64_t tti_count = 0;   ///< Milliseconds from the epoch to the boundary
+  double   delta_s   = 0.0; ///< Time from now to the boundary plus the site delay, minus 1 ms and the lookahead
+  uint32_t tti       = 0;   ///< Main loop TTI right before the one whose subframe is transmitted at the boundary
+};
+
+/**
+ * Computes the first TTI boundary whose subframe can still be generated in time. Whole seconds and the fraction are
+ * kept apart: a double holding an absolute time, such as a GPS time, is not sample accurate
+ * @param abs_now Current time of the absolute time reference
+ * @param lookahead_ms Time subframes are generated ahead of their transmission
+ * @param site_delay_ns Static delay of this transmitter, negative values transmit earlier
+ * @return The boundary, the TTI loop increments tti and waits 1 ms before the first subframe
+ */
+tx_only_boundary_t
+tx_only_next_boundary(const srsran_timestamp_t& abs_now, uint32_t lookahead_ms, int32_t site_delay_ns);
+
+} // namespace srsenb
+
+#endif // SRSENB_TX_ONLY_TIMING_H
@@ -31,6 +31,7 @@
 #include "srsran/phy/channel/channel.h"
 #include "srsran/radio/radio.h"
 #include <atomic>
+#include <chrono>
 
 namespace srsenb {
 
@@ -50,6 +51,17 @@ public:
 private:
   void run_thread() override;
 
+  // Downlink-only operation: nothing is received, so TTIs are paced on the radio time instead of the RX stream
+  void tx_only_start();
+  void tx_only_wait_tti(srsran::rf_timestamp_t& timestamp);
+  bool tx_offline_complete() const;
+  bool tx_only_widen_lookahead();
+
+  // SFN alignment of several transmitters: TTI n is transmitted n ms after the epoch of an absolute time reference,
+  // plus the static delay of the site
+  enum class time_ref_t { none, radio, system };
+  void tx_only_align(const srsran::rf_timestamp_t& radio_now);
+
   enb_time_interface*          enb     = nullptr;
   srsran::radio_interface_phy* radio_h = nullptr;
   srslog::basic_logger&        logger;
@@ -62,6 +74,19 @@ private:
   // Main system TTI counter
   uint32_t tti = 0;
 
+  static constexpr uint32_t             tx_only_sync_period = 1000;  ///< TTIs between radio time readings
+  static constexpr double               tx_only_max_error_s = 1e-3;  ///< Larger errors realign instead of correcting
+  bool                                  tx_only_radio_time  = false; ///< The radio time is known
+  uint32_t                              tx_only_tti_count   = 0;
+  srsran::rf_timestamp_t                tx_only_time        = {}; ///< Radio time of the current TTI
+  std::chrono::steady_clock::time_point tx_only_deadline    = {}; ///< Host time of the current TTI
+  time_ref_t                            tx_only_time_ref    = time_ref_t::none;
+
+  // Adaptive lookahead: the TX slack is checked once per period and the lookahead widened by 1 ms when it runs low
+  static constexpr uint32_t tx_lookahead_period = 100; ///< TTIs between slack checks
+  uint32_t                  tx_lookahead_ms     = FDD_HARQ_DELAY_UL_MS;
+  bool                      tx_lookahead_settle = false; ///< The last check widened it, the next one is discarded
+
   std::atomic<bool> running;
 };
 
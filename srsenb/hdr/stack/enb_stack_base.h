@@ -47,7 +47,11 @@ typedef struct {
   bool        enable;
   std::string m1u_multiaddr;
   std::string m1u_if_addr;
+  std::string m1u_pcap;
   uint16_t    mcs;
+  uint32_t    mtch_max_delay_ms;
+  uint32_t    mtch_queue_bytes;
+  bool        m1u_teid_per_service;
 } embms_args_t;
 
 typedef struct {
@@ -92,6 +96,16 @@ public:
   virtual void stop() = 0;
 
   virtual void toggle_padding() = 0;
+
+  // MBMS session management
+  virtual void mbms_session_start(uint32_t           area_idx,
+                                  uint32_t           pmch_idx,
+                                  const std::string& plmn,
+                                  uint32_t           service_id,
+                                  uint32_t           lcid,
+                                  int                session_id) = 0;
+  virtual void mbms_session_stop(const std::string& plmn, uint32_t service_id) = 0;
+
   // eNB metrics interface
   virtual bool get_metrics(stack_metrics_t* metrics) = 0;
 
@@ -115,6 +115,13 @@ public:
     mac.set_sched_dl_tti_mask(tti_mask, nof_sfs);
   }
   void toggle_padding() override { mac.toggle_padding(); }
+  void mbms_session_start(uint32_t           area_idx,
+                          uint32_t           pmch_idx,
+                          const std::string& plmn,
+                          uint32_t           service_id,
+                          uint32_t           lcid,
+                          int                session_id) override;
+  void mbms_session_stop(const std::string& plmn, uint32_t service_id) override;
   void tti_clock() override;
 
   // rrc_eutra_interface_rrc_nr
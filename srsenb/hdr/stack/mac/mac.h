@@ -24,6 +24,7 @@
 
 #include "sched.h"
 #include "sched_interface.h"
+#include "srsenb/hdr/common/mbsfn_area_map.h"
 #include "srsenb/hdr/common/rnti_pool.h"
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_rr.h"
 #include "srsran/adt/circular_map.h"
@@ -80,7 +81,6 @@ public:
   {
     scheduler.set_dl_tti_mask(tti_mask, nof_sfs);
   }
-  void build_mch_sched(uint32_t tbs);
 
   /******** Interface from RRC (RRC -> MAC) ****************/
   /* Provides cell configuration including SIB periodicity, etc. */
@@ -108,11 +108,14 @@ public:
 
   void add_padding();
 
-  void write_mcch(const srsran::sib2_mbms_t* sib2_,
-                  const srsran::sib13_t*     sib13_,
-                  const srsran::mcch_msg_t*  mcch_,
-                  const uint8_t*             mcch_payload,
-                  const uint8_t              mcch_payload_length) override;
+  void write_mcch(const srsran::sib2_mbms_t*                sib2_,
+                  const srsran::sib13_t*                    sib13_,
+                  const std::vector<srsran::mcch_msg_t>&    mcch_list,
+                  const std::vector<std::vector<uint8_t> >& mcch_payload_list) override;
+  void update_mcch(uint32_t                    area_idx,
+                   const srsran::mcch_msg_t&   mcch,
+                   const std::vector<uint8_t>& mcch_payload,
+                   uint32_t                    version) override;
 
 private:
   bool     check_ue_active(uint16_t rnti);
@@ -153,8 +156,6 @@ private:
   sched                                    scheduler;
   std::vector<sched_interface::cell_cfg_t> cell_config;
 
-  sched_interface::dl_pdu_mch_t mch = {};
-
   /* Map of active UEs */
   static const uint16_t            FIRST_RNTI = 0x46;
   rnti_map_t<unique_rnti_ptr<ue> > ue_db;
@@ -183,14 +184,38 @@ private:
 
   std::vector<common_buffers_t> common_buffers;
 
-  const static int    mcch_payload_len                      = 3000; // TODO FIND OUT MAX LENGTH
-  int                 current_mcch_length                   = 0;
-  uint8_t             mcch_payload_buffer[mcch_payload_len] = {};
-  srsran::mcch_msg_t  mcch;
-  srsran::sib2_mbms_t sib2;
-  srsran::sib13_t     sib13;
-  const static int    mtch_payload_len                      = 10000;
-  uint8_t             mtch_payload_buffer[mtch_payload_len] = {};
+  /* MCH scheduling state of each PMCH of each MBSFN area */
+  struct mch_pmch_t {
+    uint32_t                      data_mcs = 0;
+    sched_interface::dl_pdu_mch_t mch      = {};
+    /// First subframe and bytes left of each MTCH in the current MCH scheduling period
+    uint32_t mtch_start[sched_interface::MAX_MTCH_SCHED]      = {};
+    uint32_t mtch_bytes_left[sched_interface::MAX_MTCH_SCHED] = {};
+  };
+  struct mch_area_t {
+    uint32_t                sig_mcs = 0;
+    std::vector<uint8_t>    mcch_payload;
+    std::vector<mch_pmch_t> pmch_list;
+    /// MCCH modification period in radio frames, and latest TTI scheduled
+    uint32_t mod_period   = 0;
+    uint32_t last_tti     = 0;
+    bool     has_last_tti = false;
+    /// MCCH waiting for the start of the next modification period
+    bool                 pending_mcch         = false;
+    srsran::mcch_msg_t   pending_mcch_msg     = {};
+    std::vector<uint8_t> pending_mcch_payload;
+    uint32_t             pending_mcch_version = 0;
+  };
+  void configure_mch_area(uint32_t area_idx, mch_area_t& area, const srsran::mcch_msg_t& mcch);
+  void apply_pending_mcch(uint32_t tti);
+  void sched_mcch_notif(uint32_t tti);
+  void
+  build_mch_sched(mch_pmch_t& pmch, uint32_t nof_sf, uint32_t tbs, uint32_t first_sf_tbs, uint32_t first_sf_overhead);
+
+  std::mutex                                            mch_mutex;
+  mbsfn_area_map                                        mbsfn_map;
+  std::vector<mch_area_t>                               mch_areas;
+  std::array<std::atomic<uint32_t>, SRSRAN_N_MCH_LCIDS> mtch_buffer_size = {};
 
   // pointer to MAC PCAP object
   srsran::mac_pcap*     pcap       = nullptr;
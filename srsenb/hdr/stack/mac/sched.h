@@ -81,6 +81,7 @@ public:
   int ul_sched(uint32_t tti, uint32_t enb_cc_idx, ul_sched_res_t& sched_result) final;
 
   int set_pdcch_order(uint32_t enb_cc_idx, dl_sched_po_info_t pdcch_order_info) final;
+  int set_mcch_notif(uint32_t enb_cc_idx, uint32_t tti_tx_dl, uint8_t notif_bitmap) final;
 
   /* Custom functions
    */
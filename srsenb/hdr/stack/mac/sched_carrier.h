@@ -46,6 +46,7 @@ public:
   const cc_sched_result& generate_tti_result(srsran::tti_point tti_rx);
   int                    dl_rach_info(dl_sched_rar_info_t rar_info);
   int                    pdcch_order_info(dl_sched_po_info_t pdcch_order_info);
+  int                    mcch_notif_info(srsran::tti_point tti_tx_dl, uint8_t notif_bitmap);
 
   // getters
   const ra_sched* get_ra_sched() const { return ra_sched_ptr.get(); }
@@ -61,6 +62,8 @@ private:
   sf_sched* get_sf_sched(srsran::tti_point tti_rx);
   //! Schedule PDCCH orders
   void pdcch_order_sched(sf_sched* tti_sched);
+  //! Schedule the MCCH change notification, also in MBSFN subframes
+  void mcch_notif_sched(sf_sched* tti_sched);
 
   // args
   const sched_cell_params_t* cc_cfg = nullptr;
@@ -85,6 +88,11 @@ private:
   std::vector<dl_sched_po_info_t> pending_pdcch_orders;
 
   uint32_t po_aggr_level = 2;
+
+  // pending MCCH change notification
+  srsran::tti_point pending_mcch_notif_tti;
+  uint8_t           pending_mcch_notif    = 0;
+  uint32_t          mcch_notif_aggr_level = 2;
 };
 
 //! Broadcast (SIB + paging) scheduler
@@ -46,6 +46,7 @@ public:
   const static int MAX_DATA_LIST       = 32;
   const static int MAX_RAR_LIST        = 8;
   const static int MAX_BC_LIST         = 8;
+  const static int MAX_MTCH_SCHED      = 8;
   const static int MAX_PO_LIST         = 8;
   const static int MAX_RLC_PDU_LIST    = 8;
   const static int MAX_PHICH_LIST      = 8;
@@ -177,12 +178,11 @@ public:
     uint32_t lcid;
     uint32_t lcid_buffer_size;
     uint32_t stop;
-    uint8_t* mtch_payload;
   } dl_mtch_sched_t;
 
   typedef struct {
     dl_sched_pdu_t  pdu[20];
-    dl_mtch_sched_t mtch_sched[8];
+    dl_mtch_sched_t mtch_sched[MAX_MTCH_SCHED];
     uint32_t        num_mtch_sched;
     uint8_t*        mcch_payload;
     uint32_t        current_sf_allocation_num;
@@ -244,12 +244,18 @@ public:
     uint32_t        prach_mask_idx;
   } dl_sched_po_t;
 
+  /// DCI-only MCCH change notification on the M-RNTI
+  typedef struct {
+    srsran_dci_dl_t dci;
+  } dl_sched_mcch_notif_t;
+
   struct dl_sched_res_t {
     uint32_t                                               cfi;
     srsran::bounded_vector<dl_sched_data_t, MAX_DATA_LIST> data;
     srsran::bounded_vector<dl_sched_rar_t, MAX_RAR_LIST>   rar;
     srsran::bounded_vector<dl_sched_bc_t, MAX_BC_LIST>     bc;
     srsran::bounded_vector<dl_sched_po_t, MAX_PO_LIST>     po;
+    srsran::bounded_vector<dl_sched_mcch_notif_t, 1>       mcch_notif;
   };
 
   typedef struct {
@@ -325,6 +331,9 @@ public:
   /* PDCCH order */
   virtual int set_pdcch_order(uint32_t enb_cc_idx, dl_sched_po_info_t pdcch_order_info) = 0;
 
+  /* MCCH change notification to send in the given TTI, one bit per MBSFN area notification indicator */
+  virtual int set_mcch_notif(uint32_t enb_cc_idx, uint32_t tti_tx_dl, uint8_t notif_bitmap) = 0;
+
   /* Custom */
   virtual void                                 set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs)        = 0;
   virtual std::array<int, SRSRAN_MAX_CARRIERS> get_enb_ue_cc_map(uint16_t rnti)                            = 0;
@@ -118,6 +118,8 @@ void generate_pdcch_order_dci(sched_interface::dl_sched_po_t& pdcch_order,
                               const sched_cell_params_t&      cell_params,
                               uint32_t                        current_cfi);
 
+void generate_mcch_notif_dci(sched_interface::dl_sched_mcch_notif_t& notif, uint8_t notif_bitmap);
+
 void log_broadcast_allocation(const sched_interface::dl_sched_bc_t& bc,
                               rbg_interval                          rbg_range,
                               const sched_cell_params_t&            cell_params);
@@ -26,6 +26,7 @@
 #include "rrc_cell_cfg.h"
 #include "rrc_metrics.h"
 #include "srsenb/hdr/common/common_enb.h"
+#include "srsenb/hdr/common/mbsfn_area_map.h"
 #include "srsenb/hdr/common/rnti_pool.h"
 #include "srsran/adt/circular_buffer.h"
 #include "srsran/common/bearer_manager.h"
@@ -83,6 +84,20 @@ public:
   void get_metrics(rrc_metrics_t& m);
   void tti_clock();
 
+  /**
+   * Adds an MBMS session to a PMCH of an MBSFN area. The MRB is set up right away, while the new MCCH is sent from
+   * the start of the next MCCH modification period
+   * @param session_id MBMS session ID, or a negative value to leave it out of the MCCH
+   */
+  int mbms_session_start(uint32_t           area_idx,
+                         uint32_t           pmch_idx,
+                         const std::string& plmn,
+                         uint32_t           service_id,
+                         uint32_t           lcid,
+                         int                session_id);
+  /// Removes the MBMS session of a TMGI from all the MBSFN areas
+  int mbms_session_stop(const std::string& plmn, uint32_t service_id);
+
   // rrc_interface_mac
   int      add_user(uint16_t rnti, const sched_interface::ue_cfg_t& init_ue_cfg) override;
   void     upd_user(uint16_t new_rnti, uint16_t old_rnti) override;
@@ -91,6 +106,7 @@ public:
   void     set_radiolink_ul_state(uint16_t rnti, bool crc_res) override;
   bool     is_paging_opportunity(uint32_t tti, uint32_t* payload_len) override;
   uint8_t* read_pdu_bcch_dlsch(const uint8_t cc_idx, const uint32_t sib_index) override;
+  void     mcch_applied(uint32_t area_idx, uint32_t version) override;
 
   // rrc_interface_rlc
   void read_pdu_pcch(uint32_t tti_tx_dl, uint8_t* payload, uint32_t buffer_size) override;
@@ -194,16 +210,21 @@ private:
   void     rem_user(uint16_t rnti);
   uint32_t generate_sibs();
   void     configure_mbsfn_sibs();
-  int      pack_mcch();
+  void     generate_default_mcch(uint32_t area_idx, asn1::rrc::mbsfn_area_cfg_r9_s& area_cfg);
+  void     init_mcch(uint32_t area_idx);
+  int      pack_mcch(uint32_t area_idx);
+  void     update_mcch(uint32_t area_idx);
+  int      add_mrb(uint32_t area_idx, uint32_t pmch_idx, const asn1::rrc::mbms_session_info_r9_s& session);
+  void     rem_mrb(uint32_t lcid);
+  void     release_stopped_mrbs(uint32_t area_idx, uint32_t version);
 
   void config_mac();
   void parse_ul_dcch(ue& ue, uint32_t lcid, srsran::unique_byte_buffer_t pdu);
   void parse_ul_ccch(ue& ue, srsran::unique_byte_buffer_t pdu);
   void send_rrc_connection_reject(uint16_t rnti);
 
-  const static int mcch_payload_len                      = 3000;
-  int              current_mcch_length                   = 0;
-  uint8_t          mcch_payload_buffer[mcch_payload_len] = {};
+  const static int                   mcch_payload_len = 3000;
+  std::vector<std::vector<uint8_t> > mcch_payload_list; ///< Packed MCCH of each MBSFN area, including the RLC header
   struct rrc_pdu {
     uint16_t                     rnti;
     uint32_t                     lcid;
@@ -222,15 +243,27 @@ private:
   const static uint32_t LCID_RADLINK_DL = 0xffff0006;
   const static uint32_t LCID_RADLINK_UL = 0xffff0007;
   const static uint32_t LCID_PROT_FAIL  = 0xffff0008;
+  const static uint32_t LCID_MCCH_APPL  = 0xffff0009;
 
   bool                                running = false;
   srsran::dyn_blocking_queue<rrc_pdu> rx_pdu_queue;
 
-  asn1::rrc::mcch_msg_s  mcch;
-  bool                   enable_mbms     = false;
-  rrc_cfg_t              cfg             = {};
-  uint32_t               nof_si_messages = 0;
-  asn1::rrc::sib_type7_s sib7;
+  std::vector<asn1::rrc::mcch_msg_s> mcch_list;    ///< MCCH of each MBSFN area, in the order of the SIB13 area list
+  std::vector<uint32_t>              mcch_version; ///< Version of the last MCCH of each MBSFN area passed to MAC
+  mbsfn_area_map                     mbsfn_map;
+  bool                               enable_mbms     = false;
+  rrc_cfg_t                          cfg             = {};
+  uint32_t                           nof_si_messages = 0;
+  asn1::rrc::sib_type7_s             sib7;
+
+  /// MRB of a stopped MBMS session, kept until MAC transmits the MCCH that no longer announces it
+  struct stopped_mrb_t {
+    uint32_t area_idx;
+    uint32_t mcch_version;
+    uint32_t lcid;
+    uint32_t service_id;
+  };
+  std::vector<stopped_mrb_t> stopped_mrbs;
 
   void rem_user_thread(uint16_t rnti);
 };
@@ -79,6 +79,8 @@ struct rrc_cfg_t {
   std::map<uint32_t, rrc_cfg_qci_t>                                                       qci_cfg;
   bool                                                                                    enable_mbsfn;
   uint16_t                                                                                mbms_mcs;
+  bool                                                                                    mbms_m1u_teid_per_service;
+  std::vector<asn1::rrc::mbsfn_area_cfg_r9_s>                                             mbsfn_area_cfg_list;
   uint32_t                                                                                inactivity_timeout_ms;
   std::array<srsran::CIPHERING_ALGORITHM_ID_ENUM, srsran::CIPHERING_ALGORITHM_ID_N_ITEMS> eea_preference_list;
   std::array<srsran::INTEGRITY_ALGORITHM_ID_ENUM, srsran::INTEGRITY_ALGORITHM_ID_N_ITEMS> eia_preference_list;
@@ -19,17 +19,21 @@
  *
  */
 
+#include <array>
+#include <atomic>
 #include <map>
 #include <unordered_map>
 #include <string.h>
 
 #include "srsenb/hdr/common/common_enb.h"
+#include "srsenb/hdr/stack/upper/mtch_ingress_queue.h"
 #include "srsran/adt/bounded_vector.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/network_utils.h"
 #include "srsran/common/task_scheduler.h"
 #include "srsran/common/threads.h"
+#include "srsran/common/udp_pcap_reader.h"
 #include "srsran/interfaces/enb_gtpu_interfaces.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/srslog/srslog.h"
@@ -188,25 +192,63 @@ private:
   class m1u_handler
   {
   public:
-    explicit m1u_handler(gtpu* gtpu_) : parent(gtpu_), logger(parent->logger) {}
+    explicit m1u_handler(gtpu* gtpu_) : parent(gtpu_), logger(parent->logger), replay_reader(logger) {}
     ~m1u_handler();
     m1u_handler(const m1u_handler&) = delete;
     m1u_handler(m1u_handler&&)      = delete;
     m1u_handler& operator=(const m1u_handler&) = delete;
     m1u_handler& operator=(m1u_handler&&) = delete;
     bool         init(std::string m1u_multiaddr_, std::string m1u_if_addr_);
+    bool         init_replay(const std::string& pcap_filename);
     void         handle_rx_packet(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr);
+    void         add_mtch(uint32_t lcid, uint32_t teid, uint32_t pmch_id, uint32_t rate_bps, uint32_t burst_bytes);
+    void         rem_mtch(uint32_t lcid);
+    void         rem_all_mtch();
 
   private:
+    int  find_lcid(uint32_t teid) const;
+    void release_mtch_queues(mtch_ingress_queue::clock::time_point t_now);
+    void run_mtch_queues();
+    void run_replay();
+
+    mtch_ingress_queue::clock::time_point now() const;
+
     gtpu*                 parent = nullptr;
     pdcp_interface_gtpu*  pdcp   = nullptr;
     srslog::basic_logger& logger;
     std::string           m1u_multiaddr;
     std::string           m1u_if_addr;
 
-    bool initiated      = false;
-    int  m1u_sd         = -1;
-    int  bearer_counter = 0;
+    // Maximum number of M1-U datagrams read from the socket with a single system call
+    static const uint32_t rx_batch_size = 32;
+
+    bool initiated = false;
+    int  m1u_sd    = -1;
+
+    // M1-U TEID of each MTCH, indexed by LCID. Entries are written when MRBs are set up and read for every received
+    // packet, without locking
+    static const uint64_t                                 teid_valid = 1ULL << 32;
+    std::array<std::atomic<uint64_t>, SRSRAN_N_MCH_LCIDS> lcid_teid  = {};
+
+    // Ingress queue of each MTCH, drained towards PDCP every TTI. The MTCHs of a PMCH share its token bucket
+    struct mtch_queue_t {
+      std::unique_ptr<mtch_ingress_queue> queue;
+      uint64_t                            reported_drops = 0;
+    };
+    std::map<uint32_t, mtch_queue_t>                     mtch_queues;
+    std::map<uint32_t, std::weak_ptr<mtch_token_bucket>> pmch_buckets;
+    srsran::unique_timer                                 mtch_timer;
+    uint32_t                                             mtch_report_counter = 0;
+
+    // Replay of a capture instead of the multicast socket, paced by the stack TTIs. The ingress queues then run on
+    // the same synthetic clock, so the PHY may render the signal faster or slower than real time
+    bool                                  replay = false;
+    srsran::udp_pcap_reader               replay_reader;
+    srsran::unique_byte_buffer_t          replay_pdu;
+    srsran::udp_pcap_reader::datagram_t   replay_info;
+    srsran::unique_timer                  replay_timer;
+    uint64_t                              replay_ms    = 0;
+    mtch_ingress_queue::clock::time_point replay_epoch = {};
   };
   m1u_handler m1u;
 
@@ -0,0 +1,112 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_MTCH_INGRESS_QUEUE_H
+#define SRSENB_MTCH_INGRESS_QUEUE_H
+
+#include "srsran/common/byte_buffer.h"
+#include <chrono>
+#include <deque>
+#include <memory>
+
+namespace srsenb {
+
+/**
+ * Token bucket releasing packets at the rate of a PMCH. The ingress queues of all the MTCHs multiplexed in the PMCH
+ * share it, so that together they do not exceed its capacity.
+ */
+class mtch_token_bucket
+{
+public:
+  using clock = std::chrono::high_resolution_clock;
+
+  mtch_token_bucket(uint32_t rate_bps_, uint32_t bucket_bytes_, clock::time_point now);
+
+  /// Takes the tokens of a packet if there are any left. Tokens may go negative after a large packet
+  bool consume(uint32_t nof_bytes, clock::time_point now);
+
+private:
+  void refill(clock::time_point now);
+
+  uint32_t          rate_bps;
+  uint32_t          bucket_bytes;
+  int64_t           tokens = 0; ///< In bytes
+  clock::time_point last_refill;
+  uint64_t          refill_rem = 0; ///< Remainder of the refill, in bits times microseconds
+};
+
+/**
+ * Ingress stage of an MTCH, between the M1-U interface and PDCP/RLC.
+ * Packets are released at the rate of the PMCH that carries the MTCH by a token bucket, so that bursts are absorbed
+ * here rather than in the RLC queue, where they would add latency. Packets that waited for longer than the maximum
+ * delay are dropped on release, and the oldest packets are dropped when the queue is full.
+ */
+class mtch_ingress_queue
+{
+public:
+  using clock = mtch_token_bucket::clock;
+
+  struct args_t {
+    uint32_t rate_bps     = 0; ///< Token bucket rate. 0 releases packets as soon as they arrive, unless shared
+    uint32_t bucket_bytes = 0; ///< Token bucket depth
+    uint32_t max_delay_ms = 0; ///< Maximum time a packet can wait in the queue. 0 disables the check
+    uint32_t max_bytes    = 0; ///< Queue capacity. 0 disables the check
+  };
+
+  struct metrics_t {
+    uint64_t rx_pkts               = 0;
+    uint64_t rx_bytes              = 0;
+    uint64_t tx_pkts               = 0;
+    uint64_t tx_bytes              = 0;
+    uint64_t dropped_late_pkts     = 0; ///< Packets dropped for exceeding the maximum delay
+    uint64_t dropped_overflow_pkts = 0; ///< Packets dropped to make room for newer ones
+    uint64_t dropped_bytes         = 0;
+    uint32_t queued_pkts           = 0;
+    uint32_t queued_bytes          = 0;
+    uint32_t max_delay_us          = 0; ///< Longest wait of a released packet
+  };
+
+  explicit mtch_ingress_queue(const args_t& args_, clock::time_point now);
+
+  /// Queue drawing from the token bucket of its PMCH, shared with the other MTCHs of the PMCH. The rate and depth of
+  /// the arguments are not used
+  mtch_ingress_queue(const args_t& args_, std::shared_ptr<mtch_token_bucket> bucket_);
+
+  /// Enqueues a packet, timestamped with its arrival time
+  void push(srsran::unique_byte_buffer_t pdu, clock::time_point now);
+
+  /// Returns the next packet allowed by the token bucket, or nullptr if none is
+  srsran::unique_byte_buffer_t pop(clock::time_point now);
+
+  const metrics_t& get_metrics() const { return metrics; }
+
+private:
+  void drop_front(uint64_t& counter);
+
+  args_t                                   args;
+  metrics_t                                metrics;
+  std::deque<srsran::unique_byte_buffer_t> queue;
+  std::shared_ptr<mtch_token_bucket>       bucket; ///< nullptr when the queue is not shaped
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_MTCH_INGRESS_QUEUE_H
@@ -0,0 +1,207 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/common/mbsfn_area_map.h"
+#include "srsran/common/gen_mch_tables.h"
+#include <algorithm>
+
+namespace srsenb {
+
+bool mbsfn_area_map::is_alloc_sf(const srsran::mbsfn_sf_cfg_t& cfg, uint32_t sfn, uint32_t sf)
+{
+  uint8_t  table[40] = {};
+  uint32_t period    = enum_to_number(cfg.radioframe_alloc_period);
+  uint32_t offset    = cfg.radioframe_alloc_offset;
+
+  if (cfg.nof_alloc_subfrs == srsran::mbsfn_sf_cfg_t::sf_alloc_type_t::one_frame) {
+    generate_mch_table(table, cfg.sf_alloc, 1);
+    return (sfn % period == offset) and table[sf] > 0;
+  }
+  if (cfg.nof_alloc_subfrs == srsran::mbsfn_sf_cfg_t::sf_alloc_type_t::four_frames) {
+    generate_mch_table(table, cfg.sf_alloc, 4);
+    uint32_t idx = sfn % period;
+    return (idx >= offset) and (idx < offset + 4) and table[(idx - offset) * 10 + sf] > 0;
+  }
+  return false;
+}
+
+void mbsfn_area_map::configure(const srsran::sib2_mbms_t&             sib2,
+                               const srsran::sib13_t&                 sib13,
+                               const std::vector<srsran::mcch_msg_t>& mcch_list)
+{
+  sib2_sf_cfg_list.clear();
+  if (sib2.mbsfn_sf_cfg_list_present) {
+    for (int i = 0; i < sib2.nof_mbsfn_sf_cfg; ++i) {
+      sib2_sf_cfg_list.push_back(sib2.mbsfn_sf_cfg_list[i]);
+    }
+  }
+
+  // All the periods involved are powers of two that divide the SFN range, so the allocation of an area repeats after
+  // the largest of them
+  uint32_t sib2_nof_frames = 1;
+  for (const srsran::mbsfn_sf_cfg_t& sf_cfg : sib2_sf_cfg_list) {
+    sib2_nof_frames = std::max(sib2_nof_frames, (uint32_t)enum_to_number(sf_cfg.radioframe_alloc_period));
+  }
+
+  areas.clear();
+  areas.resize(std::min((size_t)sib13.nof_mbsfn_area_info, mcch_list.size()));
+  for (uint32_t a = 0; a < areas.size(); ++a) {
+    const srsran::mbsfn_area_info_t& area_info = sib13.mbsfn_area_info_list[a];
+    const srsran::mcch_msg_t&        mcch      = mcch_list[a];
+    area_t&                          area      = areas[a];
+
+    area.mcch_period = enum_to_number(area_info.mcch_cfg.mcch_repeat_period);
+    area.mcch_offset = area_info.mcch_cfg.mcch_offset;
+    area.notif_ind   = area_info.notif_ind;
+    generate_mcch_table(area.mcch_table, area_info.mcch_cfg.sf_alloc_info);
+
+    uint32_t csa_period = enum_to_number(mcch.common_sf_alloc_period);
+    area.nof_frames     = std::max(csa_period, sib2_nof_frames);
+    for (uint32_t i = 0; i < mcch.nof_common_sf_alloc; ++i) {
+      area.nof_frames =
+          std::max(area.nof_frames, (uint32_t)enum_to_number(mcch.common_sf_alloc[i].radioframe_alloc_period));
+    }
+    for (uint32_t p = 0; p < mcch.nof_pmch_info; ++p) {
+      area.nof_frames = std::max(area.nof_frames, (uint32_t)enum_to_number(mcch.pmch_info_list[p].mch_sched_period));
+    }
+
+    area.sf_table.assign(area.nof_frames * 10, {});
+    area.nof_sf_per_msp.assign(mcch.nof_pmch_info, 0);
+    std::vector<uint32_t> msp_count(mcch.nof_pmch_info, 0);
+    std::vector<uint32_t> total_count(mcch.nof_pmch_info, 0);
+
+    uint32_t csa_idx = 0;
+    for (uint32_t sfn = 0; sfn < area.nof_frames; ++sfn) {
+      if (sfn % csa_period == 0) {
+        csa_idx = 0;
+      }
+      for (uint32_t p = 0; p < mcch.nof_pmch_info; ++p) {
+        if (sfn % enum_to_number(mcch.pmch_info_list[p].mch_sched_period) == 0) {
+          msp_count[p] = 0;
+        }
+      }
+      for (uint32_t sf = 0; sf < 10; ++sf) {
+        bool in_sib2 = std::any_of(sib2_sf_cfg_list.begin(),
+                                   sib2_sf_cfg_list.end(),
+                                   [sfn, sf](const srsran::mbsfn_sf_cfg_t& c) { return is_alloc_sf(c, sfn, sf); });
+        bool in_csa  = false;
+        for (uint32_t i = 0; i < mcch.nof_common_sf_alloc and not in_csa; ++i) {
+          in_csa = is_alloc_sf(mcch.common_sf_alloc[i], sfn, sf);
+        }
+        if (not in_sib2 or not in_csa) {
+          continue;
+        }
+
+        // PMCH p is allocated the CSA subframes following the last one of PMCH p-1, up to sf_alloc_end
+        uint32_t start = 0;
+        for (uint32_t p = 0; p < mcch.nof_pmch_info; ++p) {
+          uint32_t end = mcch.pmch_info_list[p].sf_alloc_end;
+          if (csa_idx >= start and csa_idx <= end) {
+            sf_entry_t& entry   = area.sf_table[sfn * 10 + sf];
+            entry.pmch_idx      = p;
+            entry.sf_idx_in_msp = msp_count[p]++;
+            total_count[p]++;
+            break;
+          }
+          start = end + 1;
+        }
+        csa_idx++;
+      }
+    }
+
+    for (uint32_t p = 0; p < mcch.nof_pmch_info; ++p) {
+      uint32_t nof_msp       = area.nof_frames / enum_to_number(mcch.pmch_info_list[p].mch_sched_period);
+      area.nof_sf_per_msp[p] = total_count[p] / std::max(nof_msp, 1u);
+    }
+  }
+
+  // The notification occasions are common to all areas, repeating a number of times within the shortest MCCH
+  // modification period. notificationSF-Index 1 to 6 selects FDD subframes 1, 2, 3, 6, 7 and 8
+  static const uint32_t notif_sf_table[] = {1, 2, 3, 6, 7, 8};
+  uint32_t              mod_period       = 0;
+  for (uint32_t a = 0; a < areas.size(); ++a) {
+    uint32_t area_mod_period = enum_to_number(sib13.mbsfn_area_info_list[a].mcch_cfg.mcch_mod_period);
+    mod_period               = (a == 0) ? area_mod_period : std::min(mod_period, area_mod_period);
+  }
+  uint32_t coeff = sib13.notif_cfg.notif_repeat_coeff == srsran::mbms_notif_cfg_t::coeff_t::n2 ? 2 : 4;
+  notif_period   = 0;
+  if (mod_period > 0 and sib13.notif_cfg.notif_sf_idx >= 1 and sib13.notif_cfg.notif_sf_idx <= 6) {
+    notif_period = mod_period / coeff;
+    notif_offset = sib13.notif_cfg.notif_offset;
+    notif_sf     = notif_sf_table[sib13.notif_cfg.notif_sf_idx - 1];
+  }
+
+  configured = true;
+}
+
+bool mbsfn_area_map::is_mbsfn_sf(uint32_t tti) const
+{
+  uint32_t sfn = tti / 10;
+  uint32_t sf  = tti % 10;
+  return std::any_of(sib2_sf_cfg_list.begin(), sib2_sf_cfg_list.end(), [sfn, sf](const srsran::mbsfn_sf_cfg_t& c) {
+    return is_alloc_sf(c, sfn, sf);
+  });
+}
+
+bool mbsfn_area_map::get_sf_alloc(uint32_t tti, mbsfn_sf_alloc_t& sf_alloc) const
+{
+  if (not configured or not is_mbsfn_sf(tti)) {
+    return false;
+  }
+
+  uint32_t sfn = tti / 10;
+  uint32_t sf  = tti % 10;
+  for (uint32_t a = 0; a < areas.size(); ++a) {
+    const area_t&     area    = areas[a];
+    const sf_entry_t& entry   = area.sf_table[(sfn % area.nof_frames) * 10 + sf];
+    bool              is_mcch = (sfn % area.mcch_period == area.mcch_offset) and area.mcch_table[sf] > 0;
+    if (entry.pmch_idx < 0 and not is_mcch) {
+      continue;
+    }
+    sf_alloc.area_idx      = a;
+    sf_alloc.has_pmch      = entry.pmch_idx >= 0;
+    sf_alloc.pmch_idx      = sf_alloc.has_pmch ? entry.pmch_idx : 0;
+    sf_alloc.sf_idx_in_msp = entry.sf_idx_in_msp;
+    sf_alloc.is_mcch       = is_mcch;
+    return true;
+  }
+  return false;
+}
+
+uint32_t mbsfn_area_map::get_nof_sf_per_msp(uint32_t area_idx, uint32_t pmch_idx) const
+{
+  if (area_idx >= areas.size() or pmch_idx >= areas[area_idx].nof_sf_per_msp.size()) {
+    return 0;
+  }
+  return areas[area_idx].nof_sf_per_msp[pmch_idx];
+}
+
+bool mbsfn_area_map::is_mcch_notif_sf(uint32_t tti) const
+{
+  return notif_period > 0 and (tti / 10) % notif_period == notif_offset and tti % 10 == notif_sf;
+}
+
+uint32_t mbsfn_area_map::get_notif_ind(uint32_t area_idx) const
+{
+  return area_idx < areas.size() ? areas[area_idx].notif_ind : 0;
+}
+
+} // namespace srsenb
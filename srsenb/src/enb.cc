@@ -212,6 +212,7 @@ bool enb::get_metrics(enb_metrics_t* m)
   }
   radio->get_metrics(&m->rf);
   phy->get_metrics(m->phy);
+  phy->get_tx_metrics(m->phy_tx);
   if (eutra_stack) {
     eutra_stack->get_metrics(&m->stack);
   }
@@ -263,6 +264,31 @@ void enb::toggle_padding()
   }
 }
 
+void enb::cmd_mbms_session_start(uint32_t           area_idx,
+                                 uint32_t           pmch_idx,
+                                 const std::string& plmn,
+                                 uint32_t           service_id,
+                                 uint32_t           lcid,
+                                 int                session_id)
+{
+  if (!started) {
+    return;
+  }
+  if (eutra_stack) {
+    eutra_stack->mbms_session_start(area_idx, pmch_idx, plmn, service_id, lcid, session_id);
+  }
+}
+
+void enb::cmd_mbms_session_stop(const std::string& plmn, uint32_t service_id)
+{
+  if (!started) {
+    return;
+  }
+  if (eutra_stack) {
+    eutra_stack->mbms_session_stop(plmn, service_id);
+  }
+}
+
 void enb::tti_clock()
 {
   if (!started) {
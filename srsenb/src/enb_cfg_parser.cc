@@ -258,6 +258,24 @@ bool extract_sf_alloc(mbsfn_sf_cfg_s::sf_alloc_c_* store_ptr, const char* name,
   return false;
 }
 
+static int parse_mbsfn_sf_cfg(mbsfn_sf_cfg_s* sf_cfg, Setting& root)
+{
+  field_asn1_choice_number<mbsfn_sf_cfg_s::sf_alloc_c_> c(
+      "subframeAllocation", "subframeAllocationNumFrames", &extract_sf_alloc, &sf_cfg->sf_alloc);
+  HANDLEPARSERCODE(c.parse(root));
+
+  sf_cfg->radioframe_alloc_offset = 0;
+  parser::field<uint8_t> f("radioframeAllocationOffset", &sf_cfg->radioframe_alloc_offset);
+  f.parse(root);
+
+  sf_cfg->radioframe_alloc_period.value = mbsfn_sf_cfg_s::radioframe_alloc_period_opts::n1;
+  field_asn1_enum_number<mbsfn_sf_cfg_s::radioframe_alloc_period_e_> e("radioframeAllocationPeriod",
+                                                                       &sf_cfg->radioframe_alloc_period);
+  HANDLEPARSERCODE(e.parse(root));
+
+  return 0;
+}
+
 int mbsfn_sf_cfg_list_parser::parse(Setting& root)
 {
   if (not root.exists("mbsfnSubframeConfigList")) {
@@ -281,88 +299,157 @@ int mbsfn_sf_cfg_list_parser::parse(Setting& root)
   *enabled = true;
   mbsfn_list->resize(len);
 
-  field_asn1_choice_number<mbsfn_sf_cfg_s::sf_alloc_c_> c(
-      "subframeAllocation", "subframeAllocationNumFrames", &extract_sf_alloc, &(*mbsfn_list)[0].sf_alloc);
-  HANDLEPARSERCODE(c.parse(root["mbsfnSubframeConfigList"]));
+  HANDLEPARSERCODE(parse_mbsfn_sf_cfg(&(*mbsfn_list)[0], root["mbsfnSubframeConfigList"]));
 
-  parser::field<uint8_t> f("radioframeAllocationOffset", &(*mbsfn_list)[0].radioframe_alloc_offset);
-  f.parse(root["mbsfnSubframeConfigList"]);
+  // TODO: Did you forget subframeAllocationNumFrames?
 
-  (*mbsfn_list)[0].radioframe_alloc_period.value = mbsfn_sf_cfg_s::radioframe_alloc_period_opts::n1;
-  field_asn1_enum_number<mbsfn_sf_cfg_s::radioframe_alloc_period_e_> e("radioframeAllocationPeriod",
-                                                                       &(*mbsfn_list)[0].radioframe_alloc_period);
-  HANDLEPARSERCODE(e.parse(root["mbsfnSubframeConfigList"]));
+  return 0;
+}
 
-  // TODO: Did you forget subframeAllocationNumFrames?
+static int parse_mbms_session_info(mbms_session_info_r9_s* session, Setting& root)
+{
+  parser::field<uint8_t> lcid("lcid", &session->lc_ch_id_r9);
+  if (lcid.parse(root)) {
+    fprintf(stderr, "Error parsing lcid\n");
+    return SRSRAN_ERROR;
+  }
+  // The LCID doubles as EPS bearer ID of the M1-U tunnel of the MTCH
+  if (session->lc_ch_id_r9 < 1 or not srsran::is_lte_rb(session->lc_ch_id_r9)) {
+    fprintf(stderr, "Invalid MTCH lcid %d, must be within [1, %d]\n", session->lc_ch_id_r9, srsran::MAX_LTE_LCID);
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t session_id           = 0;
+  session->session_id_r9_present = root.lookupValue("session_id", session_id);
+  session->session_id_r9.from_number(session_id);
+
+  std::string       tmgi_plmn = "90156";
+  srsran::plmn_id_t plmn_id;
+  root.lookupValue("tmgi_plmn", tmgi_plmn);
+  if (plmn_id.from_string(tmgi_plmn) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error parsing tmgi_plmn %s\n", tmgi_plmn.c_str());
+    return SRSRAN_ERROR;
+  }
+  srsran::to_asn1(&session->tmgi_r9.plmn_id_r9.set_explicit_value_r9(), plmn_id);
+
+  uint32_t service_id = 0;
+  if (not root.lookupValue("tmgi_service_id", service_id)) {
+    fprintf(stderr, "Error parsing tmgi_service_id\n");
+    return SRSRAN_ERROR;
+  }
+  session->tmgi_r9.service_id_r9.from_number(service_id);
 
   return 0;
 }
 
-int mbsfn_area_info_list_parser::parse(Setting& root)
+// Parses the MBSFNAreaConfiguration sent on the MCCH of an MBSFN area. An empty common_sf_alloc is filled in by the RRC
+// with the SIB2 MBSFN subframe configuration
+static int parse_mbsfn_area_cfg(mbsfn_area_cfg_r9_s* area_cfg, Setting& root)
 {
-  if (not root.exists("mbsfn_area_info_list")) {
-    if (enabled) {
-      *enabled = false;
+  area_cfg->common_sf_alloc_period_r9.value = mbsfn_area_cfg_r9_s::common_sf_alloc_period_r9_opts::rf32;
+  if (root.exists("common_sf_alloc_period")) {
+    field_asn1_enum_str<mbsfn_area_cfg_r9_s::common_sf_alloc_period_r9_e_> period(
+        "common_sf_alloc_period", &area_cfg->common_sf_alloc_period_r9);
+    if (period.parse(root)) {
+      fprintf(stderr, "Error parsing common_sf_alloc_period\n");
+      return SRSRAN_ERROR;
     }
-    mbsfn_list->resize(0);
-    return 0;
   }
 
-  mbsfn_list->resize(1);
-  if (enabled) {
-    *enabled = true;
+  area_cfg->common_sf_alloc_r9.resize(0);
+  if (root.exists("common_sf_alloc")) {
+    area_cfg->common_sf_alloc_r9.resize(1);
+    HANDLEPARSERCODE(parse_mbsfn_sf_cfg(&area_cfg->common_sf_alloc_r9[0], root["common_sf_alloc"]));
   }
-  mbsfn_area_info_r9_s* mbsfn_item = &(*mbsfn_list)[0];
 
+  Setting& pmch_list = root["pmch_info_list"];
+  area_cfg->pmch_info_list_r9.resize((uint32_t)pmch_list.getLength());
+  for (uint32_t i = 0; i < area_cfg->pmch_info_list_r9.size(); ++i) {
+    pmch_info_r9_s* pmch_item = &area_cfg->pmch_info_list_r9[i];
+
+    parser::field<uint8_t> data_mcs("data_mcs", &pmch_item->pmch_cfg_r9.data_mcs_r9);
+    if (data_mcs.parse(pmch_list[i])) {
+      fprintf(stderr, "Error parsing data_mcs\n");
+      return SRSRAN_ERROR;
+    }
+
+    parser::field<uint16_t> sf_alloc_end("sf_alloc_end", &pmch_item->pmch_cfg_r9.sf_alloc_end_r9);
+    if (sf_alloc_end.parse(pmch_list[i])) {
+      fprintf(stderr, "Error parsing sf_alloc_end\n");
+      return SRSRAN_ERROR;
+    }
+
+    pmch_item->pmch_cfg_r9.mch_sched_period_r9.value = pmch_cfg_r9_s::mch_sched_period_r9_opts::rf32;
+    if (pmch_list[i].exists("mch_sched_period")) {
+      field_asn1_enum_str<pmch_cfg_r9_s::mch_sched_period_r9_e_> period("mch_sched_period",
+                                                                        &pmch_item->pmch_cfg_r9.mch_sched_period_r9);
+      if (period.parse(pmch_list[i])) {
+        fprintf(stderr, "Error parsing mch_sched_period\n");
+        return SRSRAN_ERROR;
+      }
+    }
+
+    Setting& session_list = pmch_list[i]["mbms_session_info_list"];
+    pmch_item->mbms_session_info_list_r9.resize((uint32_t)session_list.getLength());
+    for (uint32_t j = 0; j < pmch_item->mbms_session_info_list_r9.size(); ++j) {
+      HANDLEPARSERCODE(parse_mbms_session_info(&pmch_item->mbms_session_info_list_r9[j], session_list[j]));
+    }
+  }
+
+  return 0;
+}
+
+static int parse_mbsfn_area_info(mbsfn_area_info_r9_s* mbsfn_item, Setting& root)
+{
   field_asn1_enum_str<mbsfn_area_info_r9_s::non_mbsfn_region_len_e_> fieldlen("non_mbsfn_region_length",
                                                                               &mbsfn_item->non_mbsfn_region_len);
-  if (fieldlen.parse(root["mbsfn_area_info_list"])) {
+  if (fieldlen.parse(root)) {
     fprintf(stderr, "Error parsing non_mbsfn_region_length\n");
     return SRSRAN_ERROR;
   }
 
   field_asn1_enum_str<mbsfn_area_info_r9_s::mcch_cfg_r9_s_::mcch_repeat_period_r9_e_> repeat(
       "mcch_repetition_period", &mbsfn_item->mcch_cfg_r9.mcch_repeat_period_r9);
-  if (repeat.parse(root["mbsfn_area_info_list"])) {
+  if (repeat.parse(root)) {
     fprintf(stderr, "Error parsing mcch_repetition_period\n");
     return SRSRAN_ERROR;
   }
 
   field_asn1_enum_str<mbsfn_area_info_r9_s::mcch_cfg_r9_s_::mcch_mod_period_r9_e_> mod(
       "mcch_modification_period", &mbsfn_item->mcch_cfg_r9.mcch_mod_period_r9);
-  if (mod.parse(root["mbsfn_area_info_list"])) {
+  if (mod.parse(root)) {
     fprintf(stderr, "Error parsing mcch_modification_period\n");
     return SRSRAN_ERROR;
   }
 
   field_asn1_enum_str<mbsfn_area_info_r9_s::mcch_cfg_r9_s_::sig_mcs_r9_e_> sig("signalling_mcs",
                                                                                &mbsfn_item->mcch_cfg_r9.sig_mcs_r9);
-  if (sig.parse(root["mbsfn_area_info_list"])) {
+  if (sig.parse(root)) {
     fprintf(stderr, "Error parsing signalling_mcs\n");
     return SRSRAN_ERROR;
   }
 
   parser::field<uint16_t> areaid("mbsfn_area_id", &mbsfn_item->mbsfn_area_id_r9);
-  if (areaid.parse(root["mbsfn_area_info_list"])) {
+  if (areaid.parse(root)) {
     fprintf(stderr, "Error parsing mbsfn_area_id\n");
     return SRSRAN_ERROR;
   }
 
   parser::field<uint8_t> notif_ind("notification_indicator", &mbsfn_item->notif_ind_r9);
-  if (notif_ind.parse(root["mbsfn_area_info_list"])) {
+  if (notif_ind.parse(root)) {
     fprintf(stderr, "Error parsing notification_indicator\n");
     return SRSRAN_ERROR;
   }
 
   parser::field<uint8_t> offset("mcch_offset", &mbsfn_item->mcch_cfg_r9.mcch_offset_r9);
-  if (offset.parse(root["mbsfn_area_info_list"])) {
+  if (offset.parse(root)) {
     fprintf(stderr, "Error parsing mcch_offset\n");
     return SRSRAN_ERROR;
   }
 
   field_asn1_bitstring_number<asn1::fixed_bitstring<6>, uint8_t> alloc_info("sf_alloc_info",
                                                                             &mbsfn_item->mcch_cfg_r9.sf_alloc_info_r9);
-  if (alloc_info.parse(root["mbsfn_area_info_list"])) {
+  if (alloc_info.parse(root)) {
     fprintf(stderr, "Error parsing mbsfn_area_info_list\n");
     return SRSRAN_ERROR;
   }
@@ -370,6 +457,48 @@ int mbsfn_area_info_list_parser::parse(Setting& root)
   return 0;
 }
 
+int mbsfn_area_info_list_parser::parse(Setting& root)
+{
+  if (not root.exists("mbsfn_area_info_list")) {
+    if (enabled) {
+      *enabled = false;
+    }
+    mbsfn_list->resize(0);
+    if (mcch_list) {
+      mcch_list->clear();
+    }
+    return 0;
+  }
+
+  // Either a single area group or a list of area groups
+  Setting& list_root = root["mbsfn_area_info_list"];
+  uint32_t nof_areas = list_root.isList() ? (uint32_t)list_root.getLength() : 1;
+  if (nof_areas > ASN1_RRC_MAX_MBSFN_AREA) {
+    fprintf(stderr, "Only %d MBSFN areas are supported\n", ASN1_RRC_MAX_MBSFN_AREA);
+    return SRSRAN_ERROR;
+  }
+  mbsfn_list->resize(nof_areas);
+  if (mcch_list) {
+    mcch_list->clear();
+    mcch_list->resize(nof_areas);
+  }
+  if (enabled) {
+    *enabled = true;
+  }
+
+  for (uint32_t i = 0; i < nof_areas; ++i) {
+    Setting& area_root = list_root.isList() ? list_root[i] : list_root;
+    HANDLEPARSERCODE(parse_mbsfn_area_info(&(*mbsfn_list)[i], area_root));
+
+    // The MCCH of areas without pmch_info_list is generated by the RRC
+    if (mcch_list and area_root.exists("pmch_info_list")) {
+      HANDLEPARSERCODE(parse_mbsfn_area_cfg(&(*mcch_list)[i], area_root));
+    }
+  }
+
+  return 0;
+}
+
 int field_sf_mapping::parse(libconfig::Setting& root)
 {
   if (root.exists("subframe")) {
@@ -1498,6 +1627,20 @@ int set_derived_args(all_args_t* args_, rrc_cfg_t* rrc_cfg_, phy_cfg_t* phy_cfg_
                    args_->stack.mac.nof_prealloc_ues,
                    SRSENB_MAX_UES);
 
+  // A fixed device rate must be at least the LTE rate, non-integer ratios are only resampled on the Tx side
+  int lte_srate_hz = srsran_sampling_freq_hz(cell_cfg_.nof_prb);
+  if (std::isnormal(args_->rf.srate_hz) and lte_srate_hz > 0) {
+    ASSERT_VALID_CFG(args_->rf.srate_hz >= lte_srate_hz,
+                     "rf.srate=%.3f MHz is below the %.3f MHz sampling rate of %d PRB",
+                     args_->rf.srate_hz / 1e6,
+                     lte_srate_hz / 1e6,
+                     cell_cfg_.nof_prb);
+    ASSERT_VALID_CFG(args_->phy.tx_only or ((uint32_t)args_->rf.srate_hz % (uint32_t)lte_srate_hz) == 0,
+                     "rf.srate=%.3f MHz is not an integer multiple of %.3f MHz, which requires expert.tx_only",
+                     args_->rf.srate_hz / 1e6,
+                     lte_srate_hz / 1e6);
+  }
+
   // Check for a forced  DL EARFCN or frequency (only valid for a single cell config
   if (rrc_cfg_->cell_list.size() > 0) {
     if (rrc_cfg_->cell_list.size() == 1) {
@@ -1621,8 +1764,9 @@ int set_derived_args(all_args_t* args_, rrc_cfg_t* rrc_cfg_, phy_cfg_t* phy_cfg_
           args_->general.rrc_inactivity_timer,
           min_rrc_inactivity_timer);
   }
-  rrc_cfg_->enable_mbsfn = args_->stack.embms.enable;
-  rrc_cfg_->mbms_mcs     = args_->stack.embms.mcs;
+  rrc_cfg_->enable_mbsfn              = args_->stack.embms.enable;
+  rrc_cfg_->mbms_mcs                  = args_->stack.embms.mcs;
+  rrc_cfg_->mbms_m1u_teid_per_service = args_->stack.embms.m1u_teid_per_service;
 
   // Check number of control symbols
   if (args_->stack.mac.sched.min_nof_ctrl_symbols > args_->stack.mac.sched.max_nof_ctrl_symbols) {
@@ -2218,7 +2362,7 @@ int parse_sib15(std::string filename, sib_type15_r11_s* data)
   data->mbms_sai_intra_freq_r11[3] = 4;
   return 0;
 }
-int parse_sib13(std::string filename, sib_type13_r9_s* data)
+int parse_sib13(std::string filename, sib_type13_r9_s* data, std::vector<mbsfn_area_cfg_r9_s>* mcch_list)
 {
   parser::section sib13("sib13");
 
@@ -2236,7 +2380,7 @@ int parse_sib13(std::string filename, sib_type13_r9_s* data)
   mbsfn_notification_config.add_field(
       new parser::field<uint8>("mbsfn_notification_sf_index", &data->notif_cfg_r9.notif_sf_idx_r9));
 
-  sib13.add_field(new mbsfn_area_info_list_parser(&data->mbsfn_area_info_list_r9, nullptr));
+  sib13.add_field(new mbsfn_area_info_list_parser(&data->mbsfn_area_info_list_r9, nullptr, mcch_list));
 
   return parser::parse_section(std::move(filename), &sib13);
 }
@@ -2333,7 +2477,8 @@ int parse_sibs(all_args_t* args_, rrc_cfg_t* rrc_cfg_, srsenb::phy_cfg_t* phy_co
   }
 
   if (sib_is_present(sib1->sched_info_list, sib_type_e::sib_type13_v920)) {
-    if (sib_sections::parse_sib13(args_->enb_files.sib_config, sib13) != SRSRAN_SUCCESS) {
+    if (sib_sections::parse_sib13(args_->enb_files.sib_config, sib13, &rrc_cfg_->mbsfn_area_cfg_list) !=
+        SRSRAN_SUCCESS) {
       return SRSRAN_ERROR;
     }
   }
@@ -65,7 +65,9 @@ int parse_sib3(std::string filename, asn1::rrc::sib_type3_s* data);
 int parse_sib4(std::string filename, asn1::rrc::sib_type4_s* data);
 int parse_sib7(std::string filename, asn1::rrc::sib_type7_s* data);
 int parse_sib9(std::string filename, asn1::rrc::sib_type9_s* data);
-int parse_sib13(std::string filename, asn1::rrc::sib_type13_r9_s* data);
+int parse_sib13(std::string                                   filename,
+                asn1::rrc::sib_type13_r9_s*                   data,
+                std::vector<asn1::rrc::mbsfn_area_cfg_r9_s>* mcch_list);
 int parse_sibs(all_args_t* args_, rrc_cfg_t* rrc_cfg_, srsenb::phy_cfg_t* phy_config_common);
 
 } // namespace sib_sections
@@ -590,15 +592,18 @@ private:
 class mbsfn_area_info_list_parser final : public parser::field_itf
 {
 public:
-  mbsfn_area_info_list_parser(asn1::rrc::mbsfn_area_info_list_r9_l* mbsfn_list_, bool* enabled_) :
-    mbsfn_list(mbsfn_list_), enabled(enabled_)
+  mbsfn_area_info_list_parser(asn1::rrc::mbsfn_area_info_list_r9_l*         mbsfn_list_,
+                              bool*                                         enabled_,
+                              std::vector<asn1::rrc::mbsfn_area_cfg_r9_s>* mcch_list_ = nullptr) :
+    mbsfn_list(mbsfn_list_), enabled(enabled_), mcch_list(mcch_list_)
   {}
   int         parse(Setting& root) override;
   const char* get_name() override { return "mbsfn_area_info_list"; }
 
 private:
-  asn1::rrc::mbsfn_area_info_list_r9_l* mbsfn_list;
-  bool*                                 enabled;
+  asn1::rrc::mbsfn_area_info_list_r9_l*         mbsfn_list;
+  bool*                                         enabled;
+  std::vector<asn1::rrc::mbsfn_area_cfg_r9_s>* mcch_list;
 };
 } // namespace srsenb
 
@@ -112,6 +112,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("rf.device_name",       bpo::value<string>(&args->rf.device_name)->default_value("auto"),       "Front-end device name")
     ("rf.device_args",       bpo::value<string>(&args->rf.device_args)->default_value("auto"),       "Front-end device arguments")
     ("rf.time_adv_nsamples", bpo::value<string>(&args->rf.time_adv_nsamples)->default_value("auto"), "Transmission time advance")
+    ("rf.tx_fifo_ms",        bpo::value<uint32_t>(&args->rf.tx_fifo_ms)->default_value(0),          "Depth of the Tx FIFO feeding the devices from a dedicated thread in ms, 0 disables it")
 
     ("gui.enable",        bpo::value<bool>(&args->gui.enable)->default_value(false),          "Enable GUI plots")
 
@@ -239,7 +240,18 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.pusch_meas_evm", bpo::value<bool>(&args->phy.pusch_meas_evm)->default_value(false), "Enable/Disable PUSCH EVM measure.")
     ("expert.tx_amplitude", bpo::value<float>(&args->phy.tx_amplitude)->default_value(0.6), "Transmit amplitude factor.")
     ("expert.nof_phy_threads", bpo::value<uint32_t>(&args->phy.nof_phy_threads)->default_value(3), "Number of PHY threads.")
+    ("expert.nof_fec_threads", bpo::value<uint32_t>(&args->phy.nof_fec_threads)->default_value(0), "Number of threads shared by the PHY workers for turbo encoding the code blocks of a TB in parallel (0 to disable).")
+    ("expert.fec_cpu_mask", bpo::value<uint32_t>(&args->phy.fec_cpu_mask)->default_value(0), "Bit mask of the CPUs the FEC threads may run on (0 for any).")
     ("expert.nof_prach_threads", bpo::value<uint32_t>(&args->phy.nof_prach_threads)->default_value(1), "Number of PRACH workers per carrier. Only 1 or 0 is supported.")
+    ("expert.tx_only", bpo::value<bool>(&args->phy.tx_only)->default_value(false), "Downlink-only broadcast operation: no reception, PRACH or uplink processing. TTIs are timed on the radio clock.")
+    ("expert.tx_lookahead_ms", bpo::value<uint32_t>(&args->phy.tx_lookahead_ms)->default_value(FDD_HARQ_DELAY_UL_MS), "TX only: time in ms subframes are generated ahead of their air time.")
+    ("expert.tx_lookahead_max_ms", bpo::value<uint32_t>(&args->phy.tx_lookahead_max_ms)->default_value(0), "TX only: the lookahead widens by 1 ms, up to this value, whenever the TX slack falls below tx_slack_min_us (0 keeps it fixed).")
+    ("expert.tx_slack_min_us", bpo::value<uint32_t>(&args->phy.tx_slack_min_us)->default_value(500), "TX only: smallest time in us subframes may reach the radio ahead of their air time before the adaptive lookahead widens.")
+    ("expert.tx_burst_sf", bpo::value<uint32_t>(&args->phy.tx_burst_sf)->default_value(1), "TX only: number of consecutive subframes dispatched ahead to the PHY workers per wakeup of the TX thread.")
+    ("expert.tx_offline", bpo::value<bool>(&args->phy.tx_offline)->default_value(false), "Render the downlink as fast as possible on a synthetic clock, e.g. to a file RF device. Implies tx_only.")
+    ("expert.tx_offline_sf", bpo::value<uint32_t>(&args->phy.tx_offline_sf)->default_value(0), "TX offline: number of subframes rendered before the eNB quits (0 for no limit).")
+    ("expert.tx_time_ref", bpo::value<string>(&args->phy.tx_time_ref)->default_value("none"), "TX only: absolute time the TTI and SFN numbering is aligned on, for SFN operation: none, radio (PPS/GPSDO disciplined radio time) or system (host real-time clock).")
+    ("expert.tx_site_delay_ns", bpo::value<int32_t>(&args->phy.tx_site_delay_ns)->default_value(0), "TX only: static delay in ns added to the transmission time of every subframe of this site.")
     ("expert.max_prach_offset_us", bpo::value<float>(&args->phy.max_prach_offset_us)->default_value(30), "Maximum allowed RACH offset (in us).")
     ("expert.equalizer_mode", bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"), "Equalizer mode.")
     ("expert.estimator_fil_w", bpo::value<float>(&args->phy.estimator_fil_w)->default_value(0.1), "Chooses the coefficients for the 3-tap channel estimator centered filter.")
@@ -274,7 +286,12 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("embms.enable", bpo::value<bool>(&args->stack.embms.enable)->default_value(false), "Enables MBMS in the eNB")
     ("embms.m1u_multiaddr", bpo::value<string>(&args->stack.embms.m1u_multiaddr)->default_value("239.255.0.1"), "M1-U Multicast address the eNB joins.")
     ("embms.m1u_if_addr", bpo::value<string>(&args->stack.embms.m1u_if_addr)->default_value("127.0.1.201"), "IP address of the interface the eNB will listen for M1-U traffic.")
+    ("embms.m1u_pcap", bpo::value<string>(&args->stack.embms.m1u_pcap)->default_value(""), "Replay the M1-U traffic of a pcap file instead of joining the multicast group.")
     ("embms.mcs", bpo::value<uint16_t>(&args->stack.embms.mcs)->default_value(20), "Modulation and Coding scheme of MBMS traffic.")
+    ("embms.mtch_max_delay_ms", bpo::value<uint32_t>(&args->stack.embms.mtch_max_delay_ms)->default_value(1000), "Maximum time an M1-U packet waits for its MTCH before being dropped (0 to disable).")
+    ("embms.mtch_queue_bytes", bpo::value<uint32_t>(&args->stack.embms.mtch_queue_bytes)->default_value(1048576), "Maximum bytes queued per MTCH, the oldest packets are dropped beyond it (0 to disable).")
+    ("embms.m1u_teid_per_service", bpo::value<bool>(&args->stack.embms.m1u_teid_per_service)->default_value(false), "Demultiplex M1-U by TEID, each MBMS service being tagged with its TMGI service ID. Otherwise all M1-U traffic has TEID 0xAAAA and goes to the MTCH on LCID 1.")
+    ("embms.pmch_cache_size", bpo::value<uint32_t>(&args->phy.pmch_cache_size)->default_value(8), "Number of encoded PMCH TBs cached per PHY worker for MCCH repetitions and carousels (0 to disable).")
 
     // NR section
     ("scheduler.nr_pdsch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_dl_mcs)->default_value(28), "Fixed NR DL MCS (-1 for dynamic).")
@@ -367,6 +384,46 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     }
   }
 
+  // Offline rendering has no RX stream either
+  if (args->phy.tx_offline) {
+    args->phy.tx_only = true;
+  }
+
+  // Check TX only lookahead, every subframe of a burst needs its own worker and must still be generated in time
+  if (args->phy.tx_only) {
+    if (args->phy.tx_burst_sf < 1 or args->phy.tx_burst_sf > args->phy.nof_phy_threads) {
+      fprintf(stderr,
+              "tx_burst_sf = %d. Value must be between 1 and nof_phy_threads (%d)\n",
+              args->phy.tx_burst_sf,
+              args->phy.nof_phy_threads);
+      exit(1);
+    }
+    if (args->phy.tx_lookahead_ms < FDD_HARQ_DELAY_UL_MS) {
+      fprintf(stderr,
+              "tx_lookahead_ms = %d. Value must be at least %d\n",
+              args->phy.tx_lookahead_ms,
+              FDD_HARQ_DELAY_UL_MS);
+      exit(1);
+    }
+    if (args->phy.tx_lookahead_max_ms > 0 and args->phy.tx_lookahead_max_ms < args->phy.tx_lookahead_ms) {
+      fprintf(stderr,
+              "tx_lookahead_max_ms = %d. Value must be 0 or at least tx_lookahead_ms (%d)\n",
+              args->phy.tx_lookahead_max_ms,
+              args->phy.tx_lookahead_ms);
+      exit(1);
+    }
+  }
+
+  // Check SFN time reference, without TX only the TTIs follow the RX stream
+  if (args->phy.tx_time_ref != "none" and args->phy.tx_time_ref != "radio" and args->phy.tx_time_ref != "system") {
+    fprintf(stderr, "tx_time_ref = %s. Value must be none, radio or system\n", args->phy.tx_time_ref.c_str());
+    exit(1);
+  }
+  if (args->phy.tx_time_ref != "none" and not args->phy.tx_only) {
+    fprintf(stderr, "tx_time_ref = %s requires tx_only\n", args->phy.tx_time_ref.c_str());
+    exit(1);
+  }
+
   // Check PRACH workers
   if (args->phy.nof_prach_threads > 1) {
     fprintf(stderr,
@@ -526,6 +583,24 @@ static void execute_cmd(metrics_stdout* metrics, srsenb::enb_command_interface*
 
     // Set cell gain
     control->cmd_cell_gain(cell_id, gain_db);
+  } else if (cmd[0] == "mbms_start") {
+    if (cmd.size() != 6 and cmd.size() != 7) {
+      cout << "Usage: " << cmd[0] << " [area index] [PMCH index] [PLMN] [service ID in hex] [LCID] [session ID]"
+           << endl;
+      return;
+    }
+    uint32_t area_idx   = srsran::string_cast<uint32_t>(cmd[1]);
+    uint32_t pmch_idx   = srsran::string_cast<uint32_t>(cmd[2]);
+    uint32_t service_id = std::strtoul(cmd[4].c_str(), nullptr, 16);
+    uint32_t lcid       = srsran::string_cast<uint32_t>(cmd[5]);
+    int      session_id = (cmd.size() == 7) ? srsran::string_cast<int>(cmd[6]) : -1;
+    control->cmd_mbms_session_start(area_idx, pmch_idx, cmd[3], service_id, lcid, session_id);
+  } else if (cmd[0] == "mbms_stop") {
+    if (cmd.size() != 3) {
+      cout << "Usage: " << cmd[0] << " [PLMN] [service ID in hex]" << endl;
+      return;
+    }
+    control->cmd_mbms_session_stop(cmd[1], std::strtoul(cmd[2].c_str(), nullptr, 16));
   } else if (cmd[0] == "flush") {
     if (cmd.size() != 1) {
       cout << "Usage: " << cmd[0] << endl;
@@ -542,6 +617,8 @@ static void execute_cmd(metrics_stdout* metrics, srsenb::enb_command_interface*
     cout << "      sleep: pauses the commmand line operation for a given time in seconds" << endl;
     cout << "          p: starts MAC padding" << endl;
     cout << "      flush: flushes the buffers for the log file" << endl;
+    cout << " mbms_start: starts an MBMS session at the next MCCH modification period" << endl;
+    cout << "  mbms_stop: stops an MBMS session at the next MCCH modification period" << endl;
     cout << endl;
   }
 }
@@ -188,6 +188,37 @@ void metrics_stdout::set_metrics(const enb_metrics_t& metrics, const uint32_t pe
     fmt::print("RF status: O={}, U={}, L={}\n", metrics.rf.rf_o, metrics.rf.rf_u, metrics.rf.rf_l);
   }
 
+  if (metrics.rf.tx_fifo_drop > 0) {
+    fmt::print("RF Tx FIFO: depth={}-{}/{}, drop={}\n",
+               metrics.rf.tx_fifo_min_depth,
+               metrics.rf.tx_fifo_max_depth,
+               metrics.rf.tx_fifo_size,
+               metrics.rf.tx_fifo_drop);
+  }
+
+  // Late PHY workers point at the host, overlaps and gaps the device cleans up without them at the radio
+  if (metrics.phy_tx.nof_late > 0) {
+    fmt::print("PHY Tx slack: late={}/{}, min={:.2f} ms, avg={:.2f} ms, lookahead={} ms, hist=",
+               metrics.phy_tx.nof_late,
+               metrics.phy_tx.nof_sf,
+               metrics.phy_tx.min_slack_ms,
+               metrics.phy_tx.avg_slack_ms,
+               metrics.phy_tx.lookahead_ms);
+    for (uint32_t i = 0; i < phy_tx_slack_nof_bins; i++) {
+      fmt::print("{}{}", i == 0 ? "" : "/", metrics.phy_tx.slack_hist[i]);
+    }
+    fmt::print("\n");
+  }
+  if (metrics.rf.tx_late > 0 or metrics.rf.tx_trim > 0 or metrics.rf.tx_gap > 0 or metrics.rf.tx_gap_eob > 0) {
+    fmt::print("RF Tx timing: late={}, trim={} (max {} us), gap={} (max {} us), eob={}\n",
+               metrics.rf.tx_late,
+               metrics.rf.tx_trim,
+               metrics.rf.tx_trim_max_us,
+               metrics.rf.tx_gap,
+               metrics.rf.tx_gap_max_us,
+               metrics.rf.tx_gap_eob);
+  }
+
   if (metrics.stack.rrc.ues.size() == 0 && metrics.nr_stack.mac.ues.size() == 0) {
     return;
   }
@@ -122,6 +122,13 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
     ERROR("Error setting the CFR");
     return;
   }
+  // MBSFN areas configured before the worker
+  std::vector<uint16_t> mbsfn_area_ids = phy->get_mbsfn_area_ids();
+  if (not mbsfn_area_ids.empty() and
+      srsran_enb_dl_set_mbsfn_areas(&enb_dl, mbsfn_area_ids.data(), (uint32_t)mbsfn_area_ids.size())) {
+    ERROR("Error setting the MBSFN areas");
+    return;
+  }
   if (srsran_enb_ul_init(&enb_ul, signal_buffer_rx[0], nof_prb)) {
     ERROR("Error initiating ENB UL");
     return;
@@ -150,6 +157,14 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
 
   srsran_softbuffer_tx_reset(&temp_mbsfn_softbuffer);
 
+  if (pmch_symbols_cache.init(phy->params.pmch_cache_size, enb_dl.pmch.max_re)) {
+    ERROR("Error initiating PMCH cache");
+    exit(-1);
+  }
+
+  srsran_sch_set_tx_pool(&enb_dl.pdsch.dl_sch, phy->get_fec_pool());
+  srsran_sch_set_tx_pool(&enb_dl.pmch.dl_sch, phy->get_fec_pool());
+
   Info("Component Carrier Worker %d configured cell %d PRB", cc_idx, nof_prb);
 
   if (phy->params.pusch_8bit_decoder) {
@@ -186,6 +201,17 @@ void cc_worker::set_tti(uint32_t tti_)
   tti_tx_ul = TTI_RX_ACK(tti_rx);
 }
 
+void cc_worker::set_mbsfn_areas(const std::vector<uint16_t>& area_ids)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (not initiated or area_ids.empty()) {
+    return;
+  }
+  if (srsran_enb_dl_set_mbsfn_areas(&enb_dl, area_ids.data(), (uint32_t)area_ids.size())) {
+    ERROR("Error setting the MBSFN areas");
+  }
+}
+
 int cc_worker::add_rnti(uint16_t rnti)
 {
   std::unique_lock<std::mutex> lock(mutex);
@@ -231,7 +257,8 @@ void cc_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy
 void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                         stack_interface_phy_lte::dl_sched_t& dl_grants,
                         stack_interface_phy_lte::ul_sched_t& ul_grants,
-                        srsran_mbsfn_cfg_t*                  mbsfn_cfg)
+                        srsran_mbsfn_cfg_t*                  mbsfn_cfg,
+                        float                                tx_sc16_scale)
 {
   Info("work_dl");
   std::lock_guard<std::mutex> lock(mutex);
@@ -248,6 +275,10 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
     if (mbsfn_cfg->enable) {
       encode_pmch(dl_grants.pdsch, mbsfn_cfg);
     }
+    // The grants after the MCH one are DCI only, e.g. MCCH change notifications in the non-MBSFN region
+    if (dl_grants.nof_grants > 1) {
+      encode_pdcch_dl(&dl_grants.pdsch[1], dl_grants.nof_grants - 1);
+    }
   }
 
   // Put UL grants to resource grid.
@@ -259,13 +290,13 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
   // Generate signal and transmit
   srsran_enb_dl_gen_signal(&enb_dl);
 
-  // Scale if cell gain is set
+  // Scale if cell gain is set, int16 samples take it with the conversion below
   float cell_gain_db = phy->get_cell_gain(cc_idx);
-  if (std::isnormal(cell_gain_db)) {
-    float    scale  = srsran_convert_dB_to_amplitude(cell_gain_db);
+  float cell_gain    = std::isnormal(cell_gain_db) ? srsran_convert_dB_to_amplitude(cell_gain_db) : 1.0f;
+  if (std::isnormal(cell_gain_db) and tx_sc16_scale <= 0.0f) {
     uint32_t sf_len = SRSRAN_SF_LEN_PRB(enb_dl.cell.nof_prb);
     for (uint32_t i = 0; i < enb_dl.cell.nof_ports; i++) {
-      srsran_vec_sc_prod_cfc(signal_buffer_tx[i], scale, signal_buffer_tx[i], sf_len);
+      srsran_vec_sc_prod_cfc(signal_buffer_tx[i], cell_gain, signal_buffer_tx[i], sf_len);
     }
   }
 
@@ -282,6 +313,15 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
     // clear measurement flag on cell
     phy->clear_cell_measure_trigger(cc_idx);
   }
+
+  // Convert to the int16 samples the radio takes, in place as every subframe rewrites the whole buffer
+  if (tx_sc16_scale > 0.0f) {
+    uint32_t sf_len = SRSRAN_SF_LEN_PRB(enb_dl.cell.nof_prb);
+    for (uint32_t i = 0; i < enb_dl.cell.nof_ports; i++) {
+      srsran_vec_convert_fi(
+          (float*)signal_buffer_tx[i], cell_gain * tx_sc16_scale, (int16_t*)signal_buffer_tx[i], 2 * sf_len);
+    }
+  }
 }
 
 bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
@@ -574,17 +614,39 @@ int cc_worker::encode_pmch(stack_interface_phy_lte::dl_sched_grant_t* grant, srs
   // Set soft buffer
   pmch_cfg.pdsch_cfg.softbuffers.tx[0] = &temp_mbsfn_softbuffer;
 
+  // Repeated TBs (MCCH, carousels) reuse the symbols encoded the first time they were transmitted
+  pmch_cache::key_t key;
+  key.area_id   = pmch_cfg.area_id;
+  key.sf_idx    = dl_sf.tti % SRSRAN_NOF_SF_X_FRAME;
+  key.tbs       = pmch_cfg.pdsch_cfg.grant.tb[0].tbs;
+  key.mcs       = mbsfn_cfg->mbsfn_mcs;
+  key.nof_re    = pmch_cfg.pdsch_cfg.grant.nof_re;
+  bool  hit     = false;
+  cf_t* symbols = pmch_symbols_cache.get(key, grant->data[0], hit);
+
   // Encode PMCH
-  if (srsran_enb_dl_put_pmch(&enb_dl, &pmch_cfg, grant->data[0])) {
-    Error("Error putting PMCH");
-    return SRSRAN_ERROR;
+  if (symbols == nullptr) {
+    if (srsran_enb_dl_put_pmch(&enb_dl, &pmch_cfg, grant->data[0])) {
+      Error("Error putting PMCH");
+      return SRSRAN_ERROR;
+    }
+  } else {
+    if (not hit and srsran_enb_dl_encode_pmch_symbols(&enb_dl, &pmch_cfg, grant->data[0], symbols)) {
+      pmch_symbols_cache.clear();
+      Error("Error encoding PMCH");
+      return SRSRAN_ERROR;
+    }
+    if (srsran_enb_dl_put_pmch_symbols(&enb_dl, &pmch_cfg, symbols)) {
+      Error("Error putting PMCH");
+      return SRSRAN_ERROR;
+    }
   }
 
   // Logging
   if (logger.info.enabled()) {
     char str[512];
     srsran_pdsch_tx_info(&pmch_cfg.pdsch_cfg, str, 512);
-    logger.info("PMCH: %s", str);
+    logger.info("PMCH: %s%s", str, hit ? ", cached" : "");
   }
 
   // Save metrics stats
@@ -601,6 +663,11 @@ int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, u
   for (uint32_t i = 0; i < nof_grants; i++) {
     uint16_t rnti = grants[i].dci.rnti;
 
+    // MCCH change notifications are DCI only, they have nothing to put on the PDSCH
+    if (rnti == SRSRAN_MRNTI) {
+      continue;
+    }
+
     if (rnti && ue_db.count(rnti)) {
       srsran_dl_cfg_t dl_cfg = {};
 
@@ -0,0 +1,140 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsenb/hdr/phy/lte/pmch_cache.h"
+#include "srsran/phy/utils/vector.h"
+#include <string.h>
+
+namespace srsenb {
+namespace lte {
+
+pmch_cache::~pmch_cache()
+{
+  for (entry_t& entry : entries) {
+    free(entry.symbols);
+  }
+}
+
+int pmch_cache::init(uint32_t nof_entries, uint32_t max_re_)
+{
+  for (entry_t& entry : entries) {
+    free(entry.symbols);
+  }
+  entries.clear();
+  max_re = max_re_;
+
+  seen.assign(nof_entries * nof_seen_per_entry, seen_t{});
+  seen_next = 0;
+  entries.resize(nof_entries);
+  for (entry_t& entry : entries) {
+    entry.symbols = srsran_vec_cf_malloc(max_re);
+    if (entry.symbols == nullptr) {
+      return SRSRAN_ERROR;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+uint64_t pmch_cache::hash_payload(const uint8_t* data, uint32_t nof_bytes)
+{
+  // FNV-1a, the payload is compared on a match so collisions only cost a memcmp
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (uint32_t i = 0; i < nof_bytes; ++i) {
+    hash ^= data[i];
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+bool pmch_cache::key_equal(const key_t& a, const key_t& b)
+{
+  return a.area_id == b.area_id and a.sf_idx == b.sf_idx and a.tbs == b.tbs and a.mcs == b.mcs and
+         a.nof_re == b.nof_re;
+}
+
+bool pmch_cache::check_seen(const key_t& key, uint64_t hash)
+{
+  for (seen_t& s : seen) {
+    if (s.valid and s.hash == hash and key_equal(s.key, key)) {
+      s.valid = false;
+      return true;
+    }
+  }
+
+  // Remember the TB in place of the oldest one seen
+  seen[seen_next] = {true, key, hash};
+  seen_next       = (seen_next + 1) % seen.size();
+  return false;
+}
+
+cf_t* pmch_cache::get(const key_t& key, const uint8_t* data, bool& hit)
+{
+  hit = false;
+  if (entries.empty() or data == nullptr or key.nof_re > max_re) {
+    return nullptr;
+  }
+
+  uint32_t nof_bytes = key.tbs / 8;
+  uint64_t hash      = hash_payload(data, nof_bytes);
+  entry_t* victim    = &entries[0];
+  use_count++;
+
+  for (entry_t& entry : entries) {
+    if (entry.valid and entry.hash == hash and key_equal(entry.key, key) and
+        memcmp(entry.payload.data(), data, nof_bytes) == 0) {
+      entry.last_use = use_count;
+      nof_hits++;
+      hit = true;
+      return entry.symbols;
+    }
+    if (not entry.valid or (victim->valid and entry.last_use < victim->last_use)) {
+      victim = &entry;
+    }
+  }
+  nof_misses++;
+
+  // A hash match is enough to admit the TB, the payload is compared once it has an entry
+  if (not check_seen(key, hash)) {
+    return nullptr;
+  }
+
+  // The caller fills the symbols of the reassigned entry
+  victim->valid    = true;
+  victim->key      = key;
+  victim->hash     = hash;
+  victim->last_use = use_count;
+  victim->payload.assign(data, data + nof_bytes);
+  return victim->symbols;
+}
+
+void pmch_cache::clear()
+{
+  for (entry_t& entry : entries) {
+    entry.valid = false;
+  }
+  for (seen_t& s : seen) {
+    s.valid = false;
+  }
+}
+
+} // namespace lte
+} // namespace srsenb
@@ -147,6 +147,13 @@ uint32_t sf_worker::get_nof_rnti()
   return cc_workers[0]->get_nof_rnti();
 }
 
+void sf_worker::set_mbsfn_areas(const std::vector<uint16_t>& area_ids)
+{
+  for (auto& w : cc_workers) {
+    w->set_mbsfn_areas(area_ids);
+  }
+}
+
 void sf_worker::work_imp()
 {
   std::lock_guard<std::mutex> lock(work_mutex);
@@ -188,8 +195,8 @@ void sf_worker::work_imp()
     Info("Failed setting UL grants. Some grant's RNTI does not exist.");
   }
 
-  // Process UL
-  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+  // Process UL, unless nothing is received
+  for (uint32_t cc = 0; cc < cc_workers.size() and not phy->params.tx_only; cc++) {
     cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
   }
 
@@ -207,6 +214,9 @@ void sf_worker::work_imp()
       phy->worker_end(context, true, tx_buffer);
       return;
     }
+    // The MAC MCH scheduler decides whether the PMCH is transmitted and with which MCS
+    mbsfn_cfg.enable    = dl_grants[0].nof_grants > 0 and dl_grants[0].pdsch[0].data[0] != nullptr;
+    mbsfn_cfg.mbsfn_mcs = dl_grants[0].pdsch[0].dci.tb[0].mcs_idx;
   }
 
   // Get UL scheduling for the TX TTI from MAC
@@ -220,18 +230,20 @@ void sf_worker::work_imp()
   dl_sf.tti              = tti_tx_dl;
   dl_sf.sf_type          = sf_type;
   dl_sf.non_mbsfn_region = mbsfn_cfg.non_mbsfn_region_length;
+  dl_sf.mbsfn_area_id    = mbsfn_cfg.mbsfn_area_id;
 
   // Prepare for receive ACK for DL grants in t_tx_dl+4
   phy->ue_db.clear_tti_pending_ack(tti_tx_ul);
 
-  // Process DL
+  // Process DL, converting to int16 right away if the radio takes them
+  float tx_sc16_scale = phy->get_tx_sc16_scale();
   for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
     // Select CFI and make sure it is in the right range
     dl_sf.cfi = dl_grants[cc].cfi;
     dl_sf.cfi = SRSRAN_MAX(dl_sf.cfi, 1);
     dl_sf.cfi = SRSRAN_MIN(dl_sf.cfi, 3);
 
-    cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg);
+    cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg, tx_sc16_scale);
   }
 
   // Save grants
@@ -243,6 +255,7 @@ void sf_worker::work_imp()
       tx_buffer.set_combine(phy->get_rf_port(cc), ant, phy->get_nof_ports(0), cc_workers[cc]->get_buffer_tx(ant));
     }
   }
+  tx_buffer.set_sc16(tx_sc16_scale > 0.0f);
 
   Debug("Sending to radio");
   phy->worker_end(context, true, tx_buffer);
@@ -185,8 +185,8 @@ int phy::init_lte(const phy_args_t&            args,
     lte_workers.init(args, &workers_common, log_sink, WORKERS_THREAD_PRIO);
   }
 
-  // For each carrier, initialise PRACH worker
-  for (uint32_t cc = 0; cc < cfg.phy_cell_cfg.size(); cc++) {
+  // For each carrier, initialise PRACH worker. Nothing is received in TX only operation
+  for (uint32_t cc = 0; cc < cfg.phy_cell_cfg.size() and not args.tx_only; cc++) {
     prach_cfg.root_seq_idx = cfg.phy_cell_cfg[cc].root_seq_idx;
     prach.init(cc,
                cfg.phy_cell_cfg[cc].cell,
@@ -234,11 +234,6 @@ void phy::rem_rnti(uint16_t rnti)
   }
 }
 
-void phy::set_mch_period_stop(uint32_t stop)
-{
-  workers_common.set_mch_period_stop(stop);
-}
-
 void phy::set_activation_deactivation_scell(uint16_t rnti, const std::array<bool, SRSRAN_MAX_CARRIERS>& activation)
 {
   // Iterate all elements except 0 that is reserved for primary cell
@@ -286,6 +281,11 @@ void phy::get_metrics(std::vector<phy_metrics_t>& metrics)
   }
 }
 
+void phy::get_tx_metrics(phy_tx_metrics_t& metrics)
+{
+  workers_common.get_tx_metrics(metrics);
+}
+
 void phy::cmd_cell_gain(uint32_t cell_id, float gain_db)
 {
   Info("set_cell_gain: cell_id=%d, gain_db=%.2f", cell_id, gain_db);
@@ -326,33 +326,35 @@ void phy::complete_config(uint16_t rnti)
   }
 }
 
-void phy::configure_mbsfn(srsran::sib2_mbms_t* sib2, srsran::sib13_t* sib13, const srsran::mcch_msg_t& mcch)
+void phy::configure_mbsfn(srsran::sib2_mbms_t*                   sib2,
+                          srsran::sib13_t*                       sib13,
+                          const std::vector<srsran::mcch_msg_t>& mcch_list)
 {
   if (sib2->mbsfn_sf_cfg_list_present) {
     if (sib2->nof_mbsfn_sf_cfg == 0) {
       Warning("SIB2 does not have any MBSFN config although it was set as present");
-    } else {
-      if (sib2->nof_mbsfn_sf_cfg > 1) {
-        Warning("SIB2 has %d MBSFN subframe configs - only 1 supported", sib2->nof_mbsfn_sf_cfg);
-      }
-      mbsfn_config.mbsfn_subfr_cnfg = sib2->mbsfn_sf_cfg_list[0];
+    } else if (sib2->nof_mbsfn_sf_cfg > 1) {
+      Warning("SIB2 has %d MBSFN subframe configs - only the first one is masked in the DL scheduler",
+              sib2->nof_mbsfn_sf_cfg);
     }
   } else {
     fprintf(stderr, "SIB2 has no MBSFN subframe config specified\n");
     return;
   }
 
-  mbsfn_config.mbsfn_notification_cnfg = sib13->notif_cfg;
-  if (sib13->nof_mbsfn_area_info > 0) {
-    if (sib13->nof_mbsfn_area_info > 1) {
-      Warning("SIB13 has %d MBSFN area info elements - only 1 supported", sib13->nof_mbsfn_area_info);
-    }
-    mbsfn_config.mbsfn_area_info = sib13->mbsfn_area_info_list[0];
+  if (sib13->nof_mbsfn_area_info != mcch_list.size()) {
+    Warning("SIB13 has %d MBSFN area info elements but %zd MCCH were provided",
+            sib13->nof_mbsfn_area_info,
+            mcch_list.size());
   }
 
-  mbsfn_config.mcch = mcch;
+  workers_common.configure_mbsfn(*sib2, *sib13, mcch_list);
 
-  workers_common.configure_mbsfn(&mbsfn_config);
+  // The workers generate the PMCH scrambling and MBSFN reference signals of every area
+  std::vector<uint16_t> mbsfn_area_ids = workers_common.get_mbsfn_area_ids();
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    lte_workers[i]->set_mbsfn_areas(mbsfn_area_ids);
+  }
 }
 
 // Start GUI
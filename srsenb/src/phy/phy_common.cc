@@ -31,6 +31,20 @@ using namespace asn1::rrc;
 
 namespace srsenb {
 
+phy_common::~phy_common()
+{
+  srsran_sch_tx_pool_free(fec_pool);
+}
+
+bool phy_common::create_fec_thread(pthread_t* thread, void* (*start_routine)(void*), void* arg, void* user)
+{
+  phy_common* phy = (phy_common*)user;
+  if (phy->params.fec_cpu_mask != 0) {
+    return threads_new_rt_mask(thread, start_routine, arg, phy->params.fec_cpu_mask, FEC_THREAD_PRIO);
+  }
+  return threads_new_rt_prio(thread, start_routine, arg, FEC_THREAD_PRIO);
+}
+
 void phy_common::reset()
 {
   for (auto& q : ul_grants) {
@@ -50,9 +64,6 @@ bool phy_common::init(const phy_cell_cfg_list_t&    cell_list_,
   cell_list_lte = cell_list_;
   cell_list_nr  = cell_list_nr_;
 
-  pthread_mutex_init(&mtch_mutex, nullptr);
-  pthread_cond_init(&mtch_cvar, nullptr);
-
   // Instantiate DL channel emulator
   if (params.dl_channel_args.enable) {
     dl_channel = srsran::channel_ptr(
@@ -61,6 +72,15 @@ bool phy_common::init(const phy_cell_cfg_list_t&    cell_list_,
     dl_channel->set_signal_power_dBfs(srsran_enb_dl_get_maximum_signal_power_dBfs(cell_list_lte[0].cell.nof_prb));
   }
 
+  // Create the FEC pool, the workers attach their encoders to it when they are initialised
+  if (params.nof_fec_threads > 0 and fec_pool == nullptr) {
+    fec_pool = srsran_sch_tx_pool_create(params.nof_fec_threads, create_fec_thread, this);
+    if (fec_pool == nullptr) {
+      srslog::fetch_basic_logger("PHY").error("Error creating FEC pool with %d threads", params.nof_fec_threads);
+      return false;
+    }
+  }
+
   // Create grants
   for (auto& q : ul_grants) {
     q.resize(cell_list_lte.size());
@@ -68,15 +88,31 @@ bool phy_common::init(const phy_cell_cfg_list_t&    cell_list_,
 
   // Set UE PHY data-base stack and configuration
   ue_db.init(stack, params, cell_list_lte);
-  if (mcch_configured) {
+  if (mbsfn_map.is_configured()) {
     build_mch_table();
-    build_mcch_table();
   }
 
   reset();
   return true;
 }
 
+void phy_common::set_tx_sc16_scale(float scale)
+{
+  // Every LTE carrier needs its own RF port, the NR carriers are combined with the LTE ones in worker_end()
+  bool combined = not cell_list_nr.empty();
+  for (uint32_t i = 0; i < cell_list_lte.size(); i++) {
+    for (uint32_t j = 0; j < i; j++) {
+      combined |= cell_list_lte[i].rf_port == cell_list_lte[j].rf_port;
+    }
+  }
+
+  if (scale > 0.0f and (combined or dl_channel)) {
+    srslog::fetch_basic_logger("PHY").info("Tx samples are combined or emulated, not converting them to int16");
+    scale = 0.0f;
+  }
+  tx_sc16_scale = scale;
+}
+
 void phy_common::stop()
 {
   semaphore.wait_all();
@@ -153,6 +189,12 @@ void phy_common::worker_end(const worker_context_t& w_ctx, const bool& tx_enable
     dl_channel->run(tx_buffer.to_cf_t(), tx_buffer.to_cf_t(), tx_buffer.get_nof_samples(), tx_time.get(0));
   }
 
+  // Account the time left before the transmission, a negative slack means the subframe is late
+  if (w_ctx.tx_deadline != worker_context_t::time_point()) {
+    std::chrono::duration<float, std::milli> slack = w_ctx.tx_deadline - std::chrono::steady_clock::now();
+    count_tx_slack(slack.count());
+  }
+
   // Always transmit on single radio
   radio->tx(tx_buffer, tx_time);
 
@@ -166,164 +208,117 @@ void phy_common::worker_end(const worker_context_t& w_ctx, const bool& tx_enable
   semaphore.release();
 }
 
-void phy_common::set_mch_period_stop(uint32_t stop)
+void phy_common::count_tx_slack(float slack_ms)
 {
-  pthread_mutex_lock(&mtch_mutex);
-  have_mtch_stop  = true;
-  mch_period_stop = stop;
-  pthread_cond_signal(&mtch_cvar);
-  pthread_mutex_unlock(&mtch_mutex);
+  uint32_t bin = 0;
+  while (bin < phy_tx_slack_nof_bins - 1 and slack_ms >= phy_tx_slack_edges_ms[bin]) {
+    bin++;
+  }
+
+  std::lock_guard<std::mutex> lock(tx_metrics_mutex);
+  if (tx_metrics.nof_sf == 0 or slack_ms < tx_metrics.min_slack_ms) {
+    tx_metrics.min_slack_ms = slack_ms;
+  }
+  tx_metrics.nof_sf++;
+  tx_metrics.nof_late += (slack_ms < 0) ? 1 : 0;
+  tx_metrics.slack_hist[bin]++;
+  tx_slack_sum_ms += slack_ms;
+  tx_min_slack_ms = std::min(tx_min_slack_ms, slack_ms);
 }
 
-void phy_common::configure_mbsfn(srsran::phy_cfg_mbsfn_t* cfg)
+void phy_common::get_tx_metrics(phy_tx_metrics_t& m)
 {
-  mbsfn            = *cfg;
-  sib13_configured = true;
-  mcch_configured  = true;
+  std::lock_guard<std::mutex> lock(tx_metrics_mutex);
+  m               = tx_metrics;
+  m.avg_slack_ms  = (tx_metrics.nof_sf > 0) ? (float)(tx_slack_sum_ms / tx_metrics.nof_sf) : 0.0f;
+  m.lookahead_ms  = tx_lookahead_ms;
+  tx_metrics      = {};
+  tx_slack_sum_ms = 0;
+}
+
+float phy_common::get_tx_min_slack_ms()
+{
+  std::lock_guard<std::mutex> lock(tx_metrics_mutex);
+  float min_slack_ms = tx_min_slack_ms;
+  tx_min_slack_ms    = std::numeric_limits<float>::infinity();
+  return min_slack_ms;
+}
+
+void phy_common::configure_mbsfn(const srsran::sib2_mbms_t&             sib2,
+                                 const srsran::sib13_t&                 sib13,
+                                 const std::vector<srsran::mcch_msg_t>& mcch_list)
+{
+  {
+    std::lock_guard<std::mutex> lock(mbsfn_mutex);
+    if (sib2.nof_mbsfn_sf_cfg > 0) {
+      mbsfn_subfr_cnfg = sib2.mbsfn_sf_cfg_list[0];
+    }
+    mbsfn_sib13 = sib13;
+    mbsfn_map.configure(sib2, sib13, mcch_list);
+  }
+
+  // The DL TTI mask is pushed to the stack in init() if the PHY has not been initialised yet
+  if (stack != nullptr) {
+    build_mch_table();
+  }
 }
 
 void phy_common::build_mch_table()
 {
   // First reset tables
-  ZERO_OBJECT(mcch_table);
+  ZERO_OBJECT(mch_table);
 
   // 40 element table represents 4 frames (40 subframes)
   uint32_t nof_sfs = 0;
-  if (mbsfn.mbsfn_subfr_cnfg.nof_alloc_subfrs == srsran::mbsfn_sf_cfg_t::sf_alloc_type_t::one_frame) {
-    generate_mch_table(&mch_table[0], (uint32_t)mbsfn.mbsfn_subfr_cnfg.sf_alloc, 1);
+  if (mbsfn_subfr_cnfg.nof_alloc_subfrs == srsran::mbsfn_sf_cfg_t::sf_alloc_type_t::one_frame) {
+    generate_mch_table(&mch_table[0], (uint32_t)mbsfn_subfr_cnfg.sf_alloc, 1);
     nof_sfs = 10;
-  } else if (mbsfn.mbsfn_subfr_cnfg.nof_alloc_subfrs == srsran::mbsfn_sf_cfg_t::sf_alloc_type_t::four_frames) {
-    generate_mch_table(&mch_table[0], (uint32_t)mbsfn.mbsfn_subfr_cnfg.sf_alloc, 4);
+  } else if (mbsfn_subfr_cnfg.nof_alloc_subfrs == srsran::mbsfn_sf_cfg_t::sf_alloc_type_t::four_frames) {
+    generate_mch_table(&mch_table[0], (uint32_t)mbsfn_subfr_cnfg.sf_alloc, 4);
     nof_sfs = 40;
   } else {
     fprintf(stderr, "No valid SF alloc\n");
   }
-  // Debug
-  std::stringstream ss;
-  ss << "|";
-  for (uint32_t j = 0; j < 40; j++) {
-    ss << (int)mch_table[j] << "|";
-  }
 
   stack->set_sched_dl_tti_mask(mch_table, nof_sfs);
 }
 
-void phy_common::build_mcch_table()
-{
-  ZERO_OBJECT(mcch_table);
-
-  generate_mcch_table(mcch_table, static_cast<uint32_t>(mbsfn.mbsfn_area_info.mcch_cfg.sf_alloc_info));
-
-  std::stringstream ss;
-  ss << "|";
-  for (uint32_t j = 0; j < 10; j++) {
-    ss << (int)mcch_table[j] << "|";
-  }
-}
-
-bool phy_common::is_mcch_subframe(srsran_mbsfn_cfg_t* cfg, uint32_t phy_tti)
-{
-  uint32_t sfn; // System Frame Number
-  uint8_t  sf;  // Subframe
-  uint8_t  offset;
-  uint8_t  period;
-
-  sfn = phy_tti / 10;
-  sf  = phy_tti % 10;
-
-  if (sib13_configured) {
-    // mbsfn_area_info_r9_s* area_info = &mbsfn.mbsfn_area_info;
-    srsran::mbsfn_area_info_t* area_info = &mbsfn.mbsfn_area_info;
-    offset                               = area_info->mcch_cfg.mcch_offset;
-    period                               = enum_to_number(area_info->mcch_cfg.mcch_repeat_period);
-
-    if ((sfn % period == offset) && mcch_table[sf] > 0) {
-      cfg->mbsfn_area_id           = area_info->mbsfn_area_id;
-      cfg->non_mbsfn_region_length = enum_to_number(area_info->non_mbsfn_region_len);
-      cfg->mbsfn_mcs               = enum_to_number(area_info->mcch_cfg.sig_mcs);
-      cfg->enable                  = true;
-      cfg->is_mcch                 = true;
-      have_mtch_stop               = false;
-      return true;
-    }
-  }
-  return false;
-}
-
-bool phy_common::is_mch_subframe(srsran_mbsfn_cfg_t* cfg, uint32_t phy_tti)
+bool phy_common::is_mbsfn_sf(srsran_mbsfn_cfg_t* cfg, uint32_t phy_tti)
 {
-  uint32_t sfn; // System Frame Number
-  uint8_t  sf;  // Subframe
-  uint8_t  offset;
-  uint8_t  period;
-
-  sfn = phy_tti / 10;
-  sf  = phy_tti % 10;
-
   // Set some defaults
   cfg->mbsfn_area_id           = 0;
   cfg->non_mbsfn_region_length = 1;
   cfg->mbsfn_mcs               = 2;
   cfg->enable                  = false;
   cfg->is_mcch                 = false;
-  // Check for MCCH
-  if (is_mcch_subframe(cfg, phy_tti)) {
-    return true;
-  }
-  if (not mcch_configured) {
+
+  std::lock_guard<std::mutex> lock(mbsfn_mutex);
+  if (not mbsfn_map.is_mbsfn_sf(phy_tti)) {
     return false;
   }
 
-  // Not MCCH, check for MCH
-  srsran::mbsfn_sf_cfg_t*    subfr_cnfg = &mbsfn.mbsfn_subfr_cnfg;
-  srsran::mbsfn_area_info_t* area_info  = &mbsfn.mbsfn_area_info;
-
-  offset = subfr_cnfg->radioframe_alloc_offset;
-  period = enum_to_number(subfr_cnfg->radioframe_alloc_period);
-
-  if (subfr_cnfg->nof_alloc_subfrs == srsran::mbsfn_sf_cfg_t::sf_alloc_type_t::one_frame) {
-    if ((sfn % period == offset) && (mch_table[sf] > 0)) {
-      if (sib13_configured) {
-        cfg->mbsfn_area_id           = area_info->mbsfn_area_id;
-        cfg->non_mbsfn_region_length = enum_to_number(area_info->non_mbsfn_region_len);
-        if (mcch_configured) {
-          // Iterate through PMCH configs to see which one applies in the current frame
-          uint32_t frame_alloc_idx = sfn % enum_to_number(mbsfn.mcch.common_sf_alloc_period);
-          uint32_t mbsfn_per_frame = mbsfn.mcch.pmch_info_list[0].sf_alloc_end /
-                                     +enum_to_number(mbsfn.mcch.pmch_info_list[0].mch_sched_period);
-          uint32_t sf_alloc_idx = frame_alloc_idx * mbsfn_per_frame + ((sf < 4) ? sf - 1 : sf - 3);
-          while (!have_mtch_stop) {
-            pthread_cond_wait(&mtch_cvar, &mtch_mutex);
-          }
-          for (uint32_t i = 0; i < mbsfn.mcch.nof_pmch_info; i++) {
-            if (sf_alloc_idx <= mch_period_stop) {
-              cfg->mbsfn_mcs = mbsfn.mcch.pmch_info_list[i].data_mcs;
-              cfg->enable    = true;
-            }
-          }
-        }
-      }
-      return true;
-    }
-  } else if (subfr_cnfg->nof_alloc_subfrs == srsran::mbsfn_sf_cfg_t::sf_alloc_type_t::four_frames) {
-    uint8_t idx = sfn % period;
-    if ((idx >= offset) && (idx < offset + 4)) {
-      if (mch_table[(idx * 10) + sf] > 0) {
-        if (sib13_configured) {
-          cfg->mbsfn_area_id           = area_info->mbsfn_area_id;
-          cfg->non_mbsfn_region_length = enum_to_number(area_info->non_mbsfn_region_len);
-          // TODO: check for MCCH configuration, set MCS and decode
-        }
-        return true;
-      }
-    }
+  // MBSFN subframes which are not allocated to any area still use the non-MBSFN region of the first area
+  uint32_t         area_idx = 0;
+  mbsfn_sf_alloc_t sf_alloc;
+  if (mbsfn_map.get_sf_alloc(phy_tti, sf_alloc)) {
+    area_idx     = sf_alloc.area_idx;
+    cfg->is_mcch = sf_alloc.is_mcch;
   }
-
-  return false;
+  if (area_idx < mbsfn_sib13.nof_mbsfn_area_info) {
+    const srsran::mbsfn_area_info_t& area_info = mbsfn_sib13.mbsfn_area_info_list[area_idx];
+    cfg->mbsfn_area_id                         = area_info.mbsfn_area_id;
+    cfg->non_mbsfn_region_length               = enum_to_number(area_info.non_mbsfn_region_len);
+  }
+  return true;
 }
 
-bool phy_common::is_mbsfn_sf(srsran_mbsfn_cfg_t* cfg, uint32_t phy_tti)
+std::vector<uint16_t> phy_common::get_mbsfn_area_ids()
 {
-  return is_mch_subframe(cfg, phy_tti);
+  std::lock_guard<std::mutex> lock(mbsfn_mutex);
+  std::vector<uint16_t>       area_ids;
+  for (uint32_t i = 0; i < mbsfn_sib13.nof_mbsfn_area_info; i++) {
+    area_ids.push_back(mbsfn_sib13.mbsfn_area_info_list[i].mbsfn_area_id);
+  }
+  return area_ids;
 }
 } // namespace srsenb
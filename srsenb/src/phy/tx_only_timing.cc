@@ -0,0 +1,51 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsenb/hdr/phy/tx_only_timing.h"
+#include "srsran/common/common.h"
+#include <algorithm>
+#include <cmath>
+
+namespace srsenb {
+
+tx_only_boundary_t
+tx_only_next_boundary(const srsran_timestamp_t& abs_now, uint32_t lookahead_ms, int32_t site_delay_ns)
+{
+  tx_only_boundary_t boundary = {};
+
+  // First boundary far enough to generate its subframe, a negative site delay transmits it earlier
+  double delay_s  = site_delay_ns * 1e-9;
+  double margin_s = (lookahead_ms + 1) * 1e-3 + std::max(-delay_s, 0.0);
+  double frac_ms  = std::ceil((abs_now.frac_secs + margin_s) * 1e3);
+
+  // Time of the TTI before it relative to now, the TTI loop adds 1 ms and the lookahead on top
+  boundary.tti_count = (uint64_t)abs_now.full_secs * 1000 + (uint64_t)frac_ms;
+  boundary.delta_s   = frac_ms * 1e-3 - abs_now.frac_secs + delay_s - (lookahead_ms + 1) * 1e-3;
+
+  // As at startup without time reference, the main loop TTI is the one FDD_HARQ_DELAY_UL_MS before the transmitted
+  // TTI, and it is incremented before the first subframe
+  boundary.tti = TTI_SUB((uint32_t)(boundary.tti_count % 10240), FDD_HARQ_DELAY_UL_MS + 1);
+
+  return boundary;
+}
+
+} // namespace srsenb
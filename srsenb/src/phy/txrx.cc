@@ -19,11 +19,17 @@
  *
  */
 
+#include <cinttypes>
+#include <cmath>
+#include <csignal>
+#include <ctime>
+#include <thread>
 #include <unistd.h>
 
 #include "srsran/common/threads.h"
 #include "srsran/srsran.h"
 
+#include "srsenb/hdr/phy/tx_only_timing.h"
 #include "srsenb/hdr/phy/txrx.h"
 
 #define Error(fmt, ...)                                                                                                \
@@ -63,7 +69,7 @@ bool txrx::init(enb_time_interface*          enb_,
   running     = true;
 
   // Instantiate UL channel emulator
-  if (worker_com->params.ul_channel_args.enable) {
+  if (worker_com->params.ul_channel_args.enable and not worker_com->params.tx_only) {
     ul_channel = srsran::channel_ptr(
         new srsran::channel(worker_com->params.ul_channel_args, worker_com->get_nof_rf_channels(), logger));
   }
@@ -94,15 +100,28 @@ void txrx::run_thread()
 
   float samp_rate = srsran_sampling_freq_hz(worker_com->get_nof_prb(0));
 
+  bool tx_only = worker_com->params.tx_only;
+
   // Configure radio
-  radio_h->set_rx_srate(samp_rate);
+  if (not tx_only) {
+    radio_h->set_rx_srate(samp_rate);
+  }
   radio_h->set_tx_srate(samp_rate);
+  worker_com->set_tx_sc16_scale(radio_h->get_tx_sc16_scale());
 
   // Set Tx/Rx frequencies
   for (uint32_t cc_idx = 0; cc_idx < worker_com->get_nof_carriers(); cc_idx++) {
     double   tx_freq_hz = worker_com->get_dl_freq_hz(cc_idx);
     double   rx_freq_hz = worker_com->get_ul_freq_hz(cc_idx);
     uint32_t rf_port    = worker_com->get_rf_port(cc_idx);
+    if (tx_only) {
+      srsran::console("Setting frequency: DL=%.1f Mhz (TX only) for cc_idx=%d nof_prb=%d\n",
+                      tx_freq_hz / 1e6f,
+                      cc_idx,
+                      worker_com->get_nof_prb(cc_idx));
+      radio_h->set_tx_freq(rf_port, tx_freq_hz);
+      continue;
+    }
     srsran::console("Setting frequency: DL=%.1f Mhz, UL=%.1f MHz for cc_idx=%d nof_prb=%d\n",
                     tx_freq_hz / 1e6f,
                     rx_freq_hz / 1e6f,
@@ -122,8 +141,20 @@ void txrx::run_thread()
   // Set TTI so that first TX is at tti=0
   tti = TTI_SUB(0, FDD_HARQ_DELAY_UL_MS + 1);
 
+  if (tx_only) {
+    tx_only_start();
+  }
+
   // Main loop
   while (running) {
+    if (tx_only and tx_offline_complete()) {
+      // The rendered subframes are still being transmitted by the workers, the eNB stops them when it quits
+      logger.info("Offline render complete after %d subframes", tx_only_tti_count);
+      srsran::console("Offline render complete after %d subframes\n", tx_only_tti_count);
+      raise(SIGTERM);
+      break;
+    }
+
     tti = TTI_ADD(tti, 1);
     logger.set_context(tti);
 
@@ -146,40 +177,53 @@ void txrx::run_thread()
       }
     }
 
-    // Multiple cell buffer mapping
-    {
-      uint32_t cc = 0;
-      for (uint32_t cc_lte = 0; cc_lte < worker_com->get_nof_carriers_lte(); cc_lte++, cc++) {
-        uint32_t rf_port = worker_com->get_rf_port(cc);
-
-        for (uint32_t p = 0; p < worker_com->get_nof_ports(cc); p++) {
-          // WARNING: The number of ports for all cells must be the same
-          buffer.set(rf_port, p, worker_com->get_nof_ports(0), lte_worker->get_buffer_rx(cc_lte, p));
+    if (tx_only) {
+      tx_only_wait_tti(timestamp);
+    } else {
+      // Multiple cell buffer mapping
+      {
+        uint32_t cc = 0;
+        for (uint32_t cc_lte = 0; cc_lte < worker_com->get_nof_carriers_lte(); cc_lte++, cc++) {
+          uint32_t rf_port = worker_com->get_rf_port(cc);
+
+          for (uint32_t p = 0; p < worker_com->get_nof_ports(cc); p++) {
+            // WARNING: The number of ports for all cells must be the same
+            buffer.set(rf_port, p, worker_com->get_nof_ports(0), lte_worker->get_buffer_rx(cc_lte, p));
+          }
         }
-      }
-      for (uint32_t cc_nr = 0; cc_nr < worker_com->get_nof_carriers_nr(); cc_nr++, cc++) {
-        uint32_t rf_port = worker_com->get_rf_port(cc);
-
-        for (uint32_t p = 0; p < worker_com->get_nof_ports(cc); p++) {
-          // WARNING:
-          // - The number of ports for all cells must be the same
-          // - Only one NR cell is currently supported
-          if (nr_worker != nullptr) {
-            buffer.set(rf_port, p, worker_com->get_nof_ports(0), nr_worker->get_buffer_rx(p));
+        for (uint32_t cc_nr = 0; cc_nr < worker_com->get_nof_carriers_nr(); cc_nr++, cc++) {
+          uint32_t rf_port = worker_com->get_rf_port(cc);
+
+          for (uint32_t p = 0; p < worker_com->get_nof_ports(cc); p++) {
+            // WARNING:
+            // - The number of ports for all cells must be the same
+            // - Only one NR cell is currently supported
+            if (nr_worker != nullptr) {
+              buffer.set(rf_port, p, worker_com->get_nof_ports(0), nr_worker->get_buffer_rx(p));
+            }
           }
         }
       }
-    }
 
-    buffer.set_nof_samples(sf_len);
-    radio_h->rx_now(buffer, timestamp);
+      buffer.set_nof_samples(sf_len);
+      radio_h->rx_now(buffer, timestamp);
 
-    if (ul_channel) {
-      ul_channel->run(buffer.to_cf_t(), buffer.to_cf_t(), sf_len, timestamp.get(0));
+      if (ul_channel) {
+        ul_channel->run(buffer.to_cf_t(), buffer.to_cf_t(), sf_len, timestamp.get(0));
+      }
     }
 
-    // Compute TX time: Any transmission happens in TTI+4 thus advance 4 ms the reception time
-    timestamp.add(FDD_HARQ_DELAY_UL_MS * 1e-3);
+    // Compute TX time: Any transmission happens in TTI+4 thus advance 4 ms the reception time. Without reception there
+    // is no HARQ timing to keep, so subframes may be generated further ahead to absorb scheduling jitter
+    timestamp.add((tx_only ? tx_lookahead_ms : FDD_HARQ_DELAY_UL_MS) * 1e-3);
+
+    // Host time the workers have to hand the subframe to the radio by, offline rendering has no deadline
+    srsran::phy_common_interface::worker_context_t::time_point tx_deadline = {};
+    if (not tx_only) {
+      tx_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(FDD_HARQ_DELAY_UL_MS);
+    } else if (not worker_com->params.tx_offline) {
+      tx_deadline = tx_only_deadline + std::chrono::milliseconds(tx_lookahead_ms);
+    }
 
     Debug("Setting TTI=%d, tx_time=%ld:%f to worker %d",
           tti,
@@ -188,7 +232,7 @@ void txrx::run_thread()
           lte_worker ? lte_worker->get_id() : 0);
 
     // Trigger prach worker execution
-    for (uint32_t cc = 0; cc < worker_com->get_nof_carriers_lte(); cc++) {
+    for (uint32_t cc = 0; cc < worker_com->get_nof_carriers_lte() and not tx_only; cc++) {
       prach->new_tti(cc, tti, buffer.get(worker_com->get_rf_port(cc), 0, worker_com->get_nof_ports(0)));
     }
 
@@ -199,6 +243,7 @@ void txrx::run_thread()
       context.worker_ptr = nr_worker;
       context.last       = (lte_worker == nullptr); // Set last if standalone
       context.tx_time.copy(timestamp);
+      context.tx_deadline = tx_deadline;
 
       nr_worker->set_context(context);
 
@@ -214,6 +259,7 @@ void txrx::run_thread()
       context.worker_ptr = lte_worker;
       context.last       = true;
       context.tx_time.copy(timestamp);
+      context.tx_deadline = tx_deadline;
 
       lte_worker->set_context(context);
 
@@ -227,4 +273,153 @@ void txrx::run_thread()
   }
 }
 
+void txrx::tx_only_start()
+{
+  tx_only_tti_count   = 0;
+  tx_only_time_ref    = time_ref_t::none;
+  tx_lookahead_ms     = worker_com->params.tx_lookahead_ms;
+  tx_lookahead_settle = false;
+  worker_com->set_tx_lookahead_ms(tx_lookahead_ms);
+  if (worker_com->params.tx_time_ref == "radio") {
+    tx_only_time_ref = time_ref_t::radio;
+  } else if (worker_com->params.tx_time_ref == "system") {
+    tx_only_time_ref = time_ref_t::system;
+  }
+
+  if (worker_com->params.tx_offline) {
+    // Rendering to a file or a benchmark sink, the signal starts at time zero and TTIs follow each other without wait
+    tx_only_radio_time = false;
+    tx_only_time.copy(srsran::rf_timestamp_t());
+    logger.info("Starting offline TX rendering");
+  } else {
+    tx_only_radio_time = radio_h->get_time(tx_only_time);
+    if (not tx_only_radio_time) {
+      // Without the radio time, transmissions are timed from zero on the host clock
+      tx_only_time.copy(srsran::rf_timestamp_t());
+      logger.warning("The radio does not provide its time, TX timing follows the host clock");
+    }
+    logger.info("Starting TX only operation at radio time %.6f s", srsran_timestamp_real(&tx_only_time.get(0)));
+  }
+  tx_only_deadline = std::chrono::steady_clock::now();
+
+  if (tx_only_time_ref != time_ref_t::none) {
+    tx_only_align(tx_only_time);
+  }
+}
+
+void txrx::tx_only_align(const srsran::rf_timestamp_t& radio_now)
+{
+  // Absolute time at radio_now. The system clock is read right after the radio time, their difference is assumed
+  // constant afterwards
+  srsran_timestamp_t abs_now = radio_now.get(0);
+  if (tx_only_time_ref == time_ref_t::system) {
+    struct timespec ts = {};
+    clock_gettime(CLOCK_REALTIME, &ts);
+    srsran_timestamp_init(&abs_now, ts.tv_sec, ts.tv_nsec * 1e-9);
+  }
+
+  tx_only_boundary_t boundary = tx_only_next_boundary(abs_now, tx_lookahead_ms, worker_com->params.tx_site_delay_ns);
+  tx_only_time.copy(radio_now);
+  tx_only_time.add(boundary.delta_s);
+  tx_only_deadline = std::chrono::steady_clock::now();
+  tx_only_deadline += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(boundary.delta_s));
+  tti = boundary.tti;
+
+  logger.info("SFN aligned on %s time: TTI %d (SFN=%d, sf=%d) at %" PRIu64 ".%03d s, site delay %d ns",
+              tx_only_time_ref == time_ref_t::radio ? "radio" : "system",
+              (uint32_t)(boundary.tti_count % 10240),
+              (uint32_t)(boundary.tti_count % 10240) / 10,
+              (uint32_t)(boundary.tti_count % 10),
+              boundary.tti_count / 1000,
+              (int)(boundary.tti_count % 1000),
+              worker_com->params.tx_site_delay_ns);
+}
+
+void txrx::tx_only_wait_tti(srsran::rf_timestamp_t& timestamp)
+{
+  if (tx_only_widen_lookahead()) {
+    // This TTI keeps the radio and host time of the previous one and is dispatched right away. With the wider
+    // lookahead it is still transmitted 1 ms after it
+    tx_only_tti_count++;
+    timestamp.copy(tx_only_time);
+    return;
+  }
+
+  tx_only_time.add(1e-3);
+  if (worker_com->params.tx_offline) {
+    // The PHY workers are the only pace
+    tx_only_tti_count++;
+    timestamp.copy(tx_only_time);
+    return;
+  }
+  tx_only_deadline += std::chrono::milliseconds(1);
+
+  // Subframes are dispatched ahead in bursts: only the first one of each burst waits for its time, the rest are handed
+  // to the workers one by one right after it, up to tx_burst_sf - 1 ms earlier than they would be otherwise. This
+  // saves wakeups of this thread, each subframe is still processed on its own
+  if (tx_only_tti_count % worker_com->params.tx_burst_sf == 0) {
+    std::this_thread::sleep_until(tx_only_deadline);
+  }
+
+  // The host clock drifts from the radio clock, compare them periodically so the error does not accumulate
+  tx_only_tti_count++;
+  srsran::rf_timestamp_t radio_time;
+  if (tx_only_radio_time and tx_only_tti_count % tx_only_sync_period == 0 and radio_h->get_time(radio_time)) {
+    double host_elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - tx_only_deadline).count();
+    double error =
+        srsran_timestamp_real(&radio_time.get(0)) - srsran_timestamp_real(&tx_only_time.get(0)) - host_elapsed;
+
+    if (std::abs(error) > tx_only_max_error_s) {
+      // The radio time jumped, e.g. it was set on a PPS edge
+      logger.warning("Radio time is %+.3f ms off the TTI timing, realigning", error * 1e3);
+      if (tx_only_time_ref != time_ref_t::none) {
+        // The TTI numbering restarts from the new time, this TTI is the first one after it
+        tx_only_align(radio_time);
+        tti = TTI_ADD(tti, 1);
+        tx_only_time.add(1e-3);
+        tx_only_deadline += std::chrono::milliseconds(1);
+      } else {
+        tx_only_time.copy(radio_time);
+        tx_only_deadline = std::chrono::steady_clock::now();
+      }
+    } else {
+      tx_only_deadline -= std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(error));
+    }
+  }
+
+  timestamp.copy(tx_only_time);
+}
+
+bool txrx::tx_only_widen_lookahead()
+{
+  if (worker_com->params.tx_offline or tx_lookahead_ms >= worker_com->params.tx_lookahead_max_ms or
+      tx_only_tti_count % tx_lookahead_period != 0) {
+    return false;
+  }
+
+  // Subframes dispatched before the last widening end during the period after it, with the slack they had before
+  float min_slack_ms = worker_com->get_tx_min_slack_ms();
+  if (tx_lookahead_settle) {
+    tx_lookahead_settle = false;
+    return false;
+  }
+  if (min_slack_ms >= worker_com->params.tx_slack_min_us * 1e-3f) {
+    return false;
+  }
+
+  tx_lookahead_ms++;
+  tx_lookahead_settle = true;
+  worker_com->set_tx_lookahead_ms(tx_lookahead_ms);
+  logger.info("TX slack down to %.3f ms, widening the lookahead to %d ms", min_slack_ms, tx_lookahead_ms);
+  return true;
+}
+
+bool txrx::tx_offline_complete() const
+{
+  return worker_com->params.tx_offline and worker_com->params.tx_offline_sf > 0 and
+         tx_only_tti_count >= worker_com->params.tx_offline_sf;
+}
+
 } // namespace srsenb
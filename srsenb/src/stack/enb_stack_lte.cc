@@ -148,6 +148,9 @@ int enb_stack_lte::init(const stack_args_t&      args_,
   gtpu_args.embms_enable                 = args.embms.enable;
   gtpu_args.embms_m1u_multiaddr          = args.embms.m1u_multiaddr;
   gtpu_args.embms_m1u_if_addr            = args.embms.m1u_if_addr;
+  gtpu_args.embms_m1u_pcap               = args.embms.m1u_pcap;
+  gtpu_args.embms_mtch_max_delay_ms      = args.embms.mtch_max_delay_ms;
+  gtpu_args.embms_mtch_queue_bytes       = args.embms.mtch_queue_bytes;
   gtpu_args.mme_addr                     = args.s1ap.mme_addr;
   gtpu_args.gtp_bind_addr                = args.s1ap.gtp_bind_addr;
   gtpu_args.indirect_tunnel_timeout_msec = args.gtpu_indirect_tunnel_timeout_msec;
@@ -237,6 +240,24 @@ bool enb_stack_lte::get_metrics(stack_metrics_t* metrics)
   return false;
 }
 
+void enb_stack_lte::mbms_session_start(uint32_t           area_idx,
+                                       uint32_t           pmch_idx,
+                                       const std::string& plmn,
+                                       uint32_t           service_id,
+                                       uint32_t           lcid,
+                                       int                session_id)
+{
+  // RRC, RLC, PDCP and GTPU are only accessed from the stack thread
+  enb_task_queue.push([this, area_idx, pmch_idx, plmn, service_id, lcid, session_id]() {
+    rrc.mbms_session_start(area_idx, pmch_idx, plmn, service_id, lcid, session_id);
+  });
+}
+
+void enb_stack_lte::mbms_session_stop(const std::string& plmn, uint32_t service_id)
+{
+  enb_task_queue.push([this, plmn, service_id]() { rrc.mbms_session_stop(plmn, service_id); });
+}
+
 void enb_stack_lte::run_thread()
 {
   while (started.load(std::memory_order_relaxed)) {
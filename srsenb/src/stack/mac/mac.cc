@@ -145,10 +145,9 @@ int mac::rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint
     if (rnti != SRSRAN_MRNTI) {
       ret = scheduler.dl_rlc_buffer_state(rnti, lc_id, tx_queue, retx_queue);
     } else {
-      for (uint32_t i = 0; i < mch.num_mtch_sched; i++) {
-        if (lc_id == mch.mtch_sched[i].lcid) {
-          mch.mtch_sched[i].lcid_buffer_size = tx_queue;
-        }
+      // Called from the RLC while the MCH scheduler reads MTCH PDUs, so the MCH state is not locked here
+      if (lc_id < SRSRAN_N_MCH_LCIDS) {
+        mtch_buffer_size[lc_id] = tx_queue;
       }
       ret = 0;
     }
@@ -644,6 +643,11 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
 
   srsran::rwlock_read_guard lock(rwlock);
 
+  {
+    std::lock_guard<std::mutex> mch_lock(mch_mutex);
+    sched_mcch_notif(tti_tx_dl);
+  }
+
   for (uint32_t enb_cc_idx = 0; enb_cc_idx < cell_config.size(); enb_cc_idx++) {
     // Run scheduler with current info
     sched_interface::dl_sched_res_t sched_result = {};
@@ -801,6 +805,13 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
       }
     }
 
+    // Copy MCCH change notifications, DCI without PDSCH
+    for (uint32_t i = 0; i < sched_result.mcch_notif.size(); i++) {
+      dl_sched_res->pdsch[n].dci     = sched_result.mcch_notif[i].dci;
+      dl_sched_res->pdsch[n].data[0] = nullptr;
+      n++;
+    }
+
     dl_sched_res->nof_grants = n;
 
     // Number of CCH symbols
@@ -815,36 +826,85 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
   return SRSRAN_SUCCESS;
 }
 
-void mac::build_mch_sched(uint32_t tbs)
+static uint32_t mch_tbs(uint32_t mcs_idx, uint32_t nof_prb)
 {
-  int sfs_per_sched_period = mcch.pmch_info_list[0].sf_alloc_end;
-  int bytes_per_sf         = tbs / 8 - 6; // leave 6 bytes for header
+  srsran_ra_tb_t tb = {};
+  tb.mcs_idx        = mcs_idx;
+  srsran_dl_fill_ra_mcs(&tb, 0, nof_prb, false);
+  return tb.tbs;
+}
 
-  int total_space_avail_bytes = sfs_per_sched_period * bytes_per_sf;
+/**
+ * Plans the MTCHs of a PMCH for a new MCH scheduling period (MSP). The MTCHs are packed back to back in the order of
+ * the PMCH session list, several of them sharing a TB when they fit, and each of them is only sent between the stop of
+ * the previous one and its own stop, as signalled in the MSI (TS 36.321 5.12 and 6.1.3.7)
+ * @param nof_sf number of subframes of the PMCH in the MSP
+ * @param tbs TBS of the PMCH data MCS, in bits
+ * @param first_sf_tbs TBS of the first subframe of the MSP, in bits, which uses the signalling MCS when it carries the
+ * MCCH
+ * @param first_sf_overhead bytes taken by the MSI and MCCH in the first subframe of the MSP
+ */
+void mac::build_mch_sched(mch_pmch_t& pmch,
+                          uint32_t    nof_sf,
+                          uint32_t    tbs,
+                          uint32_t    first_sf_tbs,
+                          uint32_t    first_sf_overhead)
+{
+  sched_interface::dl_pdu_mch_t& mch = pmch.mch;
 
-  int total_bytes_to_tx = 0;
+  const uint32_t sdu_hdr_len        = 3;
+  uint32_t       bytes_per_sf       = tbs / 8;
+  uint32_t       bytes_per_first_sf = first_sf_tbs / 8;
 
-  // calculate total bytes to be scheduled
+  uint32_t total_bytes_to_tx = 0;
   for (uint32_t i = 0; i < mch.num_mtch_sched; i++) {
+    mch.mtch_sched[i].lcid_buffer_size = mtch_buffer_size[mch.mtch_sched[i].lcid];
+    mch.mtch_sched[i].stop             = srsran::sch_subh::MTCH_STOP_EMPTY;
+    pmch.mtch_start[i]                 = 0;
+    pmch.mtch_bytes_left[i]            = 0;
     total_bytes_to_tx += mch.mtch_sched[i].lcid_buffer_size;
-    mch.mtch_sched[i].stop = 0;
+  }
+  if (nof_sf == 0 or total_bytes_to_tx == 0) {
+    return;
   }
 
-  int last_mtch_stop = 0;
+  // When the MTCHs do not fit in the MSP, each of them gets a share proportional to its buffer
+  uint32_t total_space_avail_bytes = (nof_sf - 1) * (bytes_per_sf - std::min(bytes_per_sf, sdu_hdr_len)) +
+                                     bytes_per_first_sf - std::min(bytes_per_first_sf, sdu_hdr_len);
+  total_space_avail_bytes -= std::min(total_space_avail_bytes, first_sf_overhead);
 
-  if (total_bytes_to_tx > 0 && total_bytes_to_tx >= total_space_avail_bytes) {
-    for (uint32_t i = 0; i < mch.num_mtch_sched; i++) {
-      double ratio           = mch.mtch_sched[i].lcid_buffer_size / total_bytes_to_tx;
-      float  assigned_sfs    = floor(sfs_per_sched_period * ratio);
-      mch.mtch_sched[i].stop = last_mtch_stop + (uint32_t)assigned_sfs;
-      last_mtch_stop         = mch.mtch_sched[i].stop;
+  uint32_t sf   = 0;
+  uint32_t room = bytes_per_first_sf - std::min(bytes_per_first_sf, first_sf_overhead);
+  for (uint32_t i = 0; i < mch.num_mtch_sched; i++) {
+    uint32_t budget = mch.mtch_sched[i].lcid_buffer_size;
+    if (total_bytes_to_tx > total_space_avail_bytes) {
+      budget = (uint32_t)((uint64_t)budget * total_space_avail_bytes / total_bytes_to_tx);
     }
-  } else {
-    for (uint32_t i = 0; i < mch.num_mtch_sched; i++) {
-      float assigned_sfs     = ceil(((float)mch.mtch_sched[i].lcid_buffer_size) / ((float)bytes_per_sf));
-      mch.mtch_sched[i].stop = last_mtch_stop + (uint32_t)assigned_sfs;
-      last_mtch_stop         = mch.mtch_sched[i].stop;
+
+    uint32_t start = sf;
+    uint32_t bytes = 0;
+    while (bytes < budget) {
+      if (room <= sdu_hdr_len) {
+        if (sf + 1 >= nof_sf) {
+          break;
+        }
+        sf++;
+        room = bytes_per_sf;
+        if (bytes == 0) {
+          start = sf;
+        }
+        continue;
+      }
+      uint32_t n = std::min(budget - bytes, room - sdu_hdr_len);
+      bytes += n;
+      room -= n + sdu_hdr_len;
+    }
+    if (bytes == 0) {
+      continue;
     }
+    mch.mtch_sched[i].stop  = sf;
+    pmch.mtch_start[i]      = start;
+    pmch.mtch_bytes_left[i] = bytes;
   }
 }
 
@@ -853,72 +913,136 @@ int mac::get_mch_sched(uint32_t tti, bool is_mcch, dl_sched_list_t& dl_sched_res
   srsran::rwlock_read_guard lock(rwlock);
   dl_sched_t*               dl_sched_res = &dl_sched_res_list[0];
   logger.set_context(tti);
-  srsran_ra_tb_t mcs      = {};
-  srsran_ra_tb_t mcs_data = {};
-  mcs.mcs_idx             = enum_to_number(this->sib13.mbsfn_area_info_list[0].mcch_cfg.sig_mcs);
-  mcs_data.mcs_idx        = this->mcch.pmch_info_list[0].data_mcs;
-  srsran_dl_fill_ra_mcs(&mcs, 0, cell_config[0].cell.nof_prb, false);
-  srsran_dl_fill_ra_mcs(&mcs_data, 0, cell_config[0].cell.nof_prb, false);
-  if (is_mcch) {
-  //    ue_db[SRSRAN_MRNTI]->reset_sn(1);
-    build_mch_sched(mcs_data.tbs); // [kku]
-    mch.mcch_payload              = mcch_payload_buffer;
-    mch.current_sf_allocation_num = 1;
-    logger.info("MCH Sched Info: LCID: %d, Stop: %d, tti is %d ",
-                mch.mtch_sched[0].lcid,
-                mch.mtch_sched[mch.num_mtch_sched - 1].stop,
-                tti);
-    phy_h->set_mch_period_stop(mch.mtch_sched[mch.num_mtch_sched - 1].stop);
-    for (uint32_t i = 0; i < mch.num_mtch_sched; i++) {
-      mch.pdu[i].lcid = (uint32_t)srsran::mch_lcid::MCH_SCHED_INFO;
-      // m1u.mtch_sched[i].lcid = 1+i;
+
+  dl_sched_res->nof_grants        = 0;
+  dl_sched_res->pdsch[0].dci.rnti = 0;
+  dl_sched_res->pdsch[0].data[0]  = nullptr;
+
+  std::lock_guard<std::mutex> mch_lock(mch_mutex);
+  sched_mcch_notif(tti);
+
+  // Only DCIs of the control region are scheduled in MBSFN subframes
+  sched_interface::dl_sched_res_t sched_result = {};
+  if (scheduler.dl_sched(tti, 0, sched_result) < 0) {
+    logger.error("Running scheduler");
+    return SRSRAN_ERROR;
+  }
+
+  mbsfn_sf_alloc_t sf_alloc;
+  if (ue_db.contains(SRSRAN_MRNTI) and mbsfn_map.get_sf_alloc(tti, sf_alloc)) {
+    mch_area_t& area    = mch_areas[sf_alloc.area_idx];
+    uint32_t    nof_prb = cell_config[0].cell.nof_prb;
+
+    if (is_mcch != sf_alloc.is_mcch) {
+      logger.warning("MCCH subframe mismatch between PHY and MAC in tti=%d", tti);
     }
 
-    mch.pdu[mch.num_mtch_sched].lcid   = 0;
-    mch.pdu[mch.num_mtch_sched].nbytes = current_mcch_length;
-    dl_sched_res->pdsch[0].dci.rnti    = SRSRAN_MRNTI;
+    // Subframes carrying the MCCH use the signalling MCS of the area, the rest the data MCS of their PMCH
+    sched_interface::dl_pdu_mch_t  mcch_mch = {};
+    sched_interface::dl_pdu_mch_t* mch      = &mcch_mch;
+    mch_pmch_t*                    pmch     = nullptr;
+    uint32_t                       mcs_idx  = area.sig_mcs;
+    if (sf_alloc.has_pmch) {
+      pmch    = &area.pmch_list[sf_alloc.pmch_idx];
+      mch     = &pmch->mch;
+      mcs_idx = sf_alloc.is_mcch ? area.sig_mcs : pmch->data_mcs;
+    }
+    uint32_t tbs           = mch_tbs(mcs_idx, nof_prb);
+    uint32_t nof_pdu_elems = 0;
+    bool     has_ctrl      = false;
+
+    if (pmch != nullptr and sf_alloc.sf_idx_in_msp == 0) {
+      // The MSI goes first in the first subframe of each MCH scheduling period, followed by the MCCH if present
+      uint32_t overhead = 2 + 2 * mch->num_mtch_sched + (sf_alloc.is_mcch ? area.mcch_payload.size() + 3 : 0);
+      build_mch_sched(*pmch,
+                      mbsfn_map.get_nof_sf_per_msp(sf_alloc.area_idx, sf_alloc.pmch_idx),
+                      mch_tbs(pmch->data_mcs, nof_prb),
+                      tbs,
+                      overhead);
+      mch->pdu[nof_pdu_elems].lcid     = (uint32_t)srsran::mch_lcid::MCH_SCHED_INFO;
+      mch->pdu[nof_pdu_elems++].nbytes = 0;
+      has_ctrl                         = true;
+      for (uint32_t i = 0; i < mch->num_mtch_sched; i++) {
+        logger.info("MCH Sched Info: area=%d, pmch=%d, LCID: %d, bytes: %d, Start: %d, Stop: %d, tti is %d",
+                    sf_alloc.area_idx,
+                    sf_alloc.pmch_idx,
+                    mch->mtch_sched[i].lcid,
+                    pmch->mtch_bytes_left[i],
+                    pmch->mtch_start[i],
+                    mch->mtch_sched[i].stop,
+                    tti);
+      }
+    }
+    if (sf_alloc.is_mcch) {
+      mch->mcch_payload                = area.mcch_payload.data();
+      mch->pdu[nof_pdu_elems].lcid     = 0;
+      mch->pdu[nof_pdu_elems++].nbytes = area.mcch_payload.size();
+      has_ctrl                         = true;
+    }
 
-    // we use TTI % HARQ to make sure we use different buffers for consecutive TTIs to avoid races between PHY workers
-    ue_db[SRSRAN_MRNTI]->metrics_tx(true, mcs.tbs);
-    dl_sched_res->pdsch[0].data[0] =
-        ue_db[SRSRAN_MRNTI]->generate_mch_pdu(tti % SRSRAN_FDD_NOF_HARQ, mch, mch.num_mtch_sched + 1, mcs.tbs / 8);
-  } else {
-    uint32_t current_lcid = 1;
-    uint32_t mtch_index   = 0;
-    uint32_t mtch_stop    = mch.mtch_sched[mch.num_mtch_sched - 1].stop;
-
-    for (uint32_t i = 0; i < mch.num_mtch_sched; i++) {
-      if (mch.current_sf_allocation_num <= mch.mtch_sched[i].stop) {
-        current_lcid = mch.mtch_sched[i].lcid;
-        mtch_index   = i;
-        break;
+    // MTCHs whose window in the MCH scheduling period covers this subframe, in the order of the session list
+    uint32_t mtch_idx[sched_interface::MAX_MTCH_SCHED];
+    uint32_t first_mtch_elem = nof_pdu_elems;
+    uint32_t nof_mtch        = 0;
+    if (pmch != nullptr) {
+      mch->current_sf_allocation_num = sf_alloc.sf_idx_in_msp;
+      for (uint32_t i = 0; i < mch->num_mtch_sched; i++) {
+        if (pmch->mtch_bytes_left[i] == 0 or sf_alloc.sf_idx_in_msp < pmch->mtch_start[i]) {
+          continue;
+        }
+        if (sf_alloc.sf_idx_in_msp > mch->mtch_sched[i].stop) {
+          // Whatever did not fit stays in the RLC for the next MCH scheduling period
+          pmch->mtch_bytes_left[i] = 0;
+          continue;
+        }
+        mch->pdu[nof_pdu_elems].lcid     = mch->mtch_sched[i].lcid;
+        mch->pdu[nof_pdu_elems++].nbytes = pmch->mtch_bytes_left[i];
+        mtch_idx[nof_mtch++]             = i;
       }
     }
-    logger.info("MCH Sched Info: current_sf_alloc_num: %d, Stop: %d",
-        mch.current_sf_allocation_num , mtch_stop);
-    if (mch.current_sf_allocation_num <= mtch_stop) {
-      int requested_bytes = (mcs_data.tbs / 8 > (int)mch.mtch_sched[mtch_index].lcid_buffer_size)
-                                ? (mch.mtch_sched[mtch_index].lcid_buffer_size)
-                                : ((mcs_data.tbs / 8) - 2);
-      int bytes_received = ue_db[SRSRAN_MRNTI]->read_pdu(current_lcid, mtch_payload_buffer, requested_bytes);
-      mch.pdu[0].lcid    = current_lcid;
-      mch.pdu[0].nbytes  = bytes_received;
-    logger.info("MCH Sched Info: LCID: %d, Stop: %d, tti is %d, bytes recvd %d ",
-                mch.mtch_sched[mtch_index].lcid,
-                mtch_stop,
-                tti, bytes_received);
-      mch.mtch_sched[0].mtch_payload  = mtch_payload_buffer;
-      dl_sched_res->pdsch[0].dci.rnti = SRSRAN_MRNTI;
-      if (bytes_received) {
-        ue_db[SRSRAN_MRNTI]->metrics_tx(true, mcs.tbs);
-        dl_sched_res->pdsch[0].data[0] =
-            ue_db[SRSRAN_MRNTI]->generate_mch_pdu(tti % SRSRAN_FDD_NOF_HARQ, mch, 1, mcs_data.tbs / 8);
+
+    if (nof_pdu_elems > 0) {
+      // we use TTI % HARQ to make sure we use different buffers for consecutive TTIs to avoid races between PHY workers
+      uint8_t* pdu = ue_db[SRSRAN_MRNTI]->generate_mch_pdu(tti % SRSRAN_FDD_NOF_HARQ, *mch, nof_pdu_elems, tbs / 8);
+
+      uint32_t mtch_bytes = 0;
+      for (uint32_t j = 0; j < nof_mtch; j++) {
+        uint32_t i      = mtch_idx[j];
+        uint32_t nbytes = mch->pdu[first_mtch_elem + j].nbytes;
+        pmch->mtch_bytes_left[i] -= std::min(nbytes, pmch->mtch_bytes_left[i]);
+        mtch_bytes += nbytes;
+        logger.debug("MCH: LCID: %d, bytes: %d, left: %d, tti is %d",
+                     mch->mtch_sched[i].lcid,
+                     nbytes,
+                     pmch->mtch_bytes_left[i],
+                     tti);
       }
-    } else {
-      dl_sched_res->pdsch[0].dci.rnti = 0;
-      dl_sched_res->pdsch[0].data[0]  = nullptr;
+      if (has_ctrl or mtch_bytes > 0) {
+        ue_db[SRSRAN_MRNTI]->metrics_tx(true, tbs);
+        dl_sched_res->pdsch[0].data[0] = pdu;
+      }
+    }
+
+    if (dl_sched_res->pdsch[0].data[0] != nullptr) {
+      dl_sched_res->nof_grants                 = 1;
+      dl_sched_res->pdsch[0].dci.rnti          = SRSRAN_MRNTI;
+      dl_sched_res->pdsch[0].dci.tb[0].mcs_idx = mcs_idx;
     }
-    mch.current_sf_allocation_num++;
+  }
+
+  // MCCH change notifications follow the MCH grant, which stays first even if the PMCH is not transmitted. Their CCEs
+  // must fit the non-MBSFN region
+  if (not sched_result.mcch_notif.empty() and sched_result.cfi > dl_sched_res->cfi) {
+    logger.warning("Dropping MCCH change notification, CFI %d exceeds the non-MBSFN region of tti=%d",
+                   sched_result.cfi,
+                   tti);
+    sched_result.mcch_notif.clear();
+  }
+  for (uint32_t i = 0; i < sched_result.mcch_notif.size(); i++) {
+    uint32_t n                     = std::max(dl_sched_res->nof_grants, 1u);
+    dl_sched_res->pdsch[n].dci     = sched_result.mcch_notif[i].dci;
+    dl_sched_res->pdsch[n].data[0] = nullptr;
+    dl_sched_res->nof_grants       = n + 1;
   }
 
   // Count number of TTIs for all active users
@@ -1042,33 +1166,142 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
   return SRSRAN_SUCCESS;
 }
 
-void mac::write_mcch(const srsran::sib2_mbms_t* sib2_,
-                     const srsran::sib13_t*     sib13_,
-                     const srsran::mcch_msg_t*  mcch_,
-                     const uint8_t*             mcch_payload,
-                     const uint8_t              mcch_payload_length)
+void mac::write_mcch(const srsran::sib2_mbms_t*                sib2_,
+                     const srsran::sib13_t*                    sib13_,
+                     const std::vector<srsran::mcch_msg_t>&    mcch_list,
+                     const std::vector<std::vector<uint8_t> >& mcch_payload_list)
 {
   srsran::rwlock_write_guard lock(rwlock);
-  mcch               = *mcch_;
-  mch.num_mtch_sched = this->mcch.pmch_info_list[0].nof_mbms_session_info;
-  for (uint32_t i = 0; i < mch.num_mtch_sched; ++i) {
-    mch.mtch_sched[i].lcid = this->mcch.pmch_info_list[0].mbms_session_info_list[i].lc_ch_id;
+  {
+    std::lock_guard<std::mutex> mch_lock(mch_mutex);
+    mbsfn_map.configure(*sib2_, *sib13_, mcch_list);
+    mch_areas.clear();
+    mch_areas.resize(mbsfn_map.nof_areas());
+    for (uint32_t a = 0; a < mch_areas.size(); ++a) {
+      mch_area_t& area = mch_areas[a];
+      area.sig_mcs     = enum_to_number(sib13_->mbsfn_area_info_list[a].mcch_cfg.sig_mcs);
+      area.mod_period  = enum_to_number(sib13_->mbsfn_area_info_list[a].mcch_cfg.mcch_mod_period);
+      if (a < mcch_payload_list.size()) {
+        area.mcch_payload = mcch_payload_list[a];
+      }
+      configure_mch_area(a, area, mcch_list[a]);
+    }
   }
-  sib2  = *sib2_;
-  sib13 = *sib13_;
-  memcpy(mcch_payload_buffer, mcch_payload, mcch_payload_length * sizeof(uint8_t));
-  current_mcch_length = mcch_payload_length;
 
-  unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(
-      SRSRAN_MRNTI, SRSRAN_MRNTI, 0, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pool.get());
+  if (not ue_db.contains(SRSRAN_MRNTI)) {
+    unique_rnti_ptr<ue> ue_ptr = make_rnti_obj<ue>(
+        SRSRAN_MRNTI, SRSRAN_MRNTI, 0, &scheduler, rrc_h, rlc_h, phy_h, logger, cells.size(), softbuffer_pool.get());
 
-  auto ret = ue_db.insert(SRSRAN_MRNTI, std::move(ue_ptr));
-  if (!ret) {
-    logger.info("Failed to allocate rnti=0x%x.for eMBMS", SRSRAN_MRNTI);
+    auto ret = ue_db.insert(SRSRAN_MRNTI, std::move(ue_ptr));
+    if (!ret) {
+      logger.info("Failed to allocate rnti=0x%x.for eMBMS", SRSRAN_MRNTI);
+    }
   }
   rrc_h->add_user(SRSRAN_MRNTI, {});
 }
 
+void mac::update_mcch(uint32_t                    area_idx,
+                      const srsran::mcch_msg_t&   mcch,
+                      const std::vector<uint8_t>& mcch_payload,
+                      uint32_t                    version)
+{
+  std::lock_guard<std::mutex> mch_lock(mch_mutex);
+  if (area_idx >= mch_areas.size()) {
+    logger.error("Can't update the MCCH of MBSFN area %d, only %zd areas are configured", area_idx, mch_areas.size());
+    return;
+  }
+  mch_area_t& area = mch_areas[area_idx];
+  if (mcch.nof_pmch_info != area.pmch_list.size()) {
+    logger.error("Can't update the MCCH of MBSFN area %d, the number of PMCHs can't change", area_idx);
+    return;
+  }
+  // A newer update replaces one that is still waiting for the modification period boundary
+  area.pending_mcch         = true;
+  area.pending_mcch_msg     = mcch;
+  area.pending_mcch_payload = mcch_payload;
+  area.pending_mcch_version = version;
+  logger.info("MCCH of MBSFN area %d will be updated at the next modification period", area_idx);
+}
+
+// Caller must hold the MCH mutex
+void mac::configure_mch_area(uint32_t area_idx, mch_area_t& area, const srsran::mcch_msg_t& mcch)
+{
+  area.pmch_list.resize(mcch.nof_pmch_info);
+  for (uint32_t p = 0; p < mcch.nof_pmch_info; ++p) {
+    const srsran::pmch_info_t& pmch_info = mcch.pmch_info_list[p];
+    mch_pmch_t&                pmch      = area.pmch_list[p];
+
+    pmch              = {};
+    pmch.data_mcs     = pmch_info.data_mcs;
+    uint32_t max_mtch = sched_interface::MAX_MTCH_SCHED;
+    if (pmch_info.nof_mbms_session_info > max_mtch) {
+      logger.warning("PMCH %d of MBSFN area %d has %d sessions, only the first %d are scheduled",
+                     p,
+                     area_idx,
+                     pmch_info.nof_mbms_session_info,
+                     max_mtch);
+    }
+    pmch.mch.num_mtch_sched = std::min(pmch_info.nof_mbms_session_info, max_mtch);
+    for (uint32_t i = 0; i < pmch.mch.num_mtch_sched; ++i) {
+      pmch.mch.mtch_sched[i].lcid = pmch_info.mbms_session_info_list[i].lc_ch_id;
+    }
+  }
+}
+
+// Caller must hold the MCH mutex
+void mac::apply_pending_mcch(uint32_t tti)
+{
+  for (uint32_t a = 0; a < mch_areas.size(); ++a) {
+    mch_area_t& area = mch_areas[a];
+    if (area.mod_period == 0) {
+      continue;
+    }
+
+    // Only TTIs after the latest one scheduled move to a new modification period, so that subframes scheduled out of
+    // order by the workers do not cross the same boundary twice
+    if (area.has_last_tti and (tti == area.last_tti or TTI_SUB(tti, area.last_tti) >= 10240 / 2)) {
+      continue;
+    }
+
+    // Modification periods are counted from SFN 0 and divide the hyperframe. The boundary is crossed when the period
+    // index changes, the hyperframe wraps around, or TTIs are skipped over a whole period
+    uint32_t period_len = area.mod_period * SRSRAN_NOF_SF_X_FRAME;
+    bool     boundary   = area.has_last_tti and
+                    (tti / period_len != area.last_tti / period_len or tti < area.last_tti or
+                     TTI_SUB(tti, area.last_tti) >= period_len);
+    area.last_tti     = tti;
+    area.has_last_tti = true;
+    if (not area.pending_mcch or not boundary) {
+      continue;
+    }
+
+    configure_mch_area(a, area, area.pending_mcch_msg);
+    area.mcch_payload = std::move(area.pending_mcch_payload);
+    area.pending_mcch = false;
+    rrc_h->mcch_applied(a, area.pending_mcch_version);
+    logger.info("Updated MCCH of MBSFN area %d in tti=%d", a, tti);
+  }
+}
+
+// Caller must hold the MCH mutex
+void mac::sched_mcch_notif(uint32_t tti)
+{
+  // A pending MCCH takes effect at the next modification period boundary, so it is notified in the current period
+  apply_pending_mcch(tti);
+  if (not mbsfn_map.is_mcch_notif_sf(tti)) {
+    return;
+  }
+  uint8_t notif_bitmap = 0;
+  for (uint32_t a = 0; a < mch_areas.size(); ++a) {
+    if (mch_areas[a].pending_mcch) {
+      notif_bitmap |= 1u << mbsfn_map.get_notif_ind(a);
+    }
+  }
+  if (notif_bitmap != 0) {
+    scheduler.set_mcch_notif(0, tti, notif_bitmap);
+  }
+}
+
 // Internal helper function, caller must hold UE DB rwlock
 bool mac::check_ue_active(uint16_t rnti)
 {
@@ -307,6 +307,15 @@ int sched::set_pdcch_order(uint32_t enb_cc_idx, dl_sched_po_info_t pdcch_order_i
   return carrier_schedulers[enb_cc_idx]->pdcch_order_info(pdcch_order_info);
 }
 
+int sched::set_mcch_notif(uint32_t enb_cc_idx, uint32_t tti_tx_dl, uint8_t notif_bitmap)
+{
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  if (enb_cc_idx >= carrier_schedulers.size()) {
+    return SRSRAN_ERROR;
+  }
+  return carrier_schedulers[enb_cc_idx]->mcch_notif_info(tti_point{tti_tx_dl}, notif_bitmap);
+}
+
 /*******************************************************
  *
  * Main sched functions
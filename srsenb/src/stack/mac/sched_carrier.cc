@@ -350,6 +350,7 @@ void sched::carrier_sched::reset()
   ra_sched_ptr.reset();
   bc_sched_ptr.reset();
   pending_pdcch_orders.clear();
+  pending_mcch_notif = 0;
 }
 
 void sched::carrier_sched::carrier_cfg(const sched_cell_params_t& cell_params_)
@@ -401,6 +402,9 @@ const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_r
     }
   }
 
+  /* Schedule MCCH change notification, its DCI also fits the control region of MBSFN subframes */
+  mcch_notif_sched(tti_sched);
+
   /* Schedule DL control data */
   if (dl_active) {
     /* Schedule Broadcast data (SIB and paging) */
@@ -528,4 +532,23 @@ void sched::carrier_sched::pdcch_order_sched(sf_sched* tti_sched)
   }
 }
 
+int sched::carrier_sched::mcch_notif_info(tti_point tti_tx_dl, uint8_t notif_bitmap)
+{
+  pending_mcch_notif_tti = tti_tx_dl;
+  pending_mcch_notif     = notif_bitmap;
+  return SRSRAN_SUCCESS;
+}
+
+void sched::carrier_sched::mcch_notif_sched(sf_sched* tti_sched)
+{
+  if (pending_mcch_notif == 0 or pending_mcch_notif_tti != tti_sched->get_tti_tx_dl()) {
+    return;
+  }
+  alloc_result ret = tti_sched->alloc_mcch_notif(mcch_notif_aggr_level, pending_mcch_notif);
+  if (ret != alloc_result::success) {
+    logger.warning("SCHED: Could not allocate MCCH change notification, cause=%s", to_string(ret));
+  }
+  pending_mcch_notif = 0;
+}
+
 } // namespace srsenb
@@ -167,8 +167,7 @@ alloc_result sf_grid_t::alloc_dl(uint32_t     aggr_idx,
 /// Allocates CCEs and RBs for control allocs. It allocates RBs in a contiguous manner.
 alloc_result sf_grid_t::alloc_dl_ctrl(uint32_t aggr_idx, rbg_interval rbg_range, alloc_type_t alloc_type)
 {
-  if (alloc_type != alloc_type_t::DL_RAR and alloc_type != alloc_type_t::DL_BC and
-      alloc_type != alloc_type_t::DL_PCCH and alloc_type != alloc_type_t::DL_PDCCH_ORDER) {
+  if (not is_dl_ctrl_alloc(alloc_type)) {
     logger.error("SCHED: DL control allocations must be RAR/BC/PDCCH");
     return alloc_result::other_cause;
   }
@@ -326,6 +325,7 @@ void sf_sched::new_tti(tti_point tti_rx_, sf_sched_result* cc_results_)
   bc_allocs.clear();
   rar_allocs.clear();
   po_allocs.clear();
+  mcch_notif_allocs.clear();
   data_allocs.clear();
   ul_data_allocs.clear();
 
@@ -487,6 +487,31 @@ sf_sched::alloc_pdcch_order(const sched_interface::dl_sched_po_info_t& po_cfg, u
   return alloc_result::success;
 }
 
+alloc_result sf_sched::alloc_mcch_notif(uint32_t aggr_lvl, uint8_t notif_bitmap)
+{
+  if (mcch_notif_allocs.full()) {
+    logger.warning("SCHED: Maximum number of MCCH change notifications per TTI reached.");
+    return alloc_result::no_grant_space;
+  }
+
+  // The notification is a DCI without PDSCH, it only takes CCEs
+  alloc_result ret = tti_alloc.alloc_dl_ctrl(aggr_lvl, rbg_interval{}, alloc_type_t::DL_MCCH_NOTIF);
+  if (ret != alloc_result::success) {
+    return ret;
+  }
+
+  mcch_notif_alloc_t notif_alloc;
+  generate_mcch_notif_dci(notif_alloc.notif_grant, notif_bitmap);
+
+  // Allocation Successful
+  notif_alloc.dci_idx   = tti_alloc.get_pdcch_grid().nof_allocs() - 1;
+  notif_alloc.rbg_range = {};
+  notif_alloc.req_bytes = 0;
+  mcch_notif_allocs.push_back(notif_alloc);
+
+  return alloc_result::success;
+}
+
 bool is_periodic_cqi_expected(const sched_interface::ue_cfg_t& ue_cfg, tti_point tti_tx_ul)
 {
   for (const sched_interface::ue_cfg_t::cc_cfg_t& cc : ue_cfg.supported_cc_list) {
@@ -992,6 +1017,15 @@ void sf_sched::generate_sched_results(sched_ue_list& ue_db)
     log_po_allocation(cc_result->dl_sched_result.po.back(), po_alloc.rbg_range, *cc_cfg);
   }
 
+  for (const auto& notif_alloc : mcch_notif_allocs) {
+    cc_result->dl_sched_result.mcch_notif.emplace_back(notif_alloc.notif_grant);
+    cc_result->dl_sched_result.mcch_notif.back().dci.location = dci_result[notif_alloc.dci_idx]->dci_pos;
+    logger.info("SCHED: MCCH change notification, notif=0x%02x, cce=%d, L=%d",
+                notif_alloc.notif_grant.dci.mcch_change_notif,
+                cc_result->dl_sched_result.mcch_notif.back().dci.location.ncce,
+                cc_result->dl_sched_result.mcch_notif.back().dci.location.L);
+  }
+
   set_dl_data_sched_result(dci_result, &cc_result->dl_sched_result, ue_db);
 
   set_ul_sched_result(dci_result, &cc_result->ul_sched_result, ue_db);
@@ -347,6 +347,17 @@ void generate_pdcch_order_dci(sched_interface::dl_sched_po_t& pdcch_order,
   get_mac_logger().debug("PDCCH order: rnti=0x%x", pdcch_order.dci.rnti);
 }
 
+void generate_mcch_notif_dci(sched_interface::dl_sched_mcch_notif_t& notif, uint8_t notif_bitmap)
+{
+  // Generate DCI Format1C MCCH change notification content (TS 36.212 5.3.3.1.4)
+  notif.dci                   = {};
+  notif.dci.format            = SRSRAN_DCI_FORMAT1C;
+  notif.dci.alloc_type        = SRSRAN_RA_ALLOC_TYPE2;
+  notif.dci.type2_alloc.mode  = srsran_ra_type2_t::SRSRAN_RA_TYPE2_DIST;
+  notif.dci.rnti              = SRSRAN_MRNTI;
+  notif.dci.mcch_change_notif = notif_bitmap;
+}
+
 void log_broadcast_allocation(const sched_interface::dl_sched_bc_t& bc,
                               rbg_interval                          rbg_range,
                               const sched_cell_params_t&            cell_params)
@@ -582,10 +582,10 @@ uint8_t* ue::generate_pdu(uint32_t                              enb_cc_idx,
   return ret;
 }
 
-uint8_t* ue::generate_mch_pdu(uint32_t                             harq_pid,
-                              const sched_interface::dl_pdu_mch_t& sched_,
-                              uint32_t                             nof_pdu_elems,
-                              uint32_t                             grant_size)
+uint8_t* ue::generate_mch_pdu(uint32_t                       harq_pid,
+                              sched_interface::dl_pdu_mch_t& sched_,
+                              uint32_t                       nof_pdu_elems,
+                              uint32_t                       grant_size)
 {
   std::lock_guard<std::mutex> lock(mutex);
   uint8_t*                    ret    = nullptr;
@@ -595,14 +595,34 @@ uint8_t* ue::generate_mch_pdu(uint32_t                             harq_pid,
 
   for (uint32_t i = 0; i < nof_pdu_elems; i++) {
     if (sched_.pdu[i].lcid == (uint32_t)srsran::mch_lcid::MCH_SCHED_INFO) {
-      mch_mac_msg_dl.new_subh();
-      mch_mac_msg_dl.get()->set_next_mch_sched_info(sched_.mtch_sched[i].lcid, sched_.mtch_sched[i].stop);
+      // A single MSI MAC CE carries the stop of every MTCH of the PMCH (TS 36.321 6.1.3.7)
+      if (mch_mac_msg_dl.new_subh()) {
+        for (uint32_t j = 0; j < sched_.num_mtch_sched; j++) {
+          if (not mch_mac_msg_dl.get()->set_next_mch_sched_info(sched_.mtch_sched[j].lcid, sched_.mtch_sched[j].stop)) {
+            logger.warning("MSI: no space for the stop of lcid=%d", sched_.mtch_sched[j].lcid);
+            break;
+          }
+        }
+      }
     } else if (sched_.pdu[i].lcid == 0) {
       mch_mac_msg_dl.new_subh();
       mch_mac_msg_dl.get()->set_sdu(0, sched_.pdu[i].nbytes, sched_.mcch_payload);
     } else if (sched_.pdu[i].lcid <= (uint32_t)srsran::mch_lcid::MTCH_MAX_LCID) {
-      mch_mac_msg_dl.new_subh();
-      mch_mac_msg_dl.get()->set_sdu(sched_.pdu[i].lcid, sched_.pdu[i].nbytes, sched_.mtch_sched[i].mtch_payload);
+      // MTCH PDUs are read from the RLC straight into the TB, until the requested bytes or the TB are exhausted
+      uint32_t lcid      = sched_.pdu[i].lcid;
+      uint32_t requested = sched_.pdu[i].nbytes;
+      uint32_t nbytes    = 0;
+      int      n         = 1;
+      while (nbytes < requested and n > 0 and mch_mac_msg_dl.get_sdu_space() >= 2 and mch_mac_msg_dl.new_subh()) {
+        n = mch_mac_msg_dl.get()->set_sdu(
+            lcid, SRSRAN_MIN(requested - nbytes, (uint32_t)mch_mac_msg_dl.get_sdu_space()), this);
+        if (n > 0) {
+          nbytes += n;
+        } else {
+          mch_mac_msg_dl.del_subh();
+        }
+      }
+      sched_.pdu[i].nbytes = nbytes;
     }
   }
 
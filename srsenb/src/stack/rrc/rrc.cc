@@ -35,6 +35,10 @@
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/interfaces/enb_pdcp_interfaces.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
+#include "srsran/phy/phch/ra.h"
+#include "srsran/upper/gtpu.h"
+#include <bitset>
+#include <set>
 
 using srsran::byte_buffer_t;
 
@@ -230,6 +234,15 @@ void rrc::protocol_failure(uint16_t rnti)
   }
 }
 
+void rrc::mcch_applied(uint32_t area_idx, uint32_t version)
+{
+  // MCCH notifications are not tied to a user, the RNTI field carries the MBSFN area
+  rrc_pdu p = {(uint16_t)area_idx, LCID_MCCH_APPL, version, nullptr};
+  if (not rx_pdu_queue.try_push(std::move(p))) {
+    logger.error("Failed to push MCCH update of MBSFN area %d to RRC queue", area_idx);
+  }
+}
+
 // This function is called from PRACH worker (can wait)
 int rrc::add_user(uint16_t rnti, const sched_interface::ue_cfg_t& sched_ue_cfg)
 {
@@ -252,19 +265,238 @@ int rrc::add_user(uint16_t rnti, const sched_interface::ue_cfg_t& sched_ue_cfg)
   }
 
   if (rnti == SRSRAN_MRNTI) {
-    for (auto& mbms_item : mcch.msg.c1().mbsfn_area_cfg_r9().pmch_info_list_r9[0].mbms_session_info_list_r9) {
-      uint32_t lcid = mbms_item.lc_ch_id_r9;
-      uint32_t addr_in;
-      // adding UE object to MAC for MRNTI without scheduling configuration (broadcast not part of regular scheduling)
-      rlc->add_bearer_mrb(SRSRAN_MRNTI, lcid);
-      bearer_manager.add_eps_bearer(SRSRAN_MRNTI, 1, srsran::srsran_rat_t::lte, lcid);
-      pdcp->add_bearer(SRSRAN_MRNTI, lcid, srsran::make_drb_pdcp_config_t(1, false));
-      gtpu->add_bearer(SRSRAN_MRNTI, lcid, 1, 1, addr_in);
+    for (uint32_t a = 0; a < mcch_list.size(); a++) {
+      const mbsfn_area_cfg_r9_s& area_cfg = mcch_list[a].msg.c1().mbsfn_area_cfg_r9();
+      for (uint32_t p = 0; p < area_cfg.pmch_info_list_r9.size(); p++) {
+        for (const mbms_session_info_r9_s& session : area_cfg.pmch_info_list_r9[p].mbms_session_info_list_r9) {
+          if (add_mrb(a, p, session) != SRSRAN_SUCCESS) {
+            logger.error("Failed to add MRB lcid=%d of MBSFN area %d, PMCH %d", session.lc_ch_id_r9, a, p);
+          }
+        }
+      }
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int rrc::add_mrb(uint32_t area_idx, uint32_t pmch_idx, const mbms_session_info_r9_s& session)
+{
+  uint32_t lcid = session.lc_ch_id_r9;
+  const pmch_info_r9_s& pmch_item = mcch_list[area_idx].msg.c1().mbsfn_area_cfg_r9().pmch_info_list_r9[pmch_idx];
+
+  // The M1-U ingress of the MTCHs is shaped to the capacity of the PMCH carrying them, which they share
+  gtpu_interface_rrc::bearer_props props;
+  uint32_t                         msp_rf  = pmch_item.pmch_cfg_r9.mch_sched_period_r9.to_number();
+  uint32_t                         nof_sf  = mbsfn_map.get_nof_sf_per_msp(area_idx, pmch_idx);
+  int                              tbs_idx = srsran_ra_tbs_idx_from_mcs(pmch_item.pmch_cfg_r9.data_mcs_r9, false, false);
+  int                              tbs     = srsran_ra_tbs_from_idx(std::max(tbs_idx, 0), cfg.cell.nof_prb);
+  if (tbs > 0 and nof_sf > 0) {
+    props.mtch_rate_bps    = (uint32_t)((uint64_t)nof_sf * tbs * 100 / msp_rf);
+    props.mtch_burst_bytes = nof_sf * tbs / 8;
+  }
+  props.mtch_pmch_id = (area_idx << 8) | pmch_idx;
+  // The MBMS-GW tags the M1-U packets of each service with the service ID of its TMGI as TEID. Otherwise all M1-U
+  // traffic has the same TEID and is carried by the first MTCH
+  if (cfg.mbms_m1u_teid_per_service) {
+    props.m1u_teid = session.tmgi_r9.service_id_r9.to_number();
+  } else if (lcid == 1) {
+    props.m1u_teid = GTPU_M1U_DEFAULT_TEID;
+  }
+
+  uint32_t addr_in;
+  // adding UE object to MAC for MRNTI without scheduling configuration (broadcast not part of regular
+  // scheduling)
+  rlc->add_bearer_mrb(SRSRAN_MRNTI, lcid);
+  // The LCID doubles as EPS bearer ID, so that each MTCH has its own bearer
+  bearer_manager.add_eps_bearer(SRSRAN_MRNTI, lcid, srsran::srsran_rat_t::lte, lcid);
+  pdcp->add_bearer(SRSRAN_MRNTI, lcid, srsran::make_drb_pdcp_config_t(1, false));
+  if (not gtpu->add_bearer(SRSRAN_MRNTI, lcid, 1, 1, addr_in, &props).has_value()) {
+    rem_mrb(lcid);
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+void rrc::rem_mrb(uint32_t lcid)
+{
+  gtpu->rem_bearer(SRSRAN_MRNTI, lcid);
+  pdcp->del_bearer(SRSRAN_MRNTI, lcid);
+  rlc->del_bearer(SRSRAN_MRNTI, lcid);
+  bearer_manager.remove_eps_bearer(SRSRAN_MRNTI, lcid);
+}
+
+void rrc::release_stopped_mrbs(uint32_t area_idx, uint32_t version)
+{
+  for (auto it = stopped_mrbs.begin(); it != stopped_mrbs.end();) {
+    // Versions of an area increase by one with each MCCH update
+    if (it->area_idx != area_idx or (int32_t)(version - it->mcch_version) < 0) {
+      ++it;
+      continue;
+    }
+    rem_mrb(it->lcid);
+    logger.info("Released MRB lcid=%d of MBMS session with service ID %x", it->lcid, it->service_id);
+    it = stopped_mrbs.erase(it);
+  }
+}
+
+/*******************************************************************************
+  MBMS session management
+*******************************************************************************/
+
+static bool tmgi_matches(const tmgi_r9_s& tmgi, const srsran::plmn_id_t& plmn, uint32_t service_id)
+{
+  if (tmgi.service_id_r9.to_number() != service_id or
+      tmgi.plmn_id_r9.type().value != tmgi_r9_s::plmn_id_r9_c_::types::explicit_value_r9) {
+    return false;
+  }
+  return srsran::make_plmn_id_t(tmgi.plmn_id_r9.explicit_value_r9()) == plmn;
+}
+
+int rrc::mbms_session_start(uint32_t           area_idx,
+                            uint32_t           pmch_idx,
+                            const std::string& plmn_str,
+                            uint32_t           service_id,
+                            uint32_t           lcid,
+                            int                session_id)
+{
+  srsran::plmn_id_t plmn;
+  if (not enable_mbms or area_idx >= mcch_list.size()) {
+    srsran::console("MBMS session start failed: MBSFN area %d is not configured\n", area_idx);
+    return SRSRAN_ERROR;
+  }
+  mbsfn_area_cfg_r9_s& area_cfg = mcch_list[area_idx].msg.c1().mbsfn_area_cfg_r9();
+  if (pmch_idx >= area_cfg.pmch_info_list_r9.size()) {
+    srsran::console("MBMS session start failed: MBSFN area %d has no PMCH %d\n", area_idx, pmch_idx);
+    return SRSRAN_ERROR;
+  }
+  if (plmn.from_string(plmn_str) != SRSRAN_SUCCESS or service_id > 0xffffff) {
+    srsran::console("MBMS session start failed: invalid TMGI %s:%x\n", plmn_str.c_str(), service_id);
+    return SRSRAN_ERROR;
+  }
+  // TS 36.321 allows MTCH LCIDs up to 28, but the LCID doubles as EPS bearer ID of the M1-U tunnel
+  if (lcid < 1 or not srsran::is_lte_rb(lcid) or session_id > 255) {
+    srsran::console("MBMS session start failed: invalid LCID %d or session ID %d\n", lcid, session_id);
+    return SRSRAN_ERROR;
+  }
+  for (const pmch_info_r9_s& pmch_item : area_cfg.pmch_info_list_r9) {
+    for (const mbms_session_info_r9_s& session : pmch_item.mbms_session_info_list_r9) {
+      if (tmgi_matches(session.tmgi_r9, plmn, service_id)) {
+        srsran::console("MBMS session start failed: TMGI %s:%x is already active\n", plmn_str.c_str(), service_id);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+  // MTCH logical channels and M1-U TEIDs are shared by all the MBSFN areas of the MRNTI, and are only reusable once
+  // the MRB of a stopped session has been released
+  for (const stopped_mrb_t& mrb : stopped_mrbs) {
+    if (mrb.lcid == lcid or mrb.service_id == service_id) {
+      srsran::console(
+          "MBMS session start failed: LCID %d or service ID %x is still being released\n", lcid, service_id);
+      return SRSRAN_ERROR;
+    }
+  }
+  for (const mcch_msg_s& mcch : mcch_list) {
+    for (const pmch_info_r9_s& pmch_item : mcch.msg.c1().mbsfn_area_cfg_r9().pmch_info_list_r9) {
+      for (const mbms_session_info_r9_s& session : pmch_item.mbms_session_info_list_r9) {
+        if (session.lc_ch_id_r9 == lcid) {
+          srsran::console("MBMS session start failed: LCID %d is already in use\n", lcid);
+          return SRSRAN_ERROR;
+        }
+        if (session.tmgi_r9.service_id_r9.to_number() == service_id) {
+          srsran::console("MBMS session start failed: service ID %x is already in use\n", service_id);
+          return SRSRAN_ERROR;
+        }
+      }
     }
   }
+  pmch_info_r9_s& pmch_item = area_cfg.pmch_info_list_r9[pmch_idx];
+  if (pmch_item.mbms_session_info_list_r9.size() >= sched_interface::MAX_MTCH_SCHED) {
+    srsran::console("MBMS session start failed: PMCH %d of MBSFN area %d is full\n", pmch_idx, area_idx);
+    return SRSRAN_ERROR;
+  }
+
+  mbms_session_info_r9_s session = {};
+  session.lc_ch_id_r9            = lcid;
+  session.session_id_r9_present  = session_id >= 0;
+  if (session.session_id_r9_present) {
+    session.session_id_r9[0] = session_id;
+  }
+  session.tmgi_r9.plmn_id_r9.set_explicit_value_r9();
+  srsran::to_asn1(&session.tmgi_r9.plmn_id_r9.explicit_value_r9(), plmn);
+  session.tmgi_r9.service_id_r9.from_number(service_id);
+  pmch_item.mbms_session_info_list_r9.push_back(session);
+
+  // The MRB is ready before the session is announced, so that the first MCH scheduling period has data to send
+  if (add_mrb(area_idx, pmch_idx, session) != SRSRAN_SUCCESS) {
+    pmch_item.mbms_session_info_list_r9.resize(pmch_item.mbms_session_info_list_r9.size() - 1);
+    srsran::console("MBMS session start failed: could not add the MRB of LCID %d\n", lcid);
+    return SRSRAN_ERROR;
+  }
+  update_mcch(area_idx);
+  logger.info("Started MBMS session TMGI=%s:%x, lcid=%d in MBSFN area %d, PMCH %d",
+              plmn_str.c_str(),
+              service_id,
+              lcid,
+              area_idx,
+              pmch_idx);
   return SRSRAN_SUCCESS;
 }
 
+int rrc::mbms_session_stop(const std::string& plmn_str, uint32_t service_id)
+{
+  srsran::plmn_id_t plmn;
+  if (not enable_mbms or plmn.from_string(plmn_str) != SRSRAN_SUCCESS) {
+    srsran::console("MBMS session stop failed: invalid TMGI %s:%x\n", plmn_str.c_str(), service_id);
+    return SRSRAN_ERROR;
+  }
+
+  bool found = false;
+  for (uint32_t a = 0; a < mcch_list.size(); a++) {
+    std::vector<uint32_t> lcids;
+    for (pmch_info_r9_s& pmch_item : mcch_list[a].msg.c1().mbsfn_area_cfg_r9().pmch_info_list_r9) {
+      auto& session_list = pmch_item.mbms_session_info_list_r9;
+      for (uint32_t i = 0; i < session_list.size();) {
+        if (not tmgi_matches(session_list[i].tmgi_r9, plmn, service_id)) {
+          i++;
+          continue;
+        }
+        lcids.push_back(session_list[i].lc_ch_id_r9);
+        logger.info("Stopped MBMS session TMGI=%s:%x, lcid=%d in MBSFN area %d",
+                    plmn_str.c_str(),
+                    service_id,
+                    session_list[i].lc_ch_id_r9,
+                    a);
+        for (uint32_t j = i + 1; j < session_list.size(); j++) {
+          session_list[j - 1] = session_list[j];
+        }
+        session_list.resize(session_list.size() - 1);
+      }
+    }
+    if (lcids.empty()) {
+      continue;
+    }
+    // The MRBs keep transmitting until the MCCH without the session takes effect at the next modification period
+    update_mcch(a);
+    for (uint32_t lcid : lcids) {
+      stopped_mrbs.push_back({a, mcch_version[a], lcid, service_id});
+    }
+    found = true;
+  }
+  if (not found) {
+    srsran::console("MBMS session stop failed: TMGI %s:%x is not active\n", plmn_str.c_str(), service_id);
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+void rrc::update_mcch(uint32_t area_idx)
+{
+  pack_mcch(area_idx);
+  mcch_version[area_idx]++;
+  mac->update_mcch(
+      area_idx, srsran::make_mcch_msg(mcch_list[area_idx]), mcch_payload_list[area_idx], mcch_version[area_idx]);
+}
+
 /* Function called by MAC after the reception of a C-RNTI CE indicating that the UE still has a
  * valid RNTI.
  */
@@ -884,120 +1116,74 @@ void rrc::configure_mbsfn_sibs()
   sibs2.mbsfn_sf_cfg_list_present = cfg.sibs[1].sib2().mbsfn_sf_cfg_list_present;
   sibs2.nof_mbsfn_sf_cfg          = cfg.sibs[1].sib2().mbsfn_sf_cfg_list.size();
   for (int i = 0; i < sibs2.nof_mbsfn_sf_cfg; i++) {
-    sibs2.mbsfn_sf_cfg_list[i].nof_alloc_subfrs = srsran::mbsfn_sf_cfg_t::sf_alloc_type_t::one_frame;
-    sibs2.mbsfn_sf_cfg_list[i].radioframe_alloc_offset =
-        cfg.sibs[1].sib2().mbsfn_sf_cfg_list[i].radioframe_alloc_offset;
-    sibs2.mbsfn_sf_cfg_list[i].radioframe_alloc_period =
-        (srsran::mbsfn_sf_cfg_t::alloc_period_t)cfg.sibs[1].sib2().mbsfn_sf_cfg_list[i].radioframe_alloc_period.value;
-    sibs2.mbsfn_sf_cfg_list[i].sf_alloc =
-        (uint32_t)cfg.sibs[1].sib2().mbsfn_sf_cfg_list[i].sf_alloc.one_frame().to_number();
+    sibs2.mbsfn_sf_cfg_list[i] = srsran::make_mbsfn_sf_cfg(cfg.sibs[1].sib2().mbsfn_sf_cfg_list[i]);
   }
   // populate struct with sib13 values needed for PHY/MAC
-  srsran::sib13_t sibs13;
-  sibs13.notif_cfg.notif_offset = cfg.sibs[12].sib13_v920().notif_cfg_r9.notif_offset_r9;
-  sibs13.notif_cfg.notif_repeat_coeff =
-      (srsran::mbms_notif_cfg_t::coeff_t)cfg.sibs[12].sib13_v920().notif_cfg_r9.notif_repeat_coeff_r9.value;
-  sibs13.notif_cfg.notif_sf_idx = cfg.sibs[12].sib13_v920().notif_cfg_r9.notif_sf_idx_r9;
-  sibs13.nof_mbsfn_area_info    = cfg.sibs[12].sib13_v920().mbsfn_area_info_list_r9.size();
+  srsran::sib13_t sibs13 = srsran::make_sib13(cfg.sibs[12].sib13_v920());
+
+  // pack the MCCH of each MBSFN area for transmission and pass relevant MCCH values to PHY/MAC
+  mcch_list.resize(sibs13.nof_mbsfn_area_info);
+  mcch_payload_list.resize(sibs13.nof_mbsfn_area_info);
+  mcch_version.resize(sibs13.nof_mbsfn_area_info);
+  std::vector<srsran::mcch_msg_t> mcch_t_list(sibs13.nof_mbsfn_area_info);
   for (uint32_t i = 0; i < sibs13.nof_mbsfn_area_info; i++) {
-    sibs13.mbsfn_area_info_list[i].mbsfn_area_id =
-        cfg.sibs[12].sib13_v920().mbsfn_area_info_list_r9[i].mbsfn_area_id_r9;
-    sibs13.mbsfn_area_info_list[i].notif_ind        = cfg.sibs[12].sib13_v920().mbsfn_area_info_list_r9[i].notif_ind_r9;
-    sibs13.mbsfn_area_info_list[i].mcch_cfg.sig_mcs = (srsran::mbsfn_area_info_t::mcch_cfg_t::sig_mcs_t)cfg.sibs[12]
-                                                          .sib13_v920()
-                                                          .mbsfn_area_info_list_r9[i]
-                                                          .mcch_cfg_r9.sig_mcs_r9.value;
-    sibs13.mbsfn_area_info_list[i].mcch_cfg.sf_alloc_info =
-        cfg.sibs[12].sib13_v920().mbsfn_area_info_list_r9[i].mcch_cfg_r9.sf_alloc_info_r9.to_number();
-    sibs13.mbsfn_area_info_list[i].mcch_cfg.mcch_repeat_period =
-        (srsran::mbsfn_area_info_t::mcch_cfg_t::repeat_period_t)cfg.sibs[12]
-            .sib13_v920()
-            .mbsfn_area_info_list_r9[i]
-            .mcch_cfg_r9.mcch_repeat_period_r9.value;
-    sibs13.mbsfn_area_info_list[i].mcch_cfg.mcch_offset =
-        cfg.sibs[12].sib13_v920().mbsfn_area_info_list_r9[i].mcch_cfg_r9.mcch_offset_r9;
-    sibs13.mbsfn_area_info_list[i].mcch_cfg.mcch_mod_period =
-        (srsran::mbsfn_area_info_t::mcch_cfg_t::mod_period_t)cfg.sibs[12]
-            .sib13_v920()
-            .mbsfn_area_info_list_r9[i]
-            .mcch_cfg_r9.mcch_mod_period_r9.value;
-    sibs13.mbsfn_area_info_list[i].non_mbsfn_region_len = (srsran::mbsfn_area_info_t::region_len_t)cfg.sibs[12]
-                                                              .sib13_v920()
-                                                              .mbsfn_area_info_list_r9[i]
-                                                              .non_mbsfn_region_len.value;
-    sibs13.mbsfn_area_info_list[i].notif_ind = cfg.sibs[12].sib13_v920().mbsfn_area_info_list_r9[i].notif_ind_r9;
-  }
-
-  // pack MCCH for transmission and pass relevant MCCH values to PHY/MAC
-  pack_mcch();
-  srsran::mcch_msg_t mcch_t;
-  mcch_t.common_sf_alloc_period         = srsran::mcch_msg_t::common_sf_alloc_period_t::rf32;
-  mcch_t.nof_common_sf_alloc            = 1;
-  srsran::mbsfn_sf_cfg_t sf_alloc_item  = mcch_t.common_sf_alloc[0];
-  sf_alloc_item.radioframe_alloc_offset = 0;
-  sf_alloc_item.radioframe_alloc_period = srsran::mbsfn_sf_cfg_t::alloc_period_t::n1;
-  sf_alloc_item.sf_alloc                = 63;
-  mcch_t.nof_pmch_info                  = 1;
-  srsran::pmch_info_t* pmch_item        = &mcch_t.pmch_info_list[0];
-
-  pmch_item->nof_mbms_session_info              = 1;
-  pmch_item->mbms_session_info_list[0].lc_ch_id = 1;
-  if (pmch_item->nof_mbms_session_info > 1) {
-    pmch_item->mbms_session_info_list[1].lc_ch_id = 2;
+    init_mcch(i);
+    pack_mcch(i);
+    mcch_t_list[i] = srsran::make_mcch_msg(mcch_list[i]);
   }
-  uint16_t mbms_mcs = cfg.mbms_mcs;
-  if (mbms_mcs > 28) {
-    mbms_mcs = 28; // TS 36.213, Table 8.6.1-1
-    logger.warning("PMCH data MCS too high, setting it to 28");
+  mbsfn_map.configure(sibs2, sibs13, mcch_t_list);
+
+  // MTCH logical channels and M1-U TEIDs are shared by all the MBSFN areas of the MRNTI
+  std::set<uint32_t> lcids, service_ids;
+  for (const mcch_msg_s& mcch : mcch_list) {
+    for (const pmch_info_r9_s& pmch_item : mcch.msg.c1().mbsfn_area_cfg_r9().pmch_info_list_r9) {
+      for (const mbms_session_info_r9_s& session : pmch_item.mbms_session_info_list_r9) {
+        if (not lcids.insert(session.lc_ch_id_r9).second) {
+          logger.error("MTCH LCID %d is used by more than one MBMS session", session.lc_ch_id_r9);
+        }
+        if (not service_ids.insert(session.tmgi_r9.service_id_r9.to_number()).second) {
+          logger.error("TMGI service ID %x is used by more than one MBMS session, its M1-U TEID is ambiguous",
+                       session.tmgi_r9.service_id_r9.to_number());
+        }
+      }
+    }
   }
-  logger.debug("PMCH data MCS=%d", mbms_mcs);
-  pmch_item->data_mcs         = mbms_mcs;
-  pmch_item->mch_sched_period = srsran::pmch_info_t::mch_sched_period_t::rf32;
-  pmch_item->sf_alloc_end     = (32 * 6) - 1;
 
   // Configure PHY when PHY is done being initialized
-  task_sched.defer_task([this, sibs2, sibs13, mcch_t]() mutable {
-    phy->configure_mbsfn(&sibs2, &sibs13, mcch_t);
-    mac->write_mcch(&sibs2, &sibs13, &mcch_t, mcch_payload_buffer, current_mcch_length);
+  std::vector<std::vector<uint8_t> > mcch_payloads = mcch_payload_list;
+  task_sched.defer_task([this, sibs2, sibs13, mcch_t_list, mcch_payloads]() mutable {
+    phy->configure_mbsfn(&sibs2, &sibs13, mcch_t_list);
+    mac->write_mcch(&sibs2, &sibs13, mcch_t_list, mcch_payloads);
   });
 }
 
-int rrc::pack_mcch()
+void rrc::generate_default_mcch(uint32_t area_idx, mbsfn_area_cfg_r9_s& area_cfg)
 {
-  mcch.msg.set_c1();
-  mbsfn_area_cfg_r9_s& area_cfg_r9      = mcch.msg.c1().mbsfn_area_cfg_r9();
-  area_cfg_r9.common_sf_alloc_period_r9 = mbsfn_area_cfg_r9_s::common_sf_alloc_period_r9_e_::rf32;
-  area_cfg_r9.common_sf_alloc_r9.resize(1);
-  mbsfn_sf_cfg_s* sf_alloc_item          = &area_cfg_r9.common_sf_alloc_r9[0];
-  sf_alloc_item->radioframe_alloc_offset = 0;
-  sf_alloc_item->radioframe_alloc_period = mbsfn_sf_cfg_s::radioframe_alloc_period_e_::n1;
-  sf_alloc_item->sf_alloc.set_one_frame().from_number(32 + 31);
-
-  area_cfg_r9.pmch_info_list_r9.resize(1);
-  pmch_info_r9_s* pmch_item = &area_cfg_r9.pmch_info_list_r9[0];
+  // A single PMCH carrying a single session over all the SIB2 MBSFN subframes of the common subframe allocation period
+  area_cfg                           = {};
+  area_cfg.common_sf_alloc_period_r9 = mbsfn_area_cfg_r9_s::common_sf_alloc_period_r9_e_::rf32;
+
+  uint32_t nof_sf = 0;
+  for (const mbsfn_sf_cfg_s& sf_cfg : cfg.sibs[1].sib2().mbsfn_sf_cfg_list) {
+    uint32_t sf_alloc = (sf_cfg.sf_alloc.type() == mbsfn_sf_cfg_s::sf_alloc_c_::types::one_frame)
+                            ? sf_cfg.sf_alloc.one_frame().to_number()
+                            : sf_cfg.sf_alloc.four_frames().to_number();
+    nof_sf += std::bitset<32>(sf_alloc).count() * (32 / sf_cfg.radioframe_alloc_period.to_number());
+  }
+
+  area_cfg.pmch_info_list_r9.resize(1);
+  pmch_info_r9_s* pmch_item = &area_cfg.pmch_info_list_r9[0];
   pmch_item->mbms_session_info_list_r9.resize(1);
 
-  pmch_item->mbms_session_info_list_r9[0].lc_ch_id_r9           = 1;
+  // Areas are told apart by their LCID and service ID
+  pmch_item->mbms_session_info_list_r9[0].lc_ch_id_r9           = 1 + area_idx;
   pmch_item->mbms_session_info_list_r9[0].session_id_r9_present = true;
   pmch_item->mbms_session_info_list_r9[0].session_id_r9[0]      = 0;
   pmch_item->mbms_session_info_list_r9[0].tmgi_r9.plmn_id_r9.set_explicit_value_r9();
   srsran::plmn_id_t plmn_obj;
   plmn_obj.from_string("90156");
   srsran::to_asn1(&pmch_item->mbms_session_info_list_r9[0].tmgi_r9.plmn_id_r9.explicit_value_r9(), plmn_obj);
-  uint8_t byte[] = {0x0, 0x0, 0x10};
-  memcpy(&pmch_item->mbms_session_info_list_r9[0].tmgi_r9.service_id_r9[0], &byte[0], 3);
-
-  if (pmch_item->mbms_session_info_list_r9.size() > 1) {
-    pmch_item->mbms_session_info_list_r9[1].lc_ch_id_r9           = 2;
-    pmch_item->mbms_session_info_list_r9[1].session_id_r9_present = true;
-    pmch_item->mbms_session_info_list_r9[1].session_id_r9[0]      = 1;
-    pmch_item->mbms_session_info_list_r9[1].tmgi_r9.plmn_id_r9.set_explicit_value_r9() =
-        pmch_item->mbms_session_info_list_r9[0].tmgi_r9.plmn_id_r9.explicit_value_r9();
-    byte[2] = 1;
-    memcpy(&pmch_item->mbms_session_info_list_r9[1].tmgi_r9.service_id_r9[0],
-           &byte[0],
-           3); // TODO: Check if service is set to 1
-  }
+  pmch_item->mbms_session_info_list_r9[0].tmgi_r9.service_id_r9.from_number(0x000010 + area_idx);
 
   uint16_t mbms_mcs = cfg.mbms_mcs;
   if (mbms_mcs > 28) {
@@ -1008,17 +1194,46 @@ int rrc::pack_mcch()
   logger.debug("PMCH data MCS=%d", mbms_mcs);
   pmch_item->pmch_cfg_r9.data_mcs_r9         = mbms_mcs;
   pmch_item->pmch_cfg_r9.mch_sched_period_r9 = pmch_cfg_r9_s::mch_sched_period_r9_e_::rf32;
-  pmch_item->pmch_cfg_r9.sf_alloc_end_r9     = (32 * 6) - 1;
+  pmch_item->pmch_cfg_r9.sf_alloc_end_r9     = std::max(nof_sf, 1u) - 1;
+}
+
+void rrc::init_mcch(uint32_t area_idx)
+{
+  mcch_msg_s& mcch = mcch_list[area_idx];
+  mcch.msg.set_c1();
+  mbsfn_area_cfg_r9_s& area_cfg_r9 = mcch.msg.c1().mbsfn_area_cfg_r9();
+  if (area_idx < cfg.mbsfn_area_cfg_list.size() and cfg.mbsfn_area_cfg_list[area_idx].pmch_info_list_r9.size() > 0) {
+    area_cfg_r9 = cfg.mbsfn_area_cfg_list[area_idx];
+    for (pmch_info_r9_s& pmch_item : area_cfg_r9.pmch_info_list_r9) {
+      if (pmch_item.pmch_cfg_r9.data_mcs_r9 > 28) {
+        pmch_item.pmch_cfg_r9.data_mcs_r9 = 28; // TS 36.213, Table 8.6.1-1
+        logger.warning("PMCH data MCS of MBSFN area %d too high, setting it to 28", area_idx);
+      }
+    }
+  } else {
+    generate_default_mcch(area_idx, area_cfg_r9);
+  }
+
+  // The common subframe allocation defaults to all the MBSFN subframes of SIB2
+  if (area_cfg_r9.common_sf_alloc_r9.size() == 0) {
+    area_cfg_r9.common_sf_alloc_r9 = cfg.sibs[1].sib2().mbsfn_sf_cfg_list;
+  }
+}
+
+int rrc::pack_mcch(uint32_t area_idx)
+{
+  const mcch_msg_s&     mcch         = mcch_list[area_idx];
+  std::vector<uint8_t>& mcch_payload = mcch_payload_list[area_idx];
+  mcch_payload.assign(mcch_payload_len, 0);
 
   const int     rlc_header_len = 1;
-  asn1::bit_ref bref(&mcch_payload_buffer[rlc_header_len], sizeof(mcch_payload_buffer) - rlc_header_len);
+  asn1::bit_ref bref(&mcch_payload[rlc_header_len], mcch_payload.size() - rlc_header_len);
   if (mcch.pack(bref) != asn1::SRSASN_SUCCESS) {
     logger.error("Failed to pack MCCH message");
   }
 
-  current_mcch_length = bref.distance_bytes(&mcch_payload_buffer[1]);
-  current_mcch_length = current_mcch_length + rlc_header_len;
-  return current_mcch_length;
+  mcch_payload.resize(bref.distance_bytes(&mcch_payload[rlc_header_len]) + rlc_header_len);
+  return mcch_payload.size();
 }
 
 /*******************************************************************************
@@ -1030,6 +1245,11 @@ void rrc::tti_clock()
   // pop cmds from queue
   rrc_pdu p;
   while (rx_pdu_queue.try_pop(p)) {
+    if (p.lcid == LCID_MCCH_APPL) {
+      release_stopped_mrbs(p.rnti, p.arg);
+      continue;
+    }
+
     // check if user exists
     auto user_it = users.find(p.rnti);
     if (user_it == users.end()) {
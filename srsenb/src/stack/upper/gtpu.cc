@@ -29,6 +29,7 @@
 #include "srsran/support/srsran_assert.h"
 
 #include <errno.h>
+#include <inttypes.h>
 #include <linux/ip.h>
 #include <sys/socket.h>
 #include <unistd.h>
@@ -419,7 +420,11 @@ int gtpu::init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_)
 
   // Start MCH socket if enabled
   if (args.embms_enable) {
-    if (not m1u.init(args.embms_m1u_multiaddr, args.embms_m1u_if_addr)) {
+    if (not args.embms_m1u_pcap.empty()) {
+      if (not m1u.init_replay(args.embms_m1u_pcap)) {
+        return SRSRAN_ERROR;
+      }
+    } else if (not m1u.init(args.embms_m1u_multiaddr, args.embms_m1u_if_addr)) {
       return SRSRAN_ERROR;
     }
   }
@@ -516,6 +521,12 @@ srsran::expected<uint32_t> gtpu::add_bearer(uint16_t            rnti,
         return default_error_t();
       }
     }
+
+    // Map the M1-U TEID of the MTCH, and shape its ingress to the capacity of the PMCH
+    if (rnti == SRSRAN_MRNTI) {
+      m1u.add_mtch(
+          eps_bearer_id, props->m1u_teid, props->mtch_pmch_id, props->mtch_rate_bps, props->mtch_burst_bytes);
+    }
   }
 
   // Return bind address for S1AP and NGAP setup
@@ -545,6 +556,9 @@ void gtpu::set_tunnel_status(uint32_t teidin, bool dl_active)
 
 void gtpu::rem_bearer(uint16_t rnti, uint32_t eps_bearer_id)
 {
+  if (rnti == SRSRAN_MRNTI) {
+    m1u.rem_mtch(eps_bearer_id);
+  }
   srsran::span<gtpu_tunnel_manager::bearer_teid_pair> bearer_tuns =
       tunnels.find_rnti_bearer_tunnels(rnti, eps_bearer_id);
   if (bearer_tuns.empty()) {
@@ -593,6 +607,9 @@ void gtpu::rem_user(uint16_t rnti)
     rem_tunnel(tun_lst->front().teid);
   }
   tunnels.remove_rnti(rnti);
+  if (rnti == SRSRAN_MRNTI) {
+    m1u.rem_all_mtch();
+  }
 }
 
 void gtpu::handle_end_marker(const gtpu_tunnel& rx_tunnel)
@@ -964,26 +981,249 @@ bool gtpu::m1u_handler::init(std::string m1u_multiaddr_, std::string m1u_if_addr
   }
   logger.info("M1-U initialized");
 
-  initiated      = true;
-  bearer_counter = 1;
+  initiated = true;
 
   // Assign a handler to rx M1U packets
   auto rx_callback = [this](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
     parent->handle_gtpu_m1u_rx_packet(std::move(pdu), from);
   };
-  parent->rx_socket_handler->add_socket_handler(m1u_sd,
-                                                srsran::make_sdu_handler(logger, parent->gtpu_queue, rx_callback));
+  parent->rx_socket_handler->add_socket_handler(
+      m1u_sd, srsran::make_batch_sdu_handler(logger, parent->gtpu_queue, rx_batch_size, rx_callback));
 
   return true;
 }
 
+bool gtpu::m1u_handler::init_replay(const std::string& pcap_filename)
+{
+  pdcp = parent->pdcp;
+  if (not replay_reader.open(pcap_filename)) {
+    srsran::console("Failed to open M1-U pcap file %s\n", pcap_filename.c_str());
+    return false;
+  }
+  replay       = true;
+  replay_ms    = 0;
+  replay_epoch = mtch_ingress_queue::clock::now();
+
+  replay_timer = parent->task_sched.get_unique_timer();
+  replay_timer.set(1, [this](uint32_t tid) {
+    run_replay();
+    if (replay_reader.is_open()) {
+      replay_timer.run();
+    }
+  });
+  replay_timer.run();
+
+  logger.info("M1-U replaying %s", pcap_filename.c_str());
+  srsran::console("M1-U replaying %s\n", pcap_filename.c_str());
+  return true;
+}
+
+void gtpu::m1u_handler::run_replay()
+{
+  replay_ms++;
+  while (true) {
+    if (replay_pdu == nullptr) {
+      replay_pdu = srsran::make_byte_buffer();
+      if (replay_pdu == nullptr) {
+        logger.warning("Failed to allocate buffer for M1-U replay");
+        return;
+      }
+      if (not replay_reader.read(replay_info, *replay_pdu)) {
+        logger.info("M1-U replay complete after %" PRIu64 " ms, %d packets skipped",
+                    replay_ms,
+                    replay_reader.get_nof_skipped());
+        srsran::console("M1-U replay complete\n");
+        replay_reader.close();
+        replay_pdu.reset();
+        return;
+      }
+    }
+    if (replay_info.time_us > replay_ms * 1000) {
+      return;
+    }
+    if (ntohs(replay_info.dst.sin_port) == GTPU_PORT + 1) {
+      handle_rx_packet(std::move(replay_pdu), replay_info.src);
+    }
+    replay_pdu.reset();
+  }
+}
+
+mtch_ingress_queue::clock::time_point gtpu::m1u_handler::now() const
+{
+  if (replay) {
+    return replay_epoch + std::chrono::milliseconds(replay_ms);
+  }
+  return mtch_ingress_queue::clock::now();
+}
+
 void gtpu::m1u_handler::handle_rx_packet(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr)
 {
   logger.debug("Received %d bytes from M1-U interface", pdu->N_bytes);
 
   gtpu_header_t header;
-  gtpu_read_header(pdu.get(), &header, logger);
-  pdcp->write_sdu(SRSRAN_MRNTI, bearer_counter, std::move(pdu));
+  if (not gtpu_read_header(pdu.get(), &header, logger) or header.message_type != GTPU_MSG_DATA_PDU) {
+    return;
+  }
+
+  int lcid = find_lcid(header.teid);
+  if (lcid < 0) {
+    logger.warning("Discarding M1-U packet with unknown " TEID_IN_FMT, header.teid);
+    return;
+  }
+
+  auto it = mtch_queues.find(lcid);
+  if (it == mtch_queues.end()) {
+    pdcp->write_sdu(SRSRAN_MRNTI, lcid, std::move(pdu));
+    return;
+  }
+  mtch_ingress_queue::clock::time_point t_now = now();
+  it->second.queue->push(std::move(pdu), t_now);
+  release_mtch_queues(t_now);
+}
+
+int gtpu::m1u_handler::find_lcid(uint32_t teid) const
+{
+  // Bounded by the number of MTCH LCIDs, whatever the number of active services
+  uint64_t entry = teid_valid | teid;
+  for (uint32_t lcid = 0; lcid < lcid_teid.size(); ++lcid) {
+    if (lcid_teid[lcid].load(std::memory_order_acquire) == entry) {
+      return lcid;
+    }
+  }
+  return -1;
+}
+
+void gtpu::m1u_handler::add_mtch(uint32_t lcid,
+                                 uint32_t teid,
+                                 uint32_t pmch_id,
+                                 uint32_t rate_bps,
+                                 uint32_t burst_bytes)
+{
+  if (lcid >= lcid_teid.size()) {
+    logger.error("Invalid MTCH lcid=%d", lcid);
+    return;
+  }
+  if (teid == 0) {
+    logger.info("No M1-U traffic is mapped to lcid=%d", lcid);
+    return;
+  }
+  int other_lcid = find_lcid(teid);
+  if (other_lcid >= 0 and (uint32_t)other_lcid != lcid) {
+    logger.error("M1-U " TEID_IN_FMT " is already mapped to lcid=%d", teid, other_lcid);
+    return;
+  }
+  lcid_teid[lcid].store(teid_valid | teid, std::memory_order_release);
+  logger.info("M1-U " TEID_IN_FMT " mapped to lcid=%d", teid, lcid);
+
+  // Shape the ingress of the MTCH if the capacity of its PMCH is known
+  if (rate_bps == 0) {
+    return;
+  }
+  mtch_ingress_queue::args_t queue_args;
+  queue_args.rate_bps     = rate_bps;
+  queue_args.bucket_bytes = burst_bytes;
+  queue_args.max_delay_ms = parent->args.embms_mtch_max_delay_ms;
+  queue_args.max_bytes    = parent->args.embms_mtch_queue_bytes;
+
+  // The MTCHs of a PMCH draw from the same token bucket, created with the first of them
+  std::shared_ptr<mtch_token_bucket> bucket = pmch_buckets[pmch_id].lock();
+  if (bucket == nullptr) {
+    bucket                = std::make_shared<mtch_token_bucket>(rate_bps, burst_bytes, now());
+    pmch_buckets[pmch_id] = bucket;
+  }
+
+  mtch_queue_t& mtch = mtch_queues[lcid];
+  mtch.queue.reset(new mtch_ingress_queue(queue_args, std::move(bucket)));
+  mtch.reported_drops = 0;
+  logger.info("M1-U ingress of lcid=%d shaped to %d kbps shared in pmch=0x%x, burst=%d bytes, max delay=%d ms, "
+              "queue=%d bytes",
+              lcid,
+              rate_bps / 1000,
+              pmch_id,
+              burst_bytes,
+              queue_args.max_delay_ms,
+              queue_args.max_bytes);
+
+  if (not mtch_timer.is_valid()) {
+    mtch_timer = parent->task_sched.get_unique_timer();
+    mtch_timer.set(1, [this](uint32_t tid) {
+      run_mtch_queues();
+      mtch_timer.run();
+    });
+  }
+  if (not mtch_timer.is_running()) {
+    mtch_timer.run();
+  }
+}
+
+void gtpu::m1u_handler::rem_mtch(uint32_t lcid)
+{
+  if (lcid < lcid_teid.size()) {
+    lcid_teid[lcid].store(0, std::memory_order_release);
+  }
+  mtch_queues.erase(lcid);
+  for (auto it = pmch_buckets.begin(); it != pmch_buckets.end();) {
+    it = it->second.expired() ? pmch_buckets.erase(it) : std::next(it);
+  }
+  if (mtch_queues.empty()) {
+    mtch_timer.stop();
+  }
+}
+
+void gtpu::m1u_handler::rem_all_mtch()
+{
+  for (std::atomic<uint64_t>& entry : lcid_teid) {
+    entry.store(0, std::memory_order_release);
+  }
+  mtch_queues.clear();
+  pmch_buckets.clear();
+  mtch_timer.stop();
+}
+
+void gtpu::m1u_handler::release_mtch_queues(mtch_ingress_queue::clock::time_point t_now)
+{
+  // One packet per MTCH and round, so that MTCHs sharing a PMCH get their turn at its tokens
+  bool released = true;
+  while (released) {
+    released = false;
+    for (auto& it : mtch_queues) {
+      srsran::unique_byte_buffer_t sdu = it.second.queue->pop(t_now);
+      if (sdu != nullptr) {
+        pdcp->write_sdu(SRSRAN_MRNTI, it.first, std::move(sdu));
+        released = true;
+      }
+    }
+  }
+}
+
+void gtpu::m1u_handler::run_mtch_queues()
+{
+  mtch_ingress_queue::clock::time_point t_now  = now();
+  bool                                  report = ++mtch_report_counter >= 1000;
+  if (report) {
+    mtch_report_counter = 0;
+  }
+
+  release_mtch_queues(t_now);
+
+  for (auto& it : mtch_queues) {
+    mtch_ingress_queue& queue = *it.second.queue;
+
+    // Drops are reported at most once per second
+    const mtch_ingress_queue::metrics_t& m     = queue.get_metrics();
+    uint64_t                             drops = m.dropped_late_pkts + m.dropped_overflow_pkts;
+    if (report and drops != it.second.reported_drops) {
+      logger.warning("M1-U lcid=%d: %" PRIu64 " packets dropped (late=%" PRIu64 ", overflow=%" PRIu64
+                     "), queued=%d bytes, max delay=%d us",
+                     it.first,
+                     drops - it.second.reported_drops,
+                     m.dropped_late_pkts,
+                     m.dropped_overflow_pkts,
+                     m.queued_bytes,
+                     m.max_delay_us);
+      it.second.reported_drops = drops;
+    }
+  }
 }
 
 } // namespace srsenb
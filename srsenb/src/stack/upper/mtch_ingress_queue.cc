@@ -0,0 +1,126 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/upper/mtch_ingress_queue.h"
+#include <algorithm>
+
+namespace srsenb {
+
+mtch_token_bucket::mtch_token_bucket(uint32_t rate_bps_, uint32_t bucket_bytes_, clock::time_point now) :
+  rate_bps(rate_bps_), bucket_bytes(bucket_bytes_), tokens(bucket_bytes_), last_refill(now)
+{}
+
+bool mtch_token_bucket::consume(uint32_t nof_bytes, clock::time_point now)
+{
+  refill(now);
+  if (tokens <= 0) {
+    return false;
+  }
+  tokens -= nof_bytes;
+  return true;
+}
+
+void mtch_token_bucket::refill(clock::time_point now)
+{
+  int64_t elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(now - last_refill).count();
+  if (elapsed_us <= 0) {
+    return;
+  }
+  last_refill = now;
+  if (tokens >= (int64_t)bucket_bytes) {
+    refill_rem = 0;
+    return;
+  }
+
+  // Bits times microseconds, so that low rates and short intervals do not lose tokens to rounding
+  uint64_t acc = (uint64_t)elapsed_us * rate_bps + refill_rem;
+  refill_rem   = acc % 8000000;
+  tokens       = std::min<int64_t>(tokens + acc / 8000000, bucket_bytes);
+}
+
+mtch_ingress_queue::mtch_ingress_queue(const args_t& args_, clock::time_point now) : args(args_)
+{
+  if (args.rate_bps > 0) {
+    bucket = std::make_shared<mtch_token_bucket>(args.rate_bps, args.bucket_bytes, now);
+  }
+}
+
+mtch_ingress_queue::mtch_ingress_queue(const args_t& args_, std::shared_ptr<mtch_token_bucket> bucket_) :
+  args(args_), bucket(std::move(bucket_))
+{}
+
+void mtch_ingress_queue::push(srsran::unique_byte_buffer_t pdu, clock::time_point now)
+{
+  if (pdu == nullptr) {
+    return;
+  }
+  metrics.rx_pkts++;
+  metrics.rx_bytes += pdu->N_bytes;
+
+  // Make room for the new packet by dropping the oldest ones
+  while (args.max_bytes > 0 and not queue.empty() and metrics.queued_bytes + pdu->N_bytes > args.max_bytes) {
+    drop_front(metrics.dropped_overflow_pkts);
+  }
+
+  pdu->set_timestamp(now);
+  metrics.queued_pkts++;
+  metrics.queued_bytes += pdu->N_bytes;
+  queue.push_back(std::move(pdu));
+}
+
+srsran::unique_byte_buffer_t mtch_ingress_queue::pop(clock::time_point now)
+{
+  // Stale packets are not worth transmitting
+  if (args.max_delay_ms > 0) {
+    while (not queue.empty() and now - queue.front()->get_timestamp() > std::chrono::milliseconds(args.max_delay_ms)) {
+      drop_front(metrics.dropped_late_pkts);
+    }
+  }
+  if (queue.empty()) {
+    return nullptr;
+  }
+
+  if (bucket != nullptr and not bucket->consume(queue.front()->N_bytes, now)) {
+    return nullptr;
+  }
+
+  srsran::unique_byte_buffer_t pdu = std::move(queue.front());
+  queue.pop_front();
+  uint32_t delay_us =
+      std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::microseconds>(now - pdu->get_timestamp()).count());
+  metrics.queued_pkts--;
+  metrics.queued_bytes -= pdu->N_bytes;
+  metrics.tx_pkts++;
+  metrics.tx_bytes += pdu->N_bytes;
+  metrics.max_delay_us = std::max(metrics.max_delay_us, delay_us);
+  return pdu;
+}
+
+void mtch_ingress_queue::drop_front(uint64_t& counter)
+{
+  counter++;
+  metrics.dropped_bytes += queue.front()->N_bytes;
+  metrics.queued_pkts--;
+  metrics.queued_bytes -= queue.front()->N_bytes;
+  queue.pop_front();
+}
+
+} // namespace srsenb
@@ -145,7 +145,12 @@ void rlc::del_bearer(uint16_t rnti, uint32_t lcid)
 {
   pthread_rwlock_rdlock(&rwlock);
   if (users.count(rnti)) {
-    users[rnti].rlc->del_bearer(lcid);
+    if (rnti != SRSRAN_MRNTI) {
+      users[rnti].rlc->del_bearer(lcid);
+    } else {
+      users[rnti].rlc->del_bearer_mrb(lcid);
+      mac->rlc_buffer_state(rnti, lcid, 0, 0);
+    }
   }
   pthread_rwlock_unlock(&rwlock);
 }
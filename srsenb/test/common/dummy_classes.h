@@ -42,11 +42,15 @@ public:
   int  bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, mac_lc_ch_cfg_t* cfg) override { return 0; }
   int  bearer_ue_rem(uint16_t rnti, uint32_t lc_id) override { return 0; }
   void phy_config_enabled(uint16_t rnti, bool enabled) override {}
-  void write_mcch(const srsran::sib2_mbms_t* sib2_,
-                  const srsran::sib13_t*     sib13_,
-                  const srsran::mcch_msg_t*  mcch_,
-                  const uint8_t*             mcch_payload,
-                  const uint8_t              mcch_payload_length) override
+  void write_mcch(const srsran::sib2_mbms_t*                sib2_,
+                  const srsran::sib13_t*                    sib13_,
+                  const std::vector<srsran::mcch_msg_t>&    mcch_list,
+                  const std::vector<std::vector<uint8_t> >& mcch_payload_list) override
+  {}
+  void update_mcch(uint32_t                    area_idx,
+                   const srsran::mcch_msg_t&   mcch,
+                   const std::vector<uint8_t>& mcch_payload,
+                   uint32_t                    version) override
   {}
   uint16_t reserve_new_crnti(const sched_interface::ue_cfg_t& ue_cfg) override { return last_rnti++; }
 
@@ -111,7 +115,10 @@ public:
 class phy_dummy : public phy_interface_rrc_lte
 {
 public:
-  void configure_mbsfn(srsran::sib2_mbms_t* sib2, srsran::sib13_t* sib13, const srsran::mcch_msg_t& mcch) override {}
+  void configure_mbsfn(srsran::sib2_mbms_t*                   sib2,
+                       srsran::sib13_t*                       sib13,
+                       const std::vector<srsran::mcch_msg_t>& mcch_list) override
+  {}
   void set_config(uint16_t rnti, const phy_rrc_cfg_list_t& dedicated_list) override {}
   void complete_config(uint16_t rnti) override{};
 };
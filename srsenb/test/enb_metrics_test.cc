@@ -45,7 +45,16 @@ public:
   enb_dummy()
   {
     // first entry
-    metrics[0].rf.rf_o = 10;
+    metrics[0].rf.rf_o              = 10;
+    metrics[0].rf.tx_trim           = 3;
+    metrics[0].rf.tx_trim_max_us    = 250;
+    metrics[0].phy_tx.nof_sf        = 1000;
+    metrics[0].phy_tx.nof_late      = 3;
+    metrics[0].phy_tx.min_slack_ms  = -0.25;
+    metrics[0].phy_tx.avg_slack_ms  = 2.5;
+    metrics[0].phy_tx.slack_hist[0] = 3;
+    metrics[0].phy_tx.slack_hist[5] = 997;
+    metrics[0].phy_tx.lookahead_ms  = 4;
     metrics[0].stack.rrc.ues.resize(2);
     metrics[0].stack.mac.ues.resize(metrics[0].stack.rrc.ues.size());
     metrics[0].stack.mac.ues[0].rnti      = 0x46;
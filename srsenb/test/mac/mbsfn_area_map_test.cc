@@ -0,0 +1,206 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/common/mbsfn_area_map.h"
+#include "srsran/common/test_common.h"
+
+using namespace srsenb;
+
+static srsran::mbsfn_sf_cfg_t make_one_frame_cfg(uint32_t sf_alloc)
+{
+  srsran::mbsfn_sf_cfg_t cfg  = {};
+  cfg.nof_alloc_subfrs        = srsran::mbsfn_sf_cfg_t::sf_alloc_type_t::one_frame;
+  cfg.radioframe_alloc_period = srsran::mbsfn_sf_cfg_t::alloc_period_t::n1;
+  cfg.radioframe_alloc_offset = 0;
+  cfg.sf_alloc                = sf_alloc;
+  return cfg;
+}
+
+static srsran::mbsfn_area_info_t make_area_info(uint32_t area_id, uint32_t mcch_sf_alloc)
+{
+  srsran::mbsfn_area_info_t area_info   = {};
+  area_info.mbsfn_area_id               = area_id;
+  area_info.non_mbsfn_region_len        = srsran::mbsfn_area_info_t::region_len_t::s1;
+  area_info.mcch_cfg.mcch_repeat_period = srsran::mbsfn_area_info_t::mcch_cfg_t::repeat_period_t::rf32;
+  area_info.mcch_cfg.mcch_offset        = 0;
+  area_info.mcch_cfg.sf_alloc_info      = mcch_sf_alloc;
+  area_info.mcch_cfg.sig_mcs            = srsran::mbsfn_area_info_t::mcch_cfg_t::sig_mcs_t::n2;
+  return area_info;
+}
+
+static void add_pmch(srsran::mcch_msg_t& mcch, uint32_t sf_alloc_end)
+{
+  srsran::pmch_info_t& pmch  = mcch.pmch_info_list[mcch.nof_pmch_info++];
+  pmch.sf_alloc_end          = sf_alloc_end;
+  pmch.data_mcs              = 10;
+  pmch.mch_sched_period      = srsran::pmch_info_t::mch_sched_period_t::rf32;
+  pmch.nof_mbms_session_info = 0;
+}
+
+/// Single area with two PMCHs sharing all the MBSFN subframes of the cell
+int test_single_area_two_pmch()
+{
+  srsran::sib2_mbms_t sib2       = {};
+  sib2.mbsfn_sf_cfg_list_present = true;
+  sib2.nof_mbsfn_sf_cfg          = 1;
+  sib2.mbsfn_sf_cfg_list[0]      = make_one_frame_cfg(63);
+
+  srsran::sib13_t sib13         = {};
+  sib13.nof_mbsfn_area_info     = 1;
+  sib13.mbsfn_area_info_list[0] = make_area_info(1, 32);
+
+  std::vector<srsran::mcch_msg_t> mcch_list(1);
+  mcch_list[0].common_sf_alloc_period = srsran::mcch_msg_t::common_sf_alloc_period_t::rf32;
+  mcch_list[0].nof_common_sf_alloc    = 1;
+  mcch_list[0].common_sf_alloc[0]     = make_one_frame_cfg(63);
+  add_pmch(mcch_list[0], 95);
+  add_pmch(mcch_list[0], 191);
+
+  mbsfn_area_map   map;
+  mbsfn_sf_alloc_t sf_alloc;
+  map.configure(sib2, sib13, mcch_list);
+  TESTASSERT(map.is_configured());
+  TESTASSERT(map.nof_areas() == 1);
+  TESTASSERT(map.get_nof_sf_per_msp(0, 0) == 96);
+  TESTASSERT(map.get_nof_sf_per_msp(0, 1) == 96);
+
+  // Subframes 0, 4, 5 and 9 are never MBSFN
+  TESTASSERT(not map.is_mbsfn_sf(0));
+  TESTASSERT(not map.is_mbsfn_sf(5));
+  TESTASSERT(not map.get_sf_alloc(9, sf_alloc));
+
+  // First MBSFN subframe carries the MCCH and starts the MCH scheduling period of the first PMCH
+  TESTASSERT(map.get_sf_alloc(1, sf_alloc));
+  TESTASSERT(sf_alloc.area_idx == 0 and sf_alloc.pmch_idx == 0 and sf_alloc.sf_idx_in_msp == 0);
+  TESTASSERT(sf_alloc.has_pmch and sf_alloc.is_mcch);
+
+  // Last subframe of the first PMCH
+  TESTASSERT(map.get_sf_alloc(15 * 10 + 8, sf_alloc));
+  TESTASSERT(sf_alloc.pmch_idx == 0 and sf_alloc.sf_idx_in_msp == 95 and not sf_alloc.is_mcch);
+
+  // Second PMCH starts after the first one
+  TESTASSERT(map.get_sf_alloc(16 * 10 + 1, sf_alloc));
+  TESTASSERT(sf_alloc.pmch_idx == 1 and sf_alloc.sf_idx_in_msp == 0 and not sf_alloc.is_mcch);
+
+  // Allocation repeats every common subframe allocation period
+  TESTASSERT(map.get_sf_alloc(32 * 10 + 2, sf_alloc));
+  TESTASSERT(sf_alloc.pmch_idx == 0 and sf_alloc.sf_idx_in_msp == 1);
+  TESTASSERT(map.get_sf_alloc(10239, sf_alloc) == false);
+  TESTASSERT(map.get_sf_alloc(10238, sf_alloc));
+  TESTASSERT(sf_alloc.pmch_idx == 1 and sf_alloc.sf_idx_in_msp == 95);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Two areas splitting the MBSFN subframes of each frame
+int test_two_areas()
+{
+  srsran::sib2_mbms_t sib2       = {};
+  sib2.mbsfn_sf_cfg_list_present = true;
+  sib2.nof_mbsfn_sf_cfg          = 1;
+  sib2.mbsfn_sf_cfg_list[0]      = make_one_frame_cfg(63);
+
+  srsran::sib13_t sib13         = {};
+  sib13.nof_mbsfn_area_info     = 2;
+  sib13.mbsfn_area_info_list[0] = make_area_info(1, 32); // MCCH in subframe 1
+  sib13.mbsfn_area_info_list[1] = make_area_info(2, 4);  // MCCH in subframe 6
+
+  std::vector<srsran::mcch_msg_t> mcch_list(2);
+  for (uint32_t i = 0; i < 2; ++i) {
+    mcch_list[i].common_sf_alloc_period = srsran::mcch_msg_t::common_sf_alloc_period_t::rf32;
+    mcch_list[i].nof_common_sf_alloc    = 1;
+    add_pmch(mcch_list[i], 95);
+  }
+  mcch_list[0].common_sf_alloc[0] = make_one_frame_cfg(32 + 16 + 8); // subframes 1, 2 and 3
+  mcch_list[1].common_sf_alloc[0] = make_one_frame_cfg(4 + 2 + 1);   // subframes 6, 7 and 8
+
+  mbsfn_area_map   map;
+  mbsfn_sf_alloc_t sf_alloc;
+  map.configure(sib2, sib13, mcch_list);
+  TESTASSERT(map.nof_areas() == 2);
+  TESTASSERT(map.get_nof_sf_per_msp(0, 0) == 96);
+  TESTASSERT(map.get_nof_sf_per_msp(1, 0) == 96);
+
+  TESTASSERT(map.get_sf_alloc(3, sf_alloc));
+  TESTASSERT(sf_alloc.area_idx == 0 and sf_alloc.sf_idx_in_msp == 2 and not sf_alloc.is_mcch);
+
+  TESTASSERT(map.get_sf_alloc(6, sf_alloc));
+  TESTASSERT(sf_alloc.area_idx == 1 and sf_alloc.sf_idx_in_msp == 0 and sf_alloc.is_mcch);
+
+  TESTASSERT(map.get_sf_alloc(10 + 7, sf_alloc));
+  TESTASSERT(sf_alloc.area_idx == 1 and sf_alloc.sf_idx_in_msp == 4 and not sf_alloc.is_mcch);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// MCCH change notification occasions follow the shortest modification period of the areas
+int test_mcch_notif_occasions()
+{
+  srsran::sib2_mbms_t sib2       = {};
+  sib2.mbsfn_sf_cfg_list_present = true;
+  sib2.nof_mbsfn_sf_cfg          = 1;
+  sib2.mbsfn_sf_cfg_list[0]      = make_one_frame_cfg(63);
+
+  using mod_period_t = srsran::mbsfn_area_info_t::mcch_cfg_t::mod_period_t;
+  srsran::sib13_t sib13                                  = {};
+  sib13.nof_mbsfn_area_info                              = 2;
+  sib13.mbsfn_area_info_list[0]                          = make_area_info(1, 32);
+  sib13.mbsfn_area_info_list[0].notif_ind                = 3;
+  sib13.mbsfn_area_info_list[0].mcch_cfg.mcch_mod_period = mod_period_t::rf1024;
+  sib13.mbsfn_area_info_list[1]                          = make_area_info(2, 4);
+  sib13.mbsfn_area_info_list[1].notif_ind                = 5;
+  sib13.mbsfn_area_info_list[1].mcch_cfg.mcch_mod_period = mod_period_t::rf512;
+  sib13.notif_cfg.notif_repeat_coeff                     = srsran::mbms_notif_cfg_t::coeff_t::n4;
+  sib13.notif_cfg.notif_offset                           = 2;
+  sib13.notif_cfg.notif_sf_idx                           = 4; // subframe 6
+
+  std::vector<srsran::mcch_msg_t> mcch_list(2);
+  for (uint32_t i = 0; i < 2; ++i) {
+    mcch_list[i].common_sf_alloc_period = srsran::mcch_msg_t::common_sf_alloc_period_t::rf32;
+    mcch_list[i].nof_common_sf_alloc    = 1;
+    mcch_list[i].common_sf_alloc[0]     = make_one_frame_cfg(63);
+    add_pmch(mcch_list[i], 95);
+  }
+
+  mbsfn_area_map map;
+  map.configure(sib2, sib13, mcch_list);
+  TESTASSERT(map.get_notif_ind(0) == 3 and map.get_notif_ind(1) == 5);
+
+  // Repeated every 512 / 4 frames, in subframe 6 of the frames with SFN mod 128 = 2
+  TESTASSERT(map.is_mcch_notif_sf(2 * 10 + 6));
+  TESTASSERT(map.is_mcch_notif_sf(130 * 10 + 6));
+  TESTASSERT(map.is_mcch_notif_sf(898 * 10 + 6));
+  TESTASSERT(not map.is_mcch_notif_sf(2 * 10 + 1));
+  TESTASSERT(not map.is_mcch_notif_sf(3 * 10 + 6));
+  TESTASSERT(not map.is_mcch_notif_sf(66 * 10 + 6));
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_single_area_two_pmch() == SRSRAN_SUCCESS);
+  TESTASSERT(test_two_areas() == SRSRAN_SUCCESS);
+  TESTASSERT(test_mcch_notif_occasions() == SRSRAN_SUCCESS);
+
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
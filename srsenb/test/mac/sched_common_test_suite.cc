@@ -252,6 +252,9 @@ int test_pdcch_collisions(const sf_output_res_t&                   sf_out,
   for (uint32_t i = 0; i < dl_result.rar.size(); ++i) {
     try_cce_fill(dl_result.rar[i].dci.location, "DL RAR");
   }
+  for (uint32_t i = 0; i < dl_result.mcch_notif.size(); ++i) {
+    try_cce_fill(dl_result.mcch_notif[i].dci.location, "DL MCCH notification");
+  }
 
   CONDERROR(expected_cce_mask != nullptr and *expected_cce_mask != used_cce,
             "The derived PDCCH mask %s does not match the expected one %s",
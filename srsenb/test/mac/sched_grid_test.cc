@@ -190,6 +190,34 @@ int test_pdcch_ue_and_sibs()
   return SRSRAN_SUCCESS;
 }
 
+int test_pdcch_mcch_notif()
+{
+  std::vector<sched_cell_params_t> cell_params(1);
+  sched_interface::cell_cfg_t      cell_cfg = generate_default_cell_cfg(25);
+  sched_interface::sched_args_t    sched_args{};
+  TESTASSERT(cell_params[0].set_cfg(0, cell_cfg, sched_args));
+
+  sf_cch_allocator pdcch;
+  pdcch.init(cell_params[PCell_IDX]);
+  pdcch.new_tti(tti_point{0});
+
+  // TEST: The MCCH change notification shares the common search space with the SIBs without overlapping them
+  TESTASSERT(pdcch.alloc_dci(alloc_type_t::DL_BC, 2));
+  TESTASSERT(pdcch.alloc_dci(alloc_type_t::DL_MCCH_NOTIF, 2));
+  TESTASSERT(pdcch.nof_allocs() == 2);
+
+  uint32_t                         cfi = pdcch.get_cfi();
+  sf_cch_allocator::alloc_result_t dci_result;
+  pdcch_mask_t                     result_pdcch_mask;
+  pdcch.get_allocs(&dci_result, &result_pdcch_mask);
+  TESTASSERT(dci_result.size() == 2);
+  const cce_position_list& common_locs = cell_params[0].common_locations[cfi - 1][2];
+  TESTASSERT(std::count(common_locs.begin(), common_locs.end(), dci_result[1]->dci_pos.ncce) > 0);
+  TESTASSERT((dci_result[0]->current_mask & dci_result[1]->current_mask).none());
+
+  return SRSRAN_SUCCESS;
+}
+
 int test_6prbs()
 {
   std::vector<sched_cell_params_t> cell_params(1);
@@ -264,6 +292,7 @@ int main()
 
   TESTASSERT(test_pdcch_one_ue() == SRSRAN_SUCCESS);
   TESTASSERT(test_pdcch_ue_and_sibs() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pdcch_mcch_notif() == SRSRAN_SUCCESS);
   TESTASSERT(test_6prbs() == SRSRAN_SUCCESS);
 
   srslog::flush();
@@ -49,6 +49,7 @@ public:
   bool     is_paging_opportunity(uint32_t tti, uint32_t* payload_len) { return false; }
   uint8_t* read_pdu_bcch_dlsch(const uint8_t enb_cc_idx, const uint32_t sib_index) { return nullptr; }
   void     read_pdu_pcch(uint32_t tti_tx_dl, uint8_t* payload, uint32_t n_bytes) {}
+  void     mcch_applied(uint32_t area_idx, uint32_t version) {}
 };
 
 /**************************
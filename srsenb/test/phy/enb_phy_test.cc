@@ -249,6 +249,7 @@ public:
     // Return True if err >= SRSRAN_SUCCESS
     return err >= SRSRAN_SUCCESS;
   }
+  bool              get_time(srsran::rf_timestamp_interface& now) override { return false; }
   void              release_freq(const uint32_t& carrier_idx) override{};
   void              set_tx_freq(const uint32_t& channel_idx, const double& freq) override {}
   void              set_rx_freq(const uint32_t& channel_idx, const double& freq) override {}
@@ -262,6 +263,7 @@ public:
   double            get_freq_offset() override { return 0; }
   bool              is_continuous_tx() override { return false; }
   bool              get_is_start_of_burst() override { return false; }
+  float             get_tx_sc16_scale() override { return 0.0f; }
   bool              is_init() override { return false; }
   void              reset() override {}
   srsran_rf_info_t* get_info() override { return nullptr; }
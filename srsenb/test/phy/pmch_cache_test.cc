@@ -0,0 +1,155 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsenb/hdr/phy/lte/pmch_cache.h"
+#include "srsran/common/test_common.h"
+
+using namespace srsenb::lte;
+
+static pmch_cache::key_t make_key(uint32_t area_id, uint32_t sf_idx)
+{
+  pmch_cache::key_t key = {};
+  key.area_id           = area_id;
+  key.sf_idx            = sf_idx;
+  key.tbs               = 64;
+  key.mcs               = 2;
+  key.nof_re            = 16;
+  return key;
+}
+
+int test_hit_and_miss()
+{
+  pmch_cache cache;
+  TESTASSERT(not cache.is_enabled());
+  TESTASSERT(cache.init(2, 16) == SRSRAN_SUCCESS);
+  TESTASSERT(cache.is_enabled());
+
+  uint8_t           payload[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+  pmch_cache::key_t key        = make_key(1, 1);
+  bool              hit        = true;
+
+  // First transmission is only remembered, the caller encodes it without the cache
+  TESTASSERT(cache.get(key, payload, hit) == nullptr and not hit);
+
+  // Second transmission fills an entry
+  cf_t* symbols = cache.get(key, payload, hit);
+  TESTASSERT(symbols != nullptr and not hit);
+  symbols[0] = 1.0f;
+
+  // Further repetitions of the same TB return the same symbols
+  TESTASSERT(cache.get(key, payload, hit) == symbols and hit);
+  TESTASSERT(symbols[0] == 1.0f);
+
+  // Any parameter the scrambling or rate matching depends on causes a miss
+  TESTASSERT(cache.get(make_key(1, 2), payload, hit) == nullptr and not hit);
+  TESTASSERT(cache.get(make_key(2, 1), payload, hit) == nullptr and not hit);
+  TESTASSERT(cache.get(make_key(2, 1), payload, hit) != symbols and not hit);
+
+  // So does a different payload with the same parameters
+  payload[7] = 0;
+  TESTASSERT(cache.get(key, payload, hit) == nullptr and not hit);
+
+  TESTASSERT(cache.get_nof_hits() == 1);
+  TESTASSERT(cache.get_nof_misses() == 6);
+
+  // TBs that do not fit are not cached
+  key.nof_re = 17;
+  TESTASSERT(cache.get(key, payload, hit) == nullptr and not hit);
+  TESTASSERT(cache.get(key, payload, hit) == nullptr and not hit);
+  return SRSRAN_SUCCESS;
+}
+
+/* Gets an entry for a TB not seen yet */
+static bool admit(pmch_cache& cache, const pmch_cache::key_t& key, const uint8_t* data)
+{
+  bool hit = false;
+  return cache.get(key, data, hit) == nullptr and cache.get(key, data, hit) != nullptr and not hit;
+}
+
+int test_lru_eviction()
+{
+  pmch_cache cache;
+  TESTASSERT(cache.init(2, 16) == SRSRAN_SUCCESS);
+
+  uint8_t a[8] = {1};
+  uint8_t b[8] = {2};
+  uint8_t c[8] = {3};
+  bool    hit  = false;
+
+  pmch_cache::key_t key = make_key(1, 1);
+  TESTASSERT(admit(cache, key, a));
+  TESTASSERT(admit(cache, key, b));
+
+  // Using A makes B the least recently used entry, which C replaces
+  TESTASSERT(cache.get(key, a, hit) != nullptr and hit);
+  TESTASSERT(admit(cache, key, c));
+  TESTASSERT(cache.get(key, a, hit) != nullptr and hit);
+  TESTASSERT(cache.get(key, c, hit) != nullptr and hit);
+  TESTASSERT(admit(cache, key, b));
+
+  // Clearing drops all entries
+  cache.clear();
+  TESTASSERT(admit(cache, key, b));
+  return SRSRAN_SUCCESS;
+}
+
+int test_single_use_tbs()
+{
+  pmch_cache cache;
+  TESTASSERT(cache.init(2, 16) == SRSRAN_SUCCESS);
+
+  uint8_t           mcch[8] = {0xaa};
+  pmch_cache::key_t key     = make_key(1, 1);
+  bool              hit     = false;
+  TESTASSERT(admit(cache, key, mcch));
+
+  // TBs sent once, however many, do not take the entry of a repeated TB
+  for (uint32_t i = 0; i < 100; i++) {
+    uint8_t mtch[8] = {(uint8_t)i, (uint8_t)(i >> 8), 0x55};
+    TESTASSERT(cache.get(key, mtch, hit) == nullptr and not hit);
+  }
+  TESTASSERT(cache.get(key, mcch, hit) != nullptr and hit);
+  return SRSRAN_SUCCESS;
+}
+
+int test_disabled()
+{
+  pmch_cache cache;
+  TESTASSERT(cache.init(0, 16) == SRSRAN_SUCCESS);
+  TESTASSERT(not cache.is_enabled());
+
+  uint8_t payload[8] = {};
+  bool    hit        = true;
+  TESTASSERT(cache.get(make_key(1, 1), payload, hit) == nullptr and not hit);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_hit_and_miss() == SRSRAN_SUCCESS);
+  TESTASSERT(test_lru_eviction() == SRSRAN_SUCCESS);
+  TESTASSERT(test_single_use_tbs() == SRSRAN_SUCCESS);
+  TESTASSERT(test_disabled() == SRSRAN_SUCCESS);
+
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
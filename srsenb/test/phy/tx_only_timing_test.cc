@@ -0,0 +1,112 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsenb/hdr/phy/tx_only_timing.h"
+#include "srsran/common/common.h"
+#include "srsran/common/test_common.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace srsenb;
+
+// GPS time in 2024, the seconds alone do not fit in the mantissa of a double with sub-microsecond resolution
+static const time_t gps_secs = 1400000000;
+
+/* Checks the subframe transmitted at the boundary is numbered after it, and is transmitted at the boundary plus the
+ * site delay, to the nanosecond, no earlier than the lookahead allows */
+static int check_boundary(const srsran_timestamp_t& now, uint32_t lookahead_ms, int32_t delay_ns)
+{
+  tx_only_boundary_t boundary = tx_only_next_boundary(now, lookahead_ms, delay_ns);
+
+  TESTASSERT(TTI_TX(TTI_ADD(boundary.tti, 1)) == boundary.tti_count % 10240);
+
+  // The TTI loop waits 1 ms before the first subframe and transmits it the lookahead after
+  int64_t now_ns      = (int64_t)now.full_secs * 1000000000 + std::llround(now.frac_secs * 1e9);
+  int64_t tx_ns       = now_ns + std::llround((boundary.delta_s + (lookahead_ms + 1) * 1e-3) * 1e9);
+  int64_t expected_ns = (int64_t)boundary.tti_count * 1000000 + delay_ns;
+  TESTASSERT(std::abs(tx_ns - expected_ns) <= 1);
+
+  // First boundary that can still be generated in time
+  double slack_s = boundary.delta_s - std::max(delay_ns * 1e-9, 0.0);
+  TESTASSERT(slack_s > -1e-12 and slack_s < 1e-3 + 1e-12);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_known_boundary()
+{
+  srsran_timestamp_t now = {};
+  srsran_timestamp_init(&now, gps_secs, 0.1234);
+
+  // 5 ms of margin from 123.4 ms, the GPS time in ms is a multiple of 10240
+  tx_only_boundary_t boundary = tx_only_next_boundary(now, 4, 0);
+  TESTASSERT(boundary.tti_count == (uint64_t)gps_secs * 1000 + 129);
+  TESTASSERT(std::abs(boundary.delta_s - 0.6e-3) < 1e-9);
+  TESTASSERT(TTI_TX(TTI_ADD(boundary.tti, 1)) == 129);
+
+  // A later site keeps the boundary and transmits it later
+  boundary = tx_only_next_boundary(now, 4, 1500);
+  TESTASSERT(boundary.tti_count == (uint64_t)gps_secs * 1000 + 129);
+  TESTASSERT(std::abs(boundary.delta_s - 0.6015e-3) < 1e-9);
+
+  // An earlier site needs a later boundary to generate it in time
+  boundary = tx_only_next_boundary(now, 4, -700000);
+  TESTASSERT(boundary.tti_count == (uint64_t)gps_secs * 1000 + 130);
+  TESTASSERT(std::abs(boundary.delta_s - 0.9e-3) < 1e-9);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_gps_epoch()
+{
+  const int32_t  delays_ns[]     = {0, 1500, 250000, -1500, -2500000};
+  const uint32_t lookaheads_ms[] = {4, 8};
+
+  // Every millisecond and a fraction of 20 s, going through SFN wraps and second boundaries
+  for (int32_t delay_ns : delays_ns) {
+    for (uint32_t lookahead_ms : lookaheads_ms) {
+      for (uint32_t ms = 0; ms < 20480; ms++) {
+        srsran_timestamp_t now = {};
+        srsran_timestamp_init(&now, gps_secs + ms / 1000, (ms % 1000) * 1e-3 + 0.4567891e-3);
+        TESTASSERT(check_boundary(now, lookahead_ms, delay_ns) == SRSRAN_SUCCESS);
+      }
+    }
+  }
+
+  // Right on and right before a boundary
+  srsran_timestamp_t now = {};
+  srsran_timestamp_init(&now, gps_secs, 0.995);
+  TESTASSERT(check_boundary(now, 4, 0) == SRSRAN_SUCCESS);
+  srsran_timestamp_init(&now, gps_secs, 0.999999999);
+  TESTASSERT(check_boundary(now, 4, 0) == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_known_boundary() == SRSRAN_SUCCESS);
+  TESTASSERT(test_gps_epoch() == SRSRAN_SUCCESS);
+
+  srsran::console("Success\n");
+  return SRSRAN_SUCCESS;
+}
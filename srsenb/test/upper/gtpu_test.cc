@@ -28,6 +28,7 @@
 #include "srsenb/test/common/dummy_classes.h"
 #include "srsenb/test/common/dummy_classes_common.h"
 #include "srsran/common/network_utils.h"
+#include "srsran/common/pcap.h"
 #include "srsran/common/test_common.h"
 #include "srsran/upper/gtpu.h"
 
@@ -381,6 +382,96 @@ int test_gtpu_direct_tunneling(tunnel_test_event event)
   return SRSRAN_SUCCESS;
 }
 
+void write_m1u_pcap_packet(FILE* f, uint32_t time_us, uint16_t dst_port, const srsran::byte_buffer_t& gtpu_pdu)
+{
+  std::vector<uint8_t> packet(sizeof(struct iphdr) + 8 + gtpu_pdu.N_bytes);
+  struct iphdr*        ip_pkt = (struct iphdr*)packet.data();
+  ip_pkt->version             = 4;
+  ip_pkt->ihl                 = 5;
+  ip_pkt->protocol            = IPPROTO_UDP;
+  ip_pkt->tot_len             = htons(packet.size());
+  uint8_t* udp                = &packet[sizeof(struct iphdr)];
+  udp[2]                      = dst_port >> 8;
+  udp[3]                      = dst_port & 0xff;
+  udp[4]                      = (8 + gtpu_pdu.N_bytes) >> 8;
+  udp[5]                      = (8 + gtpu_pdu.N_bytes) & 0xff;
+  memcpy(&udp[8], gtpu_pdu.msg, gtpu_pdu.N_bytes);
+
+  pcaprec_hdr_t record = {};
+  record.ts_sec        = time_us / 1000000;
+  record.ts_usec       = time_us % 1000000;
+  record.incl_len      = packet.size();
+  record.orig_len      = packet.size();
+  fwrite(&record, sizeof(record), 1, f);
+  fwrite(packet.data(), packet.size(), 1, f);
+}
+
+int test_gtpu_m1u_replay()
+{
+  const char*        pcap_filename = "/tmp/gtpu_m1u_replay_test.pcap";
+  const uint32_t     m1u_teid = 0x10, lcid = 1;
+  struct sockaddr_in src_sockaddr = {}, dst_sockaddr = {};
+  srsran::net_utils::set_sockaddr(&src_sockaddr, "127.0.0.1", GTPU_PORT + 1);
+  srsran::net_utils::set_sockaddr(&dst_sockaddr, "239.255.0.1", GTPU_PORT + 1);
+
+  // M1-U packets at 0 and 5 ms, and an S1-U packet which is not replayed
+  FILE* f = fopen(pcap_filename, "wb");
+  TESTASSERT(f != nullptr);
+  pcap_hdr_t header    = {};
+  header.magic_number  = 0xa1b2c3d4;
+  header.version_major = 2;
+  header.version_minor = 4;
+  header.snaplen       = 65535;
+  header.network       = 101; // Raw IP
+  fwrite(&header, sizeof(header), 1, f);
+  std::vector<uint8_t> data_vec(10, 1);
+  write_m1u_pcap_packet(f, 1000000, GTPU_PORT + 1, *encode_gtpu_packet(data_vec, m1u_teid, src_sockaddr, dst_sockaddr));
+  write_m1u_pcap_packet(f, 1001000, GTPU_PORT, *encode_gtpu_packet(data_vec, m1u_teid, src_sockaddr, dst_sockaddr));
+  data_vec.assign(10, 2);
+  write_m1u_pcap_packet(f, 1005000, GTPU_PORT + 1, *encode_gtpu_packet(data_vec, m1u_teid, src_sockaddr, dst_sockaddr));
+  fclose(f);
+
+  srsran::task_scheduler task_sched;
+  dummy_socket_manager   rx_sockets;
+  srsenb::gtpu           m1u_gtpu(&task_sched, srslog::fetch_basic_logger("GTPU"), &rx_sockets);
+  pdcp_tester            pdcp;
+  gtpu_args_t            gtpu_args;
+  gtpu_args.gtp_bind_addr  = "127.0.1.3";
+  gtpu_args.mme_addr       = "127.0.0.1";
+  gtpu_args.embms_enable   = true;
+  gtpu_args.embms_m1u_pcap = pcap_filename;
+  TESTASSERT(m1u_gtpu.init(gtpu_args, &pdcp) == SRSRAN_SUCCESS);
+
+  gtpu::bearer_props props;
+  props.m1u_teid = m1u_teid;
+  uint32_t addr_in;
+  TESTASSERT(m1u_gtpu.add_bearer(SRSRAN_MRNTI, lcid, 0, 0, addr_in, &props).has_value());
+
+  // TEST: packets are released when the TTIs reach their capture time
+  task_sched.tic();
+  TESTASSERT(pdcp.last_sdu != nullptr);
+  TESTASSERT(pdcp.last_rnti == SRSRAN_MRNTI and pdcp.last_eps_bearer_id == lcid);
+  TESTASSERT(pdcp.last_sdu->msg[pdcp.last_sdu->N_bytes - 1] == 1);
+  pdcp.clear();
+  for (uint32_t i = 1; i < 5; ++i) {
+    task_sched.tic();
+    TESTASSERT(pdcp.last_sdu == nullptr);
+  }
+  task_sched.tic();
+  TESTASSERT(pdcp.last_sdu != nullptr);
+  TESTASSERT(pdcp.last_sdu->msg[pdcp.last_sdu->N_bytes - 1] == 2);
+
+  // TEST: the replay stops at the end of the file
+  pdcp.clear();
+  for (uint32_t i = 0; i < 10; ++i) {
+    task_sched.tic();
+  }
+  TESTASSERT(pdcp.last_sdu == nullptr);
+
+  remove(pcap_filename);
+  return SRSRAN_SUCCESS;
+}
+
 } // namespace srsenb
 
 int main(int argc, char** argv)
@@ -398,6 +489,7 @@ int main(int argc, char** argv)
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::wait_end_marker_timeout) == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::ue_removal_no_marker) == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::reest_senb) == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_gtpu_m1u_replay() == SRSRAN_SUCCESS);
 
   srslog::flush();
 
@@ -0,0 +1,166 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/upper/mtch_ingress_queue.h"
+#include "srsran/common/test_common.h"
+
+namespace srsenb {
+
+using tp = mtch_ingress_queue::clock::time_point;
+
+static srsran::unique_byte_buffer_t make_pdu(uint32_t nof_bytes)
+{
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  srsran_assert(pdu != nullptr, "Failed to allocate buffer");
+  pdu->N_bytes = nof_bytes;
+  return pdu;
+}
+
+/// Packets are released at the configured rate, after the initial burst
+int test_mtch_rate_limit()
+{
+  mtch_ingress_queue::args_t args;
+  args.rate_bps     = 800000; // 100 bytes per ms
+  args.bucket_bytes = 200;
+
+  tp                 t0 = tp{};
+  mtch_ingress_queue q(args, t0);
+  for (uint32_t i = 0; i < 10; ++i) {
+    q.push(make_pdu(100), t0);
+  }
+
+  // The burst goes through at once
+  TESTASSERT(q.pop(t0) != nullptr);
+  TESTASSERT(q.pop(t0) != nullptr);
+  TESTASSERT(q.pop(t0) == nullptr);
+
+  // One packet per ms afterwards
+  TESTASSERT(q.pop(t0 + std::chrono::milliseconds(1)) != nullptr);
+  TESTASSERT(q.pop(t0 + std::chrono::milliseconds(1)) == nullptr);
+  TESTASSERT(q.pop(t0 + std::chrono::milliseconds(2)) != nullptr);
+
+  // Tokens never exceed the bucket depth
+  uint32_t count = 0;
+  while (q.pop(t0 + std::chrono::milliseconds(100)) != nullptr) {
+    count++;
+  }
+  TESTASSERT(count == 2);
+
+  const mtch_ingress_queue::metrics_t& m = q.get_metrics();
+  TESTASSERT(m.rx_pkts == 10 and m.tx_pkts == 6);
+  TESTASSERT(m.queued_pkts == 4 and m.queued_bytes == 400);
+  TESTASSERT(m.max_delay_us == 100000);
+  return SRSRAN_SUCCESS;
+}
+
+/// The MTCHs of a PMCH share its rate, whatever their number
+int test_mtch_shared_rate_limit()
+{
+  tp                                 t0     = tp{};
+  std::shared_ptr<mtch_token_bucket> bucket = std::make_shared<mtch_token_bucket>(800000, 200, t0); // 100 B per ms
+
+  mtch_ingress_queue::args_t args;
+  mtch_ingress_queue         q1(args, bucket);
+  mtch_ingress_queue         q2(args, bucket);
+  for (uint32_t i = 0; i < 10; ++i) {
+    q1.push(make_pdu(100), t0);
+    q2.push(make_pdu(100), t0);
+  }
+
+  // The burst is shared as well
+  TESTASSERT(q1.pop(t0) != nullptr);
+  TESTASSERT(q2.pop(t0) != nullptr);
+  TESTASSERT(q1.pop(t0) == nullptr);
+  TESTASSERT(q2.pop(t0) == nullptr);
+
+  // One packet per ms between both queues
+  uint32_t count = 0;
+  for (uint32_t ms = 1; ms <= 4; ++ms) {
+    tp t = t0 + std::chrono::milliseconds(ms);
+    count += (q1.pop(t) != nullptr) ? 1 : 0;
+    count += (q2.pop(t) != nullptr) ? 1 : 0;
+  }
+  TESTASSERT(count == 4);
+  TESTASSERT(q1.get_metrics().tx_pkts + q2.get_metrics().tx_pkts == 6);
+  return SRSRAN_SUCCESS;
+}
+
+/// Packets that waited too long are dropped on release
+int test_mtch_late_drop()
+{
+  mtch_ingress_queue::args_t args;
+  args.max_delay_ms = 10;
+
+  tp                 t0 = tp{};
+  mtch_ingress_queue q(args, t0);
+  q.push(make_pdu(10), t0);
+  q.push(make_pdu(20), t0 + std::chrono::milliseconds(5));
+
+  srsran::unique_byte_buffer_t pdu = q.pop(t0 + std::chrono::milliseconds(12));
+  TESTASSERT(pdu != nullptr and pdu->N_bytes == 20);
+  TESTASSERT(q.pop(t0 + std::chrono::milliseconds(12)) == nullptr);
+
+  const mtch_ingress_queue::metrics_t& m = q.get_metrics();
+  TESTASSERT(m.dropped_late_pkts == 1 and m.dropped_bytes == 10);
+  TESTASSERT(m.max_delay_us == 7000);
+  return SRSRAN_SUCCESS;
+}
+
+/// The oldest packets make room for new ones when the queue is full
+int test_mtch_overflow_drop()
+{
+  mtch_ingress_queue::args_t args;
+  args.max_bytes = 250;
+
+  tp                 t0 = tp{};
+  mtch_ingress_queue q(args, t0);
+  for (uint32_t i = 1; i <= 3; ++i) {
+    q.push(make_pdu(100 + i), t0);
+  }
+
+  const mtch_ingress_queue::metrics_t& m = q.get_metrics();
+  TESTASSERT(m.dropped_overflow_pkts == 1 and m.dropped_bytes == 101);
+  TESTASSERT(m.queued_pkts == 2 and m.queued_bytes == 205);
+
+  srsran::unique_byte_buffer_t pdu = q.pop(t0);
+  TESTASSERT(pdu != nullptr and pdu->N_bytes == 102);
+  pdu = q.pop(t0);
+  TESTASSERT(pdu != nullptr and pdu->N_bytes == 103);
+  TESTASSERT(q.pop(t0) == nullptr);
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  srsran::test_init(argc, argv);
+
+  TESTASSERT(srsenb::test_mtch_rate_limit() == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_mtch_shared_rate_limit() == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_mtch_late_drop() == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_mtch_overflow_drop() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  srsran::console("Success");
+  return SRSRAN_SUCCESS;
+}
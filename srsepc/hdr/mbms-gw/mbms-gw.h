@@ -33,20 +33,33 @@
 #include "srsran/common/threads.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
+#include <atomic>
 #include <cstddef>
+#include <memory>
+#include <sys/socket.h>
+#include <vector>
+
+struct ifreq;
 
 namespace srsepc {
 
 const uint16_t GTPU_RX_PORT = 2152;
 
+// SGi-mb input of one MBMS service. The M1-U packets of the service carry the TEID of its input
+typedef struct {
+  std::string if_name;
+  std::string if_addr;
+  uint32_t    teid;
+} sgi_mb_input_t;
+
 typedef struct {
-  std::string name;
-  std::string sgi_mb_if_name;
-  std::string sgi_mb_if_addr;
-  std::string sgi_mb_if_mask;
-  std::string m1u_multi_addr;
-  std::string m1u_multi_if;
-  int         m1u_multi_ttl;
+  std::string                 name;
+  std::vector<sgi_mb_input_t> sgi_mb_inputs;
+  std::string                 sgi_mb_if_mask;
+  std::string                 m1u_multi_addr;
+  std::string                 m1u_multi_if;
+  int                         m1u_multi_ttl;
+  uint32_t                    nof_workers;
 } mbms_gw_args_t;
 
 struct pseudo_hdr {
@@ -72,17 +85,50 @@ private:
   virtual ~mbms_gw();
   static mbms_gw* m_instance;
 
-  int      init_sgi_mb_if(mbms_gw_args_t* args);
+  int      init_sgi_mb_if(const sgi_mb_input_t& input, const std::string& if_mask, uint32_t nof_queues);
+  int      set_sgi_mb_if_addr6(struct ifreq* ifr, const std::string& if_addr);
   int      init_m1_u(mbms_gw_args_t* args);
-  void     handle_sgi_md_pdu(srsran::byte_buffer_t* msg);
+  void     close_sgi_mb_ifs();
+  bool     handle_sgi_md_pdu(srsran::byte_buffer_t* msg, uint32_t teid);
   uint16_t in_cksum(uint16_t* iphdr, int count);
 
+  /*
+   * Forwards the packets of one queue of every SGi-mb TUN interface to M1-U. The queues are drained in batches, and
+   * each batch is sent with a single sendmmsg call. With several workers the TUN interfaces are multi-queue, and the
+   * kernel steers each flow to one queue by hashing its addresses, so the packets of a destination group keep their
+   * order.
+   */
+  class sgi_mb_worker : public srsran::thread
+  {
+  public:
+    sgi_mb_worker(mbms_gw* parent_, uint32_t queue_idx_);
+    ~sgi_mb_worker();
+    int  init();
+    void run_loop();
+
+  private:
+    void run_thread() override { run_loop(); }
+    void forward_batch(uint32_t if_idx);
+
+    mbms_gw*                                  parent;
+    uint32_t                                  queue_idx;
+    int                                       epoll_fd = -1;
+    std::vector<srsran::unique_byte_buffer_t> pdus;
+    std::vector<struct iovec>                 iovs;
+    std::vector<struct mmsghdr>               msgs;
+  };
+
   /* Members */
-  bool                  m_running;
+  std::atomic<bool>     m_running;
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("MBMS");
 
-  bool m_sgi_mb_up;
-  int  m_sgi_mb_if;
+  struct sgi_mb_if_t {
+    std::vector<int> fds; ///< One TUN queue per worker
+    uint32_t         teid;
+  };
+  bool                                        m_sgi_mb_up;
+  std::vector<sgi_mb_if_t>                    m_sgi_mb_ifs;
+  std::vector<std::unique_ptr<sgi_mb_worker>> m_workers;
 
   bool               m_m1u_up;
   int                m_m1u;
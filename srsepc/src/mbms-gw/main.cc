@@ -21,6 +21,7 @@
 
 #include "srsepc/hdr/mbms-gw/mbms-gw.h"
 #include "srsran/common/config_file.h"
+#include "srsran/common/string_helpers.h"
 #include "srsran/srslog/srslog.h"
 #include <boost/program_options.hpp>
 #include <iostream>
@@ -61,6 +62,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   string mbms_gw_sgi_mb_if_name;
   string mbms_gw_sgi_mb_if_addr;
   string mbms_gw_sgi_mb_if_mask;
+  string mbms_gw_sgi_mb_teid;
   string mbms_gw_m1u_multi_addr;
   string mbms_gw_m1u_multi_if;
 
@@ -80,12 +82,14 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   common.add_options()
 
     ("mbms_gw.name",      bpo::value<string>(&mbms_gw_name)->default_value("srsmbmsgw01"), "MBMS-GW Name")
-    ("mbms_gw.sgi_mb_if_name",      bpo::value<string>(&mbms_gw_sgi_mb_if_name)->default_value("sgi_mb"), "SGi-mb TUN interface Address.")
-    ("mbms_gw.sgi_mb_if_addr",      bpo::value<string>(&mbms_gw_sgi_mb_if_addr)->default_value("172.16.1.1"), "SGi-mb TUN interface Address.")
+    ("mbms_gw.sgi_mb_if_name",      bpo::value<string>(&mbms_gw_sgi_mb_if_name)->default_value("sgi_mb"), "Comma-separated list of SGi-mb TUN interface names, one per MBMS service.")
+    ("mbms_gw.sgi_mb_if_addr",      bpo::value<string>(&mbms_gw_sgi_mb_if_addr)->default_value("172.16.1.1"), "Comma-separated list of SGi-mb TUN interface addresses. IPv6 addresses take an optional prefix length (default /64).")
     ("mbms_gw.sgi_mb_if_mask",      bpo::value<string>(&mbms_gw_sgi_mb_if_mask)->default_value("255.255.255.255"), "SGi-mb TUN interface mask.")
+    ("mbms_gw.sgi_mb_teid",         bpo::value<string>(&mbms_gw_sgi_mb_teid)->default_value("0xAAAA"), "M1-U TEID of all the SGi-mb interfaces, or comma-separated list of M1-U TEIDs (TMGI service IDs), one per SGi-mb interface.")
     ("mbms_gw.m1u_multi_addr",      bpo::value<string>(&mbms_gw_m1u_multi_addr)->default_value("239.255.0.1"), "M1-u GTPu destination multicast address.")
     ("mbms_gw.m1u_multi_if",        bpo::value<string>(&mbms_gw_m1u_multi_if)->default_value("127.0.1.200"), "Local interface IP for M1-U multicast packets.")
     ("mbms_gw.m1u_multi_ttl",       bpo::value<int>(&args->mbms_gw_args.m1u_multi_ttl)->default_value(1), "TTL for M1-U multicast packets.")
+    ("mbms_gw.nof_workers",         bpo::value<uint32_t>(&args->mbms_gw_args.nof_workers)->default_value(1), "Number of threads forwarding SGi-mb traffic. More than one makes the SGi-mb interfaces multi-queue.")
 
     ("log.all_level",     bpo::value<string>(&args->log_args.all_level)->default_value("info"),   "ALL log level")
     ("log.all_hex_limit", bpo::value<int>(&args->log_args.all_hex_limit)->default_value(32),  "ALL log hex dump limit")
@@ -143,12 +147,33 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   bpo::notify(vm);
 
   args->mbms_gw_args.name           = mbms_gw_name;
-  args->mbms_gw_args.sgi_mb_if_name = mbms_gw_sgi_mb_if_name;
-  args->mbms_gw_args.sgi_mb_if_addr = mbms_gw_sgi_mb_if_addr;
   args->mbms_gw_args.sgi_mb_if_mask = mbms_gw_sgi_mb_if_mask;
   args->mbms_gw_args.m1u_multi_addr = mbms_gw_m1u_multi_addr;
   args->mbms_gw_args.m1u_multi_if   = mbms_gw_m1u_multi_if;
 
+  // A single TEID tags the traffic of all the SGi-mb interfaces. Otherwise each interface carries one MBMS service,
+  // tagged with its own TEID on M1-U
+  std::vector<std::string> if_names = srsran::split_string(mbms_gw_sgi_mb_if_name, ',');
+  std::vector<std::string> if_addrs = srsran::split_string(mbms_gw_sgi_mb_if_addr, ',');
+  std::vector<std::string> teids    = srsran::split_string(mbms_gw_sgi_mb_teid, ',');
+  if (teids.size() == 1) {
+    teids.resize(if_names.size(), teids[0]);
+  }
+  if (if_names.size() != if_addrs.size() or if_names.size() != teids.size()) {
+    cout << "Error: sgi_mb_if_name and sgi_mb_if_addr must have the same number of entries, and sgi_mb_teid one or "
+            "as many - exiting"
+         << endl;
+    exit(1);
+  }
+  args->mbms_gw_args.sgi_mb_inputs.clear();
+  for (uint32_t i = 0; i < if_names.size(); ++i) {
+    sgi_mb_input_t input;
+    input.if_name = if_names[i];
+    input.if_addr = if_addrs[i];
+    input.teid    = strtoul(teids[i].c_str(), nullptr, 0);
+    args->mbms_gw_args.sgi_mb_inputs.push_back(input);
+  }
+
   // Apply all_level to any unset layers
   if (vm.count("log.all_level")) {
     if (!vm.count("log.mbms_gw_level")) {
@@ -23,6 +23,7 @@
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/network_utils.h"
 #include "srsran/upper/gtpu.h"
+#include "srsran/upper/ipv6.h"
 #include <algorithm>
 #include <fcntl.h>
 #include <iostream>
@@ -31,6 +32,7 @@
 #include <linux/ip.h>
 #include <netinet/in.h>
 #include <netinet/udp.h>
+#include <sys/epoll.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 
@@ -41,6 +43,12 @@ pthread_mutex_t mbms_gw_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 const uint16_t MBMS_GW_BUFFER_SIZE = 2500;
 
+// Maximum number of packets read from a TUN queue and sent to M1-U in one go
+const uint32_t MBMS_GW_BATCH_SIZE = 32;
+
+// Time after which the workers check whether the MBMS-GW is being stopped
+const int MBMS_GW_POLL_TIMEOUT_MS = 100;
+
 mbms_gw::mbms_gw() : m_running(false), m_sgi_mb_up(false), thread("MBMS_GW")
 {
   return;
@@ -75,18 +83,38 @@ int mbms_gw::init(mbms_gw_args_t* args)
 {
   int err;
 
-  err = init_sgi_mb_if(args);
-  if (err != SRSRAN_SUCCESS) {
-    srsran::console("Error initializing SGi-MB.\n");
-    m_logger.error("Error initializing SGi-MB.");
-    return SRSRAN_ERROR_CANT_START;
+  if (m_sgi_mb_up) {
+    return SRSRAN_ERROR_ALREADY_STARTED;
+  }
+  uint32_t nof_workers = std::max(args->nof_workers, 1u);
+  for (const sgi_mb_input_t& input : args->sgi_mb_inputs) {
+    err = init_sgi_mb_if(input, args->sgi_mb_if_mask, nof_workers);
+    if (err != SRSRAN_SUCCESS) {
+      srsran::console("Error initializing SGi-MB.\n");
+      m_logger.error("Error initializing SGi-MB.");
+      close_sgi_mb_ifs();
+      return SRSRAN_ERROR_CANT_START;
+    }
   }
+  m_sgi_mb_up = true;
+
   err = init_m1_u(args);
   if (err != SRSRAN_SUCCESS) {
     srsran::console("Error initializing SGi-MB.\n");
     m_logger.error("Error initializing SGi-MB.");
     return SRSRAN_ERROR_CANT_START;
   }
+
+  for (uint32_t i = 0; i < nof_workers; ++i) {
+    std::unique_ptr<sgi_mb_worker> worker(new sgi_mb_worker(this, i));
+    if (worker->init() != SRSRAN_SUCCESS) {
+      srsran::console("Error initializing MBMS-GW worker.\n");
+      m_workers.clear();
+      return SRSRAN_ERROR_CANT_START;
+    }
+    m_workers.push_back(std::move(worker));
+  }
+  m_logger.info("Forwarding SGi-mb traffic with %d worker(s)", nof_workers);
   m_logger.info("MBMS GW Initiated");
   srsran::console("MBMS GW Initiated\n");
   return SRSRAN_SUCCESS;
@@ -95,59 +123,75 @@ int mbms_gw::init(mbms_gw_args_t* args)
 void mbms_gw::stop()
 {
   if (m_running) {
-    if (m_sgi_mb_up) {
-      close(m_sgi_mb_if);
-      m_logger.info("Closed SGi-MB interface");
-    }
     m_running = false;
-    thread_cancel();
     wait_thread_finish();
+    m_workers.clear();
+    if (m_sgi_mb_up) {
+      close_sgi_mb_ifs();
+      m_logger.info("Closed SGi-MB interfaces");
+    }
   }
   return;
 }
 
-int mbms_gw::init_sgi_mb_if(mbms_gw_args_t* args)
+void mbms_gw::close_sgi_mb_ifs()
 {
-  struct ifreq ifr;
-
-  if (m_sgi_mb_up) {
-    return SRSRAN_ERROR_ALREADY_STARTED;
+  for (const sgi_mb_if_t& sgi_mb_if : m_sgi_mb_ifs) {
+    for (int fd : sgi_mb_if.fds) {
+      close(fd);
+    }
   }
+  m_sgi_mb_ifs.clear();
+}
 
-  // Construct the TUN device
-  m_sgi_mb_if = open("/dev/net/tun", O_RDWR);
-  m_logger.info("TUN file descriptor = %d", m_sgi_mb_if);
-  if (m_sgi_mb_if < 0) {
-    m_logger.error("Failed to open TUN device: %s", strerror(errno));
-    return SRSRAN_ERROR_CANT_START;
-  }
+int mbms_gw::init_sgi_mb_if(const sgi_mb_input_t& input, const std::string& if_mask, uint32_t nof_queues)
+{
+  struct ifreq ifr;
+  sgi_mb_if_t  sgi_mb_if = {};
+  sgi_mb_if.teid         = input.teid;
 
-  memset(&ifr, 0, sizeof(ifr));
-  ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
-  strncpy(ifr.ifr_ifrn.ifrn_name,
-          args->sgi_mb_if_name.c_str(),
-          std::min(args->sgi_mb_if_name.length(), (size_t)IFNAMSIZ - 1));
-  ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = '\0';
+  auto close_queues = [&sgi_mb_if]() {
+    for (int fd : sgi_mb_if.fds) {
+      close(fd);
+    }
+  };
+
+  // Construct the TUN device, with one queue per worker
+  for (uint32_t i = 0; i < nof_queues; ++i) {
+    int fd = open("/dev/net/tun", O_RDWR | O_NONBLOCK);
+    m_logger.info("TUN file descriptor = %d", fd);
+    if (fd < 0) {
+      m_logger.error("Failed to open TUN device: %s", strerror(errno));
+      close_queues();
+      return SRSRAN_ERROR_CANT_START;
+    }
+    sgi_mb_if.fds.push_back(fd);
 
-  if (ioctl(m_sgi_mb_if, TUNSETIFF, &ifr) < 0) {
-    m_logger.error("Failed to set TUN device name: %s", strerror(errno));
-    close(m_sgi_mb_if);
-    return SRSRAN_ERROR_CANT_START;
-  } else {
-    m_logger.debug("Set TUN device name: %s", args->sgi_mb_if_name.c_str());
+    memset(&ifr, 0, sizeof(ifr));
+    ifr.ifr_flags = IFF_TUN | IFF_NO_PI | (nof_queues > 1 ? IFF_MULTI_QUEUE : 0);
+    strncpy(ifr.ifr_ifrn.ifrn_name, input.if_name.c_str(), std::min(input.if_name.length(), (size_t)IFNAMSIZ - 1));
+    ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = '\0';
+
+    if (ioctl(fd, TUNSETIFF, &ifr) < 0) {
+      m_logger.error("Failed to set TUN device name: %s", strerror(errno));
+      close_queues();
+      return SRSRAN_ERROR_CANT_START;
+    } else {
+      m_logger.debug("Set TUN device name: %s", input.if_name.c_str());
+    }
   }
 
   // Bring up the interface
   int sgi_mb_sock = socket(AF_INET, SOCK_DGRAM, 0);
   if (sgi_mb_sock < 0) {
     m_logger.error("Failed to bring up socket: %s", strerror(errno));
-    close(m_sgi_mb_if);
+    close_queues();
     return SRSRAN_ERROR_CANT_START;
   }
 
   if (ioctl(sgi_mb_sock, SIOCGIFFLAGS, &ifr) < 0) {
     m_logger.error("Failed to bring up interface: %s", strerror(errno));
-    close(m_sgi_mb_if);
+    close_queues();
     close(sgi_mb_sock);
     return SRSRAN_ERROR_CANT_START;
   }
@@ -156,45 +200,96 @@ int mbms_gw::init_sgi_mb_if(mbms_gw_args_t* args)
   if (ioctl(sgi_mb_sock, SIOCSIFFLAGS, &ifr) < 0) {
     m_logger.error("Failed to set socket flags: %s", strerror(errno));
     close(sgi_mb_sock);
-    close(m_sgi_mb_if);
+    close_queues();
     return SRSRAN_ERROR_CANT_START;
   }
 
   // Set IP of the interface
-  struct sockaddr_in* addr = (struct sockaddr_in*)&ifr.ifr_addr;
+  if (input.if_addr.find(':') != std::string::npos) {
+    close(sgi_mb_sock);
+    if (set_sgi_mb_if_addr6(&ifr, input.if_addr) != SRSRAN_SUCCESS) {
+      close_queues();
+      return SRSRAN_ERROR_CANT_START;
+    }
+  } else {
+    struct sockaddr_in* addr = (struct sockaddr_in*)&ifr.ifr_addr;
+
+    if (not srsran::net_utils::set_sockaddr(addr, input.if_addr.c_str(), 0)) {
+      m_logger.error("Invalid sgi_mb_if_addr: %s", input.if_addr.c_str());
+      srsran::console("Invalid sgi_mb_if_addr: %s\n", input.if_addr.c_str());
+      close_queues();
+      close(sgi_mb_sock);
+      return SRSRAN_ERROR_CANT_START;
+    }
+
+    if (ioctl(sgi_mb_sock, SIOCSIFADDR, &ifr) < 0) {
+      m_logger.error("Failed to set TUN interface IP. Address: %s, Error: %s", input.if_addr.c_str(), strerror(errno));
+      close_queues();
+      close(sgi_mb_sock);
+      return SRSRAN_ERROR_CANT_START;
+    }
 
-  if (not srsran::net_utils::set_sockaddr(addr, args->sgi_mb_if_addr.c_str(), 0)) {
-    m_logger.error("Invalid sgi_mb_if_addr: %s", args->sgi_mb_if_addr.c_str());
-    srsran::console("Invalid sgi_mb_if_addr: %s\n", args->sgi_mb_if_addr.c_str());
-    close(m_sgi_mb_if);
+    ifr.ifr_netmask.sa_family = AF_INET;
+    if (inet_pton(ifr.ifr_netmask.sa_family,
+                  if_mask.c_str(),
+                  &((struct sockaddr_in*)&ifr.ifr_netmask)->sin_addr.s_addr) != 1) {
+      m_logger.error("Invalid sgi_mb_if_mask: %s", if_mask.c_str());
+      srsran::console("Invalid sgi_mb_if_mask: %s\n", if_mask.c_str());
+      perror("inet_pton");
+      close_queues();
+      close(sgi_mb_sock);
+      return SRSRAN_ERROR_CANT_START;
+    }
+    if (ioctl(sgi_mb_sock, SIOCSIFNETMASK, &ifr) < 0) {
+      m_logger.error("Failed to set TUN interface Netmask. Error: %s", strerror(errno));
+      close_queues();
+      close(sgi_mb_sock);
+      return SRSRAN_ERROR_CANT_START;
+    }
     close(sgi_mb_sock);
-    return SRSRAN_ERROR_CANT_START;
   }
 
-  if (ioctl(sgi_mb_sock, SIOCSIFADDR, &ifr) < 0) {
-    m_logger.error(
-        "Failed to set TUN interface IP. Address: %s, Error: %s", args->sgi_mb_if_addr.c_str(), strerror(errno));
-    close(m_sgi_mb_if);
-    close(sgi_mb_sock);
+  m_sgi_mb_ifs.push_back(sgi_mb_if);
+  m_logger.info("SGi-mb interface %s carries M1-U TEID=0x%x", input.if_name.c_str(), input.teid);
+  return SRSRAN_SUCCESS;
+}
+
+// IPv6 SGi-mb interfaces take an address with an optional prefix length, e.g. fd00:1::1/64
+int mbms_gw::set_sgi_mb_if_addr6(struct ifreq* ifr, const std::string& if_addr)
+{
+  struct in6_ifreq ifr6      = {};
+  std::string      addr_str  = if_addr;
+  uint32_t         prefixlen = 64;
+
+  size_t slash = if_addr.find('/');
+  if (slash != std::string::npos) {
+    addr_str  = if_addr.substr(0, slash);
+    prefixlen = strtoul(if_addr.c_str() + slash + 1, nullptr, 10);
+  }
+  if (inet_pton(AF_INET6, addr_str.c_str(), &ifr6.ifr6_addr) != 1 or prefixlen > 128) {
+    m_logger.error("Invalid sgi_mb_if_addr: %s", if_addr.c_str());
+    srsran::console("Invalid sgi_mb_if_addr: %s\n", if_addr.c_str());
     return SRSRAN_ERROR_CANT_START;
   }
 
-  ifr.ifr_netmask.sa_family                                = AF_INET;
-  if (inet_pton(ifr.ifr_netmask.sa_family, args->sgi_mb_if_mask.c_str(), &((struct sockaddr_in*)&ifr.ifr_netmask)->sin_addr.s_addr ) != 1) {
-    m_logger.error("Invalid sgi_mb_if_mask: %s", args->sgi_mb_if_mask.c_str());
-    srsran::console("Invalid sgi_mb_if_mask: %s\n", args->sgi_mb_if_mask.c_str());
-    perror("inet_pton");
+  int sgi_mb_sock6 = socket(AF_INET6, SOCK_DGRAM, 0);
+  if (sgi_mb_sock6 < 0) {
+    m_logger.error("Failed to open IPv6 socket: %s", strerror(errno));
     return SRSRAN_ERROR_CANT_START;
   }
-  if (ioctl(sgi_mb_sock, SIOCSIFNETMASK, &ifr) < 0) {
-    m_logger.error("Failed to set TUN interface Netmask. Error: %s", strerror(errno));
-    close(m_sgi_mb_if);
-    close(sgi_mb_sock);
+  if (ioctl(sgi_mb_sock6, SIOGIFINDEX, ifr) < 0) {
+    m_logger.error("Failed to get TUN interface index. Error: %s", strerror(errno));
+    close(sgi_mb_sock6);
     return SRSRAN_ERROR_CANT_START;
   }
-
-  m_sgi_mb_up = true;
-  close(sgi_mb_sock);
+  ifr6.ifr6_ifindex   = ifr->ifr_ifindex;
+  ifr6.ifr6_prefixlen = prefixlen;
+  if (ioctl(sgi_mb_sock6, SIOCSIFADDR, &ifr6) < 0) {
+    m_logger.error("Failed to set TUN interface IPv6. Address: %s, Error: %s", if_addr.c_str(), strerror(errno));
+    close(sgi_mb_sock6);
+    return SRSRAN_ERROR_CANT_START;
+  }
+  close(sgi_mb_sock6);
   return SRSRAN_SUCCESS;
 }
 
@@ -257,65 +352,172 @@ int mbms_gw::init_m1_u(mbms_gw_args_t* args)
 void mbms_gw::run_thread()
 {
   // Mark the thread as running
-  m_running                        = true;
-  srsran::unique_byte_buffer_t msg = srsran::make_byte_buffer();
-  if (msg == nullptr) {
-    m_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
-    return;
-  }
+  m_running = true;
 
-  uint8_t seq = 0;
-  while (m_running) {
-    msg->clear();
-    int n;
-    do {
-      n = read(m_sgi_mb_if, msg->msg, SRSRAN_MAX_BUFFER_SIZE_BYTES);
-    } while (n == -1 && errno == EAGAIN);
-
-    if (n < 0) {
-      m_logger.error("Error reading from TUN interface. Error: %s", strerror(errno));
-    } else {
-      msg->N_bytes = n;
-      handle_sgi_md_pdu(msg.get());
-    }
+  // The first worker runs in this thread
+  for (uint32_t i = 1; i < m_workers.size(); ++i) {
+    m_workers[i]->start();
+  }
+  m_workers[0]->run_loop();
+  for (uint32_t i = 1; i < m_workers.size(); ++i) {
+    m_workers[i]->wait_thread_finish();
   }
   return;
 }
 
-void mbms_gw::handle_sgi_md_pdu(srsran::byte_buffer_t* msg)
+bool mbms_gw::handle_sgi_md_pdu(srsran::byte_buffer_t* msg, uint32_t teid)
 {
-  uint8_t               version;
   srsran::gtpu_header_t header;
 
   // Setup GTP-U header
   header.flags        = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
   header.message_type = GTPU_MSG_DATA_PDU;
   header.length       = msg->N_bytes;
-  header.teid         = 0xAAAA; // TODO Harcoded TEID for now
+  header.teid         = teid;
 
   // Sanity Check IP packet
   if (msg->N_bytes < 20) {
     m_logger.error("IPv4 min len: %d, drop msg len %d", 20, msg->N_bytes);
-    return;
+    return false;
   }
 
   // IP Headers
   struct iphdr* iph = (struct iphdr*)msg->msg;
-  if (iph->version != 4) {
-    m_logger.info("IPv6 not supported yet.");
-    return;
+  if (iph->version == 6) {
+    if (msg->N_bytes < sizeof(struct ipv6hdr)) {
+      m_logger.error("IPv6 min len: %zd, drop msg len %d", sizeof(struct ipv6hdr), msg->N_bytes);
+      return false;
+    }
+  } else if (iph->version != 4) {
+    m_logger.info("Unknown IP version %d, drop msg len %d", (int)iph->version, msg->N_bytes);
+    return false;
   }
 
   // Write GTP-U header into packet
   if (!srsran::gtpu_write_header(&header, msg, m_logger)) {
     srsran::console("Error writing GTP-U header on PDU\n");
+    return false;
   }
+  return true;
+}
 
-  int n = sendto(m_m1u, msg->msg, msg->N_bytes, 0, (sockaddr*)&m_m1u_multi_addr, sizeof(struct sockaddr));
-  if (n < 0) {
-    srsran::console("Error writing to M1-U socket.\n");
-  } else {
-    m_logger.debug("Sent %d Bytes", msg->N_bytes);
+mbms_gw::sgi_mb_worker::sgi_mb_worker(mbms_gw* parent_, uint32_t queue_idx_) :
+  thread("MBMS_GW_" + std::to_string(queue_idx_)), parent(parent_), queue_idx(queue_idx_)
+{}
+
+mbms_gw::sgi_mb_worker::~sgi_mb_worker()
+{
+  if (epoll_fd >= 0) {
+    close(epoll_fd);
+  }
+}
+
+int mbms_gw::sgi_mb_worker::init()
+{
+  epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd < 0) {
+    parent->m_logger.error("Failed to create epoll instance: %s", strerror(errno));
+    return SRSRAN_ERROR_CANT_START;
+  }
+  for (uint32_t i = 0; i < parent->m_sgi_mb_ifs.size(); ++i) {
+    struct epoll_event ev = {};
+    ev.events             = EPOLLIN;
+    ev.data.u32           = i;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, parent->m_sgi_mb_ifs[i].fds[queue_idx], &ev) < 0) {
+      parent->m_logger.error("Failed to add SGi-mb interface to epoll: %s", strerror(errno));
+      return SRSRAN_ERROR_CANT_START;
+    }
+  }
+
+  // The buffers are reused for every batch, and all the datagrams go to the M1-U multicast group
+  pdus.resize(MBMS_GW_BATCH_SIZE);
+  iovs.resize(MBMS_GW_BATCH_SIZE);
+  msgs.resize(MBMS_GW_BATCH_SIZE);
+  for (uint32_t i = 0; i < MBMS_GW_BATCH_SIZE; ++i) {
+    pdus[i] = srsran::make_byte_buffer();
+    if (pdus[i] == nullptr) {
+      parent->m_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+      return SRSRAN_ERROR_CANT_START;
+    }
+    msgs[i]                     = {};
+    msgs[i].msg_hdr.msg_name    = &parent->m_m1u_multi_addr;
+    msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+    msgs[i].msg_hdr.msg_iov     = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen  = 1;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+void mbms_gw::sgi_mb_worker::run_loop()
+{
+  std::vector<struct epoll_event> events(std::max(parent->m_sgi_mb_ifs.size(), (size_t)1));
+
+  while (parent->m_running) {
+    int n = epoll_wait(epoll_fd, events.data(), events.size(), MBMS_GW_POLL_TIMEOUT_MS);
+    if (n < 0) {
+      if (errno != EINTR) {
+        parent->m_logger.error("Error polling SGi-mb interfaces. Error: %s", strerror(errno));
+      }
+      continue;
+    }
+    // Level-triggered, so interfaces with more than a batch pending are served again on the next wait
+    for (int i = 0; i < n; ++i) {
+      forward_batch(events[i].data.u32);
+    }
+  }
+}
+
+void mbms_gw::sgi_mb_worker::forward_batch(uint32_t if_idx)
+{
+  const sgi_mb_if_t& sgi_mb_if = parent->m_sgi_mb_ifs[if_idx];
+  int                fd        = sgi_mb_if.fds[queue_idx];
+
+  uint32_t nof_pdus = 0;
+  while (nof_pdus < pdus.size()) {
+    srsran::byte_buffer_t* msg = pdus[nof_pdus].get();
+    msg->clear();
+    int n = read(fd, msg->msg, msg->get_tailroom());
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno != EAGAIN and errno != EWOULDBLOCK) {
+        // The queue stays readable under level-triggered polling, keeping it would spin on the same error
+        srsran::console(
+            "Error reading from TUN interface, stopping queue %d of TEID=0x%x.\n", queue_idx, sgi_mb_if.teid);
+        parent->m_logger.error("Error reading from TUN interface, stopping queue %d of TEID=0x%x. Error: %s",
+                               queue_idx,
+                               sgi_mb_if.teid,
+                               strerror(errno));
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr) < 0) {
+          parent->m_logger.error("Failed to remove SGi-mb interface from epoll: %s", strerror(errno));
+        }
+      }
+      break;
+    }
+    msg->N_bytes = n;
+    if (parent->handle_sgi_md_pdu(msg, sgi_mb_if.teid)) {
+      iovs[nof_pdus].iov_base = msg->msg;
+      iovs[nof_pdus].iov_len  = msg->N_bytes;
+      nof_pdus++;
+    }
+  }
+
+  uint32_t nof_sent = 0;
+  while (nof_sent < nof_pdus) {
+    int n = sendmmsg(parent->m_m1u, &msgs[nof_sent], nof_pdus - nof_sent, 0);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      srsran::console("Error writing to M1-U socket.\n");
+      parent->m_logger.error("Error writing to M1-U socket. Error: %s", strerror(errno));
+      return;
+    }
+    nof_sent += n;
+  }
+  if (nof_sent > 0) {
+    parent->m_logger.debug("Sent %d packets of TEID=0x%x", nof_sent, sgi_mb_if.teid);
   }
 }
 
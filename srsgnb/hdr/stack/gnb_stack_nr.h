@@ -88,6 +88,14 @@ public:
   void process_pdus() final;
 
   void toggle_padding() override {}
+  void mbms_session_start(uint32_t           area_idx,
+                          uint32_t           pmch_idx,
+                          const std::string& plmn,
+                          uint32_t           service_id,
+                          uint32_t           lcid,
+                          int                session_id) override
+  {}
+  void mbms_session_stop(const std::string& plmn, uint32_t service_id) override {}
 
   int         slot_indication(const srsran_slot_cfg_t& slot_cfg) override;
   dl_sched_t* get_dl_sched(const srsran_slot_cfg_t& slot_cfg) override;
@@ -140,6 +140,7 @@ public:
   void              set_tx_freq(const uint32_t& carrier_idx, const double& freq) override {}
   void              set_rx_freq(const uint32_t& carrier_idx, const double& freq) override {}
   void              release_freq(const uint32_t& carrier_idx) override {}
+  bool              get_time(srsran::rf_timestamp_interface& now) override { return false; }
   void              set_tx_gain(const float& gain) override {}
   void              set_rx_gain_th(const float& gain) override {}
   void              set_rx_gain(const float& gain) override {}
@@ -150,6 +151,7 @@ public:
   float             get_rx_gain() override { return 0; }
   bool              is_continuous_tx() override { return false; }
   bool              get_is_start_of_burst() override { return false; }
+  float             get_tx_sc16_scale() override { return 0.0f; }
   bool              is_init() override { return false; }
   void              reset() override { running = false; }
   srsran_rf_info_t* get_info() override { return nullptr; }
@@ -243,6 +243,7 @@ private:
     }
     void release_freq(const uint32_t& carrier_idx) override{};
     void tx_end() override {}
+    bool get_time(srsran::rf_timestamp_interface& now) override { return false; }
     bool rx_now(srsran::rf_buffer_interface& buffer, srsran::rf_timestamp_interface& rxd_time) override
     {
       notify_rx_now();
@@ -344,6 +345,7 @@ private:
     double            get_freq_offset() override { return 0; }
     bool              is_continuous_tx() override { return false; }
     bool              get_is_start_of_burst() override { return false; }
+    float             get_tx_sc16_scale() override { return 0.0f; }
     bool              is_init() override { return false; }
     void              reset() override {}
     srsran_rf_info_t* get_info() override { return &rf_info; }
@@ -345,7 +345,9 @@ void mac::mch_decoded(uint32_t len, bool crc)
           uint16_t stop;
           uint8_t  lcid;
           if (mch_msg.get()->get_next_mch_sched_info(&lcid, &stop)) {
-            phy_h->set_mch_period_stop(stop);
+            if (stop != srsran::sch_subh::MTCH_STOP_EMPTY) {
+              phy_h->set_mch_period_stop(stop);
+            }
             Info("MCH Sched Info: LCID: %d, Stop: %d, tti is %d ", lcid, stop, phy_h->get_current_tti());
           }
         }